@@ -0,0 +1,299 @@
+/**
+ ******************************************************************************
+ * @file           : host_port.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Host emulation of the STM32F401 for the host tests.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#define _GNU_SOURCE
+#include "host_port.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "CortexM4/SCB/SCB.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define HOST_WINDOWS_NUMBER			2UL
+#define HOST_PENDSV_IRQ_NUMBER		14UL
+#define HOST_SYSTICK_IRQ_NUMBER		15UL
+/* SHPR bytes of the system handlers, from MemManage (4) */
+#define HOST_PENDSV_SHPR_INDEX		10UL
+#define HOST_SYSTICK_SHPR_INDEX		11UL
+#define HOST_AIRCR_PRIGROUP_POS		8UL
+#define HOST_MAX_CONTEXTS			16UL
+#define HOST_CONTEXT_STACK_SIZE		(128UL * 1024UL)
+/* Words of the initial thread frame: R4-R11, EXC_RETURN, R0-R3, R12, LR, PC, xPSR */
+#define HOST_FRAME_R0				9UL
+#define HOST_FRAME_LR				14UL
+#define HOST_FRAME_PC				15UL
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uintptr_t Base;
+	size_t Size;
+} Host_Window_t;
+
+typedef struct
+{
+	uint32_t * Stack_Key;
+	ucontext_t Context;
+} Host_Context_t;
+/*---------------  Section: Global Variables --------------- */
+volatile uint32_t Host_Core_PRIMASK = 0;
+volatile uint32_t Host_Core_BASEPRI = 0;
+volatile uint32_t Host_Core_IPSR = 0;
+volatile uint32_t Host_Core_CONTROL = 0;
+volatile uint32_t Host_Core_PSP = 0;
+volatile uint32_t Host_Core_Exclusive = 0;
+volatile uint64_t Host_Time = 0;
+void (*Host_Wfi_Hook)(void) = NULL;
+/*---------------  Section: Static Global Variables --------------- */
+
+/* APB1, APB2 and AHB1 peripherals, then the private peripheral bus */
+static const Host_Window_t Host_Windows[HOST_WINDOWS_NUMBER] =
+{
+	{ 0x40000000UL, 0x00030000UL },
+	{ 0xE0000000UL, 0x00100000UL }
+};
+static Interrupt_Handler_t Host_Irq_Handler = NULL;
+static uint32_t Host_Irq_Priority = 0;
+/* Host contexts of the kernel threads, keyed by their saved stack pointer */
+static Host_Context_t Host_Contexts[HOST_MAX_CONTEXTS];
+static uint32_t Host_Contexts_Count = 0;
+static Host_Context_t * Host_Context_Starting = NULL;
+static uint8_t Host_Context_Stacks[HOST_MAX_CONTEXTS][HOST_CONTEXT_STACK_SIZE] __attribute__((aligned(16)));
+/* Weak, the tests without the SysTick driver or the kernel link too */
+extern void SysTick_Handler(void) __attribute__((weak));
+extern void PendSV_Handler(void) __attribute__((weak));
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Host_Port_Map(void) __attribute__((constructor));
+static void Host_Context_Start(void);
+static uint32_t Host_Core_Is_Masked(uint32_t Priority);
+/*---------------  Section: Function Definitions --------------- */
+void Host_Port_Reset(void)
+{
+	uint32_t Idx = 0;
+
+	for(Idx = 0; Idx < HOST_WINDOWS_NUMBER; Idx++)
+		{ memset((void *)Host_Windows[Idx].Base, 0, Host_Windows[Idx].Size); }
+	Host_Core_PRIMASK = 0;
+	Host_Core_BASEPRI = 0;
+	Host_Core_IPSR = 0;
+	Host_Core_CONTROL = 0;
+	Host_Core_PSP = 0;
+	Host_Core_Exclusive = 0;
+	Host_Time = 0;
+	Host_Wfi_Hook = NULL;
+	Host_Irq_Handler = NULL;
+	Host_Irq_Priority = 0;
+	Host_Contexts_Count = 0;
+}
+
+void Host_Core_Set_PRIMASK(uint32_t Value)
+{
+	Host_Core_PRIMASK = Value & 1UL;
+	Host_Core_Take_Pending();
+}
+
+void Host_Core_Set_BASEPRI(uint32_t Value)
+{
+	Host_Core_BASEPRI = Value & 0xFFUL;
+	Host_Core_Take_Pending();
+}
+
+void Host_Core_Wfi(void)
+{
+	if(NULL != Host_Wfi_Hook)
+		{ Host_Wfi_Hook(); }
+}
+
+void Host_Core_Take_Pending(void)
+{
+	Interrupt_Handler_t Handler = NULL;
+
+	/* No nesting in the model: the handlers run from thread mode only */
+	if((0UL != Host_Core_PRIMASK) || (0UL != Host_Core_IPSR))
+		{ return; }
+
+	if((NULL != Host_Irq_Handler) && !Host_Core_Is_Masked(Host_Irq_Priority))
+	{
+		Handler = Host_Irq_Handler;
+		Host_Irq_Handler = NULL;
+		CLEAR_BIT(SCB->ICSR, SCB_ICSR_ISRPENDING_POS);
+		Host_Core_Exclusive = 0;
+		Host_Core_IPSR = 16UL;
+		Handler();
+		Host_Core_IPSR = 0;
+	}
+	if(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS) && !Host_Core_Is_Masked(SCB->SHPR[HOST_SYSTICK_SHPR_INDEX]))
+	{
+		CLEAR_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS);
+		Host_Core_Exclusive = 0;
+		Host_Core_IPSR = HOST_SYSTICK_IRQ_NUMBER;
+		if(NULL != SysTick_Handler)
+			{ SysTick_Handler(); }
+		Host_Core_IPSR = 0;
+	}
+	/* Lowest priority, tail-chained after the others */
+	if(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSVSET_POS) && !Host_Core_Is_Masked(SCB->SHPR[HOST_PENDSV_SHPR_INDEX]))
+	{
+		CLEAR_BIT(SCB->ICSR, SCB_ICSR_PENDSVSET_POS);
+		Host_Core_Exclusive = 0;
+		Host_Core_IPSR = HOST_PENDSV_IRQ_NUMBER;
+		if(NULL != PendSV_Handler)
+			{ PendSV_Handler(); }
+		Host_Core_IPSR = 0;
+	}
+}
+
+void Host_Context_Switch(uint32_t * From_Stack, uint32_t * To_Stack)
+{
+	Host_Context_t * From = NULL;
+	Host_Context_t * To = NULL;
+	uint32_t Idx = 0;
+
+	for(Idx = 0; Idx < Host_Contexts_Count; Idx++)
+	{
+		if(From_Stack == Host_Contexts[Idx].Stack_Key)
+			{ From = &Host_Contexts[Idx]; }
+		if(To_Stack == Host_Contexts[Idx].Stack_Key)
+			{ To = &Host_Contexts[Idx]; }
+	}
+	if((NULL != From) && (From == To))
+		{ return; }
+	if(((NULL == From) || (NULL == To)) && (Host_Contexts_Count + 2UL > HOST_MAX_CONTEXTS))
+	{
+		fprintf(stderr, "host_port: more than %lu thread contexts\n", (unsigned long)HOST_MAX_CONTEXTS);
+		_exit(2);
+	}
+	/* The caller (main before Kernel_Start()) gets a context to be saved in */
+	if(NULL == From)
+	{
+		From = &Host_Contexts[Host_Contexts_Count++];
+		From->Stack_Key = From_Stack;
+	}
+	/* First run of a thread: start it from the frame built by the kernel */
+	if(NULL == To)
+	{
+		To = &Host_Contexts[Host_Contexts_Count];
+		To->Stack_Key = To_Stack;
+		getcontext(&To->Context);
+		To->Context.uc_stack.ss_sp = Host_Context_Stacks[Host_Contexts_Count];
+		To->Context.uc_stack.ss_size = HOST_CONTEXT_STACK_SIZE;
+		To->Context.uc_link = NULL;
+		makecontext(&To->Context, Host_Context_Start, 0);
+		Host_Contexts_Count++;
+		Host_Context_Starting = To;
+	}
+	/* The exception returns into the other thread */
+	Host_Core_IPSR = 0;
+	swapcontext(&From->Context, &To->Context);
+}
+
+void Host_SysTick_Run(uint64_t Cycles)
+{
+	uint64_t Step = 0;
+
+	while(Cycles > 0)
+	{
+		if(!READ_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS) || ((0UL == SysTick->RVR) && (0UL == SysTick->CVR)))
+		{
+			Host_Time += Cycles;
+			break;
+		}
+		if(0UL == SysTick->CVR)
+		{
+			/* The clock after 0 loads the reload value */
+			SysTick->CVR = SysTick->RVR & SYSTICK_MAX_RELOAD;
+			Host_Time++;
+			Cycles--;
+		}
+		else
+		{
+			Step = (Cycles < SysTick->CVR) ? Cycles : SysTick->CVR;
+			SysTick->CVR -= (uint32_t)Step;
+			Host_Time += Step;
+			Cycles -= Step;
+			if((0UL == SysTick->CVR) && READ_BIT(SysTick->CSR, SYSTICK_EXCEPTION_EN_POS))
+			{
+				SET_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS);
+				Host_Core_Take_Pending();
+			}
+		}
+	}
+}
+
+void Host_SysTick_Enable(void)
+{
+	SET_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS);
+	/* The clock after the enable loads a cleared counter, before the
+	 * driver's next store: the reload value is the one set before */
+	if((0UL == SysTick->CVR) && (0UL != (SysTick->RVR & SYSTICK_MAX_RELOAD)))
+	{
+		SysTick->CVR = SysTick->RVR & SYSTICK_MAX_RELOAD;
+		Host_Time++;
+	}
+}
+
+uint32_t Host_SysTick_Cycles_To_Wrap(void)
+{
+	uint32_t Cycles = 0;
+
+	if(READ_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS))
+		{ Cycles = (0UL != SysTick->CVR) ? SysTick->CVR : ((SysTick->RVR & SYSTICK_MAX_RELOAD) + 1UL); }
+	return Cycles;
+}
+
+void Host_Wfi_Until_SysTick(void)
+{
+	Host_SysTick_Run(Host_SysTick_Cycles_To_Wrap());
+}
+
+void Host_Pend_Irq(Interrupt_Handler_t Handler, uint32_t Priority)
+{
+	Host_Irq_Handler = Handler;
+	Host_Irq_Priority = Priority & 0xFFUL;
+	SET_BIT(SCB->ICSR, SCB_ICSR_ISRPENDING_POS);
+	Host_Core_Take_Pending();
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Host_Port_Map(void)
+{
+	uint32_t Idx = 0;
+	void * Window = NULL;
+
+	for(Idx = 0; Idx < HOST_WINDOWS_NUMBER; Idx++)
+	{
+		Window = mmap((void *)Host_Windows[Idx].Base, Host_Windows[Idx].Size, PROT_READ | PROT_WRITE,
+					  MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+		if(Window != (void *)Host_Windows[Idx].Base)
+		{
+			fprintf(stderr, "host_port: cannot map the registers at 0x%08lx\n", (unsigned long)Host_Windows[Idx].Base);
+			_exit(2);
+		}
+	}
+}
+
+/* BASEPRI masks the exceptions of the same or a lower group priority,
+ * the subpriority bits under PRIGROUP are not compared */
+static uint32_t Host_Core_Is_Masked(uint32_t Priority)
+{
+	uint32_t Group_Mask = (0xFFUL << (((SCB->AIRCR >> HOST_AIRCR_PRIGROUP_POS) & 0x7UL) + 1UL)) & 0xFFUL;
+
+	return (0UL != Host_Core_BASEPRI) && ((Priority & Group_Mask) >= (Host_Core_BASEPRI & Group_Mask));
+}
+
+/* The kernel stores the entry and its argument 32-bit wide: the host
+ * tests link without PIE so the code and the data sit below 4 GB */
+static void Host_Context_Start(void)
+{
+	uint32_t * Frame = Host_Context_Starting->Stack_Key;
+	void (*Entry)(void *) = (void (*)(void *))(uintptr_t)Frame[HOST_FRAME_PC];
+	void (*Exit)(void) = (void (*)(void))(uintptr_t)Frame[HOST_FRAME_LR];
+
+	Entry((void *)(uintptr_t)Frame[HOST_FRAME_R0]);
+	Exit();
+}
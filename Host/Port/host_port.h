@@ -0,0 +1,76 @@
+/**
+ ******************************************************************************
+ * @file           : host_port.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Host emulation of the STM32F401 for the host tests.
+ *					 The peripheral and core register windows are mapped as
+ *					 plain memory at their real addresses, so the drivers
+ *					 build unchanged. The core registers, the SysTick counter
+ *					 and the exception entry are modelled here, the other
+ *					 peripherals are register models driven by the tests.
+ ******************************************************************************
+ */
+
+#ifndef HOST_PORT_HOST_PORT_H_
+#define HOST_PORT_HOST_PORT_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "CortexM4/Core/Core.h"
+/*---------------  Section: Global Variables --------------- */
+
+/* !< Core cycles elapsed, moved by Host_SysTick_Run() only */
+extern volatile uint64_t Host_Time;
+/* !< Called by CORE_WFI(), NULL returns at once like an already pending event */
+extern void (*Host_Wfi_Hook)(void);
+/*---------------  Section: Function Declarations --------------- */
+
+/*
+ * @brief Clears the register windows, the core registers, the time and the hooks.
+ */
+void Host_Port_Reset(void);
+/*
+ * @brief Runs the SysTick counter for a number of core cycles. Each wrap
+ * pends the exception, taken at once if it is enabled and unmasked.
+ * COUNTFLAG is not modelled: the driver read-modify-writes CSR, and every
+ * read of CSR clears the flag on the real core.
+ * @param Cycles: Core cycles to run, the time moves even when the timer is off.
+ */
+void Host_SysTick_Run(uint64_t Cycles);
+/*
+ * @brief SYSTICK_TIMER_ENABLE() of the host build, a cleared counter is
+ * loaded at once with the reload value, taking one cycle.
+ */
+void Host_SysTick_Enable(void);
+/*
+ * @brief Returns the cycles left until the SysTick counter reaches 0.
+ * @return The distance to the next wrap, 0 if the timer is stopped.
+ */
+uint32_t Host_SysTick_Cycles_To_Wrap(void);
+/*
+ * @brief WFI hook sleeping until the next SysTick wrap.
+ */
+void Host_Wfi_Until_SysTick(void);
+/*
+ * @brief Pends an interrupt other than SysTick (ICSR ISRPENDING), its
+ * handler runs as soon as PRIMASK and BASEPRI let it through.
+ * @param Handler: The emulated handler.
+ * @param Priority: Its priority byte, as written by NVIC_SetPriority().
+ */
+void Host_Pend_Irq(Interrupt_Handler_t Handler, uint32_t Priority);
+/*
+ * @brief Takes the pending exceptions if the interrupts are unmasked:
+ * another interrupt, SysTick then PendSV, each one unless BASEPRI masks
+ * its priority.
+ */
+void Host_Core_Take_Pending(void);
+/*
+ * @brief Context switch of the kernel's host build (PendSV_Handler).
+ * Each thread runs on a host context found by its saved stack pointer, a
+ * thread never seen before starts from the entry in its initial frame.
+ * @param From_Stack: Saved stack pointer of the running thread, NULL for main.
+ * @param To_Stack: Saved stack pointer of the next thread.
+ */
+void Host_Context_Switch(uint32_t * From_Stack, uint32_t * To_Stack);
+
+#endif /* HOST_PORT_HOST_PORT_H_ */
@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * @file           : test_core_critical.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the BASEPRI critical sections against the core
+ *					 model of Host/Port: ceiling encoding, nesting, and the
+ *					 masked window seen by an interrupt above and at the
+ *					 ceiling, with the PRIMASK sections as the baseline.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/SCB/SCB.h"
+#include "host_port.h"
+#include "test_common.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_WINDOWS_NUMBER			10000UL
+#define TEST_MAX_WINDOW_CYCLES		5000UL
+/* Preemption priority 0 (above the ceiling) and 1 (the ceiling), 4 group bits */
+#define TEST_HIGH_PRIORITY			0x00UL
+#define TEST_CEILING_PRIORITY		0x10UL
+#define TEST_PENDSV_SHPR_INDEX		10UL
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uint64_t Worst;
+	uint64_t Total;
+} Test_Latency_t;
+/*---------------  Section: Static Global Variables --------------- */
+static uint64_t Test_Handled_Time = 0;
+static uint32_t Test_Handled = 0;
+static uint32_t Test_PendSV_Runs = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Test_Irq(void)
+{
+	Test_Handled_Time = Host_Time;
+	Test_Handled++;
+}
+
+void PendSV_Handler(void)
+{
+	Test_PendSV_Runs++;
+}
+
+/* One masked window of Window cycles, the interrupt arriving after Arrival
+ * of them. Returns the cycles it waited to be taken. */
+static uint64_t Test_Window(uint32_t Use_Ceiling, uint32_t Priority, uint32_t Window, uint32_t Arrival)
+{
+	uint32_t State = 0;
+	uint64_t Arrival_Time = 0;
+
+	Test_Handled = 0;
+	State = (0UL != Use_Ceiling) ? Core_Enter_Critical_Ceiling() : Core_Enter_Critical();
+	Host_SysTick_Run(Arrival);
+	Arrival_Time = Host_Time;
+	Host_Pend_Irq(Test_Irq, Priority);
+	Host_SysTick_Run(Window - Arrival);
+	if(0UL != Use_Ceiling)
+		{ Core_Exit_Critical_Ceiling(State); }
+	else
+		{ Core_Exit_Critical(State); }
+	TEST_ASSERT_EQ(Test_Handled, 1);
+	return Test_Handled_Time - Arrival_Time;
+}
+
+static void Test_Record(Test_Latency_t * Latency, uint64_t Cycles)
+{
+	if(Cycles > Latency->Worst)
+		{ Latency->Worst = Cycles; }
+	Latency->Total += Cycles;
+}
+/*---------------  Section: Tests --------------- */
+static void Test_Ceiling_Encoding(void)
+{
+	Host_Port_Reset();
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_4_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(0), E_NOT_OK);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(16), E_NOT_OK);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(5), E_OK);
+	TEST_ASSERT_EQ(Core_Critical_Ceiling_Value, 0x50UL);
+
+	/* 2 group bits: the preemption field is the top 2 bits */
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_2_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(4), E_NOT_OK);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(3), E_OK);
+	TEST_ASSERT_EQ(Core_Critical_Ceiling_Value, 0xC0UL);
+	/* Fewer bits clamp the ceiling, more keep its preemption priority */
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_1_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Ceiling_Value, 0x80UL);
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_4_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Ceiling_Value, 0x30UL);
+	/* No group bits: any BASEPRI masks everything */
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_0_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Ceiling_Value, 0x10UL);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(1), E_NOT_OK);
+
+	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_4_BITS);
+	TEST_ASSERT_EQ(Core_Critical_Set_Ceiling(1), E_OK);
+}
+
+static void Test_Nesting(void)
+{
+	uint32_t Outer = 0;
+	uint32_t Inner = 0;
+
+	Host_Port_Reset();
+	Outer = Core_Enter_Critical_Ceiling();
+	TEST_ASSERT_EQ(Outer, 0);
+	TEST_ASSERT_EQ(Core_Get_BASEPRI(), TEST_CEILING_PRIORITY);
+	Inner = Core_Enter_Critical_Ceiling();
+	TEST_ASSERT_EQ(Inner, TEST_CEILING_PRIORITY);
+	Core_Exit_Critical_Ceiling(Inner);
+	TEST_ASSERT_EQ(Core_Get_BASEPRI(), TEST_CEILING_PRIORITY);
+	Core_Exit_Critical_Ceiling(Outer);
+	TEST_ASSERT_EQ(Core_Get_BASEPRI(), 0);
+
+	/* Inside a stricter mask the section keeps it */
+	Core_Set_BASEPRI(0x08UL);
+	Outer = Core_Enter_Critical_Ceiling();
+	TEST_ASSERT_EQ(Core_Get_BASEPRI(), 0x08UL);
+	Core_Exit_Critical_Ceiling(Outer);
+	TEST_ASSERT_EQ(Core_Get_BASEPRI(), 0x08UL);
+	Core_Set_BASEPRI(0);
+
+	/* PendSV at the lowest priority waits for the end of the section */
+	SCB->SHPR[TEST_PENDSV_SHPR_INDEX] = 0xF0U;
+	Test_PendSV_Runs = 0;
+	Outer = Core_Enter_Critical_Ceiling();
+	SET_BIT(SCB->ICSR, SCB_ICSR_PENDSVSET_POS);
+	Host_Core_Take_Pending();
+	TEST_ASSERT_EQ(Test_PendSV_Runs, 0);
+	Core_Exit_Critical_Ceiling(Outer);
+	TEST_ASSERT_EQ(Test_PendSV_Runs, 1);
+}
+
+/* The same random masked windows with PRIMASK and with the ceiling: the
+ * wait of an interrupt above the ceiling, and of one at the ceiling */
+static void Test_Masked_Window(void)
+{
+	Test_Latency_t Primask_High = { 0, 0 };
+	Test_Latency_t Ceiling_High = { 0, 0 };
+	Test_Latency_t Ceiling_Low = { 0, 0 };
+	uint32_t Iteration = 0;
+	uint32_t Window = 0;
+	uint32_t Arrival = 0;
+	uint64_t Cycles = 0;
+
+	Host_Port_Reset();
+	for(Iteration = 0; Iteration < TEST_WINDOWS_NUMBER; Iteration++)
+	{
+		Window = 1UL + (Test_Random() % TEST_MAX_WINDOW_CYCLES);
+		Arrival = Test_Random() % Window;
+
+		Cycles = Test_Window(0, TEST_HIGH_PRIORITY, Window, Arrival);
+		TEST_ASSERT_EQ(Cycles, Window - Arrival);
+		Test_Record(&Primask_High, Cycles);
+
+		Cycles = Test_Window(1, TEST_HIGH_PRIORITY, Window, Arrival);
+		TEST_ASSERT_EQ(Cycles, 0);
+		Test_Record(&Ceiling_High, Cycles);
+
+		Cycles = Test_Window(1, TEST_CEILING_PRIORITY, Window, Arrival);
+		TEST_ASSERT_EQ(Cycles, Window - Arrival);
+		Test_Record(&Ceiling_Low, Cycles);
+	}
+	printf("masked wait over %lu windows of 1..%lu cycles (host model):\n", (unsigned long)TEST_WINDOWS_NUMBER,
+		   (unsigned long)TEST_MAX_WINDOW_CYCLES);
+	printf("  PRIMASK,   priority 0: worst %5llu avg %7.1f\n", (unsigned long long)Primask_High.Worst,
+		   (double)Primask_High.Total / TEST_WINDOWS_NUMBER);
+	printf("  ceiling 1, priority 0: worst %5llu avg %7.1f\n", (unsigned long long)Ceiling_High.Worst,
+		   (double)Ceiling_High.Total / TEST_WINDOWS_NUMBER);
+	printf("  ceiling 1, priority 1: worst %5llu avg %7.1f\n", (unsigned long long)Ceiling_Low.Worst,
+		   (double)Ceiling_Low.Total / TEST_WINDOWS_NUMBER);
+}
+
+int main(void)
+{
+	Test_Ceiling_Encoding();
+	Test_Nesting();
+	Test_Masked_Window();
+	return TEST_REPORT();
+}
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file           : test_fpu.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the FPU access and context stacking control
+ *					 against the register model of Host/Port. The entry
+ *					 timing itself needs the core: FPU_Measure_Entry_Cycles()
+ *					 refuses to run on a build without hardware FP.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/FPU/FPU.h"
+#include "CortexM4/SCB/SCB.h"
+#include "host_port.h"
+#include "test_common.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_FPCCR_MODE_MASK		((1UL << FPU_FPCCR_ASPEN_POS) | (1UL << FPU_FPCCR_LSPEN_POS))
+/*---------------  Section: Tests --------------- */
+static void Test_Enable(void)
+{
+	Host_Port_Reset();
+	/* Unrelated bits of both registers are kept */
+	SCB->CPACR = 0x3UL;
+	FPU->FPCCR = 1UL << FPU_FPCCR_LSPACT_POS;
+
+	TEST_ASSERT_EQ(FPU_Enable(FPU_STACKING_LAZY), E_OK);
+	TEST_ASSERT_EQ(SCB->CPACR, SCB_CPACR_FPU_FULL_ACCESS | 0x3UL);
+	TEST_ASSERT_EQ(FPU->FPCCR, TEST_FPCCR_MODE_MASK | (1UL << FPU_FPCCR_LSPACT_POS));
+	TEST_ASSERT_EQ(FPU_Get_Stacking(), FPU_STACKING_LAZY);
+
+	/* An invalid mode grants nothing */
+	Host_Port_Reset();
+	TEST_ASSERT_EQ(FPU_Enable((FPU_Stacking_t)3), E_NOT_OK);
+	TEST_ASSERT_EQ(SCB->CPACR, 0);
+}
+
+static void Test_Stacking(void)
+{
+	Host_Port_Reset();
+	TEST_ASSERT_EQ(FPU_Set_Stacking(FPU_STACKING_FULL), E_OK);
+	TEST_ASSERT_EQ(FPU->FPCCR & TEST_FPCCR_MODE_MASK, 1UL << FPU_FPCCR_ASPEN_POS);
+	TEST_ASSERT_EQ(FPU_Get_Stacking(), FPU_STACKING_FULL);
+
+	TEST_ASSERT_EQ(FPU_Set_Stacking(FPU_STACKING_NONE), E_OK);
+	TEST_ASSERT_EQ(FPU->FPCCR & TEST_FPCCR_MODE_MASK, 0);
+	TEST_ASSERT_EQ(FPU_Get_Stacking(), FPU_STACKING_NONE);
+
+	TEST_ASSERT_EQ(FPU_Set_Stacking(FPU_STACKING_LAZY), E_OK);
+	TEST_ASSERT_EQ(FPU_Set_Stacking((FPU_Stacking_t)7), E_NOT_OK);
+	TEST_ASSERT_EQ(FPU_Get_Stacking(), FPU_STACKING_LAZY);
+
+	/* LSPEN alone is not a mode, ASPEN off means no preservation */
+	FPU->FPCCR = 1UL << FPU_FPCCR_LSPEN_POS;
+	TEST_ASSERT_EQ(FPU_Get_Stacking(), FPU_STACKING_NONE);
+}
+
+static void Test_Measure_Refused(void)
+{
+	uint32_t Cycles = 0;
+
+	Host_Port_Reset();
+	TEST_ASSERT_EQ(FPU_Measure_Entry_Cycles(FPU_STACKING_LAZY, &Cycles), E_NOT_OK);
+	TEST_ASSERT_EQ(FPU_Measure_Entry_Cycles(FPU_STACKING_FULL, NULL), E_NOT_OK);
+}
+
+static void Test_ISR_Used_FP(void)
+{
+	Host_Port_Reset();
+	TEST_ASSERT_EQ(FPU_ISR_USED_FP(), 0);
+	Host_Core_CONTROL = 1UL << CORE_CONTROL_FPCA_POS;
+	TEST_ASSERT(0 != FPU_ISR_USED_FP());
+}
+
+int main(void)
+{
+	Test_Enable();
+	Test_Stacking();
+	Test_Measure_Refused();
+	Test_ISR_Used_FP();
+	return TEST_REPORT();
+}
@@ -0,0 +1,187 @@
+/**
+ ******************************************************************************
+ * @file           : test_flash_log_codec.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Round-trip tests of the flash data logger block codec,
+ *					 with the compression ratio of typical signals.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/FlashLog/flash_log_codec.h"
+#include "test_common.h"
+#include <string.h>
+#include <time.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_BLOCK_SIZE			256UL
+#define TEST_MAX_SAMPLES		4096UL
+/*---------------  Section: Static Global Variables --------------- */
+static uint32_t Test_Block[TEST_BLOCK_SIZE / 4UL];
+static int32_t Test_Input[TEST_MAX_SAMPLES];
+static int32_t Test_Output[TEST_MAX_SAMPLES];
+/*---------------  Section: Helper Function Definitions --------------- */
+
+/* Encodes Count samples block after block, decodes every block back and
+ * compares. Returns the flash bytes used. */
+static uint32_t Test_Round_Trip(const int32_t * Samples, uint32_t Count)
+{
+	FlashLog_Encoder_t Encoder;
+	uint32_t Encoded = 0;
+	uint32_t Decoded = 0;
+	uint32_t Flash_Bytes = 0;
+	uint32_t Block_Size = 0;
+	uint32_t Decoded_Size = 0;
+	uint32_t Sample_Count = 0;
+	uint32_t Sequence = 0;
+	uint32_t Block_Sequence = 0;
+
+	TEST_ASSERT_EQ(FlashLog_Codec_Begin(&Encoder, (uint8_t *)Test_Block, TEST_BLOCK_SIZE), E_OK);
+	while(Decoded < Count)
+	{
+		/* 1. Fill one block */
+		while((Encoded < Count) && (E_OK == FlashLog_Codec_Append(&Encoder, Samples[Encoded])))
+			{ Encoded++; }
+		Block_Size = FlashLog_Codec_Seal(&Encoder, Sequence);
+		TEST_ASSERT(0 != Block_Size);
+		TEST_ASSERT(Block_Size <= TEST_BLOCK_SIZE);
+		TEST_ASSERT_EQ(Block_Size % 4UL, 0);
+		if(0 == Block_Size)
+			{ break; }
+
+		/* 2. Decode it */
+		TEST_ASSERT_EQ(FlashLog_Codec_Decode((const uint8_t *)Test_Block, TEST_BLOCK_SIZE, &Test_Output[Decoded],
+											 TEST_MAX_SAMPLES - Decoded, &Sample_Count, &Block_Sequence, &Decoded_Size), E_OK);
+		TEST_ASSERT_EQ(Block_Sequence, Sequence);
+		TEST_ASSERT_EQ(Decoded_Size, Block_Size);
+		TEST_ASSERT_EQ(Decoded + Sample_Count, Encoded);
+		Decoded += Sample_Count;
+		Flash_Bytes += Block_Size;
+		Sequence++;
+		(void)FlashLog_Codec_Begin(&Encoder, (uint8_t *)Test_Block, TEST_BLOCK_SIZE);
+	}
+	TEST_ASSERT_EQ(Decoded, Count);
+	TEST_ASSERT(0 == memcmp(Samples, Test_Output, Count * sizeof(int32_t)));
+	return Flash_Bytes;
+}
+
+static void Test_Report_Ratio(const char * Name, uint32_t Count)
+{
+	uint32_t Flash_Bytes = Test_Round_Trip(Test_Input, Count);
+	printf("%-24s %5lu samples -> %6lu bytes, ratio %.2f\n", Name, (unsigned long)Count, (unsigned long)Flash_Bytes,
+		   (double)(Count * 4UL) / (double)Flash_Bytes);
+}
+/*---------------  Section: Tests --------------- */
+static void Test_CRC32(void)
+{
+	/* The IEEE 802.3 check value */
+	TEST_ASSERT_EQ(FlashLog_Codec_CRC32((const uint8_t *)"123456789", 9), 0xCBF43926UL);
+	TEST_ASSERT_EQ(FlashLog_Codec_CRC32((const uint8_t *)"", 0), 0UL);
+}
+
+static void Test_ZigZag(void)
+{
+	TEST_ASSERT_EQ(FLASH_LOG_ZIGZAG_ENCODE(0), 0UL);
+	TEST_ASSERT_EQ(FLASH_LOG_ZIGZAG_ENCODE((uint32_t)-1L), 1UL);
+	TEST_ASSERT_EQ(FLASH_LOG_ZIGZAG_ENCODE(1), 2UL);
+	TEST_ASSERT_EQ(FLASH_LOG_ZIGZAG_ENCODE(0x7FFFFFFFUL), 0xFFFFFFFEUL);
+	TEST_ASSERT_EQ(FLASH_LOG_ZIGZAG_ENCODE(0x80000000UL), 0xFFFFFFFFUL);
+	TEST_ASSERT(FLASH_LOG_ZIGZAG_DECODE(1UL) == -1L);
+	TEST_ASSERT(FLASH_LOG_ZIGZAG_DECODE(0xFFFFFFFEUL) == 0x7FFFFFFFL);
+	TEST_ASSERT(FLASH_LOG_ZIGZAG_DECODE(0xFFFFFFFFUL) == (-0x7FFFFFFFL - 1L));
+}
+
+static void Test_Extremes(void)
+{
+	static const int32_t Extremes[] = { 0, -1, 1, 0x7FFFFFFFL, (-0x7FFFFFFFL - 1L), 0x7FFFFFFFL, 0,
+										(-0x7FFFFFFFL - 1L), -2, 12345, -12345, 0x40000000L, -0x40000000L };
+	(void)Test_Round_Trip(Extremes, sizeof(Extremes) / sizeof(Extremes[0]));
+}
+
+static void Test_Corruption(void)
+{
+	FlashLog_Encoder_t Encoder;
+	uint32_t Block_Size = 0;
+	uint32_t Sample_Count = 0;
+	uint32_t Idx = 0;
+	uint8_t * Bytes = (uint8_t *)Test_Block;
+
+	(void)FlashLog_Codec_Begin(&Encoder, Bytes, TEST_BLOCK_SIZE);
+	for(Idx = 0; Idx < 20; Idx++)
+		{ (void)FlashLog_Codec_Append(&Encoder, (int32_t)(Idx * 3UL)); }
+	Block_Size = FlashLog_Codec_Seal(&Encoder, 7);
+
+	/* Every single bit flip of header, payload or CRC is caught */
+	for(Idx = 0; Idx < (Encoder.Length + FLASH_LOG_CRC_SIZE) * 8UL; Idx++)
+	{
+		Bytes[Idx / 8UL] ^= (uint8_t)(1U << (Idx % 8UL));
+		TEST_ASSERT_EQ(FlashLog_Codec_Decode(Bytes, Block_Size, Test_Output, TEST_MAX_SAMPLES, &Sample_Count, NULL, NULL), E_NOT_OK);
+		Bytes[Idx / 8UL] ^= (uint8_t)(1U << (Idx % 8UL));
+	}
+	TEST_ASSERT_EQ(FlashLog_Codec_Decode(Bytes, Block_Size, Test_Output, TEST_MAX_SAMPLES, &Sample_Count, NULL, NULL), E_OK);
+	TEST_ASSERT_EQ(Sample_Count, 20);
+
+	/* Truncated dump, and a too small output array */
+	TEST_ASSERT_EQ(FlashLog_Codec_Decode(Bytes, Block_Size - 4UL, Test_Output, TEST_MAX_SAMPLES, &Sample_Count, NULL, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(FlashLog_Codec_Decode(Bytes, Block_Size, Test_Output, 19, &Sample_Count, NULL, NULL), E_NOT_OK);
+	/* Validation only */
+	TEST_ASSERT_EQ(FlashLog_Codec_Decode(Bytes, Block_Size, NULL, 0, &Sample_Count, NULL, NULL), E_OK);
+}
+
+static void Test_Signals(void)
+{
+	uint32_t Idx = 0;
+	uint32_t Raw = 0;
+	int32_t Value = 0;
+	clock_t Start = 0;
+	double Seconds = 0;
+	FlashLog_Encoder_t Encoder;
+
+	/* Slow sensor: small random walk around an offset */
+	Value = 2048;
+	for(Idx = 0; Idx < TEST_MAX_SAMPLES; Idx++)
+	{
+		Value += (int32_t)(Test_Random() % 7UL) - 3;
+		Test_Input[Idx] = Value;
+	}
+	Test_Report_Ratio("random walk +-3", TEST_MAX_SAMPLES);
+
+	/* 12-bit ADC noise */
+	for(Idx = 0; Idx < TEST_MAX_SAMPLES; Idx++)
+		{ Test_Input[Idx] = (int32_t)(Test_Random() & 0xFFFUL); }
+	Test_Report_Ratio("12-bit white noise", TEST_MAX_SAMPLES);
+
+	/* Worst case: full range random, the varints expand it */
+	for(Idx = 0; Idx < TEST_MAX_SAMPLES; Idx++)
+	{
+		Raw = (Test_Random() << 8) ^ Test_Random();
+		Test_Input[Idx] = FLASH_LOG_S32(Raw);
+	}
+	Test_Report_Ratio("32-bit random", TEST_MAX_SAMPLES);
+
+	/* Host encode speed, the flash write throughput is reported on target by FlashLog_GetStats() */
+	Start = clock();
+	for(Value = 0; Value < 200; Value++)
+	{
+		(void)FlashLog_Codec_Begin(&Encoder, (uint8_t *)Test_Block, TEST_BLOCK_SIZE);
+		for(Idx = 0; Idx < TEST_MAX_SAMPLES; Idx++)
+		{
+			if(E_OK != FlashLog_Codec_Append(&Encoder, Test_Input[Idx]))
+			{
+				(void)FlashLog_Codec_Seal(&Encoder, 0);
+				(void)FlashLog_Codec_Begin(&Encoder, (uint8_t *)Test_Block, TEST_BLOCK_SIZE);
+			}
+		}
+	}
+	Seconds = (double)(clock() - Start) / CLOCKS_PER_SEC;
+	if(Seconds > 0)
+		{ printf("host encode: %.1f Msamples/s\n", (200.0 * TEST_MAX_SAMPLES) / Seconds / 1e6); }
+}
+
+int main(void)
+{
+	Test_CRC32();
+	Test_ZigZag();
+	Test_Extremes();
+	Test_Corruption();
+	Test_Signals();
+	return TEST_REPORT();
+}
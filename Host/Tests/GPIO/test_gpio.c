@@ -0,0 +1,366 @@
+/**
+ ******************************************************************************
+ * @file           : test_gpio.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the GPIO driver against a register model: pin
+ *					 tables merged into the port registers, the BSRR data path
+ *					 applied to a model output register, the port clocks, and
+ *					 the EXTI routing and shared vector dispatch.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "MCAL/GPIO/gpio.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "host_port.h"
+#include "test_common.h"
+#include <string.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_TABLES_NUMBER			2000UL
+#define TEST_MAX_TABLE_SIZE			24UL
+#define TEST_DATA_OPS_NUMBER		20000UL
+#define TEST_SYSCFG_CLOCK_POS		14UL
+#define TEST_GPIOH_CLOCK_POS		7UL
+/* --------------- Section: Data Type Declarations --------------- */
+/* The registers Init_Table may write, per port */
+typedef struct
+{
+	uint32_t MODER;
+	uint32_t OTYPER;
+	uint32_t OSPEEDR;
+	uint32_t PUPDR;
+	uint32_t AFR[2];
+} Test_Port_Cfg_t;
+/*---------------  Section: Static Global Variables --------------- */
+static const GPIO_Port_t Test_Ports[] = { GPIO_PORTA, GPIO_PORTB, GPIO_PORTC, GPIO_PORTD, GPIO_PORTE, GPIO_PORTH };
+static GPIO_Pin_Config_t Test_Table[TEST_MAX_TABLE_SIZE];
+static uint32_t Test_Calls[GPIO_PINS_PER_PORT];
+static uint32_t Test_Call_Order[GPIO_PINS_PER_PORT];
+static uint32_t Test_Call_Count = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+#define TEST_PORTS_COUNT			(sizeof(Test_Ports) / sizeof(Test_Ports[0]))
+
+static uint32_t Test_Clock_Pos(GPIO_Port_t Port)
+{
+	return (GPIO_PORTH == Port) ? TEST_GPIOH_CLOCK_POS : (uint32_t)Port;
+}
+
+static Test_Port_Cfg_t Test_Read_Port(GPIO_Port_t Port)
+{
+	Test_Port_Cfg_t Cfg;
+	GPIO_Registers_t * Regs = GPIO_PORT_REGS(Port);
+
+	Cfg.MODER = Regs->MODER;
+	Cfg.OTYPER = Regs->OTYPER;
+	Cfg.OSPEEDR = Regs->OSPEEDR;
+	Cfg.PUPDR = Regs->PUPDR;
+	Cfg.AFR[0] = Regs->AFR[0];
+	Cfg.AFR[1] = Regs->AFR[1];
+	return Cfg;
+}
+
+/* The reference: one pin at a time, the later entries of a pin win */
+static void Test_Model_Pin(Test_Port_Cfg_t * Cfg, const GPIO_Pin_Config_t * Pin_Cfg)
+{
+	uint32_t Shift = 2UL * Pin_Cfg->Pin;
+	uint32_t Af_Shift = 4UL * (Pin_Cfg->Pin & 7UL);
+
+	Cfg->MODER = (Cfg->MODER & ~(3UL << Shift)) | ((uint32_t)Pin_Cfg->Mode << Shift);
+	Cfg->OSPEEDR = (Cfg->OSPEEDR & ~(3UL << Shift)) | ((uint32_t)Pin_Cfg->Speed << Shift);
+	Cfg->PUPDR = (Cfg->PUPDR & ~(3UL << Shift)) | ((uint32_t)Pin_Cfg->Pull << Shift);
+	Cfg->OTYPER = (Cfg->OTYPER & ~GPIO_PIN_MASK(Pin_Cfg->Pin)) | ((uint32_t)Pin_Cfg->Output_Type << Pin_Cfg->Pin);
+	if(GPIO_MODE_ALTERNATE == Pin_Cfg->Mode)
+	{
+		Cfg->AFR[Pin_Cfg->Pin >> 3] = (Cfg->AFR[Pin_Cfg->Pin >> 3] & ~(0xFUL << Af_Shift)) |
+									  ((uint32_t)Pin_Cfg->Alternate << Af_Shift);
+	}
+}
+
+static GPIO_Pin_Config_t Test_Random_Pin(void)
+{
+	GPIO_Pin_Config_t Pin_Cfg;
+
+	Pin_Cfg.Port = Test_Ports[Test_Random() % TEST_PORTS_COUNT];
+	Pin_Cfg.Pin = (uint8_t)(Test_Random() % GPIO_PINS_PER_PORT);
+	Pin_Cfg.Mode = (GPIO_Mode_t)(Test_Random() % 4UL);
+	Pin_Cfg.Output_Type = (GPIO_Output_Type_t)(Test_Random() % 2UL);
+	Pin_Cfg.Speed = (GPIO_Speed_t)(Test_Random() % 4UL);
+	Pin_Cfg.Pull = (GPIO_Pull_t)(Test_Random() % 3UL);
+	Pin_Cfg.Alternate = (uint8_t)(Test_Random() % 16UL);
+	return Pin_Cfg;
+}
+
+/* The output register as the hardware updates it from a BSRR store, set wins */
+static void Test_Apply_BSRR(GPIO_Port_t Port)
+{
+	GPIO_Registers_t * Regs = GPIO_PORT_REGS(Port);
+	uint32_t Bsrr = Regs->BSRR;
+
+	Regs->ODR = (Regs->ODR & ~(Bsrr >> GPIO_BSRR_RESET_POS)) | (Bsrr & GPIO_PORT_PINS_MASK);
+	Regs->BSRR = 0;
+}
+
+static void Test_Line_Handler(uint32_t Line)
+{
+	Test_Calls[Line]++;
+	Test_Call_Order[Test_Call_Count++] = Line;
+}
+
+#define TEST_LINE_HANDLER(LINE)		static void Test_Line_##LINE(void) { Test_Line_Handler(LINE); }
+TEST_LINE_HANDLER(0)  TEST_LINE_HANDLER(1)  TEST_LINE_HANDLER(2)  TEST_LINE_HANDLER(3)
+TEST_LINE_HANDLER(4)  TEST_LINE_HANDLER(5)  TEST_LINE_HANDLER(6)  TEST_LINE_HANDLER(7)
+TEST_LINE_HANDLER(8)  TEST_LINE_HANDLER(9)  TEST_LINE_HANDLER(10) TEST_LINE_HANDLER(11)
+TEST_LINE_HANDLER(12) TEST_LINE_HANDLER(13) TEST_LINE_HANDLER(14) TEST_LINE_HANDLER(15)
+static const Interrupt_Handler_t Test_Line_Handlers[GPIO_PINS_PER_PORT] =
+{
+	Test_Line_0, Test_Line_1, Test_Line_2, Test_Line_3, Test_Line_4, Test_Line_5, Test_Line_6, Test_Line_7,
+	Test_Line_8, Test_Line_9, Test_Line_10, Test_Line_11, Test_Line_12, Test_Line_13, Test_Line_14, Test_Line_15
+};
+
+extern void EXTI0_IRQHandler(void);
+extern void EXTI1_IRQHandler(void);
+extern void EXTI2_IRQHandler(void);
+extern void EXTI3_IRQHandler(void);
+extern void EXTI4_IRQHandler(void);
+extern void EXTI9_5_IRQHandler(void);
+extern void EXTI15_10_IRQHandler(void);
+static const Interrupt_Handler_t Test_EXTI_Vectors[] =
+{
+	EXTI0_IRQHandler, EXTI1_IRQHandler, EXTI2_IRQHandler, EXTI3_IRQHandler, EXTI4_IRQHandler,
+	EXTI9_5_IRQHandler, EXTI15_10_IRQHandler
+};
+/*---------------  Section: Tests --------------- */
+
+/* Random tables over random register contents: every written field matches
+ * the one pin at a time reference, the other fields are untouched */
+static void Test_Init_Table(void)
+{
+	Test_Port_Cfg_t Initial[GPIO_PORTS_NUMBER];
+	Test_Port_Cfg_t Expected[GPIO_PORTS_NUMBER];
+	Test_Port_Cfg_t After;
+	uint32_t Table_Idx = 0;
+	uint32_t Count = 0;
+	uint32_t Entry_Idx = 0;
+	uint32_t Port_Idx = 0;
+	uint32_t Pin = 0;
+	GPIO_Port_t Port = GPIO_PORTA;
+	GPIO_Registers_t * Regs = NULL;
+
+	for(Table_Idx = 0; Table_Idx < TEST_TABLES_NUMBER; Table_Idx++)
+	{
+		for(Port_Idx = 0; Port_Idx < TEST_PORTS_COUNT; Port_Idx++)
+		{
+			Regs = GPIO_PORT_REGS(Test_Ports[Port_Idx]);
+			Regs->MODER = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+			Regs->OTYPER = (uint32_t)(Test_Random() & GPIO_PORT_PINS_MASK);
+			Regs->OSPEEDR = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+			/* 11 is reserved in PUPDR, a register holding it is not modelled */
+			Regs->PUPDR = (uint32_t)((Test_Random() << 8) ^ Test_Random()) & 0x55555555UL;
+			Regs->AFR[0] = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+			Regs->AFR[1] = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+			Initial[Test_Ports[Port_Idx]] = Test_Read_Port(Test_Ports[Port_Idx]);
+			Expected[Test_Ports[Port_Idx]] = Initial[Test_Ports[Port_Idx]];
+		}
+		Count = 1UL + (Test_Random() % TEST_MAX_TABLE_SIZE);
+		for(Entry_Idx = 0; Entry_Idx < Count; Entry_Idx++)
+		{
+			Test_Table[Entry_Idx] = Test_Random_Pin();
+			Test_Model_Pin(&Expected[Test_Table[Entry_Idx].Port], &Test_Table[Entry_Idx]);
+		}
+
+		/* One bad entry anywhere: nothing is written */
+		if(0 == (Table_Idx % 8UL))
+		{
+			Test_Table[Test_Random() % Count].Pin = (uint8_t)(GPIO_PINS_PER_PORT + (Test_Random() % 4UL));
+			TEST_ASSERT_EQ(GPIO_Init_Table(Test_Table, Count), E_NOT_OK);
+			for(Port_Idx = 0; Port_Idx < TEST_PORTS_COUNT; Port_Idx++)
+			{
+				After = Test_Read_Port(Test_Ports[Port_Idx]);
+				TEST_ASSERT(0 == memcmp(&After, &Initial[Test_Ports[Port_Idx]], sizeof(After)));
+			}
+			TEST_ASSERT_EQ(RCC->AHB1ENR, 0);
+			continue;
+		}
+
+		TEST_ASSERT_EQ(GPIO_Init_Table(Test_Table, Count), E_OK);
+		for(Port_Idx = 0; Port_Idx < TEST_PORTS_COUNT; Port_Idx++)
+		{
+			Port = Test_Ports[Port_Idx];
+			After = Test_Read_Port(Port);
+			TEST_ASSERT(0 == memcmp(&After, &Expected[Port], sizeof(After)));
+		}
+		for(Entry_Idx = 0; Entry_Idx < Count; Entry_Idx++)
+			{ TEST_ASSERT(READ_BIT(RCC->AHB1ENR, Test_Clock_Pos(Test_Table[Entry_Idx].Port))); }
+
+		/* De-init pin by pin: analog without pull, the clock goes with the last pin */
+		for(Entry_Idx = 0; Entry_Idx < Count; Entry_Idx++)
+		{
+			Port = Test_Table[Entry_Idx].Port;
+			Pin = Test_Table[Entry_Idx].Pin;
+			TEST_ASSERT_EQ(GPIO_Pin_DeInit(Port, Pin), E_OK);
+			TEST_ASSERT_EQ((GPIO_PORT_REGS(Port)->MODER >> (2UL * Pin)) & 3UL, GPIO_MODE_ANALOG);
+			TEST_ASSERT_EQ((GPIO_PORT_REGS(Port)->PUPDR >> (2UL * Pin)) & 3UL, GPIO_PULL_NONE);
+		}
+		TEST_ASSERT_EQ(RCC->AHB1ENR, 0);
+	}
+
+	TEST_ASSERT_EQ(GPIO_Init_Table(NULL, 1), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_Pin_DeInit((GPIO_Port_t)5, 0), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_Pin_DeInit(GPIO_PORTA, GPIO_PINS_PER_PORT), E_NOT_OK);
+}
+
+/* Random data path operations: the output register follows the model, the
+ * driver only stores to BSRR and never writes ODR itself */
+static void Test_Data_Path(void)
+{
+	uint32_t Model[GPIO_PORTS_NUMBER];
+	uint32_t Op = 0;
+	uint32_t Pin = 0;
+	uint32_t Mask = 0;
+	uint32_t Value = 0;
+	uint32_t Odr_Before = 0;
+	GPIO_Port_t Port = GPIO_PORTA;
+	GPIO_Registers_t * Regs = NULL;
+
+	memset(Model, 0, sizeof(Model));
+	for(Op = 0; Op < TEST_DATA_OPS_NUMBER; Op++)
+	{
+		Port = Test_Ports[Test_Random() % TEST_PORTS_COUNT];
+		Regs = GPIO_PORT_REGS(Port);
+		Pin = Test_Random() % GPIO_PINS_PER_PORT;
+		Mask = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+		Value = (uint32_t)((Test_Random() << 8) ^ Test_Random());
+		Regs->BSRR = 0;
+		Odr_Before = Regs->ODR;
+
+		switch(Test_Random() % 8UL)
+		{
+			case 0: GPIO_Pin_Set(Port, Pin); Model[Port] |= GPIO_PIN_MASK(Pin); break;
+			case 1: GPIO_Pin_Reset(Port, Pin); Model[Port] &= ~GPIO_PIN_MASK(Pin); break;
+			case 2:
+				GPIO_Pin_Write(Port, Pin, (GPIO_Level_t)(Value & 1UL));
+				Model[Port] = (Model[Port] & ~GPIO_PIN_MASK(Pin)) | ((Value & 1UL) << Pin);
+				break;
+			case 3: GPIO_Pin_Toggle(Port, Pin); Model[Port] ^= GPIO_PIN_MASK(Pin); break;
+			case 4: GPIO_Port_Set(Port, Mask); Model[Port] |= (Mask & GPIO_PORT_PINS_MASK); break;
+			case 5: GPIO_Port_Reset(Port, Mask); Model[Port] &= ~Mask; break;
+			case 6:
+				GPIO_Port_Write_Masked(Port, Mask, Value);
+				Model[Port] = (Model[Port] & ~Mask) | (Value & Mask);
+				break;
+			default: GPIO_Port_Write(Port, Value); Model[Port] = Value; break;
+		}
+		Model[Port] &= GPIO_PORT_PINS_MASK;
+		TEST_ASSERT_EQ(Regs->ODR, Odr_Before);
+		Test_Apply_BSRR(Port);
+		TEST_ASSERT_EQ(Regs->ODR, Model[Port]);
+		TEST_ASSERT_EQ(GPIO_Port_Read_Output(Port), Model[Port]);
+
+		/* Inputs, the upper half of IDR is reserved */
+		Regs->IDR = Value;
+		TEST_ASSERT_EQ(GPIO_Port_Read(Port), Value & GPIO_PORT_PINS_MASK);
+		TEST_ASSERT_EQ(GPIO_Pin_Read(Port, Pin), (Value >> Pin) & 1UL);
+	}
+	for(Op = 0; Op < TEST_PORTS_COUNT; Op++)
+		{ GPIO_PORT_REGS(Test_Ports[Op])->ODR = 0; }
+}
+
+/* EXTI routing, the NVIC vector of each line and the SYSCFG clock */
+static void Test_EXTI_Init(void)
+{
+	uint32_t Line = 0;
+	GPIO_Port_t Port = GPIO_PORTA;
+	IRQn_t IRQn = EXTI0_IRQn;
+
+	for(Line = 0; Line < GPIO_PINS_PER_PORT; Line++)
+	{
+		Port = Test_Ports[Line % TEST_PORTS_COUNT];
+		IRQn = (Line <= 4UL) ? (IRQn_t)(EXTI0_IRQn + (int32_t)Line) : ((Line <= 9UL) ? EXTI9_5_IRQn : EXTI15_10_IRQn);
+		memset((void *)NVIC->ISER, 0, sizeof(NVIC->ISER));
+		EXTI->PR = 0;
+		TEST_ASSERT_EQ(GPIO_EXTI_Init(Port, Line, (GPIO_EXTI_Edge_t)(1UL + (Line % 3UL)), Test_Line_Handlers[Line]), E_OK);
+		TEST_ASSERT_EQ((SYSCFG->EXTICR[Line >> 2] >> (4UL * (Line & 3UL))) & 0xFUL, Port);
+		TEST_ASSERT_EQ(READ_BIT(EXTI->RTSR, Line), (0UL != ((1UL + (Line % 3UL)) & 1UL)) ? 1UL : 0UL);
+		TEST_ASSERT_EQ(READ_BIT(EXTI->FTSR, Line), (0UL != ((1UL + (Line % 3UL)) & 2UL)) ? 1UL : 0UL);
+		TEST_ASSERT_EQ(READ_BIT(EXTI->IMR, Line), 1);
+		TEST_ASSERT_EQ(EXTI->PR, GPIO_PIN_MASK(Line));
+		TEST_ASSERT_EQ(NVIC->ISER[(uint32_t)IRQn >> 5], 1UL << ((uint32_t)IRQn & 31UL));
+		TEST_ASSERT(READ_BIT(RCC->APB2ENR, TEST_SYSCFG_CLOCK_POS));
+	}
+	/* One port per line */
+	TEST_ASSERT_EQ(GPIO_EXTI_Init(GPIO_PORTB, 3, GPIO_EXTI_BOTH, Test_Line_3), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_EXTI_Init(GPIO_PORTB, GPIO_PINS_PER_PORT, GPIO_EXTI_BOTH, Test_Line_3), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_EXTI_Init((GPIO_Port_t)6, 3, GPIO_EXTI_BOTH, Test_Line_3), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_EXTI_Init(GPIO_PORTB, 3, (GPIO_EXTI_Edge_t)0, Test_Line_3), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_EXTI_Init(GPIO_PORTB, 3, GPIO_EXTI_BOTH, NULL), E_NOT_OK);
+}
+
+/* Random pending and masked lines on every vector: each pending unmasked
+ * line is cleared in one store and called once, lowest line first */
+static void Test_EXTI_Dispatch(void)
+{
+	static const uint32_t Vector_Lines[] = { 0x0001UL, 0x0002UL, 0x0004UL, 0x0008UL, 0x0010UL, 0x03E0UL, 0xFC00UL };
+	uint32_t Iteration = 0;
+	uint32_t Vector = 0;
+	uint32_t Pending = 0;
+	uint32_t Masked = 0;
+	uint32_t Expected = 0;
+	uint32_t Line = 0;
+	uint32_t Call = 0;
+
+	for(Iteration = 0; Iteration < 5000UL; Iteration++)
+	{
+		Vector = Test_Random() % (sizeof(Test_EXTI_Vectors) / sizeof(Test_EXTI_Vectors[0]));
+		Pending = (uint32_t)(Test_Random() & GPIO_PORT_PINS_MASK) | Vector_Lines[Vector];
+		Masked = (Vector >= 5UL) ? (uint32_t)(Test_Random() & Vector_Lines[Vector]) : 0UL;
+		/* The single line vectors do not look at PR, their line is pending */
+		Expected = Pending & Vector_Lines[Vector] & ~Masked;
+		EXTI->IMR = GPIO_PORT_PINS_MASK & ~Masked;
+		EXTI->PR = Pending;
+		memset(Test_Calls, 0, sizeof(Test_Calls));
+		Test_Call_Count = 0;
+
+		Test_EXTI_Vectors[Vector]();
+		TEST_ASSERT_EQ(EXTI->PR, Expected);
+		for(Line = 0, Call = 0; Line < GPIO_PINS_PER_PORT; Line++)
+		{
+			TEST_ASSERT_EQ(Test_Calls[Line], READ_BIT(Expected, Line));
+			if(READ_BIT(Expected, Line))
+				{ TEST_ASSERT_EQ(Test_Call_Order[Call++], Line); }
+		}
+	}
+	EXTI->IMR = GPIO_PORT_PINS_MASK;
+}
+
+/* A shared vector is disabled with its last line, SYSCFG with the last line of all */
+static void Test_EXTI_DeInit(void)
+{
+	uint32_t Line = 0;
+	IRQn_t IRQn = EXTI0_IRQn;
+	uint32_t Last_Of_Vector = 0;
+
+	for(Line = 0; Line < GPIO_PINS_PER_PORT; Line++)
+	{
+		IRQn = (Line <= 4UL) ? (IRQn_t)(EXTI0_IRQn + (int32_t)Line) : ((Line <= 9UL) ? EXTI9_5_IRQn : EXTI15_10_IRQn);
+		Last_Of_Vector = ((Line <= 4UL) || (9UL == Line) || (15UL == Line)) ? 1UL : 0UL;
+		memset((void *)NVIC->ICER, 0, sizeof(NVIC->ICER));
+		TEST_ASSERT(READ_BIT(RCC->APB2ENR, TEST_SYSCFG_CLOCK_POS));
+		TEST_ASSERT_EQ(GPIO_EXTI_DeInit(Line), E_OK);
+		TEST_ASSERT_EQ(READ_BIT(EXTI->IMR, Line), 0);
+		TEST_ASSERT_EQ(READ_BIT(EXTI->RTSR, Line) | READ_BIT(EXTI->FTSR, Line), 0);
+		TEST_ASSERT_EQ(NVIC->ICER[(uint32_t)IRQn >> 5], Last_Of_Vector << ((uint32_t)IRQn & 31UL));
+	}
+	TEST_ASSERT_EQ(READ_BIT(RCC->APB2ENR, TEST_SYSCFG_CLOCK_POS), 0);
+	TEST_ASSERT_EQ(GPIO_EXTI_DeInit(3), E_NOT_OK);
+	TEST_ASSERT_EQ(GPIO_EXTI_DeInit(GPIO_PINS_PER_PORT), E_NOT_OK);
+}
+
+int main(void)
+{
+	Host_Port_Reset();
+	Test_Init_Table();
+	Test_Data_Path();
+	Test_EXTI_Init();
+	Test_EXTI_Dispatch();
+	Test_EXTI_DeInit();
+	return TEST_REPORT();
+}
@@ -0,0 +1,244 @@
+/**
+ ******************************************************************************
+ * @file           : test_isr_profiler.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the interrupt profiler bookkeeping, the cycle
+ *					 counter being the DWT register model of Host/Port:
+ *					 nesting, interrupts without a slot, too deep nesting,
+ *					 missed exits, latency and the histogram bins.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/IsrProfiler/isr_profiler.h"
+#include "CortexM4/DWT/DWT.h"
+#include "host_port.h"
+#include "test_common.h"
+#include <string.h>
+/* --------------- Section: Macro Declarations --------------- */
+/* More interrupts than slots, the last ones are never profiled */
+#define TEST_IRQS_NUMBER			(ISR_PROFILER_MAX_IRQS + 4U)
+#define TEST_MAX_LEVEL				(ISR_PROFILER_MAX_NESTING + 3U)
+#define TEST_RUNS_NUMBER			2000UL
+/* --------------- Section: Macro Functions Declarations --------------- */
+#define TEST_AT(CYCLES)				(DWT->CYCCNT = (uint32_t)(CYCLES))
+/*---------------  Section: Static Global Variables --------------- */
+static uint32_t Test_Time = 0;
+static uint8_t Test_Active[TEST_IRQS_NUMBER];
+static uint8_t Test_Has_Slot[TEST_IRQS_NUMBER];
+static uint32_t Test_Slots_Used = 0;
+static uint64_t Test_Own_Cycles[TEST_IRQS_NUMBER];
+static uint32_t Test_Runs[TEST_IRQS_NUMBER];
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Test_Start(void)
+{
+	Host_Port_Reset();
+	TEST_ASSERT_EQ(ISR_Profiler_Init(), E_OK);
+}
+
+static ISR_Profiler_Stats_t Test_Stats(IRQn_t IRQn)
+{
+	ISR_Profiler_Stats_t Stats;
+
+	memset(&Stats, 0, sizeof(Stats));
+	TEST_ASSERT_EQ(ISR_Profiler_Get_Stats(IRQn, &Stats), E_OK);
+	return Stats;
+}
+
+/* One random interrupt at nesting Level with random preemptions inside,
+ * keeping the expected own time. Returns its gross cycles if it got a frame,
+ * else 0: its time then stays in the interrupt it preempted. */
+static uint32_t Test_Random_Run(uint32_t Level)
+{
+	uint32_t Irq = 0;
+	uint32_t Start = 0;
+	uint32_t Nested = 0;
+	uint32_t Children = 0;
+	uint8_t Framed = (Level < ISR_PROFILER_MAX_NESTING) ? 1U : 0U;
+
+	/* An interrupt is never nested in itself */
+	do
+		{ Irq = Test_Random() % TEST_IRQS_NUMBER; }
+	while(Test_Active[Irq]);
+	if(!Test_Has_Slot[Irq] && (Test_Slots_Used < ISR_PROFILER_MAX_IRQS))
+	{
+		Test_Has_Slot[Irq] = 1;
+		Test_Slots_Used++;
+	}
+
+	Test_Active[Irq] = 1;
+	TEST_AT(Test_Time);
+	ISR_Profiler_Enter((IRQn_t)Irq);
+	Start = Test_Time;
+	Test_Time += 1UL + (Test_Random() % 100UL);
+	if(Level < TEST_MAX_LEVEL)
+	{
+		for(Children = Test_Random() % 3UL; Children > 0; Children--)
+		{
+			Nested += Test_Random_Run(Level + 1UL);
+			Test_Time += Test_Random() % 50UL;
+		}
+	}
+	TEST_AT(Test_Time);
+	ISR_Profiler_Exit((IRQn_t)Irq);
+	Test_Active[Irq] = 0;
+
+	if(Framed && Test_Has_Slot[Irq])
+	{
+		Test_Own_Cycles[Irq] += (Test_Time - Start) - Nested;
+		Test_Runs[Irq]++;
+	}
+	return Framed ? (Test_Time - Start) : 0UL;
+}
+/*---------------  Section: Tests --------------- */
+static void Test_Nesting(void)
+{
+	ISR_Profiler_Stats_t Stats;
+
+	Test_Start();
+	/* USART2 preempted by TIM2 for 50 cycles */
+	TEST_AT(1000);	ISR_Profiler_Enter(USART2_IRQn);
+	TEST_AT(1100);	ISR_Profiler_Enter(TIM2_IRQn);
+	TEST_AT(1150);	ISR_Profiler_Exit(TIM2_IRQn);
+	TEST_AT(1300);	ISR_Profiler_Exit(USART2_IRQn);
+
+	Stats = Test_Stats(USART2_IRQn);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Preemptions, 1);
+	TEST_ASSERT_EQ(Stats.Max_Cycles, 250);
+	TEST_ASSERT_EQ(Stats.Last_Entry, 1000);
+	Stats = Test_Stats(TIM2_IRQn);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Min_Cycles, 50);
+	TEST_ASSERT_EQ(Stats.Preemptions, 0);
+
+	/* Latency from the trigger stamp */
+	TEST_AT(2000);	ISR_Profiler_Mark_Trigger(TIM2_IRQn);
+	TEST_AT(2012);	ISR_Profiler_Enter(TIM2_IRQn);
+	TEST_AT(2020);	ISR_Profiler_Exit(TIM2_IRQn);
+	Stats = Test_Stats(TIM2_IRQn);
+	TEST_ASSERT_EQ(Stats.Latency_Count, 1);
+	TEST_ASSERT_EQ(Stats.Max_Latency, 12);
+	TEST_ASSERT_EQ(Stats.Count, 2);
+}
+
+/* An interrupt without a slot preempted by a profiled one, and the other
+ * way round: each exit closes its own entry */
+static void Test_No_Slot(void)
+{
+	ISR_Profiler_Stats_t Stats;
+	uint32_t Irq = 0;
+
+	Test_Start();
+	for(Irq = 0; Irq < ISR_PROFILER_MAX_IRQS; Irq++)
+	{
+		TEST_AT(10);	ISR_Profiler_Enter((IRQn_t)Irq);
+		TEST_AT(20);	ISR_Profiler_Exit((IRQn_t)Irq);
+	}
+	ISR_Profiler_Reset();
+
+	TEST_AT(100);	ISR_Profiler_Enter(USART2_IRQn);
+	TEST_AT(110);	ISR_Profiler_Enter((IRQn_t)1);
+	TEST_AT(130);	ISR_Profiler_Exit((IRQn_t)1);
+	TEST_AT(200);	ISR_Profiler_Exit(USART2_IRQn);
+	TEST_ASSERT_EQ(ISR_Profiler_Get_Stats(USART2_IRQn, &Stats), E_NOT_OK);
+	Stats = Test_Stats((IRQn_t)1);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Max_Cycles, 20);
+
+	TEST_AT(300);	ISR_Profiler_Enter((IRQn_t)2);
+	TEST_AT(310);	ISR_Profiler_Enter(USART2_IRQn);
+	TEST_AT(360);	ISR_Profiler_Exit(USART2_IRQn);
+	TEST_AT(400);	ISR_Profiler_Exit((IRQn_t)2);
+	Stats = Test_Stats((IRQn_t)2);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Preemptions, 1);
+	TEST_ASSERT_EQ(Stats.Max_Cycles, 50);
+}
+
+/* A handler that returned without its exit does not shift the others */
+static void Test_Missed_Exit(void)
+{
+	ISR_Profiler_Stats_t Stats;
+
+	Test_Start();
+	TEST_AT(0);		ISR_Profiler_Enter(USART2_IRQn);
+	TEST_AT(10);	ISR_Profiler_Enter(TIM2_IRQn);
+	TEST_AT(40);	ISR_Profiler_Exit(USART2_IRQn);
+	Stats = Test_Stats(USART2_IRQn);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Max_Cycles, 40);
+	TEST_ASSERT_EQ(Test_Stats(TIM2_IRQn).Count, 0);
+
+	/* Nothing left in progress, an exit without entry is ignored */
+	TEST_AT(50);	ISR_Profiler_Exit(TIM2_IRQn);
+	TEST_AT(60);	ISR_Profiler_Enter(TIM2_IRQn);
+	TEST_AT(65);	ISR_Profiler_Exit(TIM2_IRQn);
+	Stats = Test_Stats(TIM2_IRQn);
+	TEST_ASSERT_EQ(Stats.Count, 1);
+	TEST_ASSERT_EQ(Stats.Max_Cycles, 5);
+}
+
+/* Random nesting up to past ISR_PROFILER_MAX_NESTING, with more
+ * interrupts than slots: the own time of each one adds up */
+static void Test_Random_Nesting(void)
+{
+	ISR_Profiler_Stats_t Stats;
+	uint32_t Run = 0;
+	uint32_t Irq = 0;
+
+	Test_Start();
+	memset(Test_Has_Slot, 0, sizeof(Test_Has_Slot));
+	memset(Test_Own_Cycles, 0, sizeof(Test_Own_Cycles));
+	memset(Test_Runs, 0, sizeof(Test_Runs));
+	Test_Slots_Used = 0;
+	Test_Time = 0;
+	for(Run = 0; Run < TEST_RUNS_NUMBER; Run++)
+	{
+		(void)Test_Random_Run(0);
+		Test_Time += Test_Random() % 1000UL;
+	}
+	for(Irq = 0; Irq < TEST_IRQS_NUMBER; Irq++)
+	{
+		if(Test_Has_Slot[Irq])
+		{
+			Stats = Test_Stats((IRQn_t)Irq);
+			TEST_ASSERT_EQ(Stats.Count, Test_Runs[Irq]);
+			TEST_ASSERT_EQ(Stats.Total_Cycles, Test_Own_Cycles[Irq]);
+		}
+		else
+		{
+			TEST_ASSERT_EQ(ISR_Profiler_Get_Stats((IRQn_t)Irq, &Stats), E_NOT_OK);
+		}
+	}
+}
+
+/* The counter already running keeps its count, other users measure with it */
+static void Test_Init_Keeps_Counter(void)
+{
+	Test_Start();
+	TEST_ASSERT(DWT_CYCCNT_IS_ENABLED());
+	TEST_AT(123456UL);
+	TEST_ASSERT_EQ(ISR_Profiler_Init(), E_OK);
+	TEST_ASSERT_EQ(DWT->CYCCNT, 123456UL);
+}
+
+static void Test_Hist_Bin(void)
+{
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin(0), 0);
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin((1UL << ISR_PROFILER_HIST_SHIFT) - 1UL), 0);
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin(1UL << ISR_PROFILER_HIST_SHIFT), 1);
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin((2UL << ISR_PROFILER_HIST_SHIFT) - 1UL), 1);
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin(2UL << ISR_PROFILER_HIST_SHIFT), 2);
+	TEST_ASSERT_EQ(ISR_Profiler_Hist_Bin(0xFFFFFFFFUL), ISR_PROFILER_HIST_BINS - 1U);
+}
+
+int main(void)
+{
+	Test_Nesting();
+	Test_No_Slot();
+	Test_Missed_Exit();
+	Test_Random_Nesting();
+	Test_Init_Keeps_Counter();
+	Test_Hist_Bin();
+	return TEST_REPORT();
+}
@@ -0,0 +1,159 @@
+/**
+ ******************************************************************************
+ * @file           : test_kernel.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Host model tests of the micro-kernel: preemption on a
+ *					 semaphore give, queue order, sleeps and timeouts on the
+ *					 SysTick model, and the context-switch latency benchmark.
+ *					 The threads run on host contexts (Host/Port), so the
+ *					 latency covers the kernel path plus a host context
+ *					 switch, not the Cortex-M4 exception entry and exit.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#define _POSIX_C_SOURCE 200809L
+#include "Services/Kernel/kernel.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "host_port.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <time.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_PERIOD_CYCLES			84000UL
+#define TEST_STACK_WORDS			256UL
+#define TEST_BENCH_SWITCHES			20000UL
+#define TEST_QUEUE_ITEMS			100UL
+/*---------------  Section: Static Global Variables --------------- */
+static Kernel_Thread_t Test_Main_Thread;
+static Kernel_Thread_t Test_High_Thread;
+static Kernel_Thread_t Test_Consumer_Thread;
+static uint32_t Test_Main_Stack[TEST_STACK_WORDS] __attribute__((aligned(8)));
+static uint32_t Test_High_Stack[TEST_STACK_WORDS] __attribute__((aligned(8)));
+static uint32_t Test_Consumer_Stack[TEST_STACK_WORDS] __attribute__((aligned(8)));
+
+static Kernel_Sem_t Test_Bench_Sem;
+static Kernel_Sem_t Test_Empty_Sem;
+static Kernel_Queue_t Test_Queue;
+static uint32_t Test_Queue_Buffer[8];
+static uint32_t Test_Received[TEST_QUEUE_ITEMS];
+static volatile uint32_t Test_Received_Count = 0;
+
+static volatile uint32_t Test_High_Runs = 0;
+static double Test_Give_ns = 0;
+static double Test_Latency_Sum_ns = 0;
+static double Test_Latency_Max_ns = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+static double Test_Now_ns(void)
+{
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+/* Highest priority: woken by every give, it must preempt the giver at once */
+static void Test_High_Entry(void * Arg)
+{
+	double Latency_ns = 0;
+
+	(void)Arg;
+	while(1)
+	{
+		(void)Kernel_Sem_Take(&Test_Bench_Sem, KERNEL_WAIT_FOREVER);
+		Latency_ns = Test_Now_ns() - Test_Give_ns;
+		Test_Latency_Sum_ns += Latency_ns;
+		if(Latency_ns > Test_Latency_Max_ns)
+			{ Test_Latency_Max_ns = Latency_ns; }
+		Test_High_Runs++;
+	}
+}
+
+static void Test_Consumer_Entry(void * Arg)
+{
+	uint32_t Item = 0;
+
+	(void)Arg;
+	while(1)
+	{
+		if(E_OK == Kernel_Queue_Receive(&Test_Queue, &Item, KERNEL_WAIT_FOREVER))
+			{ Test_Received[Test_Received_Count++] = Item; }
+	}
+}
+/*---------------  Section: Tests --------------- */
+static void Test_Preemption_Latency(void)
+{
+	uint32_t Idx = 0;
+	uint32_t Late = 0;
+	uint32_t Switches = Kernel_Get_Switch_Count();
+	double Start_ns = Test_Now_ns();
+
+	for(Idx = 0; Idx < TEST_BENCH_SWITCHES; Idx++)
+	{
+		Test_Give_ns = Test_Now_ns();
+		(void)Kernel_Sem_Give(&Test_Bench_Sem);
+		/* The high thread already ran and blocked again */
+		if(Test_High_Runs != (Idx + 1UL))
+			{ Late++; }
+	}
+	TEST_ASSERT_EQ(Late, 0);
+	TEST_ASSERT_EQ(Kernel_Get_Switch_Count() - Switches, 2UL * TEST_BENCH_SWITCHES);
+	printf("give -> higher priority thread running: avg %.0f ns, max %.0f ns; round trip %.0f ns (host model)\n",
+		   Test_Latency_Sum_ns / TEST_BENCH_SWITCHES, Test_Latency_Max_ns,
+		   (Test_Now_ns() - Start_ns) / TEST_BENCH_SWITCHES);
+}
+
+static void Test_Queue_Order(void)
+{
+	uint32_t Idx = 0;
+	uint32_t Out_Of_Order = 0;
+
+	for(Idx = 0; Idx < TEST_QUEUE_ITEMS; Idx++)
+		{ TEST_ASSERT_EQ(Kernel_Queue_Send(&Test_Queue, &Idx, KERNEL_WAIT_FOREVER), E_OK); }
+	TEST_ASSERT_EQ(Test_Received_Count, TEST_QUEUE_ITEMS);
+	for(Idx = 0; Idx < TEST_QUEUE_ITEMS; Idx++)
+	{
+		if(Test_Received[Idx] != Idx)
+			{ Out_Of_Order++; }
+	}
+	TEST_ASSERT_EQ(Out_Of_Order, 0);
+}
+
+/* The idle thread sleeps on the SysTick model until the wake-up tick */
+static void Test_Sleep_And_Timeout(void)
+{
+	uint32_t Start_Tick = Kernel_Get_Ticks();
+
+	Kernel_Sleep(5);
+	TEST_ASSERT_EQ(Kernel_Get_Ticks() - Start_Tick, 5);
+	TEST_ASSERT_EQ(Host_Time / TEST_PERIOD_CYCLES, SysTick_Get_Ticks());
+
+	Start_Tick = Kernel_Get_Ticks();
+	TEST_ASSERT_EQ(Kernel_Sem_Take(&Test_Empty_Sem, 3), E_NOT_OK);
+	TEST_ASSERT_EQ(Kernel_Get_Ticks() - Start_Tick, 3);
+	TEST_ASSERT_EQ(Kernel_Sem_Take(&Test_Empty_Sem, KERNEL_NO_WAIT), E_NOT_OK);
+}
+
+static void Test_Main_Entry(void * Arg)
+{
+	(void)Arg;
+	TEST_ASSERT(Kernel_Get_Current_Thread() == &Test_Main_Thread);
+	Test_Preemption_Latency();
+	Test_Queue_Order();
+	Test_Sleep_And_Timeout();
+	exit(TEST_REPORT());
+}
+
+int main(void)
+{
+	Host_Port_Reset();
+	Host_Wfi_Hook = Host_Wfi_Until_SysTick;
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(TEST_PERIOD_CYCLES, NULL), E_OK);
+	TEST_ASSERT_EQ(Kernel_Init(), E_OK);
+	TEST_ASSERT_EQ(Kernel_Sem_Init(&Test_Bench_Sem, 0, 1), E_OK);
+	TEST_ASSERT_EQ(Kernel_Sem_Init(&Test_Empty_Sem, 0, 1), E_OK);
+	TEST_ASSERT_EQ(Kernel_Queue_Init(&Test_Queue, Test_Queue_Buffer, sizeof(uint32_t), 8), E_OK);
+	TEST_ASSERT_EQ(Kernel_Thread_Create(&Test_High_Thread, Test_High_Entry, NULL, 1, Test_High_Stack, TEST_STACK_WORDS), E_OK);
+	TEST_ASSERT_EQ(Kernel_Thread_Create(&Test_Consumer_Thread, Test_Consumer_Entry, NULL, 2, Test_Consumer_Stack, TEST_STACK_WORDS), E_OK);
+	TEST_ASSERT_EQ(Kernel_Thread_Create(&Test_Main_Thread, Test_Main_Entry, NULL, 10, Test_Main_Stack, TEST_STACK_WORDS), E_OK);
+	Kernel_Start();
+	return 1;
+}
@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @file           : test_nvic_irqset.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the NVIC IRQ sets against the register model
+ *					 of Host/Port: the bounds of NVIC_IRQSet_Add/Remove()
+ *					 and the words written by the set operations.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/NVIC/NVIC.h"
+#include "host_port.h"
+#include "test_common.h"
+/*---------------  Section: Tests --------------- */
+static void Test_Bounds(void)
+{
+	NVIC_IRQSet_t Set;
+	uint32_t Word_Idx = 0;
+
+	NVIC_IRQSet_Init(&Set);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(NULL, USART2_IRQn), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, SysTick_IRQn), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, (IRQn_t)(NVIC_LAST_IRQN + 1UL)), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, (IRQn_t)(NVIC_IRQ_REGS * REG_WIDTH)), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, (IRQn_t)0x7FFFFFFF), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Remove(&Set, (IRQn_t)(NVIC_LAST_IRQN + 1UL)), E_NOT_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Remove(&Set, (IRQn_t)-1), E_NOT_OK);
+	/* The rejected numbers left the set empty */
+	for(Word_Idx = 0; Word_Idx < NVIC_IRQ_REGS; Word_Idx++)
+		{ TEST_ASSERT_EQ(Set.Words[Word_Idx], 0); }
+
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, WWDG_IRQn), E_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, USART2_IRQn), E_OK);
+	TEST_ASSERT_EQ(NVIC_IRQSet_Add(&Set, SPI4_IRQn), E_OK);
+	TEST_ASSERT_EQ(Set.Words[0], 1UL);
+	TEST_ASSERT_EQ(Set.Words[USART2_IRQn / 32], 1UL << (USART2_IRQn % 32));
+	TEST_ASSERT_EQ(Set.Words[SPI4_IRQn / 32], 1UL << (SPI4_IRQn % 32));
+	TEST_ASSERT_EQ(NVIC_IRQSet_Remove(&Set, WWDG_IRQn), E_OK);
+	TEST_ASSERT_EQ(Set.Words[0], 0);
+}
+
+static void Test_Mask_Restore(void)
+{
+	NVIC_IRQSet_t Set;
+	NVIC_IRQSet_t Snapshot;
+
+	Host_Port_Reset();
+	NVIC_IRQSet_Init(&Set);
+	(void)NVIC_IRQSet_Add(&Set, USART2_IRQn);
+	(void)NVIC_IRQSet_Add(&Set, SPI4_IRQn);
+	/* The model keeps the writes: ISER holds the enabled ones, ICER the last disable */
+	NVIC->ISER[USART2_IRQn / 32] = 1UL << (USART2_IRQn % 32);
+	NVIC_MaskIRQSet(&Set, &Snapshot);
+	TEST_ASSERT_EQ(Snapshot.Words[USART2_IRQn / 32], 1UL << (USART2_IRQn % 32));
+	TEST_ASSERT_EQ(Snapshot.Words[SPI4_IRQn / 32], 0);
+	TEST_ASSERT_EQ(NVIC->ICER[USART2_IRQn / 32], 1UL << (USART2_IRQn % 32));
+	TEST_ASSERT_EQ(NVIC->ICER[SPI4_IRQn / 32], 1UL << (SPI4_IRQn % 32));
+
+	NVIC->ISER[USART2_IRQn / 32] = 0;
+	NVIC_RestoreIRQSet(&Snapshot);
+	TEST_ASSERT_EQ(NVIC->ISER[USART2_IRQn / 32], 1UL << (USART2_IRQn % 32));
+	TEST_ASSERT_EQ(NVIC->ISER[SPI4_IRQn / 32], 0);
+}
+
+int main(void)
+{
+	Test_Bounds();
+	Test_Mask_Restore();
+	return TEST_REPORT();
+}
@@ -0,0 +1,185 @@
+/**
+ ******************************************************************************
+ * @file           : test_rcc_pll.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the PLL solver over every legal crystal: each
+ *					 result passes RCC_PLL_Check, and its SYSCLK error and M
+ *					 match a brute force search of all M, N, P and Q.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "MCAL/RCC/rcc.h"
+#include "test_common.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_MHZ					1000000UL
+/* The HSE sweep step, every crystal the oscillator accepts on a kHz grid */
+#define TEST_SWEEP_STEP				1000UL
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uint32_t Found;
+	uint32_t Error;
+	uint32_t PLL_M;
+} Test_Best_t;
+/*---------------  Section: Static Global Variables --------------- */
+/* Common crystals off the MHz grid: UART, audio and radio ones */
+static const uint32_t Test_Crystals[] =
+{
+	4096000UL, 4194304UL, 6144000UL, 7372800UL, 9830400UL, 11059200UL, 11289600UL, 12288000UL,
+	14318180UL, 14745600UL, 16384000UL, 18432000UL, 19200000UL, 22118400UL, 22579200UL, 24576000UL
+};
+static const uint32_t Test_Targets[] =
+{
+	24000000UL, 25000000UL, 30000000UL, 32000000UL, 36000000UL, 40000000UL, 42000000UL, 48000000UL,
+	50000000UL, 56000000UL, 60000000UL, 64000000UL, 72000000UL, 80000000UL, 83333333UL, 84000000UL
+};
+/*---------------  Section: Helper Function Definitions --------------- */
+static uint32_t Test_Error(uint32_t SYSCLK, uint32_t Target)
+{
+	return (SYSCLK > Target) ? (SYSCLK - Target) : (Target - SYSCLK);
+}
+
+/* Every M, N and P; Q is the largest one for SYSCLK only (PLL48CLK at most
+ * 28.8 MHz then), or the one giving exactly 48 MHz */
+static Test_Best_t Test_Brute_Force(uint32_t Input_Freq, uint32_t Target, uint32_t Require_48MHz)
+{
+	Test_Best_t Best = { 0, 0xFFFFFFFFUL, 0 };
+	RCC_PLL_Cfgs_t Pll = { 0 };
+	RCC_PLL_Freqs_t Freqs;
+	uint32_t P = 0;
+	uint32_t Error = 0;
+
+	for(Pll.PLL_M = RCC_PLL_M_MIN; Pll.PLL_M <= RCC_PLL_M_MAX; Pll.PLL_M++)
+	{
+		for(Pll.PLL_N = RCC_PLL_N_MIN; Pll.PLL_N <= RCC_PLL_N_MAX; Pll.PLL_N++)
+		{
+			Pll.PLL_Q = RCC_PLL_Q_MAX;
+			if(Require_48MHz)
+			{
+				for(Pll.PLL_Q = RCC_PLL_Q_MIN; Pll.PLL_Q <= RCC_PLL_Q_MAX; Pll.PLL_Q++)
+				{
+					if(((uint64_t)Input_Freq * Pll.PLL_N) == ((uint64_t)RCC_PLL48CLK_VALUE * Pll.PLL_M * Pll.PLL_Q))
+						{ break; }
+				}
+			}
+			for(P = RCC_PLL_P_DIVIDE_BY_2; P <= RCC_PLL_P_DIVIDE_BY_8; P++)
+			{
+				Pll.PLL_P = (RCC_PLL_P_t)P;
+				if(E_OK != RCC_PLL_Check(Input_Freq, &Pll, &Freqs))
+					{ continue; }
+				Error = Test_Error(Freqs.SYSCLK, Target);
+				if((0 == Best.Found) || (Error < Best.Error) || ((Error == Best.Error) && (Pll.PLL_M < Best.PLL_M)))
+				{
+					Best.Found = 1;
+					Best.Error = Error;
+					Best.PLL_M = Pll.PLL_M;
+				}
+			}
+		}
+	}
+	return Best;
+}
+
+/* One solve: a valid result with consistent frequencies, and no better than
+ * Best when given. Returns 1 if a configuration was found. */
+static uint32_t Test_Solve(uint32_t Input_Freq, uint32_t Target, uint32_t Require_48MHz, const Test_Best_t * Best)
+{
+	RCC_PLL_Cfgs_t Pll = { 0 };
+	RCC_PLL_Freqs_t Freqs = { 0 };
+	RCC_PLL_Freqs_t Checked = { 0 };
+	Std_ReturnType_t Ret = RCC_PLL_Solve(Input_Freq, Target, Require_48MHz, &Pll, &Freqs);
+
+	if(NULL != Best)
+	{
+		TEST_ASSERT_EQ(Ret, (Best->Found ? E_OK : E_NOT_OK));
+		if((E_OK == Ret) && Best->Found &&
+		   ((Test_Error(Freqs.SYSCLK, Target) != Best->Error) || (Pll.PLL_M != Best->PLL_M)))
+		{
+			printf("f_in %lu target %lu 48MHz %lu: M %lu error %lu, best M %lu error %lu\n", (unsigned long)Input_Freq,
+				   (unsigned long)Target, (unsigned long)Require_48MHz, (unsigned long)Pll.PLL_M,
+				   (unsigned long)Test_Error(Freqs.SYSCLK, Target), (unsigned long)Best->PLL_M, (unsigned long)Best->Error);
+			TEST_ASSERT(0);
+		}
+	}
+	if(E_OK == Ret)
+	{
+		TEST_ASSERT_EQ(RCC_PLL_Check(Input_Freq, &Pll, &Checked), E_OK);
+		TEST_ASSERT_EQ(Freqs.SYSCLK, Checked.SYSCLK);
+		TEST_ASSERT_EQ(Freqs.VCO_Output, Checked.VCO_Output);
+		TEST_ASSERT_EQ(Freqs.PLL48CLK, Checked.PLL48CLK);
+		TEST_ASSERT(Freqs.SYSCLK <= RCC_SYSCLK_MAX);
+		if(Require_48MHz)
+			{ TEST_ASSERT_EQ((uint64_t)Input_Freq * Pll.PLL_N, (uint64_t)RCC_PLL48CLK_VALUE * Pll.PLL_M * Pll.PLL_Q); }
+	}
+	return (E_OK == Ret) ? 1UL : 0UL;
+}
+
+static void Test_Against_Brute_Force(uint32_t Input_Freq)
+{
+	Test_Best_t Best;
+	uint32_t Target = 0;
+	uint32_t Require_48MHz = 0;
+
+	for(Target = 0; Target < (sizeof(Test_Targets) / sizeof(Test_Targets[0])); Target++)
+	{
+		for(Require_48MHz = 0; Require_48MHz <= 1UL; Require_48MHz++)
+		{
+			Best = Test_Brute_Force(Input_Freq, Test_Targets[Target], Require_48MHz);
+			(void)Test_Solve(Input_Freq, Test_Targets[Target], Require_48MHz, &Best);
+		}
+	}
+}
+/*---------------  Section: Tests --------------- */
+/* HSI and every whole MHz crystal, then the common fractional ones */
+static void Test_Crystals_Optimal(void)
+{
+	uint32_t Input_Freq = 0;
+	uint32_t Idx = 0;
+
+	for(Input_Freq = RCC_HSE_MIN; Input_Freq <= RCC_HSE_MAX; Input_Freq += TEST_MHZ)
+		{ Test_Against_Brute_Force(Input_Freq); }
+	for(Idx = 0; Idx < (sizeof(Test_Crystals) / sizeof(Test_Crystals[0])); Idx++)
+		{ Test_Against_Brute_Force(Test_Crystals[Idx]); }
+}
+
+/* Every crystal on the kHz grid: the SYSCLK range is always reachable, and
+ * the full speed with exact 48 MHz whenever the brute force finds one */
+static void Test_Crystals_Sweep(void)
+{
+	uint32_t Input_Freq = 0;
+	uint32_t Found_48MHz = 0;
+
+	for(Input_Freq = RCC_HSE_MIN; Input_Freq <= RCC_HSE_MAX; Input_Freq += TEST_SWEEP_STEP)
+	{
+		TEST_ASSERT_EQ(Test_Solve(Input_Freq, RCC_SYSCLK_MAX, 0, NULL), 1);
+		TEST_ASSERT_EQ(Test_Solve(Input_Freq, RCC_PLL_VCO_OUT_MIN / 8UL, 0, NULL), 1);
+		Found_48MHz += Test_Solve(Input_Freq, RCC_SYSCLK_MAX, 1, NULL);
+	}
+	printf("exact 48 MHz found for %lu of %lu crystals on the %lu Hz grid\n", (unsigned long)Found_48MHz,
+		   (unsigned long)(((RCC_HSE_MAX - RCC_HSE_MIN) / TEST_SWEEP_STEP) + 1UL), (unsigned long)TEST_SWEEP_STEP);
+}
+
+static void Test_Rejects(void)
+{
+	RCC_PLL_Cfgs_t Pll = { 0 };
+
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_MIN - 1UL, RCC_SYSCLK_MAX, 0, &Pll, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_MAX + 1UL, RCC_SYSCLK_MAX, 0, &Pll, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_VALUE, RCC_SYSCLK_MAX + 1UL, 0, &Pll, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_VALUE, (RCC_PLL_VCO_OUT_MIN / 8UL) - 1UL, 0, &Pll, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_VALUE, RCC_SYSCLK_MAX, 0, NULL, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_PLL_Check(RCC_HSE_VALUE, NULL, NULL), E_NOT_OK);
+
+	/* The reference 25 MHz / 84 MHz / USB configuration */
+	TEST_ASSERT_EQ(RCC_PLL_Solve(RCC_HSE_VALUE, RCC_SYSCLK_MAX, 1, &Pll, NULL), E_OK);
+	TEST_ASSERT_EQ(Pll.PLL_M, 25);
+	TEST_ASSERT_EQ(((uint64_t)RCC_HSE_VALUE * Pll.PLL_N) / ((uint64_t)Pll.PLL_M * ((Pll.PLL_P * 2UL) + 2UL)), RCC_SYSCLK_MAX);
+}
+
+int main(void)
+{
+	Test_Crystals_Optimal();
+	Test_Crystals_Sweep();
+	Test_Rejects();
+	return TEST_REPORT();
+}
@@ -0,0 +1,323 @@
+/**
+ ******************************************************************************
+ * @file           : test_ring_buffer.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Stress tests and benchmark of the lock-free ring buffer,
+ *					 host build on C11 atomics with POSIX threads standing
+ *					 for the interrupts. The consumer checks every element:
+ *					 order per producer, no loss, no duplicate, and the
+ *					 elements of one MPSC push kept together.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/RingBuffer/ring_buffer.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_CAPACITY				64UL
+#define TEST_SPSC_ELEMENTS			2000000UL
+#define TEST_MPSC_PRODUCERS			4UL
+#define TEST_MPSC_ELEMENTS			500000UL	/* !< Per producer */
+#define TEST_MAX_CHUNK				4UL
+#define TEST_BENCH_ELEMENTS			4000000UL
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uint32_t Sequence;				/* !< Per producer */
+	uint8_t Producer;
+	uint8_t Chunk_Index;			/* !< Position in its push */
+	uint8_t Chunk_Length;
+	uint8_t Reserved;
+} Test_Element_t;
+
+typedef struct
+{
+	Ring_Buffer_t * Ring;
+	uint32_t Producer;
+	uint32_t Elements;
+	uint32_t Use_Span;
+	uint32_t Random_State;
+} Test_Producer_t;
+/*---------------  Section: Static Global Variables --------------- */
+static Test_Element_t Test_Storage[TEST_CAPACITY];
+static uint32_t Test_Bench_Storage[1024];
+/*---------------  Section: Helper Function Definitions --------------- */
+static double Test_Now(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return (double)Now.tv_sec + ((double)Now.tv_nsec * 1e-9);
+}
+
+/* Per thread generator, the shared one of test_common.h is not thread safe */
+static uint32_t Test_Thread_Random(uint32_t * State)
+{
+	*State = (*State * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+	return (*State >> 8) & 0xFFFFFFUL;
+}
+
+static void * Test_SPSC_Producer(void * Arg)
+{
+	Test_Producer_t * Producer = (Test_Producer_t *)Arg;
+	Test_Element_t Chunk[TEST_MAX_CHUNK];
+	Test_Element_t * Span = NULL;
+	uint32_t Sequence = 0;
+	uint32_t Length = 0;
+	uint32_t Free = 0;
+	uint32_t Idx = 0;
+
+	memset(Chunk, 0, sizeof(Chunk));
+	while(Sequence < Producer->Elements)
+	{
+		Length = 1UL + (Test_Thread_Random(&Producer->Random_State) % TEST_MAX_CHUNK);
+		if(Length > (Producer->Elements - Sequence))
+			{ Length = Producer->Elements - Sequence; }
+		if(0UL != Producer->Use_Span)
+		{
+			/* Filled in place */
+			Free = Ring_SPSC_Write_Span(Producer->Ring, (void **)&Span);
+			if(Length > Free)
+				{ Length = Free; }
+			for(Idx = 0; Idx < Length; Idx++)
+			{
+				memset(&Span[Idx], 0, sizeof(Test_Element_t));
+				Span[Idx].Sequence = Sequence + Idx;
+			}
+			Ring_SPSC_Write_Commit(Producer->Ring, Length);
+			Sequence += Length;
+			if(0UL == Length)
+				{ (void)sched_yield(); }
+		}
+		else
+		{
+			/* Copied, only what fits is taken */
+			for(Idx = 0; Idx < Length; Idx++)
+				{ Chunk[Idx].Sequence = Sequence + Idx; }
+			Length = Ring_SPSC_Push(Producer->Ring, Chunk, Length);
+			Sequence += Length;
+			if(0UL == Length)
+				{ (void)sched_yield(); }
+		}
+	}
+	return NULL;
+}
+
+static void * Test_MPSC_Producer(void * Arg)
+{
+	Test_Producer_t * Producer = (Test_Producer_t *)Arg;
+	Test_Element_t Chunk[TEST_MAX_CHUNK];
+	uint32_t Sequence = 0;
+	uint32_t Length = 0;
+	uint32_t Idx = 0;
+
+	while(Sequence < Producer->Elements)
+	{
+		Length = 1UL + (Test_Thread_Random(&Producer->Random_State) % TEST_MAX_CHUNK);
+		if(Length > (Producer->Elements - Sequence))
+			{ Length = Producer->Elements - Sequence; }
+		for(Idx = 0; Idx < Length; Idx++)
+		{
+			Chunk[Idx].Sequence = Sequence + Idx;
+			Chunk[Idx].Producer = (uint8_t)Producer->Producer;
+			Chunk[Idx].Chunk_Index = (uint8_t)Idx;
+			Chunk[Idx].Chunk_Length = (uint8_t)Length;
+		}
+		/* All or nothing, a full ring is retried */
+		if(E_OK == Ring_MPSC_Push(Producer->Ring, Chunk, Length))
+			{ Sequence += Length; }
+		else
+			{ (void)sched_yield(); }
+	}
+	return NULL;
+}
+
+/* Pops until Total elements came, alternating copy and in place reads.
+ * Returns the number of ordering errors. */
+static uint32_t Test_Consume(Ring_Buffer_t * Ring, uint32_t Total, uint32_t Producers)
+{
+	uint32_t Expected[TEST_MPSC_PRODUCERS] = { 0 };
+	Test_Element_t Chunk[TEST_MAX_CHUNK];
+	const Test_Element_t * Span = NULL;
+	Test_Element_t Previous;
+	uint32_t Received = 0;
+	uint32_t Count = 0;
+	uint32_t Errors = 0;
+	uint32_t Idx = 0;
+	const Test_Element_t * Element = NULL;
+
+	memset(&Previous, 0, sizeof(Previous));
+	while(Received < Total)
+	{
+		if(0UL != (Received & 1UL))
+		{
+			Count = Ring_Pop(Ring, Chunk, TEST_MAX_CHUNK);
+			Span = Chunk;
+		}
+		else
+		{
+			Count = Ring_Read_Span(Ring, (const void **)&Span);
+		}
+		for(Idx = 0; Idx < Count; Idx++)
+		{
+			Element = &Span[Idx];
+			if((Element->Producer >= Producers) || (Element->Sequence != Expected[Element->Producer]))
+				{ Errors++; }
+			else
+				{ Expected[Element->Producer]++; }
+			/* An element inside a push follows the previous one of the same push */
+			if((0 != Element->Chunk_Index) &&
+			   ((Previous.Producer != Element->Producer) || (Previous.Chunk_Index + 1U != Element->Chunk_Index)))
+				{ Errors++; }
+			Previous = *Element;
+		}
+		if(Span != Chunk)
+			{ Ring_Read_Release(Ring, Count); }
+		Received += Count;
+		/* Few cores: let the producers run rather than spin */
+		if(0UL == Count)
+			{ (void)sched_yield(); }
+	}
+	return Errors;
+}
+/*---------------  Section: Tests --------------- */
+static void Test_Init(void)
+{
+	Ring_Buffer_t Ring;
+
+	TEST_ASSERT_EQ(Ring_Init(NULL, Test_Storage, sizeof(Test_Element_t), 64), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Init(&Ring, NULL, sizeof(Test_Element_t), 64), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Init(&Ring, Test_Storage, 0, 64), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), 48), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), 2UL * RING_BUFFER_MAX_CAPACITY), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY), E_OK);
+	TEST_ASSERT_EQ(Ring_Count(&Ring), 0);
+}
+
+/* Full and empty edges, the dropped count, and the wrap of the 16-bit indices */
+static void Test_Edges(void)
+{
+	Ring_Buffer_t Ring;
+	Test_Element_t Chunk[TEST_CAPACITY + 1UL];
+	uint32_t Round = 0;
+
+	memset(Chunk, 0, sizeof(Chunk));
+	(void)Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY);
+	TEST_ASSERT_EQ(Ring_SPSC_Push(&Ring, Chunk, TEST_CAPACITY + 1UL), TEST_CAPACITY);
+	TEST_ASSERT_EQ(Ring_Get_Dropped(&Ring), 1);
+	TEST_ASSERT_EQ(Ring_Count(&Ring), TEST_CAPACITY);
+	TEST_ASSERT_EQ(Ring_Pop(&Ring, Chunk, TEST_CAPACITY + 1UL), TEST_CAPACITY);
+	TEST_ASSERT_EQ(Ring_Pop(&Ring, Chunk, 1), 0);
+
+	/* The MPSC side pushes all or nothing */
+	(void)Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY);
+	TEST_ASSERT_EQ(Ring_MPSC_Push(&Ring, Chunk, TEST_CAPACITY - 1UL), E_OK);
+	TEST_ASSERT_EQ(Ring_MPSC_Push(&Ring, Chunk, 2), E_NOT_OK);
+	TEST_ASSERT_EQ(Ring_Get_Dropped(&Ring), 2);
+	TEST_ASSERT_EQ(Ring_Count(&Ring), TEST_CAPACITY - 1UL);
+	TEST_ASSERT_EQ(Ring_MPSC_Push(&Ring, Chunk, 1), E_OK);
+	TEST_ASSERT_EQ(Ring_Pop(&Ring, Chunk, TEST_CAPACITY + 1UL), TEST_CAPACITY);
+
+	/* Past 2^16 elements, the MPSC push as large as the ring */
+	(void)Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY);
+	for(Round = 0; Round < 3000UL; Round++)
+	{
+		TEST_ASSERT_EQ(Ring_MPSC_Push(&Ring, Chunk, TEST_CAPACITY - (Round % 3UL)), E_OK);
+		TEST_ASSERT_EQ(Ring_Count(&Ring), TEST_CAPACITY - (Round % 3UL));
+		TEST_ASSERT_EQ(Ring_Pop(&Ring, Chunk, TEST_CAPACITY), TEST_CAPACITY - (Round % 3UL));
+	}
+	TEST_ASSERT_EQ(Ring_Get_Dropped(&Ring), 0);
+}
+
+static void Test_SPSC_Stress(uint32_t Use_Span)
+{
+	Ring_Buffer_t Ring;
+	Test_Producer_t Producer = { &Ring, 0, TEST_SPSC_ELEMENTS, Use_Span, 1UL };
+	pthread_t Thread;
+
+	(void)Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY);
+	TEST_ASSERT_EQ(pthread_create(&Thread, NULL, Test_SPSC_Producer, &Producer), 0);
+	TEST_ASSERT_EQ(Test_Consume(&Ring, TEST_SPSC_ELEMENTS, 1), 0);
+	(void)pthread_join(Thread, NULL);
+	TEST_ASSERT_EQ(Ring_Count(&Ring), 0);
+}
+
+static void Test_MPSC_Stress(void)
+{
+	Ring_Buffer_t Ring;
+	Test_Producer_t Producers[TEST_MPSC_PRODUCERS];
+	pthread_t Threads[TEST_MPSC_PRODUCERS];
+	uint32_t Idx = 0;
+
+	(void)Ring_Init(&Ring, Test_Storage, sizeof(Test_Element_t), TEST_CAPACITY);
+	for(Idx = 0; Idx < TEST_MPSC_PRODUCERS; Idx++)
+	{
+		Producers[Idx].Ring = &Ring;
+		Producers[Idx].Producer = Idx;
+		Producers[Idx].Elements = TEST_MPSC_ELEMENTS;
+		Producers[Idx].Use_Span = 0;
+		Producers[Idx].Random_State = Idx + 1UL;
+		TEST_ASSERT_EQ(pthread_create(&Threads[Idx], NULL, Test_MPSC_Producer, &Producers[Idx]), 0);
+	}
+	TEST_ASSERT_EQ(Test_Consume(&Ring, TEST_MPSC_PRODUCERS * TEST_MPSC_ELEMENTS, TEST_MPSC_PRODUCERS), 0);
+	for(Idx = 0; Idx < TEST_MPSC_PRODUCERS; Idx++)
+		{ (void)pthread_join(Threads[Idx], NULL); }
+	TEST_ASSERT_EQ(Ring_Count(&Ring), 0);
+}
+
+/* Single thread cost of a push and a pop of one word */
+static void Test_Benchmark(void)
+{
+	Ring_Buffer_t Ring;
+	uint32_t Value = 0;
+	uint32_t Idx = 0;
+	double Start = 0;
+	double SPSC_Seconds = 0;
+	double MPSC_Seconds = 0;
+
+	(void)Ring_Init(&Ring, Test_Bench_Storage, sizeof(uint32_t), 1024);
+	Start = Test_Now();
+	for(Idx = 0; Idx < TEST_BENCH_ELEMENTS; Idx++)
+	{
+		(void)Ring_SPSC_Push(&Ring, &Idx, 1);
+		(void)Ring_Pop(&Ring, &Value, 1);
+	}
+	SPSC_Seconds = Test_Now() - Start;
+	TEST_ASSERT_EQ(Value, TEST_BENCH_ELEMENTS - 1UL);
+
+	Start = Test_Now();
+	for(Idx = 0; Idx < TEST_BENCH_ELEMENTS; Idx++)
+	{
+		(void)Ring_MPSC_Push(&Ring, &Idx, 1);
+		(void)Ring_Pop(&Ring, &Value, 1);
+	}
+	MPSC_Seconds = Test_Now() - Start;
+	TEST_ASSERT_EQ(Value, TEST_BENCH_ELEMENTS - 1UL);
+
+	printf("push + pop of one word, one thread (host): SPSC %.1f ns, MPSC %.1f ns\n",
+		   SPSC_Seconds * 1e9 / TEST_BENCH_ELEMENTS, MPSC_Seconds * 1e9 / TEST_BENCH_ELEMENTS);
+}
+
+int main(void)
+{
+	double Start = 0;
+
+	Test_Init();
+	Test_Edges();
+
+	Start = Test_Now();
+	Test_SPSC_Stress(0);
+	Test_SPSC_Stress(1);
+	printf("SPSC stress: 2 x %lu elements through %lu slots, %.1f Melem/s\n", (unsigned long)TEST_SPSC_ELEMENTS,
+		   (unsigned long)TEST_CAPACITY, (2.0 * TEST_SPSC_ELEMENTS) / (Test_Now() - Start) / 1e6);
+	Start = Test_Now();
+	Test_MPSC_Stress();
+	printf("MPSC stress: %lu producers x %lu elements, %.1f Melem/s\n", (unsigned long)TEST_MPSC_PRODUCERS,
+		   (unsigned long)TEST_MPSC_ELEMENTS, ((double)TEST_MPSC_PRODUCERS * TEST_MPSC_ELEMENTS) / (Test_Now() - Start) / 1e6);
+
+	Test_Benchmark();
+	return TEST_REPORT();
+}
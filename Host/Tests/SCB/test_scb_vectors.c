@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ * @file           : test_scb_vectors.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the vector table relocation, install, swap and
+ *					 restore against the register model of Host/Port.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "host_port.h"
+#include "test_common.h"
+/*---------------  Section: Static Global Variables --------------- */
+/* The flash table, VTOR is 32-bit wide so the test links without PIE */
+static Interrupt_Handler_t Test_Flash_Vectors[SCB_VECTORS_NUMBER] __attribute__((aligned(512)));
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Test_Default_Handler(void) { }
+static void Test_Fast_Handler(void) { }
+/*---------------  Section: Tests --------------- */
+static void Test_Swap_Restore(void)
+{
+	SCB_Vector_Save_t Saved;
+	uint32_t Idx = 0;
+
+	Host_Port_Reset();
+	for(Idx = 1; Idx < SCB_VECTORS_NUMBER; Idx++)
+		{ Test_Flash_Vectors[Idx] = Test_Default_Handler; }
+	/* An unused slot of the startup table */
+	Test_Flash_Vectors[USART2_IRQn + 16] = NULL;
+	SCB->VTOR = (uint32_t)(uintptr_t)Test_Flash_Vectors;
+
+	TEST_ASSERT_EQ(SCB_VectorTable_Install(USART1_IRQn, Test_Fast_Handler), E_NOT_OK);
+	TEST_ASSERT_EQ(SCB_VectorTable_Relocate(), E_OK);
+	TEST_ASSERT(SCB->VTOR != (uint32_t)(uintptr_t)Test_Flash_Vectors);
+	TEST_ASSERT(SCB_VectorTable_Get(USART1_IRQn) == Test_Default_Handler);
+	TEST_ASSERT(SCB_VectorTable_Get(USART2_IRQn) == NULL);
+
+	/* Swap and restore of a used slot */
+	TEST_ASSERT_EQ(SCB_VectorTable_Swap(USART1_IRQn, Test_Fast_Handler, &Saved), E_OK);
+	TEST_ASSERT(SCB_VectorTable_Get(USART1_IRQn) == Test_Fast_Handler);
+	TEST_ASSERT_EQ(SCB_VectorTable_Restore(&Saved), E_OK);
+	TEST_ASSERT(SCB_VectorTable_Get(USART1_IRQn) == Test_Default_Handler);
+
+	/* Swap and restore of an empty slot puts NULL back */
+	TEST_ASSERT_EQ(SCB_VectorTable_Swap(USART2_IRQn, Test_Fast_Handler, &Saved), E_OK);
+	TEST_ASSERT(SCB_VectorTable_Get(USART2_IRQn) == Test_Fast_Handler);
+	TEST_ASSERT_EQ(SCB_VectorTable_Restore(&Saved), E_OK);
+	TEST_ASSERT(SCB_VectorTable_Get(USART2_IRQn) == NULL);
+
+	/* Invalid saved slots */
+	TEST_ASSERT_EQ(SCB_VectorTable_Restore(NULL), E_NOT_OK);
+	Saved.IRQn = (int32_t)(SCB_VECTORS_NUMBER - 16UL);
+	TEST_ASSERT_EQ(SCB_VectorTable_Restore(&Saved), E_NOT_OK);
+	Saved.IRQn = -16;
+	TEST_ASSERT_EQ(SCB_VectorTable_Restore(&Saved), E_NOT_OK);
+}
+
+int main(void)
+{
+	Test_Swap_Restore();
+	return TEST_REPORT();
+}
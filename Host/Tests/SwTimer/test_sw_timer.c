@@ -0,0 +1,239 @@
+/**
+ ******************************************************************************
+ * @file           : test_sw_timer.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Expiry tests of the software timers wheel (tickless
+ *					 idle included, on the SysTick model), and the host
+ *					 benchmark of the insert and expire costs at 10, 100
+ *					 and 1000 timers.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#define _POSIX_C_SOURCE 200809L
+#include "Services/SwTimer/sw_timer.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "host_port.h"
+#include "test_common.h"
+#include <time.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_MAX_TIMERS			1000UL
+#define TEST_MAX_TIMEOUT		2000UL
+#define TEST_BENCH_ROUNDS		50UL
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uint32_t Due;
+	uint32_t Period;
+	uint32_t Fired;
+	uint32_t Late;
+	uint32_t Masked;
+} Test_Timer_State_t;
+/*---------------  Section: Static Global Variables --------------- */
+static SwTimer_t Test_Timers[TEST_MAX_TIMERS];
+static Test_Timer_State_t Test_States[TEST_MAX_TIMERS];
+static uint32_t Test_Fired_Total = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+
+static double Test_Now_ns(void)
+{
+	struct timespec Now;
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+	return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+static void Test_Callback(void * Context)
+{
+	Test_Timer_State_t * State = (Test_Timer_State_t *)Context;
+
+	State->Fired++;
+	Test_Fired_Total++;
+	if(SwTimer_Get_Ticks() != State->Due)
+		{ State->Late++; }
+	if(0 != Core_Get_PRIMASK())
+		{ State->Masked++; }
+	State->Due += State->Period;
+}
+
+static void Test_Reset(void)
+{
+	uint32_t Idx = 0;
+
+	Host_Port_Reset();
+	(void)SwTimer_Init();
+	Test_Fired_Total = 0;
+	for(Idx = 0; Idx < TEST_MAX_TIMERS; Idx++)
+	{
+		Test_States[Idx] = (Test_Timer_State_t){ 0 };
+		(void)SwTimer_Create(&Test_Timers[Idx], Test_Callback, &Test_States[Idx]);
+	}
+}
+/*---------------  Section: Tests --------------- */
+
+/* Every timer fires exactly on its tick, one-shot or periodic, across
+ * several wheel revolutions, with interrupts unmasked */
+static void Test_Expiry(void)
+{
+	uint32_t Idx = 0;
+	uint32_t Tick = 0;
+	uint32_t Timeout = 0;
+	uint32_t Late = 0;
+	uint32_t Masked = 0;
+	uint32_t Expected = 0;
+
+	Test_Reset();
+	for(Idx = 0; Idx < TEST_MAX_TIMERS; Idx++)
+	{
+		Timeout = 1UL + (uint32_t)(Test_Random() % TEST_MAX_TIMEOUT);
+		Test_States[Idx].Due = Timeout;
+		Test_States[Idx].Period = (0 == (Idx % 4UL)) ? (1UL + (uint32_t)(Test_Random() % 700UL)) : 0UL;
+		TEST_ASSERT_EQ(SwTimer_Start(&Test_Timers[Idx], Timeout, Test_States[Idx].Period), E_OK);
+	}
+	for(Tick = 0; Tick < (3UL * TEST_MAX_TIMEOUT); Tick++)
+	{
+		SwTimer_Tick();
+		/* The next expiry always matches the earliest due tick */
+		Expected = SW_TIMER_NO_EXPIRY;
+		for(Idx = 0; Idx < TEST_MAX_TIMERS; Idx++)
+		{
+			if(SwTimer_IsActive(&Test_Timers[Idx]) && ((Test_States[Idx].Due - SwTimer_Get_Ticks()) < Expected))
+				{ Expected = Test_States[Idx].Due - SwTimer_Get_Ticks(); }
+		}
+		if(0 == (Tick % 97UL))
+			{ TEST_ASSERT_EQ(SwTimer_Get_Ticks_To_Next_Expiry(), Expected); }
+	}
+	for(Idx = 0; Idx < TEST_MAX_TIMERS; Idx++)
+	{
+		Late += Test_States[Idx].Late;
+		Masked += Test_States[Idx].Masked;
+		if(0 == Test_States[Idx].Period)
+			{ TEST_ASSERT_EQ(Test_States[Idx].Fired, 1); }
+		else
+			{ TEST_ASSERT(Test_States[Idx].Fired >= 3); }
+	}
+	TEST_ASSERT_EQ(Late, 0);
+	TEST_ASSERT_EQ(Masked, 0);
+}
+
+/* The missed ticks of SwTimer_Advance() expire in order, callbacks unmasked */
+static void Test_Advance(void)
+{
+	uint32_t Idx = 0;
+
+	Test_Reset();
+	for(Idx = 0; Idx < 50UL; Idx++)
+	{
+		Test_States[Idx].Due = 1UL + Idx * 7UL;
+		(void)SwTimer_Start(&Test_Timers[Idx], Test_States[Idx].Due, 0);
+	}
+	SwTimer_Advance(200UL);
+	TEST_ASSERT_EQ(Test_Fired_Total, 29);
+	SwTimer_Advance(200UL);
+	TEST_ASSERT_EQ(Test_Fired_Total, 50);
+	for(Idx = 0; Idx < 50UL; Idx++)
+	{
+		/* Collected on the due tick, run after the catch up */
+		TEST_ASSERT_EQ(Test_States[Idx].Masked, 0);
+	}
+	TEST_ASSERT_EQ(SwTimer_Get_Ticks_To_Next_Expiry(), SW_TIMER_NO_EXPIRY);
+}
+
+/* SwTimer_Idle() runs the expired callbacks with interrupts unmasked */
+static void Test_Idle(void)
+{
+	Test_Reset();
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(84000UL, NULL), E_OK);
+	Host_Wfi_Hook = Host_Wfi_Until_SysTick;
+	Test_States[0].Due = 1;
+	(void)SwTimer_Start(&Test_Timers[0], 1, 0);
+	SwTimer_Idle();
+	TEST_ASSERT_EQ(Test_States[0].Fired, 1);
+	TEST_ASSERT_EQ(Test_States[0].Late, 0);
+	TEST_ASSERT_EQ(Test_States[0].Masked, 0);
+	TEST_ASSERT_EQ(Core_Get_PRIMASK(), 0);
+}
+
+/* Tickless SwTimer_Idle(): deadlines many ticks away, every timer fires on
+ * its tick and the wheel stays on the SysTick timebase */
+static void Test_Idle_Tickless(void)
+{
+	const uint32_t Period = 84000UL;
+	uint32_t Idx = 0;
+	uint32_t Iteration = 0;
+	uint32_t Off_Timebase = 0;
+	uint32_t Late = 0;
+	uint32_t Masked = 0;
+
+	Test_Reset();
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(Period, NULL), E_OK);
+	Host_Wfi_Hook = Host_Wfi_Until_SysTick;
+	for(Idx = 0; Idx < 100UL; Idx++)
+	{
+		Test_States[Idx].Due = 1UL + (uint32_t)(Test_Random() % TEST_MAX_TIMEOUT);
+		Test_States[Idx].Period = (0 == (Idx % 10UL)) ? (50UL + (uint32_t)(Test_Random() % 500UL)) : 0UL;
+		(void)SwTimer_Start(&Test_Timers[Idx], Test_States[Idx].Due, Test_States[Idx].Period);
+	}
+	for(Iteration = 0; SysTick_Get_Ticks() < (2UL * TEST_MAX_TIMEOUT); Iteration++)
+	{
+		SwTimer_Idle();
+		if(SwTimer_Get_Ticks() != SysTick_Get_Ticks())
+			{ Off_Timebase++; }
+		/* Some work in thread mode */
+		Host_SysTick_Run(1UL + (Test_Random() % (3UL * Period)));
+	}
+	for(Idx = 0; Idx < 100UL; Idx++)
+	{
+		Late += Test_States[Idx].Late;
+		Masked += Test_States[Idx].Masked;
+		TEST_ASSERT(Test_States[Idx].Fired >= 1);
+	}
+	printf("tickless idle: %lu idle calls for %lu ticks\n", (unsigned long)Iteration, (unsigned long)SysTick_Get_Ticks());
+	TEST_ASSERT(Iteration < (TEST_MAX_TIMEOUT / 2UL));
+	TEST_ASSERT_EQ(Off_Timebase, 0);
+	TEST_ASSERT_EQ(Late, 0);
+	TEST_ASSERT_EQ(Masked, 0);
+}
+
+static void Test_Benchmark(uint32_t Count)
+{
+	uint32_t Round = 0;
+	uint32_t Idx = 0;
+	uint32_t Ticks = 0;
+	double Start = 0;
+	double Insert_ns = 0;
+	double Expire_ns = 0;
+	double Scan_ns = 0;
+
+	for(Round = 0; Round < TEST_BENCH_ROUNDS; Round++)
+	{
+		Test_Reset();
+		Start = Test_Now_ns();
+		for(Idx = 0; Idx < Count; Idx++)
+			{ (void)SwTimer_Start(&Test_Timers[Idx], 1UL + (uint32_t)(Test_Random() % TEST_MAX_TIMEOUT), 0); }
+		Insert_ns += Test_Now_ns() - Start;
+
+		Start = Test_Now_ns();
+		(void)SwTimer_Get_Ticks_To_Next_Expiry();
+		Scan_ns += Test_Now_ns() - Start;
+
+		Start = Test_Now_ns();
+		for(Ticks = 0; Ticks < TEST_MAX_TIMEOUT; Ticks++)
+			{ SwTimer_Tick(); }
+		Expire_ns += Test_Now_ns() - Start;
+		TEST_ASSERT_EQ(Test_Fired_Total, Count);
+	}
+	printf("%4lu timers: insert %6.1f ns/timer, tick+expire %6.1f ns/timer (%5.1f ns/tick), next-expiry scan %7.1f ns\n",
+		   (unsigned long)Count, Insert_ns / (TEST_BENCH_ROUNDS * Count), Expire_ns / (TEST_BENCH_ROUNDS * Count),
+		   Expire_ns / (TEST_BENCH_ROUNDS * TEST_MAX_TIMEOUT), Scan_ns / TEST_BENCH_ROUNDS);
+}
+
+int main(void)
+{
+	Test_Expiry();
+	Test_Advance();
+	Test_Idle();
+	Test_Idle_Tickless();
+	Test_Benchmark(10UL);
+	Test_Benchmark(100UL);
+	Test_Benchmark(1000UL);
+	return TEST_REPORT();
+}
@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file           : test_systick_rescale.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the SysTick timebase across HCLK changes, against
+ *					 the SysTick model of Host/Port: random switches in the
+ *					 middle of a period, some with the wrap pending. The cycle
+ *					 count must stay exact, the microseconds follow the real
+ *					 time and the ticks stay on the 1 ms grid.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/SysTick/SysTick.h"
+#include "MCAL/RCC/rcc.h"
+#include "host_port.h"
+#include "test_common.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_RESCALES_NUMBER		500UL
+#define TEST_TICK_US				1000UL
+/*---------------  Section: Static Global Variables --------------- */
+static const uint32_t Test_HCLKs[] = { 84000000UL, 16000000UL, 48000000UL, 25000000UL, 64000000UL, 42000000UL };
+/* Real time at the last switch in ns, and the model time then */
+static double Test_Real_Base = 0;
+static uint64_t Test_Host_Base = 0;
+static uint64_t Test_Hook_Ticks = 0;
+static double Test_Worst_Tick_Error = 0;
+static uint32_t Test_Rescales = 0;
+static uint32_t Test_In_Critical = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+static double Test_Real_Now(void)
+{
+	return Test_Real_Base + (((double)(Host_Time - Test_Host_Base) * 1e9) / (double)SysTick_Get_InputClock());
+}
+
+/* Each tick ends a whole number of periods: 1 ms each, in real time */
+static void Test_Tick_Hook(void)
+{
+	double Error = 0;
+
+	Test_Hook_Ticks++;
+	if(0UL == Test_In_Critical)
+	{
+		Error = Test_Real_Now() - ((double)Test_Hook_Ticks * TEST_TICK_US * 1000.0);
+		Error = (Error < 0) ? -Error : Error;
+		if(Error > Test_Worst_Tick_Error)
+			{ Test_Worst_Tick_Error = Error; }
+	}
+}
+
+static void Test_Check_Counts(uint64_t * Last_Cycles)
+{
+	uint64_t Cycles = SysTick_Get_Cycles();
+	double Real_Us = Test_Real_Now() / 1000.0;
+	double Micros = (double)SysTick_Get_Micros();
+
+	TEST_ASSERT(Cycles >= *Last_Cycles);
+	TEST_ASSERT_EQ(Cycles, Host_Time);
+	/* Truncated to the us, each switch truncates less than 1 ns more */
+	TEST_ASSERT((Micros <= (Real_Us + 1e-6)) && (Micros > (Real_Us - 1.0 - ((double)Test_Rescales * 1e-3))));
+	TEST_ASSERT_EQ(SysTick_Get_Ticks(), Test_Hook_Ticks);
+	*Last_Cycles = Cycles;
+}
+
+/* HCLK switch at the current model time, with the wrap left pending if asked */
+static void Test_Switch(uint32_t New_HCLK, uint32_t Wrap_Pending)
+{
+	uint32_t Old_HCLK = RCC_Clock_Freqs_Cache.HCLK;
+	uint32_t Irq_State = 0;
+
+	Test_In_Critical = 1;
+	Irq_State = Core_Enter_Critical();
+	if(Wrap_Pending)
+		{ Host_SysTick_Run(Host_SysTick_Cycles_To_Wrap()); }
+	Test_Real_Base = Test_Real_Now();
+	Test_Host_Base = Host_Time;
+	RCC_Clock_Freqs_Cache.HCLK = New_HCLK;
+	TEST_ASSERT_EQ(SysTick_Rescale(Old_HCLK, New_HCLK), E_OK);
+	Test_Rescales++;
+	Core_Exit_Critical(Irq_State);
+	Test_In_Critical = 0;
+}
+/*---------------  Section: Tests --------------- */
+static void Test_Random_Switches(void)
+{
+	uint64_t Last_Cycles = 0;
+	uint32_t Iteration = 0;
+	uint32_t Period = 0;
+	uint32_t Steps = 0;
+
+	Host_Port_Reset();
+	RCC_Clock_Freqs_Cache.HCLK = Test_HCLKs[0];
+	TEST_ASSERT_EQ(SysTick_Register_TickHook(Test_Tick_Hook), E_OK);
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(SysTick_Micros_To_Ticks(TEST_TICK_US), NULL), E_OK);
+
+	for(Iteration = 0; Iteration < TEST_RESCALES_NUMBER; Iteration++)
+	{
+		/* Some work at this clock, then a switch anywhere in a period */
+		Period = SysTick_Micros_To_Ticks(TEST_TICK_US);
+		for(Steps = Test_Random() % 4UL; Steps > 0; Steps--)
+		{
+			Host_SysTick_Run(1UL + (Test_Random() % (2UL * Period)));
+			Test_Check_Counts(&Last_Cycles);
+		}
+		Test_Switch(Test_HCLKs[Test_Random() % (sizeof(Test_HCLKs) / sizeof(Test_HCLKs[0]))],
+					(0UL == (Test_Random() % 4UL)) ? 1UL : 0UL);
+		Test_Check_Counts(&Last_Cycles);
+	}
+	Host_SysTick_Run(10UL * SysTick_Micros_To_Ticks(TEST_TICK_US));
+	Test_Check_Counts(&Last_Cycles);
+
+	printf("%lu switches over %lu ticks: worst tick error %.0f ns, micros %.3f us behind\n", (unsigned long)Test_Rescales,
+		   (unsigned long)Test_Hook_Ticks, Test_Worst_Tick_Error,
+		   (Test_Real_Now() / 1000.0) - (double)SysTick_Get_Micros());
+	/* The time left in a period is rounded to half a clock of the slowest input (2 MHz) */
+	TEST_ASSERT(Test_Worst_Tick_Error <= ((double)Test_Rescales * 250.0));
+	TEST_ASSERT(Test_Hook_Ticks > TEST_RESCALES_NUMBER);
+}
+
+/* A period that does not fit 24 bits at the new clock keeps the old one */
+static void Test_Rejects(void)
+{
+	Host_Port_Reset();
+	RCC_Clock_Freqs_Cache.HCLK = 16000000UL;
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(SYSTICK_MAX_RELOAD + 1UL, NULL), E_OK);
+	TEST_ASSERT_EQ(SysTick_Rescale(16000000UL, 84000000UL), E_NOT_OK);
+	TEST_ASSERT_EQ(SysTick->RVR, SYSTICK_MAX_RELOAD);
+	TEST_ASSERT_EQ(SysTick_Rescale(0, 84000000UL), E_NOT_OK);
+	TEST_ASSERT_EQ(SysTick_Rescale(84000000UL, 0), E_NOT_OK);
+}
+
+int main(void)
+{
+	Test_Random_Switches();
+	Test_Rejects();
+	return TEST_REPORT();
+}
@@ -0,0 +1,163 @@
+/**
+ ******************************************************************************
+ * @file           : test_systick_tickless.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Deadline and drift tests of the SysTick tickless sleep,
+ *					 against the SysTick model of Host/Port. Random deadline
+ *					 sequences, early wake-ups by other interrupts and random
+ *					 work in between: the timebase must match the model time
+ *					 to the cycle after every sleep.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/SysTick/SysTick.h"
+#include "host_port.h"
+#include "test_common.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_SEQUENCE_LENGTH		3000UL
+/*---------------  Section: Static Global Variables --------------- */
+static uint64_t Test_Caller_Ticks = 0;
+static uint64_t Test_Other_Ticks = 0;
+static uint32_t Test_Wake_Early_Percent = 0;
+static uint32_t Test_Early_Wakes = 0;
+static uint32_t Test_Other_Irqs = 0;
+static uint64_t Test_Wake_Time = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+
+/* Tick hook of the sleeping service, it catches up with the returned count */
+static void Test_Caller_Hook(void)
+{
+	Test_Caller_Ticks++;
+}
+
+/* Another tick consumer, e.g. the dispatcher */
+static void Test_Other_Hook(void)
+{
+	Test_Other_Ticks++;
+}
+
+static void Test_Other_Irq(void)
+{
+	Test_Other_Irqs++;
+}
+
+/* WFI: sleeps to the programmed wrap, or is woken before by another interrupt */
+static void Test_Wfi(void)
+{
+	uint32_t To_Wrap = Host_SysTick_Cycles_To_Wrap();
+
+	if((To_Wrap > 1UL) && ((Test_Random() % 100UL) < Test_Wake_Early_Percent))
+	{
+		Host_SysTick_Run(1UL + (Test_Random() % (To_Wrap - 1UL)));
+		Host_Pend_Irq(Test_Other_Irq, 0UL);
+		Test_Early_Wakes++;
+	}
+	else
+	{
+		Host_SysTick_Run(To_Wrap);
+	}
+	Test_Wake_Time = Host_Time;
+}
+
+static void Test_Start(uint32_t Period)
+{
+	Host_Port_Reset();
+	Host_Wfi_Hook = Test_Wfi;
+	Test_Caller_Ticks = 0;
+	Test_Other_Ticks = 0;
+	Test_Early_Wakes = 0;
+	Test_Other_Irqs = 0;
+	TEST_ASSERT_EQ(SysTick_Timebase_Start(Period, NULL), E_OK);
+}
+/*---------------  Section: Tests --------------- */
+
+/* Random deadline sequences: every uninterrupted sleep ends on its deadline
+ * tick, and the ticks and cycles never drift from the model time */
+static void Test_Drift(uint32_t Period, uint32_t Max_Idle_Ticks, uint32_t Wake_Early_Percent)
+{
+	uint32_t Iteration = 0;
+	uint32_t Idle_Ticks = 0;
+	uint32_t Irq_State = 0;
+	uint32_t Early_Before = 0;
+	uint64_t Start_Tick = 0;
+	uint64_t Start_Time = 0;
+	uint32_t Deadlines = 0;
+	uint32_t Deadline_Misses = 0;
+	uint32_t Drifts = 0;
+	uint64_t Silent_Total = 0;
+	uint32_t Silent_Ticks = 0;
+
+	Test_Start(Period);
+	Test_Wake_Early_Percent = Wake_Early_Percent;
+	for(Iteration = 0; Iteration < TEST_SEQUENCE_LENGTH; Iteration++)
+	{
+		Idle_Ticks = (uint32_t)(Test_Random() % Max_Idle_Ticks);
+		Start_Time = Host_Time;
+		Start_Tick = Start_Time / Period;
+		Early_Before = Test_Early_Wakes;
+
+		Irq_State = Core_Enter_Critical();
+		Silent_Ticks = SysTick_Tickless_Sleep(Idle_Ticks, Test_Caller_Hook);
+		Test_Caller_Ticks += Silent_Ticks;
+		Silent_Total += Silent_Ticks;
+		if((Idle_Ticks >= 2UL) && (Early_Before == Test_Early_Wakes) && (0 != (Start_Time % Period)))
+		{
+			Deadlines++;
+			if(Test_Wake_Time != ((Start_Tick + Idle_Ticks) * Period))
+				{ Deadline_Misses++; }
+		}
+		Core_Exit_Critical(Irq_State);
+
+		/* After the sleep and after some work in thread mode */
+		if((SysTick_Get_Ticks() != (Host_Time / Period)) || (Test_Caller_Ticks != (Host_Time / Period)) ||
+		   (SysTick_Get_Cycles() != Host_Time))
+			{ Drifts++; }
+		Host_SysTick_Run(1UL + (Test_Random() % (2UL * Period)));
+		if((SysTick_Get_Ticks() != (Host_Time / Period)) || (Test_Caller_Ticks != (Host_Time / Period)) ||
+		   (SysTick_Get_Cycles() != Host_Time))
+			{ Drifts++; }
+	}
+	printf("period %8lu: %4lu deadlines hit of %4lu, %4lu early wakes, %7lu silent ticks, %lu drifts\n",
+		   (unsigned long)Period, (unsigned long)(Deadlines - Deadline_Misses), (unsigned long)Deadlines,
+		   (unsigned long)Test_Early_Wakes, (unsigned long)Silent_Total, (unsigned long)Drifts);
+	TEST_ASSERT_EQ(Deadline_Misses, 0);
+	TEST_ASSERT_EQ(Drifts, 0);
+	TEST_ASSERT(Silent_Total > 0);
+	TEST_ASSERT_EQ(Test_Other_Irqs, Test_Early_Wakes);
+}
+
+/* With another tick consumer the sleep is a plain WFI, nobody misses a tick */
+static void Test_Other_Consumer(void)
+{
+	const uint32_t Period = 84000UL;
+	uint32_t Irq_State = 0;
+	uint64_t Next_Tick_Time = 0;
+
+	Test_Start(Period);
+	Test_Wake_Early_Percent = 0;
+	TEST_ASSERT_EQ(SysTick_Register_TickHook(Test_Other_Hook), E_OK);
+	Host_SysTick_Run(Period / 3UL);
+	Next_Tick_Time = ((Host_Time / Period) + 1UL) * Period;
+
+	Irq_State = Core_Enter_Critical();
+	TEST_ASSERT_EQ(SysTick_Tickless_Sleep(100, Test_Caller_Hook), 0);
+	TEST_ASSERT_EQ(Test_Wake_Time, Next_Tick_Time);
+	Core_Exit_Critical(Irq_State);
+	TEST_ASSERT_EQ(Test_Other_Ticks, Host_Time / Period);
+	TEST_ASSERT_EQ(Test_Caller_Ticks, Host_Time / Period);
+}
+
+int main(void)
+{
+	TEST_ASSERT_EQ(SysTick_Register_TickHook(Test_Caller_Hook), E_OK);
+	/* One 24-bit reload covers the deadline */
+	Test_Drift(1000UL, 1500UL, 0);
+	Test_Drift(1000UL, 1500UL, 30);
+	/* Chained reloads, about 200 ticks each */
+	Test_Drift(84000UL, 1500UL, 0);
+	Test_Drift(84000UL, 1500UL, 30);
+	/* Longest period, every tick is a chained reload */
+	Test_Drift(SYSTICK_MAX_RELOAD + 1UL, 20UL, 30);
+	Test_Other_Consumer();
+	return TEST_REPORT();
+}
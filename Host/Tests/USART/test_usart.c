@@ -0,0 +1,564 @@
+/**
+ ******************************************************************************
+ * @file           : test_usart.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Tests of the USART driver against a register model: the
+ *					 baud rate divider decoded as the reference manual does,
+ *					 the frame format and DMA wiring, circular reception by a
+ *					 model DMA with its half / full buffer and IDLE interrupts,
+ *					 scatter list transmission, the error counters and the
+ *					 clock references shared by the streams of a controller.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "MCAL/USART/usart.h"
+#include "MCAL/DMA/dma.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "host_port.h"
+#include "test_common.h"
+#include <string.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define TEST_RX_SIZE				64U
+#define TEST_RX_BURSTS_NUMBER		3000UL
+#define TEST_RX_STREAM_SIZE			200000UL
+#define TEST_TX_LISTS_NUMBER		2000UL
+#define TEST_TX_MAX_SEGMENTS		6UL
+#define TEST_TX_WIRE_SIZE			(TEST_TX_LISTS_NUMBER * TEST_TX_MAX_SEGMENTS * 40UL)
+#define TEST_SR_PE_POS				0UL
+#define TEST_SR_FE_POS				1UL
+#define TEST_SR_NF_POS				2UL
+#define TEST_SR_ORE_POS				3UL
+#define TEST_SR_IDLE_POS			4UL
+#define TEST_SR_TC_POS				6UL
+#define TEST_CR1_OVER8_POS			15UL
+/* UE, M, PCE, PS, PEIE, TE, RE, IDLEIE */
+#define TEST_CR1_FRAME_MASK			((1UL << 13) | (1UL << 12) | (1UL << 10) | (1UL << 9) | (1UL << 8) | \
+									 (1UL << 3) | (1UL << 2) | (1UL << 4))
+/* --------------- Section: Data Type Declarations --------------- */
+/* The fixed wiring of a USART, seen from the test */
+typedef struct
+{
+	USART_Registers_t * Regs;
+	DMA_Registers_t * Dma;
+	uint8_t Rx_Stream;
+	uint8_t Tx_Stream;
+	uint32_t Channel;
+	IRQn_t Irq;
+	IRQn_t Rx_Irq;
+	IRQn_t Tx_Irq;
+	RCC_Periph_Clock_t Clock;
+	RCC_Periph_Clock_t Dma_Clock;
+	Interrupt_Handler_t Usart_Vector;
+	Interrupt_Handler_t Rx_Vector;
+	Interrupt_Handler_t Tx_Vector;
+} Test_Hw_t;
+/*---------------  Section: Static Global Variables --------------- */
+extern void USART1_IRQHandler(void);
+extern void USART2_IRQHandler(void);
+extern void USART6_IRQHandler(void);
+extern void DMA1_Stream5_IRQHandler(void);
+extern void DMA1_Stream6_IRQHandler(void);
+extern void DMA2_Stream1_IRQHandler(void);
+extern void DMA2_Stream2_IRQHandler(void);
+extern void DMA2_Stream6_IRQHandler(void);
+extern void DMA2_Stream7_IRQHandler(void);
+
+static const Test_Hw_t Test_Hw[USART_COUNT] =
+{
+	[USART_1] = { USART1, DMA2, 2, 7, 4, USART1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream7_IRQn, RCC_PERIPH_USART1,
+				  RCC_PERIPH_DMA2, USART1_IRQHandler, DMA2_Stream2_IRQHandler, DMA2_Stream7_IRQHandler },
+	[USART_2] = { USART2, DMA1, 5, 6, 4, USART2_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, RCC_PERIPH_USART2,
+				  RCC_PERIPH_DMA1, USART2_IRQHandler, DMA1_Stream5_IRQHandler, DMA1_Stream6_IRQHandler },
+	[USART_6] = { USART6, DMA2, 1, 6, 5, USART6_IRQn, DMA2_Stream1_IRQn, DMA2_Stream6_IRQn, RCC_PERIPH_USART6,
+				  RCC_PERIPH_DMA2, USART6_IRQHandler, DMA2_Stream1_IRQHandler, DMA2_Stream6_IRQHandler }
+};
+static const uint32_t Test_Bauds[] =
+{
+	1200UL, 2400UL, 9600UL, 19200UL, 38400UL, 57600UL, 115200UL, 230400UL, 460800UL, 921600UL,
+	1000000UL, 2000000UL, 3000000UL, 4000000UL, 5250000UL, 6000000UL, 10500000UL, 12000000UL
+};
+static const uint32_t Test_Pclks[] = { 8000000UL, 16000000UL, 21000000UL, 25000000UL, 42000000UL, 84000000UL };
+/* The DMA buffers are handed over as 32-bit addresses: static, below 4 GB without PIE */
+static uint8_t Test_Rx_Buffer[TEST_RX_SIZE];
+static uint8_t Test_Sent[TEST_RX_STREAM_SIZE];
+static uint8_t Test_Received[TEST_RX_STREAM_SIZE];
+static uint32_t Test_Received_Count = 0;
+static uint32_t Test_Rx_Calls = 0;
+static uint8_t Test_Tx_Data[TEST_TX_MAX_SEGMENTS * USART_TX_QUEUE_DEPTH][40];
+static USART_Tx_Segment_t Test_Segments[USART_TX_QUEUE_DEPTH][TEST_TX_MAX_SEGMENTS];
+static uint8_t Test_Expected[TEST_TX_WIRE_SIZE];
+static uint8_t Test_Wire[TEST_TX_WIRE_SIZE];
+static uint32_t Test_Expected_Count = 0;
+static uint32_t Test_Wire_Count = 0;
+static uint32_t Test_Done_Calls = 0;
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Test_Rx_Handler(const uint8_t * Data, uint32_t Length)
+{
+	TEST_ASSERT((Data >= Test_Rx_Buffer) && ((Data + Length) <= (Test_Rx_Buffer + TEST_RX_SIZE)));
+	TEST_ASSERT(Length > 0);
+	if((Test_Received_Count + Length) <= TEST_RX_STREAM_SIZE)
+		{ memcpy(&Test_Received[Test_Received_Count], Data, Length); }
+	Test_Received_Count += Length;
+	Test_Rx_Calls++;
+}
+
+static void Test_Tx_Done(void)
+{
+	Test_Done_Calls++;
+}
+
+static USART_Config_t Test_Config(USART_Id_t Id, uint32_t Baud_Rate)
+{
+	USART_Config_t Config;
+
+	memset(&Config, 0, sizeof(Config));
+	Config.Id = Id;
+	Config.Baud_Rate = Baud_Rate;
+	Config.Parity = USART_PARITY_NONE;
+	Config.Stop_Bits = USART_STOP_BITS_1;
+	Config.Rx_Buffer = Test_Rx_Buffer;
+	Config.Rx_Buffer_Size = TEST_RX_SIZE;
+	Config.Rx_Handler = Test_Rx_Handler;
+	return Config;
+}
+
+/* Clean registers with the transmitter idle (TC set), at the given PCLKs */
+static void Test_Start(uint32_t Pclk1, uint32_t Pclk2)
+{
+	uint32_t Id = 0;
+
+	Host_Port_Reset();
+	RCC_Clock_Freqs_Cache.PCLK1 = Pclk1;
+	RCC_Clock_Freqs_Cache.PCLK2 = Pclk2;
+	for(Id = 0; Id < USART_COUNT; Id++)
+		{ Test_Hw[Id].Regs->SR = (1UL << TEST_SR_TC_POS); }
+	Test_Received_Count = 0;
+	Test_Rx_Calls = 0;
+}
+
+/* The divider the USART runs at, decoded from BRR and OVER8 as in RM0368 */
+static uint32_t Test_Decode_Divider(const USART_Registers_t * Regs)
+{
+	uint32_t Divider = Regs->BRR;
+
+	if(READ_BIT(Regs->CR1, TEST_CR1_OVER8_POS))
+	{
+		/* DIV_Fraction[3] must be kept cleared with 8x oversampling */
+		TEST_ASSERT_EQ(READ_BIT(Regs->BRR, 3), 0);
+		Divider = ((Regs->BRR >> 4) << 3) | (Regs->BRR & 7UL);
+	}
+	return Divider;
+}
+
+/* The model DMA receives one byte: NDTR counts down, the half and full
+ * buffer interrupts are taken as the stream raises them */
+static void Test_Rx_Byte(USART_Id_t Id, uint8_t Byte)
+{
+	volatile DMA_Stream_Registers_t * Stream = &Test_Hw[Id].Dma->Streams[Test_Hw[Id].Rx_Stream];
+	uint32_t Position = TEST_RX_SIZE - Stream->NDTR;
+
+	Test_Rx_Buffer[Position] = Byte;
+	Stream->NDTR--;
+	if(0 == Stream->NDTR)
+	{
+		Stream->NDTR = TEST_RX_SIZE;
+		Test_Hw[Id].Rx_Vector();
+	}
+	else if((TEST_RX_SIZE / 2U) == Stream->NDTR)
+	{
+		Test_Hw[Id].Rx_Vector();
+	}
+}
+
+/* The status bits read by the USART interrupt, cleared afterwards like the SR then DR read does */
+static void Test_Usart_Event(USART_Id_t Id, uint32_t Status)
+{
+	Test_Hw[Id].Regs->SR |= Status;
+	Test_Hw[Id].Usart_Vector();
+	Test_Hw[Id].Regs->SR &= ~0x1FUL;
+}
+
+/* The model DMA sends every segment the driver starts, one interrupt each */
+static void Test_Tx_Run(USART_Id_t Id)
+{
+	volatile DMA_Stream_Registers_t * Stream = &Test_Hw[Id].Dma->Streams[Test_Hw[Id].Tx_Stream];
+	const uint8_t * Data = NULL;
+
+	while(READ_BIT(Stream->CR, 0))
+	{
+		Data = (const uint8_t *)Stream->M0AR;
+		TEST_ASSERT(Stream->NDTR > 0);
+		if((Test_Wire_Count + Stream->NDTR) <= TEST_TX_WIRE_SIZE)
+			{ memcpy(&Test_Wire[Test_Wire_Count], Data, Stream->NDTR); }
+		Test_Wire_Count += Stream->NDTR;
+		Stream->NDTR = 0;
+		CLEAR_BIT(Stream->CR, 0);
+		Test_Hw[Id].Tx_Vector();
+	}
+}
+/*---------------  Section: Tests --------------- */
+
+/* Every USART at every PCLK and baud rate: the decoded divider is the nearest
+ * one, 16x oversampling while it fits, and the unreachable rates are refused
+ * with nothing left clocked */
+static void Test_Baud_Rates(void)
+{
+	USART_Config_t Config;
+	USART_Stats_t Stats;
+	uint32_t Id = 0;
+	uint32_t Pclk_Idx = 0;
+	uint32_t Baud_Idx = 0;
+	uint32_t Pclk = 0;
+	uint32_t Baud = 0;
+	uint32_t Divider = 0;
+	uint32_t Achieved = 0;
+	uint32_t Permille = 0;
+	Std_ReturnType_t Ret = E_NOT_OK;
+
+	for(Id = 0; Id < USART_COUNT; Id++)
+	{
+		for(Pclk_Idx = 0; Pclk_Idx < (sizeof(Test_Pclks) / sizeof(Test_Pclks[0])); Pclk_Idx++)
+		{
+			for(Baud_Idx = 0; Baud_Idx < (sizeof(Test_Bauds) / sizeof(Test_Bauds[0])) + 20UL; Baud_Idx++)
+			{
+				Pclk = Test_Pclks[Pclk_Idx];
+				Baud = (Baud_Idx < (sizeof(Test_Bauds) / sizeof(Test_Bauds[0]))) ? Test_Bauds[Baud_Idx] :
+					   (1000UL + (Test_Random() % 12000000UL));
+				Test_Start(Pclk, Pclk);
+				Config = Test_Config((USART_Id_t)Id, Baud);
+				Ret = USART_Init(&Config);
+
+				Divider = (Pclk + (Baud / 2UL)) / Baud;
+				if((Divider < 8UL) || (Divider > 0xFFFFUL))
+				{
+					TEST_ASSERT_EQ(Ret, E_NOT_OK);
+					TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Test_Hw[Id].Clock), 0);
+					TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Test_Hw[Id].Dma_Clock), 0);
+					TEST_ASSERT_EQ(USART_DeInit((USART_Id_t)Id), E_NOT_OK);
+					continue;
+				}
+				TEST_ASSERT_EQ(Ret, E_OK);
+				TEST_ASSERT_EQ(Test_Decode_Divider(Test_Hw[Id].Regs), Divider);
+				TEST_ASSERT_EQ(READ_BIT(Test_Hw[Id].Regs->CR1, TEST_CR1_OVER8_POS) ? 1UL : 0UL, (Divider < 16UL) ? 1UL : 0UL);
+				/* Nearest divider: within half a step of the exact one */
+				TEST_ASSERT((((uint64_t)Divider * Baud) > Pclk ? (((uint64_t)Divider * Baud) - Pclk) :
+							 (Pclk - ((uint64_t)Divider * Baud))) <= (Baud / 2UL));
+				Achieved = Pclk / Divider;
+				Permille = (uint32_t)((((Achieved > Baud) ? (Achieved - Baud) : (Baud - Achieved)) * 1000ULL) / Baud);
+				TEST_ASSERT_EQ(USART_Get_Stats((USART_Id_t)Id, &Stats), E_OK);
+				TEST_ASSERT((Stats.Baud_Error_Permille <= (Permille + 1UL)) && ((Stats.Baud_Error_Permille + 1UL) >= Permille));
+				TEST_ASSERT_EQ(USART_DeInit((USART_Id_t)Id), E_OK);
+			}
+		}
+	}
+	/* A crystal friendly rate is exact */
+	Test_Start(16000000UL, 16000000UL);
+	Config = Test_Config(USART_2, 500000UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_2, &Stats), E_OK);
+	TEST_ASSERT_EQ(Stats.Baud_Error_Permille, 0);
+	TEST_ASSERT_EQ(USART_DeInit(USART_2), E_OK);
+}
+
+/* Frame format, DMA streams, interrupts and clocks after Init, all released by DeInit */
+static void Test_Init_Registers(void)
+{
+	USART_Config_t Config;
+	volatile DMA_Stream_Registers_t * Rx = NULL;
+	volatile DMA_Stream_Registers_t * Tx = NULL;
+	const Test_Hw_t * Hw = NULL;
+	uint32_t Id = 0;
+	uint32_t Parity = 0;
+	uint32_t Expected_Cr1 = 0;
+
+	for(Id = 0; Id < USART_COUNT; Id++)
+	{
+		for(Parity = USART_PARITY_NONE; Parity <= USART_PARITY_ODD; Parity++)
+		{
+			Hw = &Test_Hw[Id];
+			Rx = &Hw->Dma->Streams[Hw->Rx_Stream];
+			Tx = &Hw->Dma->Streams[Hw->Tx_Stream];
+			Test_Start(42000000UL, 84000000UL);
+			Config = Test_Config((USART_Id_t)Id, 115200UL);
+			Config.Parity = (USART_Parity_t)Parity;
+			Config.Stop_Bits = (USART_PARITY_ODD == Parity) ? USART_STOP_BITS_2 : USART_STOP_BITS_1;
+			TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+
+			/* Frame, 8 data bits plus the parity bit when used */
+			Expected_Cr1 = (1UL << 13) | (1UL << 3) | (1UL << 2) | (1UL << 4);
+			if(USART_PARITY_NONE != Parity)
+				{ Expected_Cr1 |= (1UL << 12) | (1UL << 10) | (1UL << 8); }
+			if(USART_PARITY_ODD == Parity)
+				{ Expected_Cr1 |= (1UL << 9); }
+			TEST_ASSERT_EQ(Hw->Regs->CR1 & TEST_CR1_FRAME_MASK, Expected_Cr1);
+			TEST_ASSERT_EQ(Hw->Regs->CR2, (uint32_t)Config.Stop_Bits << 12);
+			/* DMAT, DMAR, EIE */
+			TEST_ASSERT_EQ(Hw->Regs->CR3, (1UL << 7) | (1UL << 6) | (1UL << 0));
+
+			/* Reception: circular, peripheral to memory, half and full buffer interrupts, running */
+			TEST_ASSERT_EQ(Rx->PAR, (uint32_t)&Hw->Regs->DR);
+			TEST_ASSERT_EQ(Rx->M0AR, (uint32_t)Test_Rx_Buffer);
+			TEST_ASSERT_EQ(Rx->NDTR, TEST_RX_SIZE);
+			TEST_ASSERT_EQ((Rx->CR >> 25) & 7UL, Hw->Channel);
+			TEST_ASSERT_EQ((Rx->CR >> 6) & 3UL, DMA_PREPH_TO_MEMORY);
+			TEST_ASSERT(READ_BIT(Rx->CR, 8) && READ_BIT(Rx->CR, 10) && READ_BIT(Rx->CR, 3) && READ_BIT(Rx->CR, 4));
+			TEST_ASSERT(READ_BIT(Rx->CR, 0));
+			/* Transmission: memory to peripheral, stopped until the first segment */
+			TEST_ASSERT_EQ(Tx->PAR, (uint32_t)&Hw->Regs->DR);
+			TEST_ASSERT_EQ((Tx->CR >> 25) & 7UL, Hw->Channel);
+			TEST_ASSERT_EQ((Tx->CR >> 6) & 3UL, DMA_MEMORY_TO_PREPH);
+			TEST_ASSERT_EQ(READ_BIT(Tx->CR, 8), 0);
+			TEST_ASSERT_EQ(READ_BIT(Tx->CR, 0), 0);
+
+			/* One priority for the three, ISER keeps the last write only: the TX stream is enabled last */
+			TEST_ASSERT_EQ(NVIC_GetPriority(Hw->Irq), USART_IRQ_PRIORITY);
+			TEST_ASSERT_EQ(NVIC_GetPriority(Hw->Rx_Irq), USART_IRQ_PRIORITY);
+			TEST_ASSERT_EQ(NVIC_GetPriority(Hw->Tx_Irq), USART_IRQ_PRIORITY);
+			TEST_ASSERT(READ_BIT(NVIC->ISER[(uint32_t)Hw->Tx_Irq >> 5], (uint32_t)Hw->Tx_Irq & 31UL));
+			TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Hw->Clock), 1);
+			TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Hw->Dma_Clock), 1);
+			/* Initialized once only */
+			TEST_ASSERT_EQ(USART_Init(&Config), E_NOT_OK);
+
+			TEST_ASSERT_EQ(USART_DeInit((USART_Id_t)Id), E_OK);
+			TEST_ASSERT_EQ(Hw->Regs->CR1, 0);
+			TEST_ASSERT_EQ(Rx->CR, DMA_SxCR_RESET_VALUE);
+			TEST_ASSERT_EQ(Tx->CR, DMA_SxCR_RESET_VALUE);
+			TEST_ASSERT(READ_BIT(NVIC->ICER[(uint32_t)Hw->Tx_Irq >> 5], (uint32_t)Hw->Tx_Irq & 31UL));
+			TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Hw->Clock), 0);
+			TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(Hw->Dma_Clock), 0);
+		}
+	}
+
+	/* Bad configurations */
+	Config = Test_Config(USART_COUNT, 115200UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_NOT_OK);
+	Config = Test_Config(USART_2, 0);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_NOT_OK);
+	Config = Test_Config(USART_2, 115200UL);
+	Config.Rx_Handler = NULL;
+	TEST_ASSERT_EQ(USART_Init(&Config), E_NOT_OK);
+	Config = Test_Config(USART_2, 115200UL);
+	Config.Stop_Bits = (USART_Stop_Bits_t)1;
+	TEST_ASSERT_EQ(USART_Init(&Config), E_NOT_OK);
+	TEST_ASSERT_EQ(USART_Init(NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(RCC_PERIPH_USART2), 0);
+}
+
+/* USART1 and USART6 share DMA2: one clock reference until the last stream goes */
+static void Test_Shared_Dma_Clock(void)
+{
+	USART_Config_t Config;
+
+	Test_Start(42000000UL, 84000000UL);
+	Config = Test_Config(USART_1, 115200UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	Config = Test_Config(USART_6, 115200UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(RCC_PERIPH_DMA2), 1);
+	TEST_ASSERT_EQ(USART_DeInit(USART_1), E_OK);
+	TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(RCC_PERIPH_DMA2), 1);
+	TEST_ASSERT(READ_BIT(Test_Hw[USART_6].Dma->Streams[Test_Hw[USART_6].Rx_Stream].CR, 0));
+	TEST_ASSERT_EQ(USART_DeInit(USART_6), E_OK);
+	TEST_ASSERT_EQ(RCC_Periph_Clock_Get_Users(RCC_PERIPH_DMA2), 0);
+	TEST_ASSERT_EQ(USART_DeInit(USART_6), E_NOT_OK);
+}
+
+/* Random bursts through the circular buffer, most ended by an IDLE line:
+ * every byte is delivered once and in order, each IDLE with data is a frame */
+static void Test_Rx_Stream(void)
+{
+	USART_Config_t Config;
+	USART_Stats_t Stats;
+	uint32_t Burst = 0;
+	uint32_t Length = 0;
+	uint32_t Sent = 0;
+	uint32_t Frames = 0;
+
+	Test_Start(42000000UL, 84000000UL);
+	Config = Test_Config(USART_2, 921600UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+
+	for(Burst = 0; (Burst < TEST_RX_BURSTS_NUMBER) && (Sent < (TEST_RX_STREAM_SIZE - (3U * TEST_RX_SIZE))); Burst++)
+	{
+		/* Up to three buffers long, the half / full interrupts drain it in time */
+		for(Length = 1UL + (Test_Random() % (3UL * TEST_RX_SIZE)); Length > 0; Length--)
+		{
+			Test_Sent[Sent] = (uint8_t)Test_Random();
+			Test_Rx_Byte(USART_2, Test_Sent[Sent]);
+			Sent++;
+		}
+		if(0 != (Test_Random() % 4UL))
+		{
+			/* A burst ending on the half / full interrupt is delivered already, its IDLE is empty */
+			Frames += (Test_Received_Count < Sent) ? 1UL : 0UL;
+			Test_Usart_Event(USART_2, 1UL << TEST_SR_IDLE_POS);
+			/* A second IDLE without new data is not a frame */
+			if(0 == (Test_Random() % 8UL))
+				{ Test_Usart_Event(USART_2, 1UL << TEST_SR_IDLE_POS); }
+			TEST_ASSERT_EQ(Test_Received_Count, Sent);
+		}
+	}
+	Frames += (Test_Received_Count < Sent) ? 1UL : 0UL;
+	Test_Usart_Event(USART_2, 1UL << TEST_SR_IDLE_POS);
+
+	TEST_ASSERT_EQ(Test_Received_Count, Sent);
+	TEST_ASSERT_EQ(memcmp(Test_Received, Test_Sent, Sent), 0);
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_2, &Stats), E_OK);
+	TEST_ASSERT_EQ(Stats.Rx_Bytes, Sent);
+	TEST_ASSERT_EQ(Stats.Rx_Frames, Frames);
+	printf("%lu bytes received in %lu handler calls, %lu frames\n", (unsigned long)Sent,
+		   (unsigned long)Test_Rx_Calls, (unsigned long)Stats.Rx_Frames);
+	TEST_ASSERT_EQ(USART_DeInit(USART_2), E_OK);
+}
+
+/* Random scatter lists, some segments empty or NULL, queued up to the depth:
+ * the wire carries the non empty segments in order, each list completes once */
+static void Test_Tx_Scatter(void)
+{
+	USART_Config_t Config;
+	USART_Stats_t Stats;
+	USART_Tx_Segment_t Empty[2] = { { NULL, 5 }, { Test_Tx_Data[0], 0 } };
+	uint32_t List = 0;
+	uint32_t Slot = 0;
+	uint32_t Queued = 0;
+	uint32_t Count = 0;
+	uint32_t Segment = 0;
+	uint32_t Byte = 0;
+	uint32_t Data_Idx = 0;
+	uint32_t Lists_Sent = 0;
+
+	Test_Start(42000000UL, 84000000UL);
+	Config = Test_Config(USART_6, 115200UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	Test_Expected_Count = 0;
+	Test_Wire_Count = 0;
+	Test_Done_Calls = 0;
+
+	/* Nothing to send is refused, Done would never run */
+	TEST_ASSERT_EQ(USART_Transmit(USART_6, Empty, 2, Test_Tx_Done), E_NOT_OK);
+	TEST_ASSERT_EQ(USART_Transmit(USART_6, NULL, 1, Test_Tx_Done), E_NOT_OK);
+
+	for(List = 0; List < TEST_TX_LISTS_NUMBER; List += Queued)
+	{
+		/* Fill the queue with new lists, the slots of the sent ones are free again */
+		for(Queued = 0; (Queued < USART_TX_QUEUE_DEPTH) && ((List + Queued) < TEST_TX_LISTS_NUMBER); Queued++)
+		{
+			Slot = Queued;
+			Count = 1UL + (Test_Random() % TEST_TX_MAX_SEGMENTS);
+			for(Segment = 0; Segment < Count; Segment++)
+			{
+				Data_Idx = (Slot * TEST_TX_MAX_SEGMENTS) + Segment;
+				Test_Segments[Slot][Segment].Data = (0 == (Test_Random() % 8UL)) ? NULL : Test_Tx_Data[Data_Idx];
+				Test_Segments[Slot][Segment].Length = (uint16_t)(Test_Random() % 40UL);
+				for(Byte = 0; Byte < sizeof(Test_Tx_Data[0]); Byte++)
+					{ Test_Tx_Data[Data_Idx][Byte] = (uint8_t)Test_Random(); }
+			}
+			/* A list of empty segments only is refused, the last one carries data */
+			Test_Segments[Slot][Count - 1UL].Data = Test_Tx_Data[Data_Idx];
+			Test_Segments[Slot][Count - 1UL].Length = (uint16_t)(1UL + (Test_Random() % 39UL));
+			for(Segment = 0; Segment < Count; Segment++)
+			{
+				if(NULL != Test_Segments[Slot][Segment].Data)
+				{
+					memcpy(&Test_Expected[Test_Expected_Count], Test_Segments[Slot][Segment].Data, Test_Segments[Slot][Segment].Length);
+					Test_Expected_Count += Test_Segments[Slot][Segment].Length;
+				}
+			}
+			TEST_ASSERT_EQ(USART_Transmit(USART_6, Test_Segments[Slot], (uint8_t)Count, Test_Tx_Done), E_OK);
+			Lists_Sent++;
+		}
+		/* The queue is full while the first list is on the wire */
+		if(USART_TX_QUEUE_DEPTH == Queued)
+			{ TEST_ASSERT_EQ(USART_Transmit(USART_6, Test_Segments[0], 1, Test_Tx_Done), E_NOT_OK); }
+		Test_Tx_Run(USART_6);
+		TEST_ASSERT_EQ(Test_Done_Calls, Lists_Sent);
+	}
+
+	TEST_ASSERT_EQ(Test_Wire_Count, Test_Expected_Count);
+	TEST_ASSERT_EQ(memcmp(Test_Wire, Test_Expected, Test_Expected_Count), 0);
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_6, &Stats), E_OK);
+	TEST_ASSERT_EQ(Stats.Tx_Bytes, Test_Expected_Count);
+	TEST_ASSERT_EQ(USART_DeInit(USART_6), E_OK);
+}
+
+/* Each error bit counts once per interrupt, the reset keeps the baud rate error */
+static void Test_Errors(void)
+{
+	USART_Config_t Config;
+	USART_Stats_t Stats;
+	uint32_t Iteration = 0;
+	uint32_t Status = 0;
+	uint32_t Counts[4] = { 0 };
+	uint32_t Baud_Error = 0;
+
+	Test_Start(42000000UL, 84000000UL);
+	/* 84 MHz / 921600 is 91.1: 1 permille off */
+	Config = Test_Config(USART_1, 921600UL);
+	Config.Parity = USART_PARITY_EVEN;
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	for(Iteration = 0; Iteration < 1000UL; Iteration++)
+	{
+		Status = Test_Random() & 0xFUL;
+		Counts[0] += (Status >> TEST_SR_PE_POS) & 1UL;
+		Counts[1] += (Status >> TEST_SR_FE_POS) & 1UL;
+		Counts[2] += (Status >> TEST_SR_NF_POS) & 1UL;
+		Counts[3] += (Status >> TEST_SR_ORE_POS) & 1UL;
+		Test_Usart_Event(USART_1, Status);
+	}
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_1, &Stats), E_OK);
+	TEST_ASSERT_EQ(Stats.Parity_Errors, Counts[0]);
+	TEST_ASSERT_EQ(Stats.Framing_Errors, Counts[1]);
+	TEST_ASSERT_EQ(Stats.Noise_Errors, Counts[2]);
+	TEST_ASSERT_EQ(Stats.Overrun_Errors, Counts[3]);
+	TEST_ASSERT_EQ(Stats.Rx_Frames, 0);
+	TEST_ASSERT_EQ(Test_Received_Count, 0);
+
+	Baud_Error = Stats.Baud_Error_Permille;
+	TEST_ASSERT_EQ(Baud_Error, 1);
+	TEST_ASSERT_EQ(USART_Reset_Stats(USART_1), E_OK);
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_1, &Stats), E_OK);
+	TEST_ASSERT_EQ(Stats.Parity_Errors + Stats.Framing_Errors + Stats.Noise_Errors + Stats.Overrun_Errors, 0);
+	TEST_ASSERT_EQ(Stats.Baud_Error_Permille, Baud_Error);
+	TEST_ASSERT_EQ(USART_Get_Stats(USART_1, NULL), E_NOT_OK);
+	TEST_ASSERT_EQ(USART_Reset_Stats(USART_COUNT), E_NOT_OK);
+	TEST_ASSERT_EQ(USART_DeInit(USART_1), E_OK);
+}
+
+/* A clock change recomputes the divider of the initialized USARTs only */
+static void Test_Clock_Changed(void)
+{
+	USART_Config_t Config;
+
+	Test_Start(42000000UL, 84000000UL);
+	Config = Test_Config(USART_2, 115200UL);
+	TEST_ASSERT_EQ(USART_Init(&Config), E_OK);
+	TEST_ASSERT_EQ(Test_Decode_Divider(USART2), 365);
+	USART1->BRR = 0x1234UL;
+
+	RCC_Clock_Freqs_Cache.PCLK1 = 16000000UL;
+	RCC_Clock_Freqs_Cache.PCLK2 = 16000000UL;
+	USART_Clock_Changed(NULL, NULL);
+	TEST_ASSERT_EQ(Test_Decode_Divider(USART2), 139);
+	TEST_ASSERT_EQ(USART1->BRR, 0x1234UL);
+	/* Still running after the divider change */
+	TEST_ASSERT(READ_BIT(USART2->CR1, 13));
+
+	RCC_Clock_Freqs_Cache.PCLK1 = 84000000UL;
+	TEST_ASSERT_EQ(USART_Update_Baud_Rate(USART_2), E_OK);
+	TEST_ASSERT_EQ(Test_Decode_Divider(USART2), 729);
+	TEST_ASSERT_EQ(USART_Update_Baud_Rate(USART_1), E_NOT_OK);
+	TEST_ASSERT_EQ(USART_DeInit(USART_2), E_OK);
+}
+
+int main(void)
+{
+	Test_Baud_Rates();
+	Test_Init_Registers();
+	Test_Shared_Dma_Clock();
+	Test_Rx_Stream();
+	Test_Tx_Scatter();
+	Test_Errors();
+	Test_Clock_Changed();
+	return TEST_REPORT();
+}
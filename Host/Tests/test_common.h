@@ -0,0 +1,41 @@
+/**
+ ******************************************************************************
+ * @file           : test_common.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Minimal assertions shared by the host tests.
+ *					 Include it after the driver headers: Std_Types.h
+ *					 defines NULL and the fixed width types itself.
+ ******************************************************************************
+ */
+
+#ifndef HOST_TESTS_TEST_COMMON_H_
+#define HOST_TESTS_TEST_COMMON_H_
+
+/* --------------- Section : Includes --------------- */
+#include <stdio.h>
+/* --------------- Section: Macro Functions Declarations --------------- */
+static unsigned long Test_Failures = 0;
+static unsigned long Test_Checks = 0;
+
+#define TEST_ASSERT(COND)		do { Test_Checks++; \
+									 if(!(COND)) { Test_Failures++; printf("%s:%d: FAILED: %s\n", __FILE__, __LINE__, #COND); } \
+								} while(0)
+
+#define TEST_ASSERT_EQ(A, B)	do { Test_Checks++; \
+									 if((unsigned long long)(A) != (unsigned long long)(B)) { Test_Failures++; \
+										printf("%s:%d: FAILED: %s == %s (%llu != %llu)\n", __FILE__, __LINE__, #A, #B, \
+											   (unsigned long long)(A), (unsigned long long)(B)); } \
+								} while(0)
+
+/* @brief Ends main(): prints the summary and returns the process status */
+#define TEST_REPORT()			(printf("%lu checks, %lu failures\n", Test_Checks, Test_Failures), (0 != Test_Failures))
+
+/* @brief Deterministic pseudo random numbers, the tests must be reproducible */
+static unsigned long Test_Random_State = 12345UL;
+static inline unsigned long Test_Random(void)
+{
+	Test_Random_State = (Test_Random_State * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+	return (Test_Random_State >> 8) & 0xFFFFFFUL;
+}
+
+#endif /* HOST_TESTS_TEST_COMMON_H_ */
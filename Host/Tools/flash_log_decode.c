@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log_decode.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Host decoder of a flash data logger dump.
+ *					 Reads the raw bytes of the log sectors (e.g. read back
+ *					 with st-flash or a debugger) and prints the samples as
+ *					 "sequence,sample" lines, oldest block first.
+ *					 Usage: flash_log_decode <dump.bin>
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/FlashLog/flash_log_codec.h"
+#include <stdio.h>
+/* --------------- Section: Macro Declarations --------------- */
+#define DECODE_MAX_DUMP_SIZE		(512UL * 1024UL)
+#define DECODE_MAX_BLOCKS			(DECODE_MAX_DUMP_SIZE / FLASH_LOG_BLOCK_OVERHEAD)
+#define DECODE_MAX_SAMPLES			0xFFFFUL
+/*---------------  Section: Static Global Variables --------------- */
+static uint8_t Decode_Dump[DECODE_MAX_DUMP_SIZE];
+static uint32_t Decode_Block_Offset[DECODE_MAX_BLOCKS];
+static uint32_t Decode_Block_Sequence[DECODE_MAX_BLOCKS];
+static int32_t Decode_Samples[DECODE_MAX_SAMPLES];
+/*---------------  Section: Function Definitions --------------- */
+int main(int argc, char ** argv)
+{
+	FILE * Dump_File = NULL;
+	uint32_t Dump_Size = 0;
+	uint32_t Offset = 0;
+	uint32_t Blocks = 0;
+	uint32_t Block_Size = 0;
+	uint32_t Sample_Count = 0;
+	uint32_t Sequence = 0;
+	uint32_t Total_Samples = 0;
+	uint32_t Total_Bytes = 0;
+	uint32_t Oldest = 0;
+	uint32_t Idx = 0;
+	uint32_t Sample_Idx = 0;
+
+	if(2 != argc)
+	{
+		fprintf(stderr, "usage: %s <dump.bin>\n", argv[0]);
+		return 2;
+	}
+	Dump_File = fopen(argv[1], "rb");
+	if(NULL == Dump_File)
+	{
+		perror(argv[1]);
+		return 2;
+	}
+	Dump_Size = (uint32_t)fread(Decode_Dump, 1, DECODE_MAX_DUMP_SIZE, Dump_File);
+	fclose(Dump_File);
+
+	/* 1. Find every valid block, the blocks are word aligned */
+	while(((Offset + FLASH_LOG_BLOCK_OVERHEAD) <= Dump_Size) && (Blocks < DECODE_MAX_BLOCKS))
+	{
+		if(E_OK == FlashLog_Codec_Decode(&Decode_Dump[Offset], Dump_Size - Offset, NULL, 0,
+										 &Sample_Count, &Sequence, &Block_Size))
+		{
+			Decode_Block_Offset[Blocks] = Offset;
+			Decode_Block_Sequence[Blocks] = Sequence;
+			Blocks++;
+			Total_Samples += Sample_Count;
+			Total_Bytes += Block_Size;
+			Offset += Block_Size;
+		}
+		else
+		{
+			/* Erased space, or a torn block */
+			Offset += 4UL;
+		}
+	}
+
+	/* 2. Print the blocks in sequence order, the sectors form a ring */
+	for(Idx = 0; Idx < Blocks; Idx++)
+	{
+		Oldest = Idx;
+		for(Offset = Idx + 1UL; Offset < Blocks; Offset++)
+		{
+			if((int32_t)FLASH_LOG_S32(Decode_Block_Sequence[Offset] - Decode_Block_Sequence[Oldest]) < 0)
+				{ Oldest = Offset; }
+		}
+		Sequence = Decode_Block_Sequence[Oldest];
+		Decode_Block_Sequence[Oldest] = Decode_Block_Sequence[Idx];
+		Decode_Block_Sequence[Idx] = Sequence;
+		Offset = Decode_Block_Offset[Oldest];
+		Decode_Block_Offset[Oldest] = Decode_Block_Offset[Idx];
+		Decode_Block_Offset[Idx] = Offset;
+
+		(void)FlashLog_Codec_Decode(&Decode_Dump[Offset], Dump_Size - Offset, Decode_Samples, DECODE_MAX_SAMPLES,
+									&Sample_Count, NULL, NULL);
+		for(Sample_Idx = 0; Sample_Idx < Sample_Count; Sample_Idx++)
+			{ printf("%lu,%ld\n", (unsigned long)Sequence, (long)Decode_Samples[Sample_Idx]); }
+	}
+
+	fprintf(stderr, "%lu blocks, %lu samples in %lu bytes, compression ratio %.2f\n",
+			(unsigned long)Blocks, (unsigned long)Total_Samples, (unsigned long)Total_Bytes,
+			(0 != Total_Bytes) ? ((double)Total_Samples * 4.0) / (double)Total_Bytes : 0.0);
+	return 0;
+}
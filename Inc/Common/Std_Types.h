@@ -13,9 +13,20 @@
 #define STD_HIGH				0x01
 #define STD_LOW					0x00
 
+#if defined(__arm__)
 typedef unsigned char 			uint8_t;
 typedef unsigned short 			uint16_t;
 typedef unsigned long 			uint32_t;
+typedef unsigned long long 		uint64_t;
+
+typedef signed char 			int8_t;
+typedef signed short 			int16_t;
+typedef signed long 			int32_t;
+typedef signed long long 		int64_t;
+#else
+/* Host builds (Host/): a long is 64 bits there, take the exact width types of the C library */
+#include <stdint.h>
+#endif
 
 
 typedef uint8_t 				Std_ReturnType_t;
@@ -145,4 +145,113 @@ typedef struct
 
 /* -------------------------- FLASH Defines End ----------------------------- */
 
+/* -------------------------- PWR Defines Start ----------------------------- */
+
+#define PWR_BASE_ADDRESS			0x40007000
+#define PWR							((PWR_Registers_t * )(PWR_BASE_ADDRESS))
+
+
+typedef struct
+{
+	volatile uint32_t CR;      		/*!< PWR power control register, Address offset: 0x00 */
+	volatile uint32_t CSR;     		/*!< PWR power control/status register, Address offset: 0x04 */
+} PWR_Registers_t;
+
+/* -------------------------- PWR Defines End ----------------------------- */
+
+/* -------------------------- GPIO Defines Start ----------------------------- */
+
+#define GPIOA_BASE_ADDRESS			0x40020000
+#define GPIOB_BASE_ADDRESS			0x40020400
+#define GPIOC_BASE_ADDRESS			0x40020800
+#define GPIOD_BASE_ADDRESS			0x40020C00
+#define GPIOE_BASE_ADDRESS			0x40021000
+#define GPIOH_BASE_ADDRESS			0x40021C00
+/* !< The ports are 0x400 apart, port index (A = 0 .. H = 7) to its registers */
+#define GPIO_PORT_STRIDE			0x400
+#define GPIOA						((GPIO_Registers_t * )(GPIOA_BASE_ADDRESS))
+#define GPIOB						((GPIO_Registers_t * )(GPIOB_BASE_ADDRESS))
+#define GPIOC						((GPIO_Registers_t * )(GPIOC_BASE_ADDRESS))
+#define GPIOD						((GPIO_Registers_t * )(GPIOD_BASE_ADDRESS))
+#define GPIOE						((GPIO_Registers_t * )(GPIOE_BASE_ADDRESS))
+#define GPIOH						((GPIO_Registers_t * )(GPIOH_BASE_ADDRESS))
+
+/**
+  * @brief General Purpose I/O
+  */
+typedef struct
+{
+	volatile uint32_t MODER;   		/*!< GPIO port mode register, Address offset: 0x00 */
+	volatile uint32_t OTYPER;  		/*!< GPIO port output type register, Address offset: 0x04 */
+	volatile uint32_t OSPEEDR; 		/*!< GPIO port output speed register, Address offset: 0x08 */
+	volatile uint32_t PUPDR;   		/*!< GPIO port pull-up/pull-down register, Address offset: 0x0C */
+	volatile uint32_t IDR;     		/*!< GPIO port input data register, Address offset: 0x10 */
+	volatile uint32_t ODR;     		/*!< GPIO port output data register, Address offset: 0x14 */
+	volatile uint32_t BSRR;    		/*!< GPIO port bit set/reset register, Address offset: 0x18 */
+	volatile uint32_t LCKR;    		/*!< GPIO port configuration lock register, Address offset: 0x1C */
+	volatile uint32_t AFR[2];  		/*!< GPIO alternate function low / high registers, Address offset: 0x20-0x24 */
+} GPIO_Registers_t;
+
+/* -------------------------- GPIO Defines End ----------------------------- */
+
+/* -------------------------- SYSCFG Defines Start ----------------------------- */
+
+#define SYSCFG_BASE_ADDRESS			0x40013800
+#define SYSCFG						((SYSCFG_Registers_t * )(SYSCFG_BASE_ADDRESS))
+
+
+typedef struct
+{
+	volatile uint32_t MEMRMP;  		/*!< SYSCFG memory remap register, Address offset: 0x00 */
+	volatile uint32_t PMC;     		/*!< SYSCFG peripheral mode configuration register, Address offset: 0x04 */
+	volatile uint32_t EXTICR[4];	/*!< SYSCFG external interrupt configuration registers, Address offset: 0x08-0x14 */
+	uint32_t RESERVED[2];			/*!< Reserved, 0x18-0x1C */
+	volatile uint32_t CMPCR;   		/*!< SYSCFG compensation cell control register, Address offset: 0x20 */
+} SYSCFG_Registers_t;
+
+/* -------------------------- SYSCFG Defines End ----------------------------- */
+
+/* -------------------------- EXTI Defines Start ----------------------------- */
+
+#define EXTI_BASE_ADDRESS			0x40013C00
+#define EXTI						((EXTI_Registers_t * )(EXTI_BASE_ADDRESS))
+
+
+typedef struct
+{
+	volatile uint32_t IMR;     		/*!< EXTI interrupt mask register, Address offset: 0x00 */
+	volatile uint32_t EMR;     		/*!< EXTI event mask register, Address offset: 0x04 */
+	volatile uint32_t RTSR;    		/*!< EXTI rising trigger selection register, Address offset: 0x08 */
+	volatile uint32_t FTSR;    		/*!< EXTI falling trigger selection register, Address offset: 0x0C */
+	volatile uint32_t SWIER;   		/*!< EXTI software interrupt event register, Address offset: 0x10 */
+	volatile uint32_t PR;      		/*!< EXTI pending register, Address offset: 0x14 */
+} EXTI_Registers_t;
+
+/* -------------------------- EXTI Defines End ----------------------------- */
+
+/* -------------------------- USART Defines Start ----------------------------- */
+
+#define USART1_BASE_ADDRESS			0x40011000
+#define USART2_BASE_ADDRESS			0x40004400
+#define USART6_BASE_ADDRESS			0x40011400
+#define USART1						((USART_Registers_t * )(USART1_BASE_ADDRESS))
+#define USART2						((USART_Registers_t * )(USART2_BASE_ADDRESS))
+#define USART6						((USART_Registers_t * )(USART6_BASE_ADDRESS))
+
+/**
+  * @brief Universal Synchronous Asynchronous Receiver Transmitter
+  */
+typedef struct
+{
+	volatile uint32_t SR;      		/*!< USART status register, Address offset: 0x00 */
+	volatile uint32_t DR;      		/*!< USART data register, Address offset: 0x04 */
+	volatile uint32_t BRR;     		/*!< USART baud rate register, Address offset: 0x08 */
+	volatile uint32_t CR1;     		/*!< USART control register 1, Address offset: 0x0C */
+	volatile uint32_t CR2;     		/*!< USART control register 2, Address offset: 0x10 */
+	volatile uint32_t CR3;     		/*!< USART control register 3, Address offset: 0x14 */
+	volatile uint32_t GTPR;    		/*!< USART guard time and prescaler register, Address offset: 0x18 */
+} USART_Registers_t;
+
+/* -------------------------- USART Defines End ----------------------------- */
+
 #endif /* COMMON_STM32F401_REGISTERS_H_ */
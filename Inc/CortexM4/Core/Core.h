@@ -0,0 +1,327 @@
+/**
+ ******************************************************************************
+ * @file           : Core.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Cortex-M4 Core Instructions and Special Registers Access.
+ ******************************************************************************
+ */
+
+#ifndef CORTEXM4_CORE_CORE_H_
+#define CORTEXM4_CORE_CORE_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "Core_Cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+/* !< Implemented priority bits of the STM32F4 (upper nibble of the priority byte) */
+#define CORE_NVIC_PRIO_BITS			4UL
+
+#define CORE_CONTROL_FPCA_POS		2UL
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+#if defined(__arm__)
+/* @brief Function-Like-Macro Masks all the configurable interrupts (PRIMASK = 1) */
+#define CORE_DISABLE_IRQ()			__asm volatile ("cpsid i" : : : "memory")
+/* @brief Function-Like-Macro Unmasks the configurable interrupts (PRIMASK = 0) */
+#define CORE_ENABLE_IRQ()			__asm volatile ("cpsie i" : : : "memory")
+
+/* @brief Function-Like-Macro Waits for an interrupt */
+#define CORE_WFI()					__asm volatile ("wfi" : : : "memory")
+/* @brief Function-Like-Macro Waits for an event */
+#define CORE_WFE()					__asm volatile ("wfe" : : : "memory")
+/* @brief Function-Like-Macro Signals an event to the core */
+#define CORE_SEV()					__asm volatile ("sev" : : : "memory")
+
+/* @brief Function-Like-Macro Data Memory Barrier */
+#define CORE_DMB()					__asm volatile ("dmb 0xF" : : : "memory")
+/* @brief Function-Like-Macro Data Synchronization Barrier */
+#define CORE_DSB()					__asm volatile ("dsb 0xF" : : : "memory")
+/* @brief Function-Like-Macro Instruction Synchronization Barrier */
+#define CORE_ISB()					__asm volatile ("isb 0xF" : : : "memory")
+#else
+/* Host build (Host/): the core registers and the exceptions are emulated by Host/Port */
+extern volatile uint32_t Host_Core_PRIMASK;
+extern volatile uint32_t Host_Core_BASEPRI;
+extern volatile uint32_t Host_Core_IPSR;
+extern volatile uint32_t Host_Core_CONTROL;
+extern volatile uint32_t Host_Core_PSP;
+extern volatile uint32_t Host_Core_Exclusive;
+void Host_Core_Set_PRIMASK(uint32_t Value);
+void Host_Core_Set_BASEPRI(uint32_t Value);
+void Host_Core_Wfi(void);
+
+#define CORE_DISABLE_IRQ()			(Host_Core_PRIMASK = 1UL)
+#define CORE_ENABLE_IRQ()			Host_Core_Set_PRIMASK(0UL)
+#define CORE_WFI()					Host_Core_Wfi()
+#define CORE_WFE()					Host_Core_Wfi()
+#define CORE_SEV()					((void)0)
+#define CORE_DMB()					__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define CORE_DSB()					__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define CORE_ISB()					__atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Kind of critical section, for the masked window statistics
+ */
+typedef enum
+{
+	CORE_CRITICAL_PRIMASK = 0,
+	CORE_CRITICAL_BASEPRI
+} Core_Critical_Kind_t;
+
+/* !< Encoded BASEPRI of the ceiling, private to Core.c and the inline functions */
+extern volatile uint32_t Core_Critical_Ceiling_Value;
+/*---------------  Section: Function Declarations --------------- */
+
+/*
+ * @brief Sets the ceiling of Core_Enter_Critical_Ceiling() and encodes it
+ * for the current priority grouping.
+ * @param Preempt_Priority: Highest preemption priority to mask, 1 or more.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Out of range for the grouping, or no preemption bits
+ */
+Std_ReturnType_t Core_Critical_Set_Ceiling(uint32_t Preempt_Priority);
+/*
+ * @brief Encodes the ceiling again after a change of the priority grouping.
+ * Called by NVIC_SetPriorityGrouping().
+ */
+void Core_Critical_Update_Grouping(void);
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+/*
+ * @brief Records the start of an outermost critical section.
+ */
+void Core_Critical_Measure_Start(Core_Critical_Kind_t Kind);
+/*
+ * @brief Records the end of an outermost critical section.
+ */
+void Core_Critical_Measure_Stop(Core_Critical_Kind_t Kind);
+#endif
+/*
+ * @brief Returns the longest masked window seen since the last reset.
+ * @param Kind: PRIMASK or BASEPRI critical sections.
+ * @return The window in CPU cycles, 0 when the measurement is disabled.
+ */
+uint32_t Core_Critical_Get_Worst_Cycles(Core_Critical_Kind_t Kind);
+/*
+ * @brief Clears the masked window statistics.
+ */
+void Core_Critical_Reset_Stats(void);
+
+#if defined(__arm__)
+/*
+ * @brief Reads the PRIMASK register.
+ * @return 1 if the configurable interrupts are masked, 0 otherwise.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Get_PRIMASK(void)
+{
+	uint32_t Result;
+	__asm volatile ("mrs %0, primask" : "=r" (Result) : : "memory");
+	return Result;
+}
+/*
+ * @brief Writes the PRIMASK register.
+ * @param Value: 1 to mask the configurable interrupts, 0 to unmask them.
+ */
+static inline __attribute__((always_inline)) void Core_Set_PRIMASK(uint32_t Value)
+{
+	__asm volatile ("msr primask, %0" : : "r" (Value) : "memory");
+}
+/*
+ * @brief Reads the IPSR register.
+ * @return The number of the active exception, 0 in thread mode.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Get_IPSR(void)
+{
+	uint32_t Result;
+	__asm volatile ("mrs %0, ipsr" : "=r" (Result) : : "memory");
+	return Result;
+}
+/*
+ * @brief Reads the CONTROL register.
+ * @return nPRIV (bit 0), SPSEL (bit 1) and FPCA (bit 2, a floating-point context is active).
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Get_CONTROL(void)
+{
+	uint32_t Result;
+	__asm volatile ("mrs %0, control" : "=r" (Result) : : "memory");
+	return Result;
+}
+/*
+ * @brief Writes the process stack pointer.
+ * @param Top_Of_Stack: The new PSP value.
+ */
+static inline __attribute__((always_inline)) void Core_Set_PSP(uint32_t Top_Of_Stack)
+{
+	__asm volatile ("msr psp, %0" : : "r" (Top_Of_Stack) : "memory");
+}
+/*
+ * @brief Counts the leading zeros of a word in one instruction.
+ * @param Value: The word to scan.
+ * @return 0 to 31 for the most significant set bit, 32 if Value is 0.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_CLZ(uint32_t Value)
+{
+	uint32_t Result;
+	__asm volatile ("clz %0, %1" : "=r" (Result) : "r" (Value));
+	return Result;
+}
+/*
+ * @brief Exclusive load of a word, opens a monitor closed by Core_STREXW().
+ * @param Address: The word to load.
+ * @return The word value.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_LDREXW(volatile uint32_t * Address)
+{
+	uint32_t Result;
+	__asm volatile ("ldrex %0, %1" : "=r" (Result) : "Q" (*Address) : "memory");
+	return Result;
+}
+/*
+ * @brief Exclusive store of a word, fails if the monitor was lost
+ * (an exception return or another exclusive access since Core_LDREXW()).
+ * @param Value: The word to store.
+ * @param Address: The word loaded by Core_LDREXW().
+ * @return 0 if stored, 1 if the load-store sequence must be retried.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_STREXW(uint32_t Value, volatile uint32_t * Address)
+{
+	uint32_t Result;
+	__asm volatile ("strex %0, %2, %1" : "=&r" (Result), "=Q" (*Address) : "r" (Value) : "memory");
+	return Result;
+}
+/*
+ * @brief Drops the exclusive monitor opened by Core_LDREXW().
+ */
+static inline __attribute__((always_inline)) void Core_CLREX(void)
+{
+	__asm volatile ("clrex" : : : "memory");
+}
+#else
+static inline __attribute__((always_inline)) uint32_t Core_Get_PRIMASK(void) { return Host_Core_PRIMASK; }
+static inline __attribute__((always_inline)) void Core_Set_PRIMASK(uint32_t Value) { Host_Core_Set_PRIMASK(Value); }
+static inline __attribute__((always_inline)) uint32_t Core_Get_IPSR(void) { return Host_Core_IPSR; }
+static inline __attribute__((always_inline)) uint32_t Core_Get_CONTROL(void) { return Host_Core_CONTROL; }
+static inline __attribute__((always_inline)) void Core_Set_PSP(uint32_t Top_Of_Stack) { Host_Core_PSP = Top_Of_Stack; }
+static inline __attribute__((always_inline)) uint32_t Core_CLZ(uint32_t Value)
+{
+	return (0UL == Value) ? 32UL : (uint32_t)__builtin_clz(Value);
+}
+static inline __attribute__((always_inline)) uint32_t Core_LDREXW(volatile uint32_t * Address)
+{
+	Host_Core_Exclusive = 1UL;
+	return *Address;
+}
+/* The monitor is lost when an emulated exception runs in between */
+static inline __attribute__((always_inline)) uint32_t Core_STREXW(uint32_t Value, volatile uint32_t * Address)
+{
+	uint32_t Result = 1UL;
+	if(Host_Core_Exclusive)
+	{
+		*Address = Value;
+		Result = 0UL;
+	}
+	Host_Core_Exclusive = 0UL;
+	return Result;
+}
+static inline __attribute__((always_inline)) void Core_CLREX(void) { Host_Core_Exclusive = 0UL; }
+#endif
+/*
+ * @brief Masks all the configurable interrupts.
+ * @return The previous PRIMASK, to be handed to Core_Exit_Critical().
+ * Calls can be nested.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Enter_Critical(void)
+{
+	uint32_t Previous_State = Core_Get_PRIMASK();
+	CORE_DISABLE_IRQ();
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	if(0 == Previous_State)
+		{ Core_Critical_Measure_Start(CORE_CRITICAL_PRIMASK); }
+#endif
+	return Previous_State;
+}
+/*
+ * @brief Restores the interrupt mask saved by Core_Enter_Critical().
+ * @param Previous_State: The value returned by Core_Enter_Critical().
+ */
+static inline __attribute__((always_inline)) void Core_Exit_Critical(uint32_t Previous_State)
+{
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	if(0 == Previous_State)
+		{ Core_Critical_Measure_Stop(CORE_CRITICAL_PRIMASK); }
+#endif
+	Core_Set_PRIMASK(Previous_State);
+}
+#if defined(__arm__)
+/*
+ * @brief Reads the BASEPRI register.
+ * @return The priority byte masked, 0 when nothing is masked.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Get_BASEPRI(void)
+{
+	uint32_t Result;
+	__asm volatile ("mrs %0, basepri" : "=r" (Result) : : "memory");
+	return Result;
+}
+/*
+ * @brief Writes the BASEPRI register.
+ * @param Value: Priority byte to mask from, 0 to unmask.
+ */
+static inline __attribute__((always_inline)) void Core_Set_BASEPRI(uint32_t Value)
+{
+	__asm volatile ("msr basepri, %0" : : "r" (Value) : "memory");
+}
+/*
+ * @brief Raises BASEPRI, a value that would lower the masking is ignored.
+ * @param Value: Priority byte to mask from.
+ */
+static inline __attribute__((always_inline)) void Core_Set_BASEPRI_MAX(uint32_t Value)
+{
+	__asm volatile ("msr basepri_max, %0" : : "r" (Value) : "memory");
+}
+#else
+static inline __attribute__((always_inline)) uint32_t Core_Get_BASEPRI(void) { return Host_Core_BASEPRI; }
+static inline __attribute__((always_inline)) void Core_Set_BASEPRI(uint32_t Value) { Host_Core_Set_BASEPRI(Value); }
+static inline __attribute__((always_inline)) void Core_Set_BASEPRI_MAX(uint32_t Value)
+{
+	Value &= 0xFFUL;
+	if((0UL != Value) && ((0UL == Host_Core_BASEPRI) || (Value < Host_Core_BASEPRI)))
+		{ Host_Core_BASEPRI = Value; }
+}
+#endif
+/*
+ * @brief Masks the interrupts at or below CORE_CRITICAL_CEILING (see
+ * Core_Critical_Set_Ceiling()), the higher priority ones keep running
+ * and must not touch the data protected here.
+ * @return The previous BASEPRI, to be handed to Core_Exit_Critical_Ceiling().
+ * Calls can be nested, also inside a handler already above the ceiling.
+ */
+static inline __attribute__((always_inline)) uint32_t Core_Enter_Critical_Ceiling(void)
+{
+	uint32_t Previous_State = Core_Get_BASEPRI();
+	/* basepri_max never lowers an already stricter mask */
+	Core_Set_BASEPRI_MAX(Core_Critical_Ceiling_Value);
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	if(0 == Previous_State)
+		{ Core_Critical_Measure_Start(CORE_CRITICAL_BASEPRI); }
+#endif
+	return Previous_State;
+}
+/*
+ * @brief Restores the BASEPRI saved by Core_Enter_Critical_Ceiling().
+ * @param Previous_State: The value returned by Core_Enter_Critical_Ceiling().
+ */
+static inline __attribute__((always_inline)) void Core_Exit_Critical_Ceiling(uint32_t Previous_State)
+{
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	if(0 == Previous_State)
+		{ Core_Critical_Measure_Stop(CORE_CRITICAL_BASEPRI); }
+#endif
+	Core_Set_BASEPRI(Previous_State);
+}
+
+#endif /* CORTEXM4_CORE_CORE_H_ */
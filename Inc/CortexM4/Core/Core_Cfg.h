@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file           : Core_Cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Cortex-M4 Core Configurations File.
+ ******************************************************************************
+ */
+#ifndef CORTEXM4_CORE_CORE_CFG_H_
+#define CORTEXM4_CORE_CORE_CFG_H_
+
+/* !< Preemption priority masked by Core_Enter_Critical_Ceiling().
+ * 	  Interrupts with this preemption priority or a lower one (numerically
+ * 	  greater or equal) are held off, the ones above keep running.
+ * 	  It is a group priority: its range depends on NVIC_SetPriorityGrouping(). */
+#define CORE_CRITICAL_CEILING				1UL
+
+/* !< Worst masked window measurement with the DWT cycle counter,
+ * 	  for both PRIMASK and BASEPRI critical sections */
+#define CORE_CRITICAL_MEASURE_DISABLED		0UL
+#define CORE_CRITICAL_MEASURE_ENABLED		1UL
+
+#define CORE_CRITICAL_MEASURE_STATE			CORE_CRITICAL_MEASURE_DISABLED
+
+#endif /* CORTEXM4_CORE_CORE_CFG_H_ */
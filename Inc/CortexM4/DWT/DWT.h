@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file           : DWT.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Data-Watchpoint-and-Trace Unit Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef CORTEXM4_DWT_DWT_H_
+#define CORTEXM4_DWT_DWT_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define DWT_BASE_ADDRESS				(0xE0001000UL)
+#define DWT								((DWT_t *)(DWT_BASE_ADDRESS))
+
+#define COREDEBUG_BASE_ADDRESS			(0xE000EDF0UL)
+#define CoreDebug						((CoreDebug_t *)(COREDEBUG_BASE_ADDRESS))
+
+#define DWT_CTRL_CYCCNTENA_POS			0UL
+#define DWT_CTRL_NOCYCCNT_POS			25UL
+
+#define COREDEBUG_DEMCR_TRCENA_POS		24UL
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* @brief Function-Like-Macro Enables the trace and debug blocks (DWT, ITM, ETM, TPIU) */
+#define COREDEBUG_TRACE_ENABLE()		(SET_BIT(CoreDebug->DEMCR, COREDEBUG_DEMCR_TRCENA_POS))
+
+/* @brief Function-Like-Macro Starts the DWT cycle counter */
+#define DWT_CYCCNT_ENABLE()				(SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_POS))
+/* @brief Function-Like-Macro Stops the DWT cycle counter */
+#define DWT_CYCCNT_DISABLE()			(CLEAR_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_POS))
+/* @brief Function-Like-Macro Returns 1 if the DWT cycle counter is running */
+#define DWT_CYCCNT_IS_ENABLED()			(READ_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_POS))
+
+/* @brief Function-Like-Macro Returns the current value of the processor cycle counter */
+#define DWT_GET_CYCCNT()				(DWT->CYCCNT)
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/**
+  @brief  Structure type to access the Data Watchpoint and Trace Register (DWT).
+ */
+typedef struct
+{
+	volatile uint32_t CTRL;			/*!< Offset: 0x000 (R/W)  Control Register */
+	volatile uint32_t CYCCNT;		/*!< Offset: 0x004 (R/W)  Cycle Count Register */
+	volatile uint32_t CPICNT;		/*!< Offset: 0x008 (R/W)  CPI Count Register */
+	volatile uint32_t EXCCNT;		/*!< Offset: 0x00C (R/W)  Exception Overhead Count Register */
+	volatile uint32_t SLEEPCNT;		/*!< Offset: 0x010 (R/W)  Sleep Count Register */
+	volatile uint32_t LSUCNT;		/*!< Offset: 0x014 (R/W)  LSU Count Register */
+	volatile uint32_t FOLDCNT;		/*!< Offset: 0x018 (R/W)  Folded-instruction Count Register */
+	volatile uint32_t PCSR;			/*!< Offset: 0x01C (R/ )  Program Counter Sample Register */
+	volatile uint32_t COMP0;		/*!< Offset: 0x020 (R/W)  Comparator Register 0 */
+	volatile uint32_t MASK0;		/*!< Offset: 0x024 (R/W)  Mask Register 0 */
+	volatile uint32_t FUNCTION0;	/*!< Offset: 0x028 (R/W)  Function Register 0 */
+	uint32_t RESERVED0;
+	volatile uint32_t COMP1;		/*!< Offset: 0x030 (R/W)  Comparator Register 1 */
+	volatile uint32_t MASK1;		/*!< Offset: 0x034 (R/W)  Mask Register 1 */
+	volatile uint32_t FUNCTION1;	/*!< Offset: 0x038 (R/W)  Function Register 1 */
+	uint32_t RESERVED1;
+	volatile uint32_t COMP2;		/*!< Offset: 0x040 (R/W)  Comparator Register 2 */
+	volatile uint32_t MASK2;		/*!< Offset: 0x044 (R/W)  Mask Register 2 */
+	volatile uint32_t FUNCTION2;	/*!< Offset: 0x048 (R/W)  Function Register 2 */
+	uint32_t RESERVED2;
+	volatile uint32_t COMP3;		/*!< Offset: 0x050 (R/W)  Comparator Register 3 */
+	volatile uint32_t MASK3;		/*!< Offset: 0x054 (R/W)  Mask Register 3 */
+	volatile uint32_t FUNCTION3;	/*!< Offset: 0x058 (R/W)  Function Register 3 */
+} DWT_t;
+
+/**
+  @brief  Structure type to access the Core Debug Register (CoreDebug).
+ */
+typedef struct
+{
+	volatile uint32_t DHCSR;		/*!< Offset: 0x000 (R/W)  Debug Halting Control and Status Register */
+	volatile uint32_t DCRSR;		/*!< Offset: 0x004 ( /W)  Debug Core Register Selector Register */
+	volatile uint32_t DCRDR;		/*!< Offset: 0x008 (R/W)  Debug Core Register Data Register */
+	volatile uint32_t DEMCR;		/*!< Offset: 0x00C (R/W)  Debug Exception and Monitor Control Register */
+} CoreDebug_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/*
+ * @brief A software interface enables the trace block and starts the
+ * DWT cycle counter. A running counter is left as it is, the other users
+ * measure with it: only the reset handler starts it from zero.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The cycle counter is not implemented
+ */
+Std_ReturnType_t DWT_CycleCounter_Init(void);
+/*
+ * @brief A software interface busy-waits a number of processor cycles.
+ * It only reads the cycle counter, which is started if needed.
+ * @param Cycles: Number of HCLK cycles to wait.
+ */
+void DWT_Delay_Cycles(uint32_t Cycles);
+/*
+ * @brief A software interface busy-waits for a sub-microsecond interval,
+ * converted to cycles with the live HCLK frequency.
+ * The resolution is one HCLK cycle (about 12 ns at 84 MHz) plus the call overhead.
+ * @param delay_ns: The delay time in nanoseconds.
+ */
+void DWT_Delay_ns(uint32_t delay_ns);
+
+#endif /* CORTEXM4_DWT_DWT_H_ */
@@ -0,0 +1,102 @@
+/**
+ ******************************************************************************
+ * @file           : FPU.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Floating-Point Unit Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef CORTEXM4_FPU_FPU_H_
+#define CORTEXM4_FPU_FPU_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "CortexM4/Core/Core.h"
+#include "FPU_Cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define FPU_BASE_ADDRESS				(0xE000EF34UL)
+#define FPU								((FPU_t *)(FPU_BASE_ADDRESS))
+
+#define FPU_FPCCR_LSPACT_POS			0UL
+#define FPU_FPCCR_LSPEN_POS				30UL
+#define FPU_FPCCR_ASPEN_POS				31UL
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/*
+ * Keeping the FPU out of hot handlers:
+ * - With lazy stacking the entry only reserves the 18 FP words, they are
+ *   pushed the first time the handler executes an FP instruction.
+ *   A handler free of FP code never pays for them.
+ * - The compiler may use FP registers for float/double arithmetic and also
+ *   for plain copies (memcpy of structures, integer <-> float casts).
+ *   Keep that work in the thread or hand it to a deferred work item.
+ * - Check a handler by calling FPU_ISR_USED_FP() at its end, while debugging.
+ */
+
+/* @brief Function-Like-Macro Returns 1 if the running handler has executed an FP
+ * 		  instruction (CONTROL.FPCA is cleared on exception entry) */
+#define FPU_ISR_USED_FP()				(READ_BIT(Core_Get_CONTROL(), CORE_CONTROL_FPCA_POS))
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/**
+  @brief  Structure type to access the Floating Point Context Registers.
+ */
+typedef struct
+{
+	volatile uint32_t FPCCR;		/*!< Offset: 0x000 (R/W)  Floating-Point Context Control Register */
+	volatile uint32_t FPCAR;		/*!< Offset: 0x004 (R/W)  Floating-Point Context Address Register */
+	volatile uint32_t FPDSCR;		/*!< Offset: 0x008 (R/W)  Floating-Point Default Status Control Register */
+} FPU_t;
+
+/*
+ * @brief 	Preservation of the FP context on exception entry
+ */
+typedef enum
+{
+	FPU_STACKING_NONE = 0,			/* !< Not saved, no handler may use the FPU */
+	FPU_STACKING_FULL,				/* !< S0-S15 and FPSCR pushed on every entry with an active FP context */
+	FPU_STACKING_LAZY				/* !< Space reserved, pushed only if the handler uses the FPU (reset default) */
+} FPU_Stacking_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/*
+ * @brief A software interface grants full access to CP10/CP11 and sets the
+ * context preservation. Call it before any FP instruction.
+ * @param Stacking: The preservation mode (@ref FPU_Stacking_t).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Invalid mode
+ */
+Std_ReturnType_t FPU_Enable(FPU_Stacking_t Stacking);
+/*
+ * @brief A software interface changes the preservation of the FP context.
+ * The kernel context switch relies on it being FULL or LAZY.
+ * @param Stacking: The preservation mode (@ref FPU_Stacking_t).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Invalid mode
+ */
+Std_ReturnType_t FPU_Set_Stacking(FPU_Stacking_t Stacking);
+/*
+ * @brief A software interface reads the preservation of the FP context.
+ * @return The preservation mode (@ref FPU_Stacking_t).
+ */
+FPU_Stacking_t FPU_Get_Stacking(void);
+/*
+ * @brief A software interface measures the exception entry, from the
+ * software trigger to the first handler instruction, with an active FP
+ * context. The entries are timed with FPU_MEASURE_IRQN and the mode
+ * given, then the previous mode and handler are restored.
+ * The trigger overhead is the same in all modes, compare the results.
+ * @param Stacking: The preservation mode to measure.
+ * @param Cycles: Returns the shortest entry in CPU cycles.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Vector table not relocated, no cycle counter,
+ *          			 software FP build or invalid parameters
+ */
+Std_ReturnType_t FPU_Measure_Entry_Cycles(FPU_Stacking_t Stacking, uint32_t * Cycles);
+
+#endif /* CORTEXM4_FPU_FPU_H_ */
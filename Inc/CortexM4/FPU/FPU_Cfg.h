@@ -0,0 +1,19 @@
+/**
+ ******************************************************************************
+ * @file           : FPU_Cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Floating-Point Unit Configurations File.
+ ******************************************************************************
+ */
+#ifndef CORTEXM4_FPU_FPU_CFG_H_
+#define CORTEXM4_FPU_FPU_CFG_H_
+
+/* !< Interrupt borrowed by FPU_Measure_Entry_Cycles(), software triggered.
+ * 	  Its handler is swapped out during the measurement, the FPU interrupt is
+ * 	  only raised by floating-point exceptions and is unused by the drivers. */
+#define FPU_MEASURE_IRQN				FPU_IRQn
+
+/* !< Exception entries timed by FPU_Measure_Entry_Cycles(), the shortest is kept */
+#define FPU_MEASURE_RUNS				8UL
+
+#endif /* CORTEXM4_FPU_FPU_CFG_H_ */
@@ -16,6 +16,9 @@
 #define REG_WIDTH			(uint32_t)32
 #define REG_MAX_IDX			(uint32_t)31
 #define NVIC_BASE_ADDRESS 	0xE000E100UL
+#define NVIC_PRIO_BITS		(uint32_t)4		/* !< Implemented priority bits (upper nibble) */
+#define NVIC_IRQ_REGS		(uint32_t)8		/* !< Words of ISER/ICER/ISPR/ICPR */
+#define NVIC_LAST_IRQN		(uint32_t)84	/* !< Last device interrupt of the STM32F401 (SPI4_IRQn) */
 
 
 #define NVIC				((NVIC_t *)(NVIC_BASE_ADDRESS))
@@ -129,6 +132,24 @@ typedef enum
 	NVIC_PRIORITY_GROUP_0_BITS = 7UL
 } NVIC_PriorityGroupBits_t;
 
+/**
+ * @brief One line of a priority plan, see NVIC_ApplyPriorityPlan().
+ */
+typedef struct
+{
+	IRQn_t IRQn;
+	uint8_t Preempt_Priority;
+	uint8_t Sub_Priority;
+} NVIC_PriorityPlan_Entry_t;
+
+/**
+ * @brief Set of device specific interrupts, one bit per IRQn laid out as the ISER words.
+ */
+typedef struct
+{
+	uint32_t Words[NVIC_IRQ_REGS];
+} NVIC_IRQSet_t;
+
 /*---------------  Section: Function Declarations --------------- */
 
 /**
@@ -216,6 +237,113 @@ void NVIC_SetPriority(IRQn_t IRQn, uint32_t Priority);
                       Value is aligned automatically to the implemented priority bits of the microcontroller.
  */
 uint32_t NVIC_GetPriority(IRQn_t IRQn);
+/**
+  @brief   Get Priority Grouping
+  @details Reads the priority grouping field from the NVIC Interrupt Controller.
+  @return                Priority grouping field (SCB->AIRCR [10:8] PRIGROUP field).
+ */
+uint32_t NVIC_GetPriorityGrouping(void);
+/**
+  @brief   Encode Priority
+  @details Encodes the priority for an interrupt with the given priority group,
+           preemptive priority value, and subpriority value.
+           In case of a conflict between priority grouping and available
+           priority bits (NVIC_PRIO_BITS), the smallest possible priority group is set.
+  @param [in]     PriorityGroup  Used priority group.
+  @param [in]   PreemptPriority  Preemptive priority value (starting from 0).
+  @param [in]       SubPriority  Subpriority value (starting from 0).
+  @return                        Encoded priority. Value can be used in the function NVIC_SetPriority().
+ */
+uint32_t NVIC_EncodePriority(NVIC_PriorityGroupBits_t PriorityGroup, uint32_t PreemptPriority, uint32_t SubPriority);
+/**
+  @brief   Decode Priority
+  @details Decodes an interrupt priority value with a given priority group to
+           preemptive priority value and subpriority value.
+  @param [in]         Priority   Priority value, which can be retrieved with the function NVIC_GetPriority().
+  @param [in]     PriorityGroup  Used priority group.
+  @param [out] pPreemptPriority  Preemptive priority value (starting from 0).
+  @param [out]     pSubPriority  Subpriority value (starting from 0).
+ */
+void NVIC_DecodePriority(uint32_t Priority, NVIC_PriorityGroupBits_t PriorityGroup,
+						 uint32_t * const pPreemptPriority, uint32_t * const pSubPriority);
+/**
+  @brief   Apply Priority Plan
+  @details Sets the priority grouping, then writes the priority of every interrupt and
+           system exception of the table in one pass with the interrupts masked.
+           The whole table is checked first, nothing is written if one entry is invalid.
+  @param [in]     PriorityGroup  Priority grouping of the plan.
+  @param [in]              Plan  Table of interrupts with their preemptive and subpriority values.
+  @param [in]           Entries  Number of lines of the table.
+  @return                  E_OK  The plan has been applied.
+  @return              E_NOT_OK  NULL table, priority out of range for the group, or
+                                 an exception with a fixed priority (NMI, HardFault).
+ */
+Std_ReturnType_t NVIC_ApplyPriorityPlan(NVIC_PriorityGroupBits_t PriorityGroup,
+										const NVIC_PriorityPlan_Entry_t * Plan, uint32_t Entries);
 
+/**
+  @brief   Empty IRQ Set
+  @details Removes every interrupt from an IRQ set.
+  @param [out]      Set  The IRQ set.
+ */
+void NVIC_IRQSet_Init(NVIC_IRQSet_t * Set);
+/**
+  @brief   Add to IRQ Set
+  @details Adds a device specific interrupt to an IRQ set, no register is written.
+  @param [in,out]   Set  The IRQ set.
+  @param [in]      IRQn  Device specific interrupt number.
+  @return          E_OK  The interrupt has been added.
+  @return      E_NOT_OK  NULL set, or IRQn not a device interrupt of the STM32F401.
+ */
+Std_ReturnType_t NVIC_IRQSet_Add(NVIC_IRQSet_t * Set, IRQn_t IRQn);
+/**
+  @brief   Remove from IRQ Set
+  @details Removes a device specific interrupt from an IRQ set, no register is written.
+  @param [in,out]   Set  The IRQ set.
+  @param [in]      IRQn  Device specific interrupt number.
+  @return          E_OK  The interrupt has been removed.
+  @return      E_NOT_OK  NULL set, or IRQn not a device interrupt of the STM32F401.
+ */
+Std_ReturnType_t NVIC_IRQSet_Remove(NVIC_IRQSet_t * Set, IRQn_t IRQn);
+/**
+  @brief   Enable IRQ Set
+  @details Enables all the interrupts of the set, writing each ISER word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_EnableIRQSet(const NVIC_IRQSet_t * Set);
+/**
+  @brief   Disable IRQ Set
+  @details Disables all the interrupts of the set, writing each ICER word once.
+           None of them is taken after the function returns.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_DisableIRQSet(const NVIC_IRQSet_t * Set);
+/**
+  @brief   Set Pending IRQ Set
+  @details Sets the pending bit of all the interrupts of the set, writing each ISPR word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_SetPendingIRQSet(const NVIC_IRQSet_t * Set);
+/**
+  @brief   Clear Pending IRQ Set
+  @details Clears the pending bit of all the interrupts of the set, writing each ICPR word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_ClearPendingIRQSet(const NVIC_IRQSet_t * Set);
+/**
+  @brief   Mask IRQ Set
+  @details Saves which interrupts of the set are enabled, then disables the whole set at once,
+           e.g. while reconfiguring a subsystem. NVIC_RestoreIRQSet() enables back only
+           the interrupts that were enabled.
+  @param [in]       Set  The IRQ set.
+  @param [out] Snapshot  Receives the enabled interrupts of the set.
+ */
+void NVIC_MaskIRQSet(const NVIC_IRQSet_t * Set, NVIC_IRQSet_t * Snapshot);
+/**
+  @brief   Restore IRQ Set
+  @details Enables back the interrupts saved by NVIC_MaskIRQSet() at once.
+  @param [in]  Snapshot  The snapshot taken by NVIC_MaskIRQSet().
+ */
+void NVIC_RestoreIRQSet(const NVIC_IRQSet_t * Snapshot);
 
 #endif /* CORTEXM4_NVIC_NVIC_H_ */
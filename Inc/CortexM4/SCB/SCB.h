@@ -14,6 +14,25 @@
 #define SCB_BASE_ADDRESS			0xE000ED00
 
 #define SCB							((SCB_t *)(SCB_BASE_ADDRESS))
+
+#define SCB_ICSR_ISRPENDING_POS		22UL
+#define SCB_ICSR_PENDSTCLR_POS		25UL
+#define SCB_ICSR_PENDSTSET_POS		26UL
+#define SCB_ICSR_PENDSVSET_POS		28UL
+
+#define SCB_SCR_SLEEPONEXIT_POS		1UL
+#define SCB_SCR_SLEEPDEEP_POS		2UL
+#define SCB_SCR_SEVONPEND_POS		4UL
+
+/* !< CP10 and CP11 (the FPU) access fields, 0b11 is full access */
+#define SCB_CPACR_CP10_POS			20UL
+#define SCB_CPACR_CP11_POS			22UL
+#define SCB_CPACR_FPU_FULL_ACCESS	(0xFUL << SCB_CPACR_CP10_POS)
+
+/* !< 16 system exceptions + 85 device interrupts (up to SPI4_IRQn) */
+#define SCB_VECTORS_NUMBER			(16UL + 85UL)
+/* !< VTOR needs the table aligned on its size rounded up to a power of two */
+#define SCB_VECTOR_TABLE_ALIGNMENT	512UL
 /* --------------- Section: Macro Functions Declarations --------------- */
 
 /* --------------- Section: Data Type Declarations --------------- */
@@ -25,10 +44,73 @@ typedef struct
 	volatile uint32_t AIRCR;    	/*!< (R/W)  Application Interrupt and Reset Control Register */
 	volatile uint32_t SCR;      	/*!< (R/W)  System Control Register */
 	volatile uint32_t CCR;         	/*!< (R/W)  Configuration Control Register */
-	volatile uint32_t SHPR[12U];   	/*!< (R/W)  System Handlers Priority Registers (4-7, 8-11, 12-15) */
+	volatile uint8_t  SHPR[12U];   	/*!< (R/W)  System Handlers Priority Registers (4-7, 8-11, 12-15), byte per handler */
 	volatile uint32_t SHCSR;       	/*!< (R/W)  System Handler Control and State Register */
 	volatile uint32_t CFSR;        	/*!< (R/W)  Configurable Fault Status Register */
+	volatile uint32_t HFSR;        	/*!< (R/W)  HardFault Status Register */
+	volatile uint32_t DFSR;        	/*!< (R/W)  Debug Fault Status Register */
+	volatile uint32_t MMFAR;       	/*!< (R/W)  MemManage Fault Address Register */
+	volatile uint32_t BFAR;        	/*!< (R/W)  BusFault Address Register */
+	volatile uint32_t AFSR;        	/*!< (R/W)  Auxiliary Fault Status Register */
+	volatile uint32_t ID_REGS[13U];	/*!< (R/ )  Processor Feature, Debug, Memory Model and ISA Feature Registers */
+	uint32_t RESERVED0[5U];
+	volatile uint32_t CPACR;       	/*!< (R/W)  Coprocessor Access Control Register */
 } SCB_t;
+
+/*
+ * @brief 	Vector slot content saved by SCB_VectorTable_Swap()
+ */
+typedef struct
+{
+	int32_t IRQn;
+	Interrupt_Handler_t Handler;
+} SCB_Vector_Save_t;
 /*---------------  Section: Function Declarations --------------- */
 
+/*
+ * @brief A software interface copies the active vector table into aligned
+ * SRAM and points VTOR at the copy. Calling it again does nothing.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SCB_VectorTable_Relocate(void);
+/*
+ * @brief A software interface writes a handler straight into the vector slot
+ * of an interrupt, so the exception entry branches to it with no dispatcher
+ * in between. The handler has to clear the interrupt flag of its peripheral.
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @param Handler: The interrupt handler.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid IRQn or NULL handler
+ */
+Std_ReturnType_t SCB_VectorTable_Install(int32_t IRQn, Interrupt_Handler_t Handler);
+/*
+ * @brief A software interface reads the handler of a vector slot.
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @return The handler, NULL for an invalid IRQn.
+ */
+Interrupt_Handler_t SCB_VectorTable_Get(int32_t IRQn);
+/*
+ * @brief A software interface installs a handler temporarily,
+ * keeping the previous one for SCB_VectorTable_Restore().
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @param Handler: The temporary interrupt handler.
+ * @param Saved: Returns the previous content of the slot.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid parameters
+ */
+Std_ReturnType_t SCB_VectorTable_Swap(int32_t IRQn, Interrupt_Handler_t Handler, SCB_Vector_Save_t * Saved);
+/*
+ * @brief A software interface puts back a handler saved by SCB_VectorTable_Swap(),
+ * an empty (NULL) slot included.
+ * @param Saved: The saved slot.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid parameters
+ */
+Std_ReturnType_t SCB_VectorTable_Restore(const SCB_Vector_Save_t * Saved);
+
 #endif /* CORTEXM4_SCB_SCB_H_ */
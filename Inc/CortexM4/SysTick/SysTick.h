@@ -13,6 +13,7 @@
 #include "Common/Std_Types.h"
 #include "SysTick_Cfg.h"
 #include "../NVIC/NVIC.h"
+#include "../Core/Core.h"
 /* --------------- Section: Macro Declarations --------------- */
 #define SYSTICK_BASE_ADDRESS			(0xE000E010)
 #define SysTick							((SysTick_Registers_t *)(SYSTICK_BASE_ADDRESS))
@@ -25,11 +26,20 @@
 #define SYSTICK_MODE_INIT_VALUE			0U
 #define SYSTICK_MODE_SINGLE_INTERVAL	1U
 #define SYSTICK_MODE_PERIODIC_INTERVAL	2U
+#define SYSTICK_MODE_TIMEBASE			3U
+
+#define SYSTICK_MAX_RELOAD				(16777215UL)
 
 /* --------------- Section: Macro Functions Declarations --------------- */
 
+#if defined(__arm__)
 /* @brief Function-Like-Macro Enables the SysTick Timer */
 #define SYSTICK_TIMER_ENABLE()			(SET_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS))
+#else
+/* Host build (Host/): the model loads a cleared counter right away, as the first clock does */
+void Host_SysTick_Enable(void);
+#define SYSTICK_TIMER_ENABLE()			Host_SysTick_Enable()
+#endif
 /* @brief Function-Like-Macro Disables the SysTick Timer */
 #define SYSTICK_TIMER_DISABLE()			(CLEAR_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS))
 
@@ -43,6 +53,15 @@
 /* @brief Function-Like-Macro Selects SysTick Clock With Prescaler */
 #define SYSTICK_CLK_WITH_PRESCALER()	(CLEAR_BIT(SysTick->CSR, SYSTICK_CLKSOURCE_BIT_POS))
 
+/* @brief Function-Like-Macro Returns the SysTick counter clock for an HCLK */
+#if SYSTICK_CLOCK_SOURCE == SYSTICK_EXTERNAL_CLOCK
+#define SYSTICK_INPUT_CLOCK(HCLK)		((HCLK) / 8UL)
+#elif SYSTICK_CLOCK_SOURCE == SYSTICK_PROCESSOR_CLOCK
+#define SYSTICK_INPUT_CLOCK(HCLK)		(HCLK)
+#else
+#error "Invalid SysTick Clock Source Configurations"
+#endif
+
 /* @brief Function-Like-Macro Returns 1 if timer counted to 0 */
 #define SYSTICK_GET_COUNTFLAG()			(READ_BIT(SysTick->CSR, SYSTICK_COUNTFLAG_BIT_POS))
 
@@ -75,12 +94,38 @@ Std_ReturnType_t SysTick_DeInit(void);
 /*
  * @brief A software interface halts the processor execution for a
  * defined interval.
+ * The interval is converted with the live clock frequency. The delay reads
+ * the DWT cycle counter, so it holds with the SysTick exception masked or
+ * pending, and never reprograms the SysTick registers.
  * @param delay_ms: The delay time in milliseconds.
  * @return Status of the function
  *          (E_OK) : The function done successfully
  *          (E_NOT_OK) : The function has issue to perform this action
  */
-Std_ReturnType_t SysTick_Delay_ms(uint32_t No_Of_Ticks);
+Std_ReturnType_t SysTick_Delay_ms(uint32_t delay_ms);
+/*
+ * @brief A software interface halts the processor execution for a
+ * defined interval, like SysTick_Delay_ms().
+ * Use DWT_Delay_ns() for sub-microsecond delays.
+ * @param delay_us: The delay time in microseconds.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SysTick_Delay_us(uint32_t delay_us);
+/*
+ * @brief A software interface returns the frequency of the SysTick counter,
+ * derived from the live HCLK and SYSTICK_CLOCK_SOURCE.
+ * @return The counter frequency in Hz.
+ */
+uint32_t SysTick_Get_InputClock(void);
+/*
+ * @brief A software interface converts a time to SysTick counter ticks
+ * with the live clock frequency, e.g. for SysTick_Timebase_Start().
+ * @param Time_us: The time in microseconds.
+ * @return The number of counter ticks (rounded to the nearest).
+ */
+uint32_t SysTick_Micros_To_Ticks(uint32_t Time_us);
 /*
  * @brief A software interface fires one interrupt request
  * for one interval only.
@@ -101,6 +146,82 @@ Std_ReturnType_t SysTick_SingleInterval(uint32_t No_Of_Ticks, Interrupt_Handler_
  *          (E_NOT_OK) : The function has issue to perform this action
  */
 Std_ReturnType_t SysTick_PeriodicInterval(uint32_t No_Of_Ticks, Interrupt_Handler_t isr);
+/*
+ * @brief A software interface starts the free-running timebase.
+ * The timer interrupts every No_Of_Ticks counts and the interrupt
+ * extends the counter to 64 bits.
+ * @param No_Of_Ticks: Number of timer ticks of one timebase period.
+ * @param isr: Pointer to the callback function, called every period (may be NULL).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SysTick_Timebase_Start(uint32_t No_Of_Ticks, Interrupt_Handler_t isr);
+/*
+ * @brief A software interface returns the number of timebase periods
+ * elapsed since SysTick_Timebase_Start().
+ * @return The 64-bit period count.
+ */
+uint64_t SysTick_Get_Ticks(void);
+/*
+ * @brief A software interface returns the number of SysTick counter
+ * cycles elapsed since SysTick_Timebase_Start().
+ * It is lock-free and safe from any context. With the SysTick exception
+ * masked or pending it stays right for one period past the pending wrap
+ * only: a second wrap before the handler runs is not seen, and the count
+ * goes back by a whole period.
+ * Across an HCLK change (SysTick_Rescale()) the cycles of each clock add
+ * up, the count never goes back.
+ * @return The 64-bit cycle count.
+ */
+uint64_t SysTick_Get_Cycles(void);
+/*
+ * @brief A software interface returns the time elapsed since
+ * SysTick_Timebase_Start() in microseconds.
+ * @return The 64-bit time in microseconds.
+ */
+uint64_t SysTick_Get_Micros(void);
+/*
+ * @brief A software interface registers a function called from the
+ * SysTick interrupt on every period, before the interval callback.
+ * It lets several services share the timer (software timers, dispatchers...).
+ * Registering a hook again does nothing.
+ * @param Hook: Pointer to the hook function.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : NULL hook or all the SYSTICK_MAX_TICK_HOOKS slots are used
+ */
+Std_ReturnType_t SysTick_Register_TickHook(Interrupt_Handler_t Hook);
+/*
+ * @brief A software interface sleeps (WFI) for up to Idle_Ticks timebase
+ * periods without waking up on the periods in between (tickless idle).
+ * The reload register is programmed to the deadline, several 24-bit
+ * reloads are chained for longer deadlines, and the timebase is
+ * corrected for the elapsed time on wake-up.
+ * The SysTick interrupt still fires for the period that ends the sleep,
+ * the periods before it are not seen by the tick hooks: the caller
+ * catches up with the returned count. Other tick consumers (another hook
+ * or the timebase callback, e.g. the dispatcher or the kernel) cannot,
+ * so while one is registered the sleep is a plain WFI.
+ * Call it with interrupts masked, after checking there is nothing to do,
+ * so a wake-up event cannot be missed. Less than 2 ticks is a plain WFI.
+ * @param Idle_Ticks: Number of periods until the next deadline.
+ * @param Caller_Hook: Tick hook of the caller, the only one allowed to miss ticks.
+ * @return Number of periods elapsed without a SysTick interrupt.
+ */
+uint32_t SysTick_Tickless_Sleep(uint32_t Idle_Ticks, Interrupt_Handler_t Caller_Hook);
+/*
+ * @brief A software interface keeps the period of a running interval or
+ * timebase in time across an HCLK change, by scaling the reload value.
+ * The period in progress keeps the time it has left, and the cycle and
+ * microsecond counts go on from where they are. Call it right after the switch.
+ * @param Old_HCLK: HCLK before the change in Hz.
+ * @param New_HCLK: HCLK after the change in Hz.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully, or the timer is stopped
+ *          (E_NOT_OK) : Null frequency or the scaled period does not fit 24 bits
+ */
+Std_ReturnType_t SysTick_Rescale(uint32_t Old_HCLK, uint32_t New_HCLK);
 
 
 #endif /* CORTEXM4_SYSTICK_SYSTICK_H_ */
@@ -13,4 +13,7 @@
 
 #define SYSTICK_CLOCK_SOURCE		SYSTICK_EXTERNAL_CLOCK
 
+/* !< Number of services that can hook the SysTick interrupt */
+#define SYSTICK_MAX_TICK_HOOKS		4U
+
 #endif /* CORTEXM4_SYSTICK_SYSTICK_CFG_H_ */
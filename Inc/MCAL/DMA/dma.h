@@ -82,10 +82,34 @@
 #define DMA_SxM0AR_RESET_VALUE 				(0x00000000UL)
 #define DMA_SxNDTR_RESET_VALUE 				(0x00000000UL)
 #define DMA_SxPAR_RESET_VALUE 				(0x00000000UL)
+/* !< Polls of the EN bit when stopping a stream before giving up */
+#define DMA_STREAM_STOP_TIMEOUT				10000UL
 #define DMA_SxM1AR_RESET_VALUE 				(0x00000000UL)
 
 /* --------------- Section: Macro Functions Declarations --------------- */
 
+/* @brief Returns 1 while the stream is enabled. The hardware clears EN
+ * 		  at the end of a normal mode transfer or on a transfer error. */
+#define DMA_STREAM_IS_ENABLED(DMAx, STREAM_IDX)		(READ_BIT((DMAx)->Streams[(STREAM_IDX)].CR, 0))
+
+/* @brief Position of the transfer complete flag of a stream: 5, 11, 21, 27 in LISR (streams 0-3)
+ * 		  and the same positions in HISR (streams 4-7) */
+#define DMA_TCIF_POS(STREAM_IDX)					((((STREAM_IDX) & 1UL) * 6UL) + (((STREAM_IDX) & 2UL) * 8UL) + 5UL)
+/* @brief Clears the transfer complete flag, for handlers installed
+ * 		  directly in the vector table (SCB_VectorTable_Install()) */
+#define DMA_CLEAR_TC_FLAG(DMAx, STREAM_IDX)			(((STREAM_IDX) < 4U) ?								\
+													 ((DMAx)->LIFCR = (1UL << DMA_TCIF_POS(STREAM_IDX))) :	\
+													 ((DMAx)->HIFCR = (1UL << DMA_TCIF_POS(STREAM_IDX))))
+/* @brief All the flags of a stream (FE, DME, TE, HT, TC) at their LISR / HISR positions */
+#define DMA_STREAM_FLAGS_MASK(STREAM_IDX)			(0x3DUL << (DMA_TCIF_POS(STREAM_IDX) - 5UL))
+/* @brief Clears every flag of a stream */
+#define DMA_CLEAR_ALL_FLAGS(DMAx, STREAM_IDX)		(((STREAM_IDX) < 4U) ?								\
+													 ((DMAx)->LIFCR = DMA_STREAM_FLAGS_MASK(STREAM_IDX)) :	\
+													 ((DMAx)->HIFCR = DMA_STREAM_FLAGS_MASK(STREAM_IDX)))
+/* @brief Enables the half transfer interrupt, it may change while the stream runs.
+ * 		  With the transfer complete one, a circular stream interrupts twice per lap. */
+#define DMA_ENABLE_HT_IT(DMAx, STREAM_IDX)			(SET_BIT((DMAx)->Streams[(STREAM_IDX)].CR, 3))
+
 
 /* --------------- Section: Data Type Declarations --------------- */
 
@@ -221,7 +245,7 @@ Std_ReturnType_t DMA1_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
  * 			otherwise E_NOT_OK.
  *
  * This function resets all the DMA Controller registers to their
- * reset value.
+ * reset value, and turns the DMA clock off with the last stream.
  */
 Std_ReturnType_t DMA1_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs);
 
@@ -259,9 +283,23 @@ Std_ReturnType_t DMA2_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
  * 			otherwise E_NOT_OK.
  *
  * This function resets all the DMA Controller registers to their
- * reset value.
+ * reset value, and turns the DMA clock off with the last stream.
  */
 Std_ReturnType_t DMA2_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs);
 
 
+/**
+ * @brief  Restarts an initialized stream on a new memory buffer, for the
+ * 		   transfers of a normal mode stream one after the other.
+ * 		   The stream is stopped and its flags cleared before the reload.
+ * @param  DMAx: DMA1 or DMA2.
+ * @param  Stream_Idx: The stream, 0 .. 7.
+ * @param  Memory_Address: The new memory address.
+ * @param  No_Of_Items: The new number of items.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, or the stream did not stop
+ */
+Std_ReturnType_t DMA_Stream_Reload(DMA_Registers_t * DMAx, uint8_t Stream_Idx, uint32_t Memory_Address, uint16_t No_Of_Items);
+
 #endif /* MCAL_DMA_DMA_H_ */
@@ -12,6 +12,7 @@
 /* --------------- Section : Includes --------------- */
 #include "Common/Std_Types.h"
 #include "Common/stm32f401_registers.h"
+#include "flash_cfg.h"
 /* --------------- Section: Macro Declarations --------------- */
 
 #define FLASH_CR_KEY_1				(0x45670123UL)
@@ -42,14 +43,59 @@
 #define FLASH_RDERR_POS				(8UL)
 #define FLASH_FLAG_RDERR			(READ_BIT(FLASH->SR, FLASH_RDERR_POS))
 
+/* !< All the error flags of the status register */
+#define FLASH_SR_ERRORS_MASK		((1UL << FLASH_OPERR_POS) | (1UL << FLASH_WRPERR_POS) | \
+									 (1UL << FLASH_PGAERR_POS) | (1UL << FLASH_PGPERR_POS) | \
+									 (1UL << FLASH_PGSERR_POS) | (1UL << FLASH_RDERR_POS))
+
+/* !< Operation bits of the control register (PG, SER, MER, SNB) */
+#define FLASH_CR_OPERATION_MASK		(0x0000007FUL)
+
+#define FLASH_ACR_LATENCY_MASK		(0x0000000FUL)
+#define FLASH_ACR_PRFTEN_POS		(8UL)		/* !< Prefetch enable */
+#define FLASH_ACR_ICEN_POS			(9UL)		/* !< Instruction cache enable */
+#define FLASH_ACR_DCEN_POS			(10UL)		/* !< Data cache enable */
+
+#define FLASH_SECTORS_NUMBER		(6UL)
+
+#define FLASH_ERASED_WORD			(0xFFFFFFFFUL)
+
+/* !< Layout of the erase counters journal, in FLASH_STATS_SECTOR_A or B:
+ * 	  [Magic][Sequence][Counter 0]...[Counter 5][Entry][Entry]...
+ * 	  Every sector erase appends one entry word. When the journal is full the
+ * 	  counters are folded into a new header in the other sector, the copy with
+ * 	  the magic word and the highest sequence is the current one. The same fold
+ * 	  runs before the sector holding the current journal is erased. */
+#define FLASH_STATS_MAGIC			(0x57454152UL)
+#define FLASH_STATS_ENTRY_TAG		(0xA5A5A500UL)
+#define FLASH_STATS_ENTRY_TAG_MASK	(0xFFFFFF00UL)
+#define FLASH_STATS_HEADER_WORDS	(2UL + FLASH_SECTORS_NUMBER)
+
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+#if (FLASH_STATS_SECTOR_A == FLASH_STATS_SECTOR_B)
+#error "FLASH_STATS_SECTOR_A and FLASH_STATS_SECTOR_B must be different sectors"
+#endif
+#if (FLASH_STATS_SECTOR_A < 1) || (FLASH_STATS_SECTOR_A > 5) || (FLASH_STATS_SECTOR_B < 1) || (FLASH_STATS_SECTOR_B > 5)
+#error "The flash statistics journal needs sectors 1 to 5, sector 0 holds the vector table"
+#endif
+#endif
+
 /* --------------- Section: Macro Functions Declarations --------------- */
 
 #define FLASH_WAIT_FOR_COMPLETION()	while(READ_BIT(FLASH->SR, 16))
 
+/* @brief Returns 1 while an operation is in progress (BSY) */
+#define FLASH_IS_BUSY()				(READ_BIT(FLASH->SR, 16))
+
 #define FLASH_START_OPERATION()		(SET_BIT(FLASH->CR, 16))
 
 #define FLASH_OB_START_OPERATION()	(SET_BIT(FLASH->OPTCR, 1))
 
+/* @brief Returns the error flags raised by the last operation */
+#define FLASH_GET_ERRORS()			(FLASH->SR & FLASH_SR_ERRORS_MASK)
+/* @brief Clears the error flags (write 1 to clear) */
+#define FLASH_CLEAR_ERRORS()		(FLASH->SR = FLASH_SR_ERRORS_MASK)
+
 /* --------------- Section: Data Type Declarations --------------- */
 
 /*
@@ -65,6 +111,16 @@ typedef enum
 	FLASH_SECTOR_5 = 21
 } Flash_Sector_t;
 
+/*
+ * @brief 	Operation started by the non-blocking interface
+ */
+typedef enum
+{
+	FLASH_ASYNC_NONE = 0,
+	FLASH_ASYNC_SECTOR_ERASE,
+	FLASH_ASYNC_PROGRAM
+} Flash_Async_Operation_t;
+
 /*
  * @brief 	The read protection levels for Flash Memory
  */
@@ -75,6 +131,29 @@ typedef enum
 	FLASH_READ_PROTECT_LEV2
 } Flash_ReadProtectionLev_t;
 
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+/*
+ * @brief 	Timing and error statistics of one type of flash operation
+ */
+typedef struct
+{
+	uint32_t Count;					/* !< Operations timed since boot */
+	uint32_t Worst_Cycles;			/* !< Longest operation in CPU cycles */
+	uint32_t Mean_Cycles;			/* !< Average operation in CPU cycles */
+	uint32_t Error_Count;			/* !< Operations that raised an error flag */
+	uint32_t Last_Error_Flags;		/* !< FLASH->SR error flags of the last failed operation */
+} Flash_OpStats_t;
+
+/*
+ * @brief 	Wear and erase statistics of one flash sector
+ */
+typedef struct
+{
+	uint32_t Erase_Count;			/* !< Lifetime erase count, kept in the journal sectors */
+	Flash_OpStats_t Erase;			/* !< Erase timing since boot */
+} Flash_SectorStats_t;
+#endif
+
 
 /*---------------  Section: Function Declarations --------------- */
 
@@ -105,6 +184,59 @@ Std_ReturnType_t Flash_Erase_Mass(void);
  *         - E_NOT_OK: Operation failed (e.g., address not aligned, programming error)
  */
 Std_ReturnType_t Flash_Program(uint32_t address, uint32_t data);
+/**
+ * @brief  Programs consecutive words in the FLASH memory with a single
+ *         unlock/lock sequence, which is cheaper than one Flash_Program() per word.
+ * @param  address: Address in FLASH memory of the first word (word-aligned).
+ * @param  data: Pointer to the words to be programmed.
+ * @param  words: Number of words to program.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Operation failed (e.g., address not aligned, programming error)
+ */
+Std_ReturnType_t Flash_Program_Buffer(uint32_t address, const uint32_t * data, uint32_t words);
+/**
+ * @brief  Starts the erase of a FLASH sector and returns without waiting.
+ *         Poll FLASH_IS_BUSY() (or await it) then call Flash_Operation_Finish().
+ *         The CPU still stalls on any FLASH read while the erase runs,
+ *         so the code doing other work meanwhile should run from RAM.
+ *         A sector holding the erase counters journal has it folded into the
+ *         other journal sector first, that part waits.
+ * @param  Sector: The sector to be erased.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation started
+ *         - E_NOT_OK: Invalid sector, FLASH busy, journal fold or unlock failed
+ */
+Std_ReturnType_t Flash_Erase_Sector_Start(const Flash_Sector_t Sector);
+/**
+ * @brief  Starts programming one word and returns without waiting.
+ *         Poll FLASH_IS_BUSY() (or await it) then call Flash_Operation_Finish().
+ * @param  address: Address in FLASH memory (word-aligned).
+ * @param  data: Data to be programmed.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation started
+ *         - E_NOT_OK: Address not aligned, FLASH busy or unlock failed
+ */
+Std_ReturnType_t Flash_Program_Start(uint32_t address, uint32_t data);
+/**
+ * @brief  Completes the operation started by Flash_Erase_Sector_Start() or
+ *         Flash_Program_Start(): waits for the end if needed, checks the error
+ *         flags, locks the control register and updates the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No operation started or the operation failed
+ */
+Std_ReturnType_t Flash_Operation_Finish(void);
+/**
+ * @brief  Returns the memory range of a FLASH sector.
+ * @param  Sector: The sector to look up.
+ * @param  Address: Pointer receiving the first address of the sector.
+ * @param  Size: Pointer receiving the size of the sector in bytes.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid sector or NULL pointer
+ */
+Std_ReturnType_t Flash_Get_Sector_Range(const Flash_Sector_t Sector, uint32_t * Address, uint32_t * Size);
 /**
  * @brief  Sets the read protection level of the FLASH memory.
  * @param  Protection_Level: Level of read protection to be applied.
@@ -123,5 +255,61 @@ Std_ReturnType_t Flash_SetReadProtection(const Flash_ReadProtectionLev_t Protect
  *         - E_NOT_OK: Operation failed
  */
 Std_ReturnType_t Flash_SetWriteProtection(const Flash_Sector_t Sector);
+/**
+ * @brief  Sets the number of FLASH read wait states (ACR LATENCY).
+ *         Raise it before speeding HCLK up, lower it after slowing down.
+ * @param  Wait_States: Number of wait states, 0 to 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Out of range, or the new value did not read back
+ */
+Std_ReturnType_t Flash_Set_Latency(uint32_t Wait_States);
+/**
+ * @brief  Returns the number of FLASH read wait states.
+ */
+uint32_t Flash_Get_Latency(void);
+
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+/**
+ * @brief  Loads the lifetime erase counters from the newest valid journal in
+ *         FLASH_STATS_SECTOR_A / B and starts the cycle counter used to time
+ *         the operations. Sector A is formatted if neither holds a journal.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: A journal sector overlaps the program image, or a flash operation failed
+ */
+Std_ReturnType_t Flash_Stats_Init(void);
+/**
+ * @brief  Reports the erase count and the erase timing of a sector.
+ * @param  Sector: The sector to report.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid sector or NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetSector(const Flash_Sector_t Sector, Flash_SectorStats_t * Stats);
+/**
+ * @brief  Reports the timing and errors of the mass erase operations.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetMassErase(Flash_OpStats_t * Stats);
+/**
+ * @brief  Reports the timing and errors of the program operations.
+ *         A Flash_Program_Buffer() call counts as one operation.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetProgram(Flash_OpStats_t * Stats);
+/**
+ * @brief  Clears the timing and error statistics kept in RAM.
+ *         The lifetime erase counters are not affected.
+ */
+void Flash_Stats_ResetTiming(void);
+#endif
 
 #endif /* MCAL_FLASH_FLASH_H_ */
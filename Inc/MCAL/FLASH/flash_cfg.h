@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file           : flash_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Flash Device-Driver Configurations File.
+ ******************************************************************************
+ */
+#ifndef MCAL_FLASH_FLASH_CFG_H_
+#define MCAL_FLASH_FLASH_CFG_H_
+
+#define FLASH_STATS_DISABLED		0UL
+#define FLASH_STATS_ENABLED			1UL
+
+/* !< Wear and timing statistics for the erase and program operations */
+#define FLASH_STATS_STATE			FLASH_STATS_DISABLED
+
+/* !< Sector numbers (1 to 5) of the two sectors holding the erase counters
+ * 	  journal, written alternately so a valid copy survives any reset.
+ * 	  Both must be reserved by the linker script: Flash_Stats_Init() refuses
+ * 	  sectors overlapping the program image and formats them otherwise. */
+#define FLASH_STATS_SECTOR_A		2UL
+#define FLASH_STATS_SECTOR_B		3UL
+
+#endif /* MCAL_FLASH_FLASH_CFG_H_ */
@@ -0,0 +1,233 @@
+/**
+ ******************************************************************************
+ * @file           : gpio.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : GPIO Device-Driver Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef MCAL_GPIO_GPIO_H_
+#define MCAL_GPIO_GPIO_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "Common/stm32f401_registers.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define GPIO_PINS_PER_PORT					16UL
+#define GPIO_PORT_PINS_MASK					(0x0000FFFFUL)
+#define GPIO_BSRR_RESET_POS					16UL
+#define GPIO_PORTS_NUMBER					8UL		/* !< Port indexes, F and G do not exist on the F401 */
+
+/** @defgroup GPIO_Pin_Mask Pin masks of the multi-pin operations
+  * @{
+  */
+#define GPIO_PIN_MASK(PIN)					(1UL << (PIN))
+#define GPIO_PIN_ALL						GPIO_PORT_PINS_MASK
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+/* !< Port index (@ref GPIO_Port_t) to its registers */
+#define GPIO_PORT_REGS(PORT)				((GPIO_Registers_t *)(GPIOA_BASE_ADDRESS + ((uint32_t)(PORT) * GPIO_PORT_STRIDE)))
+
+/* --------------- Section: Data Type Declarations --------------- */
+typedef enum
+{
+	GPIO_PORTA = 0,
+	GPIO_PORTB = 1,
+	GPIO_PORTC = 2,
+	GPIO_PORTD = 3,
+	GPIO_PORTE = 4,
+	GPIO_PORTH = 7
+} GPIO_Port_t;
+
+typedef enum
+{
+	GPIO_MODE_INPUT = 0,
+	GPIO_MODE_OUTPUT,
+	GPIO_MODE_ALTERNATE,
+	GPIO_MODE_ANALOG
+} GPIO_Mode_t;
+
+typedef enum
+{
+	GPIO_OUTPUT_PUSH_PULL = 0,
+	GPIO_OUTPUT_OPEN_DRAIN
+} GPIO_Output_Type_t;
+
+typedef enum
+{
+	GPIO_SPEED_LOW = 0,
+	GPIO_SPEED_MEDIUM,
+	GPIO_SPEED_HIGH,
+	GPIO_SPEED_VERY_HIGH
+} GPIO_Speed_t;
+
+typedef enum
+{
+	GPIO_PULL_NONE = 0,
+	GPIO_PULL_UP,
+	GPIO_PULL_DOWN
+} GPIO_Pull_t;
+
+typedef enum
+{
+	GPIO_LOW = 0,
+	GPIO_HIGH
+} GPIO_Level_t;
+
+typedef enum
+{
+	GPIO_EXTI_RISING = 1,
+	GPIO_EXTI_FALLING,
+	GPIO_EXTI_BOTH
+} GPIO_EXTI_Edge_t;
+
+typedef struct
+{
+	GPIO_Port_t Port;
+	uint8_t Pin;						/* !< 0 .. 15 */
+	GPIO_Mode_t Mode;
+	GPIO_Output_Type_t Output_Type;
+	GPIO_Speed_t Speed;
+	GPIO_Pull_t Pull;
+	uint8_t Alternate;					/* !< AF0 .. AF15, used in GPIO_MODE_ALTERNATE */
+} GPIO_Pin_Config_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Configures one pin, turning its port clock on with the first pin.
+ * @param  Pin_Cfg: The pin configuration.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or invalid configuration
+ */
+Std_ReturnType_t GPIO_Pin_Init(const GPIO_Pin_Config_t * Pin_Cfg);
+/**
+ * @brief  Configures a table of pins. The whole table is checked first, then each port
+ * 		   register is written once for all its pins, with the interrupts masked.
+ * @param  Table: The pin configurations, in any order. A pin given twice takes its last entry.
+ * @param  Count: Number of entries.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or an invalid entry (nothing is written)
+ */
+Std_ReturnType_t GPIO_Init_Table(const GPIO_Pin_Config_t * Table, uint32_t Count);
+/**
+ * @brief  Returns a pin to analog mode (lowest consumption), the port clock
+ * 		   turns off with its last configured pin.
+ * @param  Port: The port.
+ * @param  Pin: The pin, 0 .. 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid port or pin
+ */
+Std_ReturnType_t GPIO_Pin_DeInit(GPIO_Port_t Port, uint32_t Pin);
+/**
+ * @brief  Routes a pin to its EXTI line and calls a handler on the selected edges.
+ * 		   A line serves one port at a time.
+ * @param  Port: The port.
+ * @param  Pin: The pin, 0 .. 15, also the EXTI line.
+ * @param  Edge: The trigger edges.
+ * @param  Handler: Called from the EXTI interrupt, the pending bit already cleared.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, or the line is in use
+ */
+Std_ReturnType_t GPIO_EXTI_Init(GPIO_Port_t Port, uint32_t Pin, GPIO_EXTI_Edge_t Edge, Interrupt_Handler_t Handler);
+/**
+ * @brief  Frees an EXTI line, its NVIC interrupt is disabled once no line of it is in use.
+ * @param  Pin: The EXTI line, 0 .. 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or unused line
+ */
+Std_ReturnType_t GPIO_EXTI_DeInit(uint32_t Pin);
+
+/*
+ * The data path below is inline and does not check its parameters.
+ * Every write is a single BSRR store: atomic against interrupts, no read-modify-write.
+ */
+
+/**
+ * @brief  Drives a pin high.
+ */
+static inline __attribute__((always_inline)) void GPIO_Pin_Set(GPIO_Port_t Port, uint32_t Pin)
+{
+	GPIO_PORT_REGS(Port)->BSRR = GPIO_PIN_MASK(Pin);
+}
+/**
+ * @brief  Drives a pin low.
+ */
+static inline __attribute__((always_inline)) void GPIO_Pin_Reset(GPIO_Port_t Port, uint32_t Pin)
+{
+	GPIO_PORT_REGS(Port)->BSRR = GPIO_PIN_MASK(Pin) << GPIO_BSRR_RESET_POS;
+}
+/**
+ * @brief  Drives a pin to a level.
+ */
+static inline __attribute__((always_inline)) void GPIO_Pin_Write(GPIO_Port_t Port, uint32_t Pin, GPIO_Level_t Level)
+{
+	GPIO_PORT_REGS(Port)->BSRR = GPIO_PIN_MASK(Pin) << ((GPIO_LOW == Level) ? GPIO_BSRR_RESET_POS : 0UL);
+}
+/**
+ * @brief  Inverts a pin. The output is sampled then written in one store,
+ * 		   the other pins of the port are not touched.
+ */
+static inline __attribute__((always_inline)) void GPIO_Pin_Toggle(GPIO_Port_t Port, uint32_t Pin)
+{
+	uint32_t Odr = GPIO_PORT_REGS(Port)->ODR;
+
+	GPIO_PORT_REGS(Port)->BSRR = ((Odr & GPIO_PIN_MASK(Pin)) << GPIO_BSRR_RESET_POS) | (~Odr & GPIO_PIN_MASK(Pin));
+}
+/**
+ * @brief  Reads a pin input level.
+ */
+static inline __attribute__((always_inline)) GPIO_Level_t GPIO_Pin_Read(GPIO_Port_t Port, uint32_t Pin)
+{
+	return (GPIO_Level_t)READ_BIT(GPIO_PORT_REGS(Port)->IDR, Pin);
+}
+/**
+ * @brief  Drives high the pins of a mask (@ref GPIO_Pin_Mask).
+ */
+static inline __attribute__((always_inline)) void GPIO_Port_Set(GPIO_Port_t Port, uint32_t Mask)
+{
+	GPIO_PORT_REGS(Port)->BSRR = Mask & GPIO_PORT_PINS_MASK;
+}
+/**
+ * @brief  Drives low the pins of a mask (@ref GPIO_Pin_Mask).
+ */
+static inline __attribute__((always_inline)) void GPIO_Port_Reset(GPIO_Port_t Port, uint32_t Mask)
+{
+	GPIO_PORT_REGS(Port)->BSRR = (Mask & GPIO_PORT_PINS_MASK) << GPIO_BSRR_RESET_POS;
+}
+/**
+ * @brief  Writes the pins of a mask to the matching bits of a value, in one store.
+ * 		   E.g. a 4-bit bus on pins 4..7: GPIO_Port_Write_Masked(GPIO_PORTB, 0xF0, Nibble << 4)
+ */
+static inline __attribute__((always_inline)) void GPIO_Port_Write_Masked(GPIO_Port_t Port, uint32_t Mask, uint32_t Value)
+{
+	Mask &= GPIO_PORT_PINS_MASK;
+	GPIO_PORT_REGS(Port)->BSRR = ((~Value & Mask) << GPIO_BSRR_RESET_POS) | (Value & Mask);
+}
+/**
+ * @brief  Writes all the 16 outputs of a port at once.
+ */
+static inline __attribute__((always_inline)) void GPIO_Port_Write(GPIO_Port_t Port, uint32_t Value)
+{
+	GPIO_Port_Write_Masked(Port, GPIO_PORT_PINS_MASK, Value);
+}
+/**
+ * @brief  Reads all the 16 inputs of a port at once.
+ */
+static inline __attribute__((always_inline)) uint32_t GPIO_Port_Read(GPIO_Port_t Port)
+{
+	return GPIO_PORT_REGS(Port)->IDR & GPIO_PORT_PINS_MASK;
+}
+/**
+ * @brief  Reads back the 16 output levels of a port.
+ */
+static inline __attribute__((always_inline)) uint32_t GPIO_Port_Read_Output(GPIO_Port_t Port)
+{
+	return GPIO_PORT_REGS(Port)->ODR & GPIO_PORT_PINS_MASK;
+}
+
+#endif /* MCAL_GPIO_GPIO_H_ */
@@ -39,9 +39,45 @@
 #define RCC_HSE_SW_MASK						0x00000001U
 #define RCC_PLL_SW_MASK						0x00000002U
 
+#define RCC_SWS_POS							0x00000002U
+
 #define RCC_HPRE_POS						0x00000004U
 #define RCC_PPRE1_POS						0x0000000AU
 #define RCC_PPRE2_POS						0x0000000DU
+#define RCC_CR_HSION_POS					0UL
+#define RCC_CR_HSIRDY_POS					1UL
+#define RCC_CR_HSEON_POS					16UL
+#define RCC_CR_HSERDY_POS					17UL
+#define RCC_CR_PLLON_POS					24UL
+#define RCC_CR_PLLRDY_POS					25UL
+/* !< Oscillators frequencies in Hz */
+#define RCC_HSI_VALUE						16000000UL
+#define RCC_HSE_VALUE						25000000UL	/* !< BlackPill crystal, change for other boards */
+/* !< Clock tree limits of the STM32F401 in Hz (datasheet, RM0368 6.3.2) */
+#define RCC_HSE_MIN							4000000UL
+#define RCC_HSE_MAX							26000000UL
+#define RCC_PLL_VCO_IN_MIN					1000000UL
+#define RCC_PLL_VCO_IN_MAX					2000000UL
+#define RCC_PLL_VCO_OUT_MIN					192000000UL
+#define RCC_PLL_VCO_OUT_MAX					432000000UL
+#define RCC_SYSCLK_MAX						84000000UL
+#define RCC_PCLK1_MAX						42000000UL
+#define RCC_PCLK2_MAX						84000000UL
+#define RCC_PLL48CLK_VALUE					48000000UL	/* !< USB OTG FS needs it exact, SDIO and RNG at most */
+#define RCC_PLL_M_MIN						2UL
+#define RCC_PLL_M_MAX						63UL
+#define RCC_PLL_N_MIN						50UL
+#define RCC_PLL_N_MAX						432UL
+#define RCC_PLL_Q_MIN						2UL
+#define RCC_PLL_Q_MAX						15UL
+/* !< Polls of a ready flag before giving up */
+#define RCC_READY_TIMEOUT					100000UL
+
+/** @defgroup RCC_Periph_Sleep_Config Peripheral clock in Sleep mode
+  * @{
+  */
+#define RCC_PERIPH_SLEEP_CLOCK_OFF			0x00000000U
+#define RCC_PERIPH_SLEEP_CLOCK_ON			0x00000001U
 /* --------------- Section: Macro Functions Declarations --------------- */
 /* !< IO port A clock enable */
 #define PORTA_CLOCK_ENABLE_POS				0
@@ -76,6 +112,29 @@
 #define RCC_PLL_ENABLE()					(SET_BIT(RCC->CR, 24))
 #define RCC_PLL_DISABLE()					(CLEAR_BIT(RCC->CR, 24))
 
+/* !< PLL output frequencies, exact for F_IN * N, P_DIV is the divider (2, 4, 6 or 8) */
+#define RCC_PLL_VCO_OUT(F_IN, M, N)			(((uint64_t)(F_IN) * (N)) / (M))
+#define RCC_PLL_SYSCLK(F_IN, M, N, P_DIV)	(((uint64_t)(F_IN) * (N)) / ((uint64_t)(M) * (P_DIV)))
+#define RCC_PLL_48CLK(F_IN, M, N, Q)		(((uint64_t)(F_IN) * (N)) / ((uint64_t)(M) * (Q)))
+
+/* @brief Rejects a PLL configuration out of the STM32F401 limits at build time, e.g.
+ * 		  RCC_PLL_STATIC_ASSERT(RCC_HSE_VALUE, 25, 336, 4, 7); at file scope */
+#define RCC_PLL_STATIC_ASSERT(F_IN, M, N, P_DIV, Q)																\
+	_Static_assert(((M) >= RCC_PLL_M_MIN) && ((M) <= RCC_PLL_M_MAX), "PLL_M out of 2..63");						\
+	_Static_assert(((N) >= RCC_PLL_N_MIN) && ((N) <= RCC_PLL_N_MAX), "PLL_N out of 50..432");					\
+	_Static_assert(((P_DIV) == 2) || ((P_DIV) == 4) || ((P_DIV) == 6) || ((P_DIV) == 8), "PLL_P not 2, 4, 6 or 8");	\
+	_Static_assert(((Q) >= RCC_PLL_Q_MIN) && ((Q) <= RCC_PLL_Q_MAX), "PLL_Q out of 2..15");						\
+	_Static_assert(((uint64_t)(F_IN) >= ((uint64_t)RCC_PLL_VCO_IN_MIN * (M))) &&									\
+				   ((uint64_t)(F_IN) <= ((uint64_t)RCC_PLL_VCO_IN_MAX * (M))), "PLL VCO input out of 1..2 MHz");	\
+	_Static_assert((RCC_PLL_VCO_OUT(F_IN, M, N) >= RCC_PLL_VCO_OUT_MIN) &&										\
+				   (RCC_PLL_VCO_OUT(F_IN, M, N) <= RCC_PLL_VCO_OUT_MAX), "PLL VCO output out of 192..432 MHz");	\
+	_Static_assert(RCC_PLL_SYSCLK(F_IN, M, N, P_DIV) <= RCC_SYSCLK_MAX, "SYSCLK above 84 MHz");					\
+	_Static_assert(RCC_PLL_48CLK(F_IN, M, N, Q) <= RCC_PLL48CLK_VALUE, "PLL48CLK above 48 MHz")
+
+/* @brief Rejects at build time a PLL configuration whose PLL48CLK is not exactly 48 MHz (USB OTG FS) */
+#define RCC_PLL_STATIC_ASSERT_USB(F_IN, M, N, Q)																\
+	_Static_assert(((uint64_t)(F_IN) * (N)) == ((uint64_t)RCC_PLL48CLK_VALUE * (M) * (Q)), "PLL48CLK not 48 MHz")
+
 /* --------------- Section: Data Type Declarations --------------- */
 typedef enum
 {
@@ -155,7 +214,8 @@ typedef struct
 	RCC_PLL_Source_t Pll_Clk_Src;	/* !< Main PLL (PLL) Clock source
 	 	 	 	 	 	 	 	 	 Takes RCC_PLL_SOURE_HSI or RCC_PLL_SOURE_HSE */
 	uint32_t PLL_N;					/* !< Main PLL (PLL) multiplication factor
-										Takes a value from (192) to (432)
+										Takes a value from (50) to (432), with the
+										VCO output within 192..432 MHz
 										Anything else is wrong configurations */
 	uint32_t PLL_M;					/* !< Division factor for the main PLL
 										Takes a value from (2) to (63) */
@@ -164,9 +224,17 @@ typedef struct
 	 	 	 	 	 	 	 	 	  	 Takes a value from (2) to (15) */
 	uint32_t PLL_P;					/* !< Main PLL (PLL) division factor
 	 	 	 	 	 	 	 	 	 	 for main system clock
-	 	 	 	 	 	 	 	 		Takes 2, 4, 6, or 8*/
+	 	 	 	 	 	 	 	 		Takes 2, 4, 6, or 8 as @ref RCC_PLL_P_t */
 } RCC_PLL_Cfgs_t;
 
+typedef struct
+{
+	uint32_t VCO_Input;				/* !< f_in / M */
+	uint32_t VCO_Output;			/* !< f_in * N / M */
+	uint32_t SYSCLK;				/* !< VCO output / P */
+	uint32_t PLL48CLK;				/* !< VCO output / Q, USB OTG FS, SDIO and RNG */
+} RCC_PLL_Freqs_t;
+
 typedef struct
 {
 	RCC_OscInit_t Oscillator_Configurations;
@@ -176,10 +244,222 @@ typedef struct
 	RCC_APB2_Prescaler_t APB2_Prescaler;
 	RCC_PLL_Cfgs_t PLL_Configurations;
 } RCC_InitConfigs_t;
+
+typedef struct
+{
+	uint32_t SYSCLK;
+	uint32_t HCLK;
+	uint32_t PCLK1;
+	uint32_t PCLK2;
+	uint32_t APB1_Timer;
+	uint32_t APB2_Timer;
+} RCC_Clock_Freqs_t;
+
+typedef enum
+{
+	RCC_BUS_AHB1 = 0,
+	RCC_BUS_AHB2,
+	RCC_BUS_APB1,
+	RCC_BUS_APB2
+} RCC_Bus_t;
+
+/* !< Gated peripheral clocks, each one maps to a bit of an *ENR / *LPENR register */
+typedef enum
+{
+	/* AHB1 */
+	RCC_PERIPH_GPIOA = 0,
+	RCC_PERIPH_GPIOB,
+	RCC_PERIPH_GPIOC,
+	RCC_PERIPH_GPIOD,
+	RCC_PERIPH_GPIOE,
+	RCC_PERIPH_GPIOH,
+	RCC_PERIPH_CRC,
+	RCC_PERIPH_DMA1,
+	RCC_PERIPH_DMA2,
+	/* AHB2 */
+	RCC_PERIPH_OTGFS,
+	/* APB1 */
+	RCC_PERIPH_TIM2,
+	RCC_PERIPH_TIM3,
+	RCC_PERIPH_TIM4,
+	RCC_PERIPH_TIM5,
+	RCC_PERIPH_WWDG,
+	RCC_PERIPH_SPI2,
+	RCC_PERIPH_SPI3,
+	RCC_PERIPH_USART2,
+	RCC_PERIPH_I2C1,
+	RCC_PERIPH_I2C2,
+	RCC_PERIPH_I2C3,
+	RCC_PERIPH_PWR,
+	/* APB2 */
+	RCC_PERIPH_TIM1,
+	RCC_PERIPH_USART1,
+	RCC_PERIPH_USART6,
+	RCC_PERIPH_ADC1,
+	RCC_PERIPH_SDIO,
+	RCC_PERIPH_SPI1,
+	RCC_PERIPH_SPI4,
+	RCC_PERIPH_SYSCFG,
+	RCC_PERIPH_TIM9,
+	RCC_PERIPH_TIM10,
+	RCC_PERIPH_TIM11,
+	RCC_PERIPH_COUNT
+} RCC_Periph_Clock_t;
+
+/* !< Frequencies in Hz decoded by RCC_Update_Clock_Freqs(), read through the getters */
+extern RCC_Clock_Freqs_t RCC_Clock_Freqs_Cache;
 /*---------------  Section: Function Declarations --------------- */
 Std_ReturnType_t RCC_Init(const RCC_InitConfigs_t * rcc_cfgs);
 
 void RCC_Switch_Systen_Clock(const RCC_Clock_Source_t Clock_Source);
 RCC_Clock_Source_t RCC_Get_Systen_Clock(void);
 
+/**
+ * @brief  Decodes RCC->CFGR and RCC->PLLCFGR into the frequency cache.
+ * 		   RCC_Init() and RCC_Switch_Systen_Clock() call it, code changing
+ * 		   the clock tree registers directly has to call it too.
+ */
+void RCC_Update_Clock_Freqs(void);
+/**
+ * @brief  Computes the frequencies a configuration would give, without touching the hardware.
+ * @param  rcc_cfgs: The configuration, as for RCC_Init().
+ * @param  Freqs: Returns the frequencies.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer, invalid PLL configuration, or an APB clock above its limit
+ */
+Std_ReturnType_t RCC_Compute_Clock_Freqs(const RCC_InitConfigs_t * rcc_cfgs, RCC_Clock_Freqs_t * Freqs);
+/**
+ * @brief  Turns the main PLL off, moving SYSCLK to HSI first if the PLL clocks it.
+ * 		   The PLL must be off to change its factors or the voltage scaling.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: HSI or the PLL did not answer in time
+ */
+Std_ReturnType_t RCC_PLL_Stop(void);
+/**
+ * @brief  Reads all the cached clock frequencies.
+ * @param  Freqs: Returns a copy of the cache.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t RCC_Get_Clock_Freqs(RCC_Clock_Freqs_t * Freqs);
+
+/**
+ * @brief  Returns the current system clock frequency, from the cache.
+ * @return SYSCLK in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_SYSCLK_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.SYSCLK;
+}
+/**
+ * @brief  Returns the current AHB clock frequency (SYSCLK / HPRE), from the cache.
+ * @return HCLK in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_HCLK_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.HCLK;
+}
+/**
+ * @brief  Returns the current APB1 clock frequency (HCLK / PPRE1), from the cache.
+ * @return PCLK1 in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_PCLK1_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.PCLK1;
+}
+/**
+ * @brief  Returns the current APB2 clock frequency (HCLK / PPRE2), from the cache.
+ * @return PCLK2 in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_PCLK2_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.PCLK2;
+}
+/**
+ * @brief  Returns the clock of the timers on APB1 (TIM2..TIM5), from the cache.
+ * @return PCLK1, doubled when APB1 is divided, in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_APB1_Timer_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.APB1_Timer;
+}
+/**
+ * @brief  Returns the clock of the timers on APB2 (TIM1, TIM9..TIM11), from the cache.
+ * @return PCLK2, doubled when APB2 is divided, in Hz.
+ */
+static inline __attribute__((always_inline)) uint32_t RCC_Get_APB2_Timer_Freq(void)
+{
+	return RCC_Clock_Freqs_Cache.APB2_Timer;
+}
+/**
+ * @brief  Checks a PLL configuration against the clock tree limits
+ * 		   (M, N, P, Q ranges, VCO input 1..2 MHz, VCO output 192..432 MHz,
+ * 		   SYSCLK up to 84 MHz, PLL48CLK up to 48 MHz).
+ * @param  Input_Freq: The PLL source frequency in Hz.
+ * @param  Pll: The configuration, the source field is not used.
+ * @param  Freqs: Returns the resulting frequencies, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: The configuration is valid
+ *         - E_NOT_OK: Out of range or NULL configuration
+ */
+Std_ReturnType_t RCC_PLL_Check(uint32_t Input_Freq, const RCC_PLL_Cfgs_t * Pll, RCC_PLL_Freqs_t * Freqs);
+/**
+ * @brief  Picks the M, N, P and Q giving the SYSCLK closest to a target.
+ * 		   On a tie the highest VCO input (lowest jitter) is kept.
+ * @param  Input_Freq: The PLL source frequency in Hz (HSI, or a 4..26 MHz HSE).
+ * @param  Target_SYSCLK: The wanted SYSCLK in Hz, up to 84 MHz.
+ * @param  Require_48MHz: Non zero to accept only an exact 48 MHz PLL48CLK (USB).
+ * @param  Pll: Returns M, N, P and Q, the source field is left untouched.
+ * @param  Freqs: Returns the achieved frequencies, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Parameters out of range or no configuration found
+ */
+Std_ReturnType_t RCC_PLL_Solve(uint32_t Input_Freq, uint32_t Target_SYSCLK, uint32_t Require_48MHz,
+							   RCC_PLL_Cfgs_t * Pll, RCC_PLL_Freqs_t * Freqs);
+/**
+ * @brief  Takes a reference on a peripheral clock, the first one turns the clock on.
+ * 		   Every driver acquires the clocks it uses in its init and releases them in its de-init.
+ * @param  Clock: The peripheral clock.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or reference counter full
+ */
+Std_ReturnType_t RCC_Periph_Clock_Acquire(RCC_Periph_Clock_t Clock);
+/**
+ * @brief  Drops a reference on a peripheral clock, the last one turns the clock off.
+ * @param  Clock: The peripheral clock.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or no reference held
+ */
+Std_ReturnType_t RCC_Periph_Clock_Release(RCC_Periph_Clock_t Clock);
+/**
+ * @brief  Chooses whether an enabled peripheral clock keeps running in Sleep mode
+ * 		   (*LPENR bit, all of them are on out of reset).
+ * @param  Clock: The peripheral clock.
+ * @param  State: @ref RCC_Periph_Sleep_Config
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or state
+ */
+Std_ReturnType_t RCC_Periph_Clock_Sleep_Config(RCC_Periph_Clock_t Clock, uint32_t State);
+/**
+ * @brief  Returns the number of references held on a peripheral clock, 0 for an invalid clock.
+ */
+uint8_t RCC_Periph_Clock_Get_Users(RCC_Periph_Clock_t Clock);
+/**
+ * @brief  Returns 1 if a peripheral clock is on, whoever turned it on, 0 otherwise.
+ */
+uint32_t RCC_Periph_Clock_Is_Enabled(RCC_Periph_Clock_t Clock);
+/**
+ * @brief  Returns the enable register of a bus, one bit per enabled clock (0 for an invalid bus).
+ * @param  Bus: The bus.
+ * @param  Sleep: 0 for the run mode *ENR register, 1 for the Sleep mode *LPENR one.
+ */
+uint32_t RCC_Get_Enabled_Clocks(RCC_Bus_t Bus, uint32_t Sleep);
+
 #endif /* MCAL_RCC_RCC_H_ */
@@ -0,0 +1,153 @@
+/**
+ ******************************************************************************
+ * @file           : usart.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : USART Device-Driver Header Interface File.
+ * 					 USART1, USART2 and USART6 with DMA in both directions:
+ * 					 circular reception delivered on IDLE line, half and full
+ * 					 buffer, and queued transmission of scatter lists.
+ * 					 The TX / RX pins are configured by the application (AF7 USART1/2, AF8 USART6).
+ ******************************************************************************
+ */
+
+#ifndef MCAL_USART_USART_H_
+#define MCAL_USART_USART_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "Common/stm32f401_registers.h"
+#include "MCAL/RCC/rcc.h"
+#include "usart_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define USART_RX_BUFFER_MAX					0xFFFFUL	/* !< Bound by the DMA NDTR */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+typedef enum
+{
+	USART_1 = 0,
+	USART_2,
+	USART_6,
+	USART_COUNT
+} USART_Id_t;
+
+typedef enum
+{
+	USART_PARITY_NONE = 0,
+	USART_PARITY_EVEN,
+	USART_PARITY_ODD
+} USART_Parity_t;
+
+typedef enum
+{
+	USART_STOP_BITS_1 = 0,
+	USART_STOP_BITS_2 = 2
+} USART_Stop_Bits_t;
+
+/*
+ * @brief 	Receives the bytes that arrived since the last call, from the interrupt.
+ * 			A frame wrapping the end of the buffer comes in two calls.
+ * 			The data stays valid until the DMA laps the buffer, copy it out.
+ */
+typedef void (*USART_Rx_Handler_t)(const uint8_t * Data, uint32_t Length);
+
+/*
+ * @brief 	Called from the interrupt once the last segment of a scatter list
+ * 			is handed to the USART, the segments may be reused then.
+ */
+typedef void (*USART_Tx_Done_t)(void);
+
+typedef struct
+{
+	const uint8_t * Data;
+	uint16_t Length;
+} USART_Tx_Segment_t;
+
+typedef struct
+{
+	USART_Id_t Id;
+	uint32_t Baud_Rate;
+	USART_Parity_t Parity;			/* !< 8 data bits, plus the parity bit when used */
+	USART_Stop_Bits_t Stop_Bits;
+	uint8_t * Rx_Buffer;			/* !< Circular DMA buffer, sized for the data of the longest handler latency */
+	uint16_t Rx_Buffer_Size;
+	USART_Rx_Handler_t Rx_Handler;
+} USART_Config_t;
+
+typedef struct
+{
+	uint32_t Rx_Bytes;
+	uint32_t Rx_Frames;				/* !< IDLE line events with data */
+	uint32_t Tx_Bytes;
+	uint32_t Overrun_Errors;
+	uint32_t Framing_Errors;
+	uint32_t Noise_Errors;
+	uint32_t Parity_Errors;
+	uint32_t Baud_Error_Permille;	/* !< Deviation of the achieved baud rate */
+} USART_Stats_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Initializes a USART: baud rate from the live PCLK, circular DMA reception
+ * 		   with IDLE line detection, DMA transmission, and the error interrupt.
+ * @param  Config: The configuration.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid configuration, baud rate out of reach, or a DMA stream failed
+ */
+Std_ReturnType_t USART_Init(const USART_Config_t * Config);
+/**
+ * @brief  Stops a USART and its DMA streams and releases their clocks.
+ * 		   The queued transmissions are dropped without their callbacks.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or not initialized USART
+ */
+Std_ReturnType_t USART_DeInit(USART_Id_t Id);
+/**
+ * @brief  Queues a scatter list, sent by DMA one segment after the other
+ * 		   with one interrupt per segment. Empty segments are skipped.
+ * @param  Id: The USART.
+ * @param  Segments: The list, it and its data must stay valid until Done is called.
+ * @param  Count: Number of segments.
+ * @param  Done: Called when the list is sent, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, not initialized USART or queue full
+ */
+Std_ReturnType_t USART_Transmit(USART_Id_t Id, const USART_Tx_Segment_t * Segments, uint8_t Count, USART_Tx_Done_t Done);
+/**
+ * @brief  Recomputes the baud rate divider from the live PCLK, after a clock change.
+ * 		   Waits for the current character to leave.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or not initialized USART, or baud rate out of reach
+ */
+Std_ReturnType_t USART_Update_Baud_Rate(USART_Id_t Id);
+/**
+ * @brief  Clock change listener updating every initialized USART,
+ * 		   it matches the performance profiles listener type.
+ */
+void USART_Clock_Changed(const RCC_Clock_Freqs_t * Old_Freqs, const RCC_Clock_Freqs_t * New_Freqs);
+/**
+ * @brief  Reads the statistics of a USART.
+ * @param  Id: The USART.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid USART or NULL pointer
+ */
+Std_ReturnType_t USART_Get_Stats(USART_Id_t Id, USART_Stats_t * Stats);
+/**
+ * @brief  Clears the counters of a USART, the baud rate error is kept.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid USART
+ */
+Std_ReturnType_t USART_Reset_Stats(USART_Id_t Id);
+
+#endif /* MCAL_USART_USART_H_ */
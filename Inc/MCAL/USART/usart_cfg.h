@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file           : usart_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : USART Driver Configurations File.
+ ******************************************************************************
+ */
+#ifndef MCAL_USART_USART_CFG_H_
+#define MCAL_USART_USART_CFG_H_
+
+/* !< Scatter lists waiting per USART, the one being sent included */
+#define USART_TX_QUEUE_DEPTH				4U
+
+/* !< Priority of the USART and of its two DMA streams, equal so the RX paths never nest */
+#define USART_IRQ_PRIORITY					5UL
+
+/* !< DMA requests (RM0368 tables 28 and 29), streams not shared between the USARTs:
+ * 	  USART1 RX DMA2 S2, TX DMA2 S7, channel 4
+ * 	  USART2 RX DMA1 S5, TX DMA1 S6, channel 4
+ * 	  USART6 RX DMA2 S1, TX DMA2 S6, channel 5 */
+#define USART1_RX_DMA_STREAM				2U
+#define USART1_TX_DMA_STREAM				7U
+#define USART2_RX_DMA_STREAM				5U
+#define USART2_TX_DMA_STREAM				6U
+#define USART6_RX_DMA_STREAM				1U
+#define USART6_TX_DMA_STREAM				6U
+
+#endif /* MCAL_USART_USART_CFG_H_ */
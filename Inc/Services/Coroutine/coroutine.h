@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file           : coroutine.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Stackless Coroutines (Protothreads) Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_COROUTINE_COROUTINE_H_
+#define SERVICES_COROUTINE_COROUTINE_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "MCAL/DMA/dma.h"
+#include "MCAL/FLASH/flash.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/*
+ * A coroutine is a function taking its Coroutine_t and returning Coroutine_State_t.
+ * The main loop calls every coroutine again and again; a waiting coroutine returns
+ * at once and resumes at the same await point on the next call. All the coroutines
+ * share the caller stack, which also means that local variables are lost at every
+ * await point: keep the state in static variables or in a context structure.
+ * switch statements cannot be used around an await point.
+ *
+ *	static Coroutine_State_t Logger_Flow(Coroutine_t * Co)
+ *	{
+ *		COROUTINE_BEGIN(Co);
+ *		while(1)
+ *		{
+ *			DMA2_Init(&Dma_Cfgs, &Stream_Cfgs);
+ *			COROUTINE_AWAIT_DMA(Co, DMA2, 0);
+ *			Flash_Program_Start(Address, Word);
+ *			COROUTINE_AWAIT_FLASH(Co);
+ *			Flash_Operation_Finish();
+ *			COROUTINE_SLEEP(Co, 100);
+ *		}
+ *		COROUTINE_END(Co);
+ *	}
+ */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* @brief Prepares a coroutine to start from its beginning */
+#define COROUTINE_INIT(CO)					((CO)->Line = 0)
+
+/* @brief Opens the body of a coroutine, resuming at the last await point */
+#define COROUTINE_BEGIN(CO)					switch((CO)->Line) { case 0:
+
+/* @brief Closes the body of a coroutine, the coroutine is done */
+#define COROUTINE_END(CO)					} (CO)->Line = 0; return COROUTINE_DONE
+
+/* @brief Returns until the condition is true */
+#define COROUTINE_AWAIT(CO, COND)			do { (CO)->Line = __LINE__; case __LINE__:		\
+												 if(!(COND)) { return COROUTINE_WAITING; } } while(0)
+
+/* @brief Lets the other coroutines run once */
+#define COROUTINE_YIELD(CO)					do { (CO)->Line = __LINE__; return COROUTINE_WAITING;	\
+												 case __LINE__: ; } while(0)
+
+/* @brief Ends the coroutine from anywhere in its body */
+#define COROUTINE_EXIT(CO)					do { (CO)->Line = 0; return COROUTINE_DONE; } while(0)
+
+/* @brief Returns until the SysTick tick count reaches an absolute deadline */
+#define COROUTINE_AWAIT_DEADLINE(CO, TICK)	do { (CO)->Deadline = (TICK);							\
+												 COROUTINE_AWAIT(CO, SysTick_Get_Ticks() >= (CO)->Deadline); } while(0)
+
+/* @brief Returns for a number of SysTick ticks (the timebase must be started) */
+#define COROUTINE_SLEEP(CO, TICKS)			COROUTINE_AWAIT_DEADLINE(CO, SysTick_Get_Ticks() + (TICKS))
+
+/* @brief Returns until a DMA stream transfer is complete (EN cleared by the hardware) */
+#define COROUTINE_AWAIT_DMA(CO, DMAx, STREAM_IDX)	COROUTINE_AWAIT(CO, !DMA_STREAM_IS_ENABLED(DMAx, STREAM_IDX))
+
+/* @brief Returns until the FLASH operation started without waiting is over (BSY cleared) */
+#define COROUTINE_AWAIT_FLASH(CO)			COROUTINE_AWAIT(CO, !FLASH_IS_BUSY())
+
+/* @brief Runs a child coroutine to completion before going on */
+#define COROUTINE_AWAIT_CHILD(CO, CHILD_CALL)	COROUTINE_AWAIT(CO, COROUTINE_DONE == (CHILD_CALL))
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+typedef enum
+{
+	COROUTINE_WAITING = 0,
+	COROUTINE_DONE
+} Coroutine_State_t;
+
+/*
+ * @brief 	Coroutine control block: the resume point and the sleep deadline.
+ * 			16 bytes per flow, the stack is shared.
+ */
+typedef struct
+{
+	uint32_t Line;
+	uint64_t Deadline;
+} Coroutine_t;
+/*---------------  Section: Function Declarations --------------- */
+
+#endif /* SERVICES_COROUTINE_COROUTINE_H_ */
@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @file           : deferred.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Deferred Interrupt Work Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_DEFERRED_DEFERRED_H_
+#define SERVICES_DEFERRED_DEFERRED_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "deferred_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+typedef void (*Deferred_Handler_t)(void * Arg);
+
+/*
+ * @brief 	Work item, owned by the caller and posted by reference.
+ * 			Set up with Deferred_Work_Init(), do not touch it while pending.
+ */
+typedef struct Deferred_Work_s
+{
+	Deferred_Handler_t Handler;
+	void * Arg;
+	struct Deferred_Work_s * volatile Next;
+	volatile uint32_t Pending;			/* !< Posted and not run yet, further posts coalesce */
+} Deferred_Work_t;
+
+typedef struct
+{
+	uint32_t Posted;					/* !< Posts queued */
+	uint32_t Coalesced;					/* !< Posts merged into an item already pending */
+	uint32_t Dropped;					/* !< Posts refused, the queue was full */
+	uint32_t Executed;					/* !< Handlers run */
+	uint32_t High_Water;				/* !< Most items pending at once */
+} Deferred_Stats_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Initializes the queue and, when owned, the PendSV priority.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Operation failed
+ */
+Std_ReturnType_t Deferred_Init(void);
+/**
+ * @brief  Sets up a work item.
+ * @param  Work: The work item.
+ * @param  Handler: Runs in the deferred context.
+ * @param  Arg: Passed to the handler.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or the item is pending
+ */
+Std_ReturnType_t Deferred_Work_Init(Deferred_Work_t * Work, Deferred_Handler_t Handler, void * Arg);
+/**
+ * @brief  Queues a work item, lock-free, from any interrupt or thread.
+ * 		   The item runs once however many times it is posted before it runs.
+ * @param  Work: The work item.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Queued or coalesced
+ *         - E_NOT_OK: NULL pointer or queue full (counted as dropped)
+ */
+Std_ReturnType_t Deferred_Post(Deferred_Work_t * Work);
+/**
+ * @brief  Runs all the queued work in posting order.
+ * 		   Called by PendSV_Handler when owned, by the application otherwise.
+ * 		   Must not preempt itself.
+ */
+void Deferred_Run(void);
+/**
+ * @brief  Registers a hook called on every post that queued an item, to wake
+ * 		   up the context calling Deferred_Run() when PendSV is not owned.
+ * @param  Notify: The hook, called from the posting context, NULL to remove it.
+ */
+void Deferred_Register_Notify(void (*Notify)(void));
+/**
+ * @brief  Reads the queue statistics.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Deferred_Get_Stats(Deferred_Stats_t * Stats);
+/**
+ * @brief  Clears the statistics, the high-water mark restarts from the current depth.
+ */
+void Deferred_Reset_Stats(void);
+
+#endif /* SERVICES_DEFERRED_DEFERRED_H_ */
@@ -0,0 +1,27 @@
+/**
+ ******************************************************************************
+ * @file           : deferred_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Deferred Interrupt Work Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_DEFERRED_DEFERRED_CFG_H_
+#define SERVICES_DEFERRED_DEFERRED_CFG_H_
+
+/* !< Most work items waiting at once, the posts beyond are dropped */
+#define DEFERRED_QUEUE_DEPTH			16U
+
+/* !< Owned, the service defines PendSV_Handler and drains the queue in it.
+ * 	  Not owned, Deferred_Run() is called by the application, the notify hook tells when.
+ * 	  Must be not owned when the kernel is linked, it switches the threads in PendSV
+ * 	  (kernel.c stops the build otherwise). */
+#define DEFERRED_PENDSV_NOT_OWNED		0UL
+#define DEFERRED_PENDSV_OWNED			1UL
+
+#define DEFERRED_PENDSV_STATE			DEFERRED_PENDSV_NOT_OWNED
+
+/* !< PendSV priority (0..15, as for NVIC_SetPriority()), the lowest so the
+ * 	  deferred work never delays an interrupt handler */
+#define DEFERRED_PENDSV_PRIORITY		15UL
+
+#endif /* SERVICES_DEFERRED_DEFERRED_CFG_H_ */
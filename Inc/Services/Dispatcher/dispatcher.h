@@ -0,0 +1,94 @@
+/**
+ ******************************************************************************
+ * @file           : dispatcher.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Rate-Monotonic Periodic Task Dispatcher Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_DISPATCHER_DISPATCHER_H_
+#define SERVICES_DISPATCHER_DISPATCHER_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "dispatcher_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+#if (DISPATCHER_RUN_MODE != DISPATCHER_RUN_IN_ISR) && (DISPATCHER_RUN_MODE != DISPATCHER_RUN_IN_THREAD)
+#error "Invalid Dispatcher Run Mode Configurations"
+#endif
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Periodic task body, runs to completion
+ */
+typedef void (*Dispatcher_Task_t)(void);
+
+/*
+ * @brief 	Run-time statistics of one task
+ */
+typedef struct
+{
+	uint32_t Releases;				/* !< Number of periods started */
+	uint32_t Runs;					/* !< Number of completed executions */
+	uint32_t Overruns;				/* !< Releases found the previous one not finished */
+	uint32_t Last_Cycles;			/* !< Execution time of the last run in CPU cycles */
+	uint32_t Worst_Cycles;			/* !< Longest execution time in CPU cycles */
+	uint64_t Total_Cycles;			/* !< Sum of the execution times, Total / Runs is the mean */
+} Dispatcher_TaskStats_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Clears the task table, starts the DWT cycle counter and hooks
+ *         the service to the SysTick interrupt.
+ *         The SysTick timebase must be started to make the tasks run.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t Dispatcher_Init(void);
+/**
+ * @brief  Adds a periodic task to the table. Tasks are kept sorted by period,
+ *         the shortest period runs first (rate-monotonic priority).
+ *         Give tasks of the same rate different phases to spread them over the ticks,
+ *         e.g. 100 Hz at phase 3 and 10 Hz at phase 7 with a 1 kHz tick.
+ * @param  Task: The task body.
+ * @param  Period_Ticks: Release period in SysTick ticks.
+ * @param  Phase_Ticks: Offset of the first release, less than the period.
+ * @param  Task_Id: Returns the task id used by the statistics API, may be NULL.
+ *         Ids of tasks added before are shifted by a shorter period task.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters or table full
+ */
+Std_ReturnType_t Dispatcher_Add_Task(Dispatcher_Task_t Task, uint32_t Period_Ticks,
+									 uint32_t Phase_Ticks, uint8_t * Task_Id);
+/**
+ * @brief  Advances the dispatcher by one tick and releases the due tasks.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void Dispatcher_Tick(void);
+/**
+ * @brief  Runs the released tasks, highest priority first, until none is pending.
+ *         Call it from the main loop when DISPATCHER_RUN_MODE is DISPATCHER_RUN_IN_THREAD,
+ *         it does nothing in the other mode.
+ * @return The number of tasks executed.
+ */
+uint32_t Dispatcher_Run(void);
+/**
+ * @brief  Reads the statistics of a task.
+ * @param  Task_Id: The task id.
+ * @param  Stats: Returns a consistent copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Unknown task or NULL pointer
+ */
+Std_ReturnType_t Dispatcher_Get_Stats(uint8_t Task_Id, Dispatcher_TaskStats_t * Stats);
+/**
+ * @brief  Clears the statistics of all tasks.
+ */
+void Dispatcher_Reset_Stats(void);
+
+#endif /* SERVICES_DISPATCHER_DISPATCHER_H_ */
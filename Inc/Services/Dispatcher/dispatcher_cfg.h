@@ -0,0 +1,20 @@
+/**
+ ******************************************************************************
+ * @file           : dispatcher_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Periodic Task Dispatcher Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_DISPATCHER_DISPATCHER_CFG_H_
+#define SERVICES_DISPATCHER_DISPATCHER_CFG_H_
+
+/* !< Size of the static task table */
+#define DISPATCHER_MAX_TASKS			8U
+
+/* !< Where the released tasks run */
+#define DISPATCHER_RUN_IN_ISR			0UL		/* !< Inside the SysTick interrupt */
+#define DISPATCHER_RUN_IN_THREAD		1UL		/* !< From Dispatcher_Run() in the main loop */
+
+#define DISPATCHER_RUN_MODE				DISPATCHER_RUN_IN_ISR
+
+#endif /* SERVICES_DISPATCHER_DISPATCHER_CFG_H_ */
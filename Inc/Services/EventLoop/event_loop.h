@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file           : event_loop.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Low-Power Event Loop Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_EVENTLOOP_EVENT_LOOP_H_
+#define SERVICES_EVENTLOOP_EVENT_LOOP_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "event_loop_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Loop statistics, the times are in SysTick input clock cycles.
+ * 			Idle excludes the interrupts served while the loop was asleep,
+ * 			the core clock and so the DWT cycle counter stop in sleep.
+ */
+typedef struct
+{
+	uint32_t Wakeups;					/* !< Returns from sleep to the loop */
+	uint32_t Dispatched;				/* !< Event handlers run */
+	uint64_t Idle_Cycles;				/* !< Time the core was asleep */
+	uint64_t Elapsed_Cycles;			/* !< Time since the last reset */
+	uint32_t Load_Permille;				/* !< CPU load, 1000 * (1 - Idle / Elapsed) */
+} Event_Loop_Stats_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Initializes the loop and the sleep configuration (SCB->SCR).
+ * 		   The SysTick timebase must be running for the idle accounting.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No cycle counter
+ */
+Std_ReturnType_t Event_Loop_Init(void);
+/**
+ * @brief  Registers the handler of an event, run in the loop (thread mode).
+ * @param  Event_Id: The event, 0 to EVENT_LOOP_MAX_EVENTS - 1.
+ * @param  Handler: The handler, NULL to remove it.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid event
+ */
+Std_ReturnType_t Event_Loop_Register(uint8_t Event_Id, Interrupt_Handler_t Handler);
+/**
+ * @brief  Posts an event, from an interrupt or the loop itself.
+ * 		   Posts of the same event before it runs are merged.
+ * @param  Event_Id: The event.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid event
+ */
+Std_ReturnType_t Event_Loop_Post(uint8_t Event_Id);
+/**
+ * @brief  Runs the handlers of the posted events, or sleeps until an interrupt
+ * 		   when none is posted. For a loop that does other work too.
+ */
+void Event_Loop_Run_Once(void);
+/**
+ * @brief  Runs the loop forever.
+ */
+void Event_Loop_Run(void);
+/**
+ * @brief  Reads the loop statistics.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Event_Loop_Get_Stats(Event_Loop_Stats_t * Stats);
+/**
+ * @brief  Clears the statistics and starts a new measurement window.
+ */
+void Event_Loop_Reset_Stats(void);
+
+#endif /* SERVICES_EVENTLOOP_EVENT_LOOP_H_ */
@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file           : event_loop_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Low-Power Event Loop Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_EVENTLOOP_EVENT_LOOP_CFG_H_
+#define SERVICES_EVENTLOOP_EVENT_LOOP_CFG_H_
+
+/* !< Number of events (1 to 32), event 0 is dispatched first */
+#define EVENT_LOOP_MAX_EVENTS			32U
+
+/* !< WFI sleeps until an interrupt is taken, WFE also wakes up on a pending
+ * 	  interrupt that is disabled or masked (SEVONPEND) and on SEV */
+#define EVENT_LOOP_SLEEP_WFI			0UL
+#define EVENT_LOOP_SLEEP_WFE			1UL
+
+#define EVENT_LOOP_SLEEP_MODE			EVENT_LOOP_SLEEP_WFE
+
+/* !< Sleep-on-exit: an interrupt that posts no event returns straight to
+ * 	  sleep, without unstacking to the loop and stacking again */
+#define EVENT_LOOP_SLEEP_ON_EXIT_DISABLED	0UL
+#define EVENT_LOOP_SLEEP_ON_EXIT_ENABLED	1UL
+
+#define EVENT_LOOP_SLEEP_ON_EXIT_STATE		EVENT_LOOP_SLEEP_ON_EXIT_ENABLED
+
+#endif /* SERVICES_EVENTLOOP_EVENT_LOOP_CFG_H_ */
@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Compressed Append-Only Flash Data Logger Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_FLASHLOG_FLASH_LOG_H_
+#define SERVICES_FLASHLOG_FLASH_LOG_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "MCAL/FLASH/flash.h"
+#include "flash_log_cfg.h"
+#include "flash_log_codec.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Compression and write throughput of the logger since FlashLog_Init()
+ */
+typedef struct
+{
+	uint32_t Samples;					/* !< Samples committed to flash */
+	uint32_t Raw_Bytes;					/* !< Size of the committed samples as plain 32-bit words */
+	uint32_t Flash_Bytes;				/* !< Bytes programmed, framing included */
+	uint32_t Blocks;					/* !< Blocks committed */
+	uint32_t Sector_Erases;				/* !< Sectors erased to make room */
+	uint32_t Compression_Ratio_x100;	/* !< Raw_Bytes * 100 / Flash_Bytes */
+	uint64_t Write_Cycles;				/* !< CPU cycles spent programming and erasing */
+	uint32_t Bytes_Per_MCycle;			/* !< Flash_Bytes per million CPU cycles of Write_Cycles */
+} FlashLog_Stats_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Finds the end of the log in the configured sectors and
+ *         resumes appending after the newest valid block.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: A log sector overlaps the program image, or a flash operation failed
+ */
+Std_ReturnType_t FlashLog_Init(void);
+/**
+ * @brief  Appends a sample to the RAM block, the block is
+ *         programmed in one batch once it is full.
+ * @param  Sample: The sample to log.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Logger not initialized or flash failure
+ */
+Std_ReturnType_t FlashLog_Append(int32_t Sample);
+/**
+ * @brief  Programs the partially filled RAM block now (e.g. before a reset).
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Logger not initialized or flash failure
+ */
+Std_ReturnType_t FlashLog_Flush(void);
+/**
+ * @brief  Reports the compression ratio and the write throughput.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t FlashLog_GetStats(FlashLog_Stats_t * Stats);
+
+#endif /* SERVICES_FLASHLOG_FLASH_LOG_H_ */
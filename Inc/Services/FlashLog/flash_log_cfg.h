@@ -0,0 +1,21 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Flash Data Logger Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_FLASHLOG_FLASH_LOG_CFG_H_
+#define SERVICES_FLASHLOG_FLASH_LOG_CFG_H_
+
+/* !< The log ring occupies the sectors from FIRST to LAST (inclusive).
+ * 	  The oldest sector is erased when the ring wraps around, so they must
+ * 	  lie past the program image: FlashLog_Init() refuses them otherwise. */
+#define FLASH_LOG_FIRST_SECTOR		FLASH_SECTOR_4
+#define FLASH_LOG_LAST_SECTOR		FLASH_SECTOR_5
+
+/* !< Size in bytes of a full block (header + payload + CRC).
+ * 	  Must be a multiple of 4 that divides the sector size. */
+#define FLASH_LOG_BLOCK_SIZE		256UL
+
+#endif /* SERVICES_FLASHLOG_FLASH_LOG_CFG_H_ */
@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log_codec.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Flash Data Logger Block Codec Header Interface File.
+ *					 The codec has no hardware dependency, the host decoder
+ *					 in Host/Tools builds it as is, on 64-bit longs too.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_FLASHLOG_FLASH_LOG_CODEC_H_
+#define SERVICES_FLASHLOG_FLASH_LOG_CODEC_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define FLASH_LOG_BLOCK_MAGIC			(0xB10CU)
+#define FLASH_LOG_HEADER_SIZE			(12UL)
+#define FLASH_LOG_CRC_SIZE				(4UL)
+#define FLASH_LOG_BLOCK_OVERHEAD		(FLASH_LOG_HEADER_SIZE + FLASH_LOG_CRC_SIZE)
+/* !< Worst case encoded size of one sample (32-bit varint) */
+#define FLASH_LOG_MAX_SAMPLE_SIZE		(5UL)
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* @brief Truncates to 32 bits, uint32_t is an unsigned long and has 64 bits on LP64 hosts */
+#define FLASH_LOG_U32(V)				((uint32_t)(V) & 0xFFFFFFFFUL)
+/* @brief Reads the 32-bit two's complement value V as a signed number, whatever the width of long */
+#define FLASH_LOG_S32(V)				((FLASH_LOG_U32(V) & 0x80000000UL) ? \
+										 (-(int32_t)(~FLASH_LOG_U32(V) & 0x7FFFFFFFUL) - 1) : (int32_t)FLASH_LOG_U32(V))
+
+/* @brief Maps signed deltas to unsigned so small magnitudes give small varints */
+#define FLASH_LOG_ZIGZAG_ENCODE(V)		FLASH_LOG_U32((FLASH_LOG_U32(V) << 1) ^ (0UL - (FLASH_LOG_U32(V) >> 31)))
+#define FLASH_LOG_ZIGZAG_DECODE(V)		FLASH_LOG_S32((FLASH_LOG_U32(V) >> 1) ^ (0UL - (FLASH_LOG_U32(V) & 1UL)))
+
+/* @brief Rounds a block size up to whole flash words */
+#define FLASH_LOG_WORD_ALIGN(SIZE)		(((SIZE) + 3UL) & ~3UL)
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Block layout as stored in flash (little endian):
+ * 			[Magic:16][Payload_Length:16][Sequence:32][Sample_Count:16][Reserved:16]
+ * 			[Payload: zig-zag varints, first sample absolute, then deltas]
+ * 			[CRC-32 over header + payload][0xFF padding to a word boundary]
+ */
+typedef struct
+{
+	uint8_t * Buffer;			/* !< Block buffer, word aligned */
+	uint32_t Capacity;			/* !< Buffer size in bytes */
+	uint32_t Length;			/* !< Bytes used by header + payload */
+	uint32_t Sample_Count;		/* !< Samples in the current block */
+	int32_t Previous_Sample;	/* !< Reference for the next delta */
+} FlashLog_Encoder_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Starts a new empty block in the encoder buffer.
+ * @param  Encoder: The encoder state.
+ * @param  Buffer: Word aligned buffer holding the block.
+ * @param  Capacity: Buffer size, at least one header, one sample and the CRC.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or buffer too small
+ */
+Std_ReturnType_t FlashLog_Codec_Begin(FlashLog_Encoder_t * Encoder, uint8_t * Buffer, uint32_t Capacity);
+/**
+ * @brief  Appends one sample to the current block.
+ * @param  Encoder: The encoder state.
+ * @param  Sample: The sample to encode.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: The sample is in the block
+ *         - E_NOT_OK: The block is full, seal it and begin a new one
+ */
+Std_ReturnType_t FlashLog_Codec_Append(FlashLog_Encoder_t * Encoder, int32_t Sample);
+/**
+ * @brief  Writes the header and the CRC, and pads the block to a word boundary.
+ * @param  Encoder: The encoder state.
+ * @param  Sequence: Sequence number of the block.
+ * @return Size of the sealed block in bytes (multiple of 4), 0 for an empty block.
+ */
+uint32_t FlashLog_Codec_Seal(FlashLog_Encoder_t * Encoder, uint32_t Sequence);
+/**
+ * @brief  Checks and decodes one block.
+ * @param  Block: Pointer to the first byte of the block.
+ * @param  Available: Bytes readable from Block.
+ * @param  Samples: Array receiving the samples, may be NULL to only validate.
+ * @param  Max_Samples: Size of the Samples array.
+ * @param  Sample_Count: Receives the number of samples in the block.
+ * @param  Sequence: Receives the sequence number, may be NULL.
+ * @param  Block_Size: Receives the block size in flash, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Valid block
+ *         - E_NOT_OK: Bad magic, length, CRC or too many samples
+ */
+Std_ReturnType_t FlashLog_Codec_Decode(const uint8_t * Block, uint32_t Available,
+									   int32_t * Samples, uint32_t Max_Samples, uint32_t * Sample_Count,
+									   uint32_t * Sequence, uint32_t * Block_Size);
+/**
+ * @brief  Computes the CRC-32 (IEEE 802.3) of a byte buffer.
+ * @param  Data: Pointer to the data.
+ * @param  Length: Number of bytes.
+ * @return The CRC value.
+ */
+uint32_t FlashLog_Codec_CRC32(const uint8_t * Data, uint32_t Length);
+
+#endif /* SERVICES_FLASHLOG_FLASH_LOG_CODEC_H_ */
@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file           : isr_profiler.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Interrupt Latency and Duration Profiler Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_ISRPROFILER_ISR_PROFILER_H_
+#define SERVICES_ISRPROFILER_ISR_PROFILER_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "isr_profiler_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+#if ISR_PROFILER_STATE == ISR_PROFILER_ENABLED
+
+/* @brief Defines an interrupt handler NAME timing HANDLER for IRQN,
+ * 		  to be installed in the vector table (e.g. SCB_VectorTable_Install()) */
+#define ISR_PROFILER_WRAP(NAME, IRQN, HANDLER)	void NAME(void)							\
+												{										\
+													ISR_Profiler_Enter(IRQN);			\
+													HANDLER();							\
+													ISR_Profiler_Exit(IRQN);			\
+												}
+/* @brief Brackets the body of an existing handler */
+#define ISR_PROFILER_ENTER(IRQN)				ISR_Profiler_Enter(IRQN)
+#define ISR_PROFILER_EXIT(IRQN)					ISR_Profiler_Exit(IRQN)
+/* @brief Stamps the moment an interrupt is requested, e.g. before NVIC_SetPending() */
+#define ISR_PROFILER_MARK_TRIGGER(IRQN)			ISR_Profiler_Mark_Trigger(IRQN)
+
+#else
+
+#define ISR_PROFILER_WRAP(NAME, IRQN, HANDLER)	void NAME(void) { HANDLER(); }
+#define ISR_PROFILER_ENTER(IRQN)
+#define ISR_PROFILER_EXIT(IRQN)
+#define ISR_PROFILER_MARK_TRIGGER(IRQN)
+
+#endif
+/* --------------- Section: Data Type Declarations --------------- */
+#if ISR_PROFILER_STATE == ISR_PROFILER_ENABLED
+
+/*
+ * @brief 	Profile of one interrupt, all the times are in CPU cycles
+ */
+typedef struct
+{
+	uint32_t Count;						/* !< Completed runs */
+	uint32_t Preemptions;				/* !< Runs preempted by another interrupt calling the profiler */
+	uint32_t Last_Entry;				/* !< CYCCNT timestamp of the last entry */
+	uint32_t Min_Cycles;				/* !< Shortest run, own time without the nested interrupts */
+	uint32_t Max_Cycles;				/* !< Longest run */
+	uint64_t Total_Cycles;				/* !< Total / Count is the mean */
+	uint32_t Latency_Count;				/* !< Entries with a trigger stamp */
+	uint32_t Max_Latency;				/* !< Longest trigger to entry time */
+	uint64_t Total_Latency;
+	uint32_t Histogram[ISR_PROFILER_HIST_BINS];
+} ISR_Profiler_Stats_t;
+#endif
+/*---------------  Section: Function Declarations --------------- */
+#if ISR_PROFILER_STATE == ISR_PROFILER_ENABLED
+
+/**
+ * @brief  Starts the DWT cycle counter if it is stopped, and clears all the profiles.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No cycle counter
+ */
+Std_ReturnType_t ISR_Profiler_Init(void);
+/**
+ * @brief  Marks the entry of a profiled interrupt, first thing in the handler.
+ * @param  IRQn: The interrupt number, negative for a system exception.
+ */
+void ISR_Profiler_Enter(IRQn_t IRQn);
+/**
+ * @brief  Marks the exit of a profiled interrupt, last thing in the handler.
+ * @param  IRQn: The interrupt number given to ISR_Profiler_Enter(), the exit
+ *         closes the frame of that entry.
+ */
+void ISR_Profiler_Exit(IRQn_t IRQn);
+/**
+ * @brief  Stamps the request of an interrupt, its next entry measures the latency.
+ * @param  IRQn: The interrupt number.
+ */
+void ISR_Profiler_Mark_Trigger(IRQn_t IRQn);
+/**
+ * @brief  Reads the profile of an interrupt.
+ * @param  IRQn: The interrupt number.
+ * @param  Stats: Returns a consistent copy of the profile.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Interrupt never profiled or NULL pointer
+ */
+Std_ReturnType_t ISR_Profiler_Get_Stats(IRQn_t IRQn, ISR_Profiler_Stats_t * Stats);
+/**
+ * @brief  Clears the profiles, the slots stay assigned.
+ */
+void ISR_Profiler_Reset(void);
+/**
+ * @brief  Adds one run to a profile. Pure function, no register access.
+ * @param  Stats: The profile.
+ * @param  Cycles: Execution cycles of the run.
+ */
+void ISR_Profiler_Stats_Record(ISR_Profiler_Stats_t * Stats, uint32_t Cycles);
+/**
+ * @brief  Returns the histogram bin of an execution time. Pure function.
+ * @param  Cycles: Execution cycles.
+ * @return The bin index, 0 to ISR_PROFILER_HIST_BINS - 1.
+ */
+uint32_t ISR_Profiler_Hist_Bin(uint32_t Cycles);
+#endif
+
+#endif /* SERVICES_ISRPROFILER_ISR_PROFILER_H_ */
@@ -0,0 +1,32 @@
+/**
+ ******************************************************************************
+ * @file           : isr_profiler_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Interrupt Profiler Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_ISRPROFILER_ISR_PROFILER_CFG_H_
+#define SERVICES_ISRPROFILER_ISR_PROFILER_CFG_H_
+
+/* !< Disabled, the wrappers call the handlers directly and no code or data is left */
+#define ISR_PROFILER_DISABLED			0UL
+#define ISR_PROFILER_ENABLED			1UL
+
+/* !< Can be set from the build, e.g. by the host tests */
+#ifndef ISR_PROFILER_STATE
+#define ISR_PROFILER_STATE				ISR_PROFILER_DISABLED
+#endif
+
+/* !< Number of interrupts that can be profiled, a slot is taken on the first entry */
+#define ISR_PROFILER_MAX_IRQS			8U
+
+/* !< Deepest nesting of profiled interrupts (one per preemption level is enough) */
+#define ISR_PROFILER_MAX_NESTING		8U
+
+/* !< Histogram of the execution cycles: bin 0 counts runs shorter than
+ * 	  2^ISR_PROFILER_HIST_SHIFT cycles, each next bin doubles the range,
+ * 	  the last bin takes all the longer runs */
+#define ISR_PROFILER_HIST_BINS			8U
+#define ISR_PROFILER_HIST_SHIFT			5U
+
+#endif /* SERVICES_ISRPROFILER_ISR_PROFILER_CFG_H_ */
@@ -0,0 +1,222 @@
+/**
+ ******************************************************************************
+ * @file           : kernel.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Preemptive Priority-Based Micro-Kernel Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_KERNEL_KERNEL_H_
+#define SERVICES_KERNEL_KERNEL_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "kernel_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define KERNEL_IDLE_PRIORITY			(KERNEL_MAX_PRIORITIES - 1U)
+#define KERNEL_NO_WAIT					(0UL)
+#define KERNEL_WAIT_FOREVER				(0xFFFFFFFFUL)
+
+/* !< Smallest thread stack: the exception frame with the FPU registers
+ * 	  and the callee-saved registers */
+#define KERNEL_MIN_STACK_WORDS			(26U + 16U + 9U)
+
+#if (KERNEL_MAX_PRIORITIES < 2U) || (KERNEL_MAX_PRIORITIES > 32U)
+#error "KERNEL_MAX_PRIORITIES must be in the range 2..32"
+#endif
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+struct Kernel_Thread_s;
+
+/*
+ * @brief 	Thread body, returning from it terminates the thread
+ */
+typedef void (*Kernel_Thread_Entry_t)(void * Arg);
+
+typedef enum
+{
+	KERNEL_THREAD_READY = 0,
+	KERNEL_THREAD_BLOCKED,
+	KERNEL_THREAD_SLEEPING,
+	KERNEL_THREAD_TERMINATED
+} Kernel_Thread_State_t;
+
+/*
+ * @brief 	Circular doubly linked list of threads (ready queue or wait list)
+ */
+typedef struct
+{
+	struct Kernel_Thread_s * Head;
+} Kernel_List_t;
+
+/*
+ * @brief 	Thread control block, allocated statically by the user.
+ * 			The fields are private to the kernel.
+ */
+typedef struct Kernel_Thread_s
+{
+	uint32_t * Stack_Pointer;			/* !< Saved PSP, must stay the first member */
+	struct Kernel_Thread_s * Next;
+	struct Kernel_Thread_s * Prev;
+	Kernel_List_t * List;				/* !< Ready queue or wait list holding the thread */
+	struct Kernel_Thread_s * Delay_Next;
+	struct Kernel_Thread_s * Delay_Prev;
+	uint32_t Wake_Tick;					/* !< Absolute tick ending the sleep or the wait */
+	uint32_t * Stack_Base;
+	uint32_t Stack_Words;
+	uint8_t Priority;
+	uint8_t State;
+	uint8_t Wait_Result;				/* !< E_OK when woken by an object, E_NOT_OK on timeout */
+	uint8_t Delayed;					/* !< Linked in the delay list */
+} Kernel_Thread_t;
+
+/*
+ * @brief 	Counting semaphore
+ */
+typedef struct
+{
+	uint32_t Count;
+	uint32_t Max_Count;
+	Kernel_List_t Waiters;				/* !< Sorted by priority */
+} Kernel_Sem_t;
+
+/*
+ * @brief 	Message queue of fixed size items, copied by value
+ */
+typedef struct
+{
+	uint8_t * Buffer;
+	uint32_t Item_Size;
+	uint32_t Capacity;
+	uint32_t Count;
+	uint32_t Head;
+	uint32_t Tail;
+	Kernel_List_t Senders;				/* !< Waiting for room, sorted by priority */
+	Kernel_List_t Receivers;			/* !< Waiting for an item, sorted by priority */
+} Kernel_Queue_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Clears the ready queues, creates the idle thread and hooks
+ *         the kernel tick to the SysTick interrupt.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t Kernel_Init(void);
+/**
+ * @brief  Creates a thread on a static stack, ready to run.
+ *         It can be called before or after Kernel_Start().
+ * @param  Thread: The thread control block.
+ * @param  Entry: The thread body.
+ * @param  Arg: Argument handed to the body.
+ * @param  Priority: 0 (highest) to KERNEL_IDLE_PRIORITY - 1.
+ * @param  Stack: The stack array.
+ * @param  Stack_Words: Size of the stack in words, at least KERNEL_MIN_STACK_WORDS.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Thread_Create(Kernel_Thread_t * Thread, Kernel_Thread_Entry_t Entry, void * Arg,
+									  uint8_t Priority, uint32_t * Stack, uint32_t Stack_Words);
+/**
+ * @brief  Sets the PendSV priority and switches to the highest priority thread.
+ *         The SysTick timebase should be started before, it drives the sleeps
+ *         and the timeouts. The caller (main) is never resumed.
+ */
+void Kernel_Start(void);
+/**
+ * @brief  Hands the CPU to the next ready thread of the same priority.
+ */
+void Kernel_Yield(void);
+/**
+ * @brief  Blocks the calling thread for a number of ticks.
+ * @param  Ticks: Ticks to sleep, 0 is the same as Kernel_Yield().
+ */
+void Kernel_Sleep(uint32_t Ticks);
+/**
+ * @brief  Returns the kernel tick count.
+ * @return The current tick.
+ */
+uint32_t Kernel_Get_Ticks(void);
+/**
+ * @brief  Returns the running thread.
+ * @return The thread control block, NULL before Kernel_Start().
+ */
+Kernel_Thread_t * Kernel_Get_Current_Thread(void);
+/**
+ * @brief  Returns the number of context switches since the start.
+ * @return The context switch count.
+ */
+uint32_t Kernel_Get_Switch_Count(void);
+/**
+ * @brief  Initializes a counting semaphore.
+ * @param  Sem: The semaphore.
+ * @param  Initial_Count: Initial number of tokens.
+ * @param  Max_Count: Maximum number of tokens, 1 for a binary semaphore.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Sem_Init(Kernel_Sem_t * Sem, uint32_t Initial_Count, uint32_t Max_Count);
+/**
+ * @brief  Takes a token, blocking until one is given or the timeout ends.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Sem: The semaphore.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Token taken
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Sem_Take(Kernel_Sem_t * Sem, uint32_t Timeout_Ticks);
+/**
+ * @brief  Gives a token and wakes the highest priority waiter.
+ *         It can be called from an interrupt handler.
+ * @param  Sem: The semaphore.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Semaphore full or NULL
+ */
+Std_ReturnType_t Kernel_Sem_Give(Kernel_Sem_t * Sem);
+/**
+ * @brief  Initializes a message queue on a user buffer.
+ * @param  Queue: The queue.
+ * @param  Buffer: Storage of (Item_Size * Capacity) bytes.
+ * @param  Item_Size: Size of one item in bytes.
+ * @param  Capacity: Number of items.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Init(Kernel_Queue_t * Queue, void * Buffer, uint32_t Item_Size, uint32_t Capacity);
+/**
+ * @brief  Copies an item to the queue tail, blocking while the queue is full.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Queue: The queue.
+ * @param  Item: The item to copy.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Item queued
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Send(Kernel_Queue_t * Queue, const void * Item, uint32_t Timeout_Ticks);
+/**
+ * @brief  Copies the item at the queue head out, blocking while the queue is empty.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Queue: The queue.
+ * @param  Item: Returns the item.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Item received
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Receive(Kernel_Queue_t * Queue, void * Item, uint32_t Timeout_Ticks);
+/**
+ * @brief  Advances the kernel time by one tick, wakes the expired sleeps and
+ *         timeouts and rotates the running priority level.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void Kernel_Tick(void);
+
+#endif /* SERVICES_KERNEL_KERNEL_H_ */
@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file           : kernel_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Preemptive Micro-Kernel Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_KERNEL_KERNEL_CFG_H_
+#define SERVICES_KERNEL_KERNEL_CFG_H_
+
+/* !< Number of thread priorities (1 to 32), 0 is the highest.
+ * 	  The lowest one is reserved for the idle thread. */
+#define KERNEL_MAX_PRIORITIES			32U
+
+/* !< Stack of the idle thread in words, it needs room for one FPU frame */
+#define KERNEL_IDLE_STACK_WORDS			64U
+
+/* !< Round-robin between threads of the same priority on every tick */
+#define KERNEL_TIME_SLICE_DISABLED		0UL
+#define KERNEL_TIME_SLICE_ENABLED		1UL
+
+#define KERNEL_TIME_SLICE_STATE			KERNEL_TIME_SLICE_ENABLED
+
+/* !< PendSV priority (0..15, as for NVIC_SetPriority()), must be the lowest
+ * 	  in the system so the context switch never preempts an interrupt handler */
+#define KERNEL_PENDSV_PRIORITY			15UL
+
+#endif /* SERVICES_KERNEL_KERNEL_CFG_H_ */
@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file           : perf_profile.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Performance Profiles Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_PERFPROFILE_PERF_PROFILE_H_
+#define SERVICES_PERFPROFILE_PERF_PROFILE_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "MCAL/RCC/rcc.h"
+#include "perf_profile_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+
+/*
+ * @brief 	Named clock tree, the FLASH wait states and the voltage
+ * 			scaling are derived from it when switching.
+ */
+typedef struct
+{
+	const char * Name;
+	RCC_InitConfigs_t Clock;
+} Perf_Profile_t;
+
+/*
+ * @brief 	Called after every clock change, in thread mode, with the
+ * 			frequencies before and after, to recompute dividers and baud rates.
+ */
+typedef void (*Perf_Profile_Listener_t)(const RCC_Clock_Freqs_t * Old_Freqs, const RCC_Clock_Freqs_t * New_Freqs);
+
+/* !< 84 MHz from the HSI PLL, APB1 at 42 MHz, 48 MHz PLL48CLK */
+extern const Perf_Profile_t Perf_Profile_Burst;
+/* !< HSI 16 MHz, the PLL off */
+extern const Perf_Profile_t Perf_Profile_Idle;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Switches to a profile in a safe order:
+ * 		   1. raises the FLASH wait states if the new HCLK needs more,
+ * 		   2. parks SYSCLK on HSI and stops the PLL,
+ * 		   3. sets the voltage scaling of the new SYSCLK,
+ * 		   4. applies the clock tree, waiting for each source to be ready,
+ * 		   5. lowers the FLASH wait states if the new HCLK needs less,
+ * 		   6. rescales the SysTick and calls the listeners.
+ * 		   Call it from thread mode, the interrupts are masked during the switch.
+ * @param  Profile: The profile.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid profile, or a source did not start (the system stays on HSI)
+ */
+Std_ReturnType_t Perf_Profile_Switch(const Perf_Profile_t * Profile);
+/**
+ * @brief  Returns the profile in use, NULL before the first switch.
+ */
+const Perf_Profile_t * Perf_Profile_Get_Current(void);
+/**
+ * @brief  Registers a clock-change listener.
+ * @param  Listener: The listener.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL listener or all the PERF_PROFILE_MAX_LISTENERS slots are used
+ */
+Std_ReturnType_t Perf_Profile_Register_Listener(Perf_Profile_Listener_t Listener);
+
+#endif /* SERVICES_PERFPROFILE_PERF_PROFILE_H_ */
@@ -0,0 +1,21 @@
+/**
+ ******************************************************************************
+ * @file           : perf_profile_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Performance Profiles Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_PERFPROFILE_PERF_PROFILE_CFG_H_
+#define SERVICES_PERFPROFILE_PERF_PROFILE_CFG_H_
+
+/* !< Clock-change listeners that can be registered */
+#define PERF_PROFILE_MAX_LISTENERS			4U
+
+/* !< HCLK range of one FLASH wait state (RM0368 table 6):
+ * 	  30 MHz at 2.7..3.6 V, 24 MHz at 2.4..2.7 V, 18 MHz at 2.1..2.4 V, 16 MHz at 1.7..2.1 V */
+#define PERF_PROFILE_FLASH_WS_STEP_HZ		30000000UL
+
+/* !< Highest SYSCLK of the voltage scale 3, above it the scale 2 is used */
+#define PERF_PROFILE_VOS_SCALE3_MAX_HZ		60000000UL
+
+#endif /* SERVICES_PERFPROFILE_PERF_PROFILE_CFG_H_ */
@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @file           : ring_buffer.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Lock-Free Ring Buffer Service Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_RINGBUFFER_RING_BUFFER_H_
+#define SERVICES_RINGBUFFER_RING_BUFFER_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#if !defined(__arm__)
+/* Host build (stress tests, benchmarks), C11 atomics replace LDREX/STREX */
+#define RING_BUFFER_HOST
+#include <stdatomic.h>
+#endif
+/* --------------- Section: Macro Declarations --------------- */
+/* !< Indices wrap at 2^16 so the MPSC reservation fits one exclusive word */
+#define RING_BUFFER_MAX_CAPACITY		32768UL
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+#if defined(RING_BUFFER_HOST)
+typedef _Atomic uint32_t Ring_Atomic_t;
+#else
+typedef volatile uint32_t Ring_Atomic_t;
+#endif
+
+/*
+ * @brief 	Ring of fixed size elements over a caller buffer.
+ * 			The producer side is either SPSC (one producer, wait-free) or
+ * 			MPSC (any number of interrupts, lock-free), never both.
+ * 			There is always one consumer.
+ */
+typedef struct
+{
+	uint8_t * Buffer;
+	uint32_t Elem_Size;
+	uint32_t Capacity;					/* !< Elements, a power of two */
+	Ring_Atomic_t Reserve;				/* !< MPSC: bits 0..15 next free index, 16..31 writers in progress */
+	Ring_Atomic_t Head;					/* !< Published write index */
+	Ring_Atomic_t Tail;					/* !< Read index */
+	Ring_Atomic_t Dropped;				/* !< Elements refused, the ring was full */
+} Ring_Buffer_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Initializes an empty ring.
+ * @param  Ring: The ring.
+ * @param  Buffer: Storage of Capacity * Elem_Size bytes.
+ * @param  Elem_Size: Size of one element in bytes.
+ * @param  Capacity: Number of elements, a power of two up to RING_BUFFER_MAX_CAPACITY.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or invalid size
+ */
+Std_ReturnType_t Ring_Init(Ring_Buffer_t * Ring, void * Buffer, uint32_t Elem_Size, uint32_t Capacity);
+/**
+ * @brief  SPSC: pushes as many elements as fit, wait-free.
+ * @param  Ring: The ring.
+ * @param  Data: The elements.
+ * @param  Count: Number of elements.
+ * @return Number of elements pushed, the rest is counted as dropped.
+ */
+uint32_t Ring_SPSC_Push(Ring_Buffer_t * Ring, const void * Data, uint32_t Count);
+/**
+ * @brief  SPSC: gets the contiguous free span to be filled in place.
+ * @param  Ring: The ring.
+ * @param  Span: Returns the address of the first free element.
+ * @return Number of free contiguous elements, may be less than the free total at the wrap.
+ */
+uint32_t Ring_SPSC_Write_Span(Ring_Buffer_t * Ring, void ** Span);
+/**
+ * @brief  SPSC: publishes the elements filled in the span.
+ * @param  Ring: The ring.
+ * @param  Count: Number of elements filled, at most the span size.
+ */
+void Ring_SPSC_Write_Commit(Ring_Buffer_t * Ring, uint32_t Count);
+/**
+ * @brief  MPSC: pushes all the elements or none, lock-free, from any interrupt.
+ * @param  Ring: The ring.
+ * @param  Data: The elements.
+ * @param  Count: Number of elements.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Not enough room (counted as dropped)
+ */
+Std_ReturnType_t Ring_MPSC_Push(Ring_Buffer_t * Ring, const void * Data, uint32_t Count);
+/**
+ * @brief  Pops up to Count elements.
+ * @param  Ring: The ring.
+ * @param  Data: Receives the elements.
+ * @param  Count: Most elements to pop.
+ * @return Number of elements popped.
+ */
+uint32_t Ring_Pop(Ring_Buffer_t * Ring, void * Data, uint32_t Count);
+/**
+ * @brief  Gets the contiguous span of elements to be read in place.
+ * @param  Ring: The ring.
+ * @param  Span: Returns the address of the oldest element.
+ * @return Number of contiguous elements, may be less than the total at the wrap.
+ */
+uint32_t Ring_Read_Span(Ring_Buffer_t * Ring, const void ** Span);
+/**
+ * @brief  Frees the elements read in the span.
+ * @param  Ring: The ring.
+ * @param  Count: Number of elements read, at most the span size.
+ */
+void Ring_Read_Release(Ring_Buffer_t * Ring, uint32_t Count);
+/**
+ * @brief  Returns the number of elements ready to be read.
+ * @param  Ring: The ring.
+ */
+uint32_t Ring_Count(Ring_Buffer_t * Ring);
+/**
+ * @brief  Returns the number of elements dropped since the initialization.
+ * @param  Ring: The ring.
+ */
+uint32_t Ring_Get_Dropped(Ring_Buffer_t * Ring);
+
+#endif /* SERVICES_RINGBUFFER_RING_BUFFER_H_ */
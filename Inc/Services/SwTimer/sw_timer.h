@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file           : sw_timer.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Software Timers Service (Hashed Timing Wheel) Header Interface File.
+ ******************************************************************************
+ */
+
+#ifndef SERVICES_SWTIMER_SW_TIMER_H_
+#define SERVICES_SWTIMER_SW_TIMER_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "sw_timer_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define SW_TIMER_WHEEL_MASK			(SW_TIMER_WHEEL_SIZE - 1UL)
+#define SW_TIMER_NO_EXPIRY			(0xFFFFFFFFUL)
+
+#if (SW_TIMER_WHEEL_SIZE & SW_TIMER_WHEEL_MASK) != 0
+#error "SW_TIMER_WHEEL_SIZE must be a power of two"
+#endif
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+struct SwTimer_s;
+
+/*
+ * @brief 	Timer expiry callback, runs in the SysTick interrupt
+ */
+typedef void (*SwTimer_Callback_t)(void * Context);
+
+/*
+ * @brief 	Doubly linked list of timers (one per wheel slot)
+ */
+typedef struct
+{
+	struct SwTimer_s * Head;
+} SwTimer_List_t;
+
+/*
+ * @brief 	Software timer object, allocated statically by the user.
+ * 			The fields are private to the service.
+ */
+typedef struct SwTimer_s
+{
+	struct SwTimer_s * Next;
+	struct SwTimer_s * Prev;
+	SwTimer_List_t * List;			/* !< List holding the timer, NULL when stopped */
+	uint32_t Expiry;				/* !< Absolute expiry tick */
+	uint32_t Timeout;				/* !< First timeout, reused by SwTimer_Restart() */
+	uint32_t Period;				/* !< Reload period, 0 for a one-shot timer */
+	SwTimer_Callback_t Callback;
+	void * Context;
+} SwTimer_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Clears the wheel and hooks the service to the SysTick interrupt.
+ *         The SysTick timebase must be started to make the timers run.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t SwTimer_Init(void);
+/**
+ * @brief  Prepares a timer object before its first start.
+ * @param  Timer: The timer object.
+ * @param  Callback: Function called on expiry.
+ * @param  Context: Argument handed to the callback.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or callback
+ */
+Std_ReturnType_t SwTimer_Create(SwTimer_t * Timer, SwTimer_Callback_t Callback, void * Context);
+/**
+ * @brief  Starts (or re-arms) a timer in O(1).
+ * @param  Timer: The timer object.
+ * @param  Timeout_Ticks: Ticks until the first expiry (0 is taken as 1).
+ * @param  Period_Ticks: Reload period after each expiry, 0 for a one-shot timer.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or timer not created
+ */
+Std_ReturnType_t SwTimer_Start(SwTimer_t * Timer, uint32_t Timeout_Ticks, uint32_t Period_Ticks);
+/**
+ * @brief  Stops a timer in O(1). Stopping a stopped timer is harmless.
+ * @param  Timer: The timer object.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer
+ */
+Std_ReturnType_t SwTimer_Stop(SwTimer_t * Timer);
+/**
+ * @brief  Re-arms a timer with the timeout and period of its last start (e.g. watchdog kick).
+ * @param  Timer: The timer object.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or timer never started
+ */
+Std_ReturnType_t SwTimer_Restart(SwTimer_t * Timer);
+/**
+ * @brief  Tells whether a timer is running.
+ * @param  Timer: The timer object.
+ * @return 1 if the timer is armed, 0 otherwise.
+ */
+uint8_t SwTimer_IsActive(const SwTimer_t * Timer);
+/**
+ * @brief  Returns the tick count of the wheel.
+ * @return The current tick.
+ */
+uint32_t SwTimer_Get_Ticks(void);
+/**
+ * @brief  Advances the wheel by one tick and runs the expired timers.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void SwTimer_Tick(void);
+/**
+ * @brief  Returns the number of ticks until the earliest armed timer expires.
+ *         The wheel is walked one slot per critical section, a timer started
+ *         meanwhile by an interrupt may be missed.
+ * @return Ticks to the next expiry (at least 1), SW_TIMER_NO_EXPIRY if no timer is armed.
+ */
+uint32_t SwTimer_Get_Ticks_To_Next_Expiry(void);
+/**
+ * @brief  Catches up with ticks that were not delivered by the tick source
+ *         (e.g. while sleeping tickless), expiring the timers due in between.
+ *         The callbacks run with interrupts unmasked, after the catch up.
+ * @param  Ticks: Number of missed ticks.
+ */
+void SwTimer_Advance(uint32_t Ticks);
+/**
+ * @brief  Idles the CPU until the next timer deadline or any interrupt.
+ *         SysTick is reprogrammed so the core is not woken on every tick,
+ *         then the wheel is corrected for the time slept. While another
+ *         SysTick consumer is registered it is a plain WFI.
+ *         Call it from the main loop when there is nothing else to do.
+ */
+void SwTimer_Idle(void);
+
+#endif /* SERVICES_SWTIMER_SW_TIMER_H_ */
@@ -0,0 +1,16 @@
+/**
+ ******************************************************************************
+ * @file           : sw_timer_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Software Timers Service Configurations File.
+ ******************************************************************************
+ */
+#ifndef SERVICES_SWTIMER_SW_TIMER_CFG_H_
+#define SERVICES_SWTIMER_SW_TIMER_CFG_H_
+
+/* !< Number of slots of the timing wheel, must be a power of two.
+ * 	  Timeouts shorter than the wheel never share a slot with a later
+ * 	  round, longer ones cost one compare per wheel revolution. */
+#define SW_TIMER_WHEEL_SIZE			256UL
+
+#endif /* SERVICES_SWTIMER_SW_TIMER_CFG_H_ */
@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file           : startup.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Startup Header Interface File.
+ * 					 Vector table and Reset_Handler of the STM32F401, it replaces
+ * 					 the IDE generated startup_stm32f401rctx.s (remove that one from the build).
+ * 					 Uses the linker script symbols _estack, _sidata, _sdata, _edata, _sbss, _ebss
+ * 					 and the .isr_vector section.
+ ******************************************************************************
+ */
+
+#ifndef STARTUP_STARTUP_H_
+#define STARTUP_STARTUP_H_
+
+/* --------------- Section : Includes --------------- */
+#include "Common/Std_Types.h"
+#include "startup_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+
+/* --------------- Section: Data Type Declarations --------------- */
+typedef enum
+{
+	STARTUP_PHASE_RESET = 0,			/* !< Reset_Handler entry, the cycle counter starts at 0 */
+	STARTUP_PHASE_CLOCK_READY,			/* !< FLASH wait states set and SYSCLK on the PLL */
+	STARTUP_PHASE_DATA_READY,			/* !< .data copied */
+	STARTUP_PHASE_BSS_READY,			/* !< .bss zeroed */
+	STARTUP_PHASE_INIT_READY,			/* !< Constructors run */
+	STARTUP_PHASE_MAIN_ENTRY,			/* !< main() called */
+	STARTUP_PHASE_APP_READY,			/* !< Marked by the application, e.g. its first sample */
+	STARTUP_PHASE_COUNT
+} Startup_Phase_t;
+
+typedef struct
+{
+	uint32_t Stamps[STARTUP_PHASE_COUNT];	/* !< CYCCNT at each phase, 0 if not reached */
+	uint32_t Reset_Clock;					/* !< Core clock in Hz up to STARTUP_PHASE_CLOCK_READY */
+	uint32_t Run_Clock;						/* !< Core clock in Hz after it */
+	uint8_t Dma_Used;						/* !< 1 if DMA2 copied .data / zeroed .bss */
+} Startup_Boot_Times_t;
+/*---------------  Section: Function Declarations --------------- */
+
+/**
+ * @brief  Entry point after reset:
+ * 		   1. starts the cycle counter and grants the FPU access,
+ * 		   2. sets the FLASH wait states, prefetch and caches, and moves SYSCLK to the PLL,
+ * 		   3. copies .data and zeroes .bss (DMA2 memory-to-memory or unrolled word stores),
+ * 		   4. runs the constructors and calls main().
+ * 		   Nothing before step 3 may rely on initialized or zeroed globals.
+ */
+void Reset_Handler(void);
+/**
+ * @brief  Records the application ready stamp (STARTUP_PHASE_APP_READY),
+ * 		   only the first call counts. The time-to-first-sample is read from it.
+ */
+void Startup_Mark_App_Ready(void);
+/**
+ * @brief  Reads the boot timestamps.
+ * @param  Times: Returns a copy of the timestamps.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Startup_Get_Boot_Times(Startup_Boot_Times_t * Times);
+/**
+ * @brief  Converts a boot stamp to microseconds since reset, taking the clock switch into account.
+ * @param  Phase: The phase.
+ * @return Microseconds since reset, 0 for a phase not reached or invalid.
+ */
+uint32_t Startup_Get_Phase_Us(Startup_Phase_t Phase);
+
+#endif /* STARTUP_STARTUP_H_ */
@@ -0,0 +1,33 @@
+/**
+ ******************************************************************************
+ * @file           : startup_cfg.h
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Startup Configurations File.
+ ******************************************************************************
+ */
+#ifndef STARTUP_STARTUP_CFG_H_
+#define STARTUP_STARTUP_CFG_H_
+
+#define STARTUP_EARLY_CLOCK_DISABLED		0UL
+#define STARTUP_EARLY_CLOCK_ENABLED			1UL
+/* !< Starts the PLL before the C runtime init, so the init loops run at full speed */
+#define STARTUP_EARLY_CLOCK_STATE			STARTUP_EARLY_CLOCK_ENABLED
+
+/* !< Early clock: HSI / M * N / P = 84 MHz SYSCLK, HSI / M * N / Q = 48 MHz PLL48CLK */
+#define STARTUP_PLL_M						8UL
+#define STARTUP_PLL_N						168UL
+#define STARTUP_PLL_P						RCC_PLL_P_DIVIDE_BY_4
+#define STARTUP_PLL_P_DIV					4UL
+#define STARTUP_PLL_Q						7UL
+#define STARTUP_APB1_PRESCALER				APB1_CLOCK_DIVIDED_BY_2
+/* !< Wait states of the early SYSCLK at 2.7..3.6 V (RM0368 table 6) */
+#define STARTUP_FLASH_WAIT_STATES			2UL
+
+#define STARTUP_COPY_CPU					0UL
+#define STARTUP_COPY_DMA					1UL
+/* !< .data copy and .bss zeroing engine, the DMA2 streams run both at once */
+#define STARTUP_COPY_MODE					STARTUP_COPY_DMA
+/* !< Below this number of words the CPU is faster than setting a stream up */
+#define STARTUP_DMA_MIN_WORDS				64UL
+
+#endif /* STARTUP_STARTUP_CFG_H_ */
@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * @file           : Core.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Cortex-M4 Core Critical Sections Code Implementation File.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/DWT/DWT.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define CORE_AIRCR_PRIGROUP_POS				8UL
+/* --------------- Section: Global Variables --------------- */
+
+/* Reset grouping (PRIGROUP 0): 4 preemption bits */
+volatile uint32_t Core_Critical_Ceiling_Value = (CORE_CRITICAL_CEILING << (8UL - CORE_NVIC_PRIO_BITS));
+/*---------------  Section: Static Global Variables --------------- */
+static uint32_t Core_Critical_Ceiling_Priority = CORE_CRITICAL_CEILING;
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+static uint32_t Core_Critical_Start_Cycles[2];
+static uint32_t Core_Critical_Worst_Cycles[2];
+#endif
+/*---------------  Section: Helper Function Declarations --------------- */
+static uint32_t Core_Get_Preempt_Bits(void);
+/*---------------  Section: Function Definitions --------------- */
+
+/*
+ * @brief Sets the ceiling of Core_Enter_Critical_Ceiling() and encodes it
+ * for the current priority grouping.
+ * @param Preempt_Priority: Highest preemption priority to mask, 1 or more.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Out of range for the grouping, or no preemption bits
+ */
+Std_ReturnType_t Core_Critical_Set_Ceiling(uint32_t Preempt_Priority)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Preempt_Bits = Core_Get_Preempt_Bits();
+
+	/* BASEPRI 0 masks nothing, so preemption priority 0 cannot be a ceiling */
+	if((0 == Preempt_Bits) || (0 == Preempt_Priority) || (Preempt_Priority >= (1UL << Preempt_Bits)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* The preemption field is the top Preempt_Bits of the priority byte,
+		 * the subpriority bits under it are left 0 as BASEPRI ignores them */
+		Core_Critical_Ceiling_Priority = Preempt_Priority;
+		Core_Critical_Ceiling_Value = Preempt_Priority << (8UL - Preempt_Bits);
+	}
+	return retVal;
+}
+/*
+ * @brief Encodes the ceiling again after a change of the priority grouping.
+ * Called by NVIC_SetPriorityGrouping().
+ */
+void Core_Critical_Update_Grouping(void)
+{
+	uint32_t Preempt_Bits = Core_Get_Preempt_Bits();
+	uint32_t Preempt_Priority = Core_Critical_Ceiling_Priority;
+
+	/* Without preemption bits every interrupt has group priority 0 and any
+	 * non-zero BASEPRI masks them all, like PRIMASK. Otherwise clamp to the
+	 * new range rather than mask less than asked. */
+	if(0 == Preempt_Bits)
+		{ Core_Critical_Ceiling_Value = (1UL << (8UL - CORE_NVIC_PRIO_BITS)); }
+	else
+	{
+		if(Preempt_Priority >= (1UL << Preempt_Bits))
+			{ Preempt_Priority = (1UL << Preempt_Bits) - 1UL; }
+		Core_Critical_Ceiling_Value = Preempt_Priority << (8UL - Preempt_Bits);
+	}
+}
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+/*
+ * @brief Records the start of an outermost critical section.
+ */
+void Core_Critical_Measure_Start(Core_Critical_Kind_t Kind)
+{
+	Core_Critical_Start_Cycles[Kind] = DWT_GET_CYCCNT();
+}
+/*
+ * @brief Records the end of an outermost critical section.
+ */
+void Core_Critical_Measure_Stop(Core_Critical_Kind_t Kind)
+{
+	uint32_t Cycles = DWT_GET_CYCCNT() - Core_Critical_Start_Cycles[Kind];
+	if(Cycles > Core_Critical_Worst_Cycles[Kind])
+		{ Core_Critical_Worst_Cycles[Kind] = Cycles; }
+}
+#endif
+/*
+ * @brief Returns the longest masked window seen since the last reset.
+ * @param Kind: PRIMASK or BASEPRI critical sections.
+ * @return The window in CPU cycles, 0 when the measurement is disabled.
+ */
+uint32_t Core_Critical_Get_Worst_Cycles(Core_Critical_Kind_t Kind)
+{
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	return (Kind <= CORE_CRITICAL_BASEPRI) ? Core_Critical_Worst_Cycles[Kind] : 0;
+#else
+	(void)Kind;
+	return 0;
+#endif
+}
+/*
+ * @brief Clears the masked window statistics.
+ */
+void Core_Critical_Reset_Stats(void)
+{
+#if CORE_CRITICAL_MEASURE_STATE == CORE_CRITICAL_MEASURE_ENABLED
+	Core_Critical_Worst_Cycles[CORE_CRITICAL_PRIMASK] = 0;
+	Core_Critical_Worst_Cycles[CORE_CRITICAL_BASEPRI] = 0;
+#endif
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static uint32_t Core_Get_Preempt_Bits(void)
+{
+	uint32_t Priority_Group = (SCB->AIRCR >> CORE_AIRCR_PRIGROUP_POS) & 0x7UL;
+
+	/* PRIGROUP n splits the priority byte after bit n: with 4 implemented bits
+	 * groups 0..3 keep 4 preemption bits, then one less per group up to 7 */
+	return (Priority_Group <= (7UL - CORE_NVIC_PRIO_BITS)) ? CORE_NVIC_PRIO_BITS : (7UL - Priority_Group);
+}
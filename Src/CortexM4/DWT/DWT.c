@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file           : DWT.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Data-Watchpoint-and-Trace Unit Code Implementation File.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/DWT/DWT.h"
+#include "MCAL/RCC/rcc.h"
+/*---------------  Section: Function Definitions --------------- */
+
+/*
+ * @brief A software interface enables the trace block and starts the
+ * DWT cycle counter. A running counter is left as it is, the other users
+ * measure with it: only the reset handler starts it from zero.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The cycle counter is not implemented
+ */
+Std_ReturnType_t DWT_CycleCounter_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. Power the DWT block through the debug monitor control register */
+	COREDEBUG_TRACE_ENABLE();
+
+	/* 2. Check that the cycle counter is implemented */
+	if(READ_BIT(DWT->CTRL, DWT_CTRL_NOCYCCNT_POS))
+	{
+		retVal = E_NOT_OK;
+	}
+	else if(!DWT_CYCCNT_IS_ENABLED())
+	{
+		/* 3. Reset and start a stopped counter */
+		DWT->CYCCNT = 0;
+		DWT_CYCCNT_ENABLE();
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface busy-waits a number of processor cycles.
+ * It only reads the cycle counter, which is started if needed.
+ * @param Cycles: Number of HCLK cycles to wait.
+ */
+void DWT_Delay_Cycles(uint32_t Cycles)
+{
+	uint32_t Start_Cycles = 0;
+
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ (void)DWT_CycleCounter_Init(); }
+
+	/* The unsigned difference stays right across a counter wrap */
+	Start_Cycles = DWT_GET_CYCCNT();
+	while((DWT_GET_CYCCNT() - Start_Cycles) < Cycles);
+}
+/*
+ * @brief A software interface busy-waits for a sub-microsecond interval,
+ * converted to cycles with the live HCLK frequency.
+ * The resolution is one HCLK cycle (about 12 ns at 84 MHz) plus the call overhead.
+ * @param delay_ns: The delay time in nanoseconds.
+ */
+void DWT_Delay_ns(uint32_t delay_ns)
+{
+	DWT_Delay_Cycles((uint32_t)((((uint64_t)delay_ns * RCC_Get_HCLK_Freq()) + 999999999UL) / 1000000000UL));
+}
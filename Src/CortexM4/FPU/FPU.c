@@ -0,0 +1,177 @@
+/**
+ ******************************************************************************
+ * @file           : FPU.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Floating-Point Unit Code Implementation File.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/FPU/FPU.h"
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/DWT/DWT.h"
+/*---------------  Section: Static Global Variables --------------- */
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+static volatile uint32_t FPU_Measure_Entry = 0;
+static volatile uint8_t FPU_Measure_Done = 0;
+#endif
+/*---------------  Section: Helper Function Declarations --------------- */
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+static void FPU_Measure_Handler(void);
+#endif
+/*---------------  Section: Function Definitions --------------- */
+
+/*
+ * @brief A software interface grants full access to CP10/CP11 and sets the
+ * context preservation. Call it before any FP instruction.
+ * @param Stacking: The preservation mode (@ref FPU_Stacking_t).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Invalid mode
+ */
+Std_ReturnType_t FPU_Enable(FPU_Stacking_t Stacking)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. The mode first, no FP context can be active yet */
+	retVal = FPU_Set_Stacking(Stacking);
+	if(E_OK == retVal)
+	{
+		/* 2. Grant the access, the next instructions may be FP ones */
+		SCB->CPACR |= SCB_CPACR_FPU_FULL_ACCESS;
+		CORE_DSB();
+		CORE_ISB();
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface changes the preservation of the FP context.
+ * The kernel context switch relies on it being FULL or LAZY.
+ * @param Stacking: The preservation mode (@ref FPU_Stacking_t).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Invalid mode
+ */
+Std_ReturnType_t FPU_Set_Stacking(FPU_Stacking_t Stacking)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t FPCCR_Value = FPU->FPCCR & ~((1UL << FPU_FPCCR_ASPEN_POS) | (1UL << FPU_FPCCR_LSPEN_POS));
+
+	switch(Stacking)
+	{
+		case FPU_STACKING_NONE:
+			break;
+		case FPU_STACKING_FULL:
+			FPCCR_Value |= (1UL << FPU_FPCCR_ASPEN_POS);
+			break;
+		case FPU_STACKING_LAZY:
+			FPCCR_Value |= (1UL << FPU_FPCCR_ASPEN_POS) | (1UL << FPU_FPCCR_LSPEN_POS);
+			break;
+		default:
+			retVal = E_NOT_OK;
+			break;
+	}
+	if(E_OK == retVal)
+	{
+		FPU->FPCCR = FPCCR_Value;
+		CORE_DSB();
+		CORE_ISB();
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface reads the preservation of the FP context.
+ * @return The preservation mode (@ref FPU_Stacking_t).
+ */
+FPU_Stacking_t FPU_Get_Stacking(void)
+{
+	FPU_Stacking_t Stacking = FPU_STACKING_NONE;
+
+	if(READ_BIT(FPU->FPCCR, FPU_FPCCR_ASPEN_POS))
+		{ Stacking = READ_BIT(FPU->FPCCR, FPU_FPCCR_LSPEN_POS) ? FPU_STACKING_LAZY : FPU_STACKING_FULL; }
+
+	return Stacking;
+}
+/*
+ * @brief A software interface measures the exception entry, from the
+ * software trigger to the first handler instruction, with an active FP
+ * context. The entries are timed with FPU_MEASURE_IRQN and the mode
+ * given, then the previous mode and handler are restored.
+ * The trigger overhead is the same in all modes, compare the results.
+ * @param Stacking: The preservation mode to measure.
+ * @param Cycles: Returns the shortest entry in CPU cycles.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Vector table not relocated, no cycle counter,
+ *          			 software FP build or invalid parameters
+ */
+Std_ReturnType_t FPU_Measure_Entry_Cycles(FPU_Stacking_t Stacking, uint32_t * Cycles)
+{
+	Std_ReturnType_t retVal = E_OK;
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+	SCB_Vector_Save_t Saved_Vector;
+	FPU_Stacking_t Saved_Stacking = FPU_Get_Stacking();
+	uint32_t Saved_Priority = NVIC_GetPriority(FPU_MEASURE_IRQN);
+	uint32_t Saved_Enable = NVIC_GetEnableIRQ(FPU_MEASURE_IRQN);
+	uint32_t Start_Cycles = 0;
+	uint32_t Run_Idx = 0;
+
+	/* The cycle counter is shared with the boot stamps and the other measurements,
+	 * it is started if stopped but never reset here */
+	if((NULL != Cycles) && !DWT_CYCCNT_IS_ENABLED())
+		{ retVal = DWT_CycleCounter_Init(); }
+
+	if((NULL == Cycles) || (E_OK != retVal) || READ_BIT(DWT->CTRL, DWT_CTRL_NOCYCCNT_POS) ||
+	   (E_OK != SCB_VectorTable_Swap(FPU_MEASURE_IRQN, FPU_Measure_Handler, &Saved_Vector)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Highest priority, nothing may slip in between the trigger and the entry */
+		NVIC_SetPriority(FPU_MEASURE_IRQN, 0);
+		NVIC_EnableIRQ(FPU_MEASURE_IRQN);
+		retVal = FPU_Set_Stacking(Stacking);
+
+		*Cycles = 0xFFFFFFFFUL;
+		for(Run_Idx = 0; (E_OK == retVal) && (Run_Idx < FPU_MEASURE_RUNS); Run_Idx++)
+		{
+			/* 2. Any FP instruction makes the FP context active (CONTROL.FPCA) */
+			__asm volatile ("vmov.f32 s0, s0" : : : "memory");
+
+			/* 3. Trigger, the handler stamps its first instruction */
+			FPU_Measure_Done = 0;
+			Start_Cycles = DWT_GET_CYCCNT();
+			NVIC->STIR = (uint32_t)FPU_MEASURE_IRQN;
+			CORE_DSB();
+			CORE_ISB();
+			while(0 == FPU_Measure_Done);
+
+			if((FPU_Measure_Entry - Start_Cycles) < *Cycles)
+				{ *Cycles = FPU_Measure_Entry - Start_Cycles; }
+		}
+
+		/* 4. Put everything back */
+		(void)FPU_Set_Stacking(Saved_Stacking);
+		if(0 == Saved_Enable)
+			{ NVIC_DisableIRQ(FPU_MEASURE_IRQN); }
+		NVIC_SetPriority(FPU_MEASURE_IRQN, Saved_Priority);
+		(void)SCB_VectorTable_Restore(&Saved_Vector);
+	}
+#else
+	/* Software FP build, no FP context is ever stacked */
+	(void)Stacking;
+	(void)Cycles;
+	retVal = E_NOT_OK;
+#endif
+	return retVal;
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+static void FPU_Measure_Handler(void)
+{
+	/* Integer only, the FP words stay unpushed in lazy mode */
+	FPU_Measure_Entry = DWT_GET_CYCCNT();
+	FPU_Measure_Done = 1;
+}
+#endif
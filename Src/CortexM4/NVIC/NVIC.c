@@ -7,8 +7,13 @@
  */
 /* --------------- Section : Includes --------------- */
 #include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/Core/Core.h"
 /* --------------- Section: Global Variables --------------- */
 
+/*---------------  Section: Helper Function Declarations --------------- */
+static void NVIC_Get_Priority_Split(uint32_t PriorityGroup, uint32_t * PreemptBits, uint32_t * SubBits);
+static void NVIC_Write_IRQSet(volatile uint32_t * Registers, const NVIC_IRQSet_t * Set);
+
 /*---------------  Section: Functions Definition --------------- */
 /**
   @brief   Enable Interrupt
@@ -130,6 +135,8 @@ void NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
 	AIRCR_Register_Value |= (0x05FA << 16UL) | ((uint32_t)PriorityGroup << 8UL);
 	/* Write the new register value */
 	SCB->AIRCR = AIRCR_Register_Value;
+	/* The BASEPRI ceiling is encoded with the grouping */
+	Core_Critical_Update_Grouping();
 }
 
 /**
@@ -145,11 +152,13 @@ void NVIC_SetPriority(IRQn_t IRQn, uint32_t Priority)
 {
 	if(IRQn >= 0)
 	{
-		NVIC->IP[(uint32_t)IRQn] = (uint8_t)(((uint8_t)Priority << 4UL) & 0xFFUL);
+		NVIC->IP[(uint32_t)IRQn] = (uint8_t)((Priority << (8UL - NVIC_PRIO_BITS)) & 0xFFUL);
 	}
-	else
+	else if((((uint32_t)IRQn) & 0xFUL) >= 4UL)
 	{
-
+		/* SHPR1..3 hold one byte per system handler, from exception 4 (MemManage).
+		 * NMI and HardFault have fixed priorities. */
+		SCB->SHPR[(((uint32_t)IRQn) & 0xFUL) - 4UL] = (uint8_t)((Priority << (8UL - NVIC_PRIO_BITS)) & 0xFFUL);
 	}
 }
 /**
@@ -165,10 +174,267 @@ uint32_t NVIC_GetPriority(IRQn_t IRQn)
 {
 	if(IRQn >= 0)
 	{
-		return (NVIC->IP[(uint32_t)IRQn] >> 4) & 0x0FUL;
+		return ((uint32_t)NVIC->IP[(uint32_t)IRQn] >> (8UL - NVIC_PRIO_BITS));
+	}
+	else if((((uint32_t)IRQn) & 0xFUL) >= 4UL)
+	{
+		return ((uint32_t)SCB->SHPR[(((uint32_t)IRQn) & 0xFUL) - 4UL] >> (8UL - NVIC_PRIO_BITS));
 	}
 	else
 	{
 		return 0UL;
 	}
 }
+/**
+  @brief   Get Priority Grouping
+  @details Reads the priority grouping field from the NVIC Interrupt Controller.
+  @return                Priority grouping field (SCB->AIRCR [10:8] PRIGROUP field).
+ */
+uint32_t NVIC_GetPriorityGrouping(void)
+{
+	return ((SCB->AIRCR >> 8UL) & 0x07UL);
+}
+/**
+  @brief   Encode Priority
+  @details Encodes the priority for an interrupt with the given priority group,
+           preemptive priority value, and subpriority value.
+           In case of a conflict between priority grouping and available
+           priority bits (NVIC_PRIO_BITS), the smallest possible priority group is set.
+  @param [in]     PriorityGroup  Used priority group.
+  @param [in]   PreemptPriority  Preemptive priority value (starting from 0).
+  @param [in]       SubPriority  Subpriority value (starting from 0).
+  @return                        Encoded priority. Value can be used in the function NVIC_SetPriority().
+ */
+uint32_t NVIC_EncodePriority(NVIC_PriorityGroupBits_t PriorityGroup, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	uint32_t PreemptBits = 0;
+	uint32_t SubBits = 0;
+
+	NVIC_Get_Priority_Split((uint32_t)PriorityGroup & 0x07UL, &PreemptBits, &SubBits);
+
+	return (((PreemptPriority & ((1UL << PreemptBits) - 1UL)) << SubBits) |
+			((SubPriority & ((1UL << SubBits) - 1UL))));
+}
+/**
+  @brief   Decode Priority
+  @details Decodes an interrupt priority value with a given priority group to
+           preemptive priority value and subpriority value.
+  @param [in]         Priority   Priority value, which can be retrieved with the function NVIC_GetPriority().
+  @param [in]     PriorityGroup  Used priority group.
+  @param [out] pPreemptPriority  Preemptive priority value (starting from 0).
+  @param [out]     pSubPriority  Subpriority value (starting from 0).
+ */
+void NVIC_DecodePriority(uint32_t Priority, NVIC_PriorityGroupBits_t PriorityGroup,
+						 uint32_t * const pPreemptPriority, uint32_t * const pSubPriority)
+{
+	uint32_t PreemptBits = 0;
+	uint32_t SubBits = 0;
+
+	NVIC_Get_Priority_Split((uint32_t)PriorityGroup & 0x07UL, &PreemptBits, &SubBits);
+
+	if(NULL != pPreemptPriority)
+		{ *pPreemptPriority = (Priority >> SubBits) & ((1UL << PreemptBits) - 1UL); }
+	if(NULL != pSubPriority)
+		{ *pSubPriority = Priority & ((1UL << SubBits) - 1UL); }
+}
+/**
+  @brief   Apply Priority Plan
+  @details Sets the priority grouping, then writes the priority of every interrupt and
+           system exception of the table in one pass with the interrupts masked.
+           The whole table is checked first, nothing is written if one entry is invalid.
+  @param [in]     PriorityGroup  Priority grouping of the plan.
+  @param [in]              Plan  Table of interrupts with their preemptive and subpriority values.
+  @param [in]           Entries  Number of lines of the table.
+  @return                  E_OK  The plan has been applied.
+  @return              E_NOT_OK  NULL table, priority out of range for the group, or
+                                 an exception with a fixed priority (NMI, HardFault).
+ */
+Std_ReturnType_t NVIC_ApplyPriorityPlan(NVIC_PriorityGroupBits_t PriorityGroup,
+										const NVIC_PriorityPlan_Entry_t * Plan, uint32_t Entries)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t PreemptBits = 0;
+	uint32_t SubBits = 0;
+	uint32_t Entry_Idx = 0;
+	uint32_t Irq_State = 0;
+
+	NVIC_Get_Priority_Split((uint32_t)PriorityGroup & 0x07UL, &PreemptBits, &SubBits);
+
+	/* 1. Check the whole plan before touching anything */
+	if(NULL == Plan)
+		{ retVal = E_NOT_OK; }
+	for(Entry_Idx = 0; (E_OK == retVal) && (Entry_Idx < Entries); Entry_Idx++)
+	{
+		if((Plan[Entry_Idx].IRQn < MemoryManagement_IRQn) || (Plan[Entry_Idx].IRQn > SPI4_IRQn) ||
+		   (Plan[Entry_Idx].Preempt_Priority >= (1UL << PreemptBits)) ||
+		   (Plan[Entry_Idx].Sub_Priority >= (1UL << SubBits)))
+			{ retVal = E_NOT_OK; }
+	}
+
+	if(E_OK == retVal)
+	{
+		/* 2. Grouping and priorities change together, no interrupt
+		 *    is taken with half of the plan applied */
+		Irq_State = Core_Enter_Critical();
+		NVIC_SetPriorityGrouping((uint32_t)PriorityGroup);
+		for(Entry_Idx = 0; Entry_Idx < Entries; Entry_Idx++)
+		{
+			NVIC_SetPriority(Plan[Entry_Idx].IRQn,
+							 NVIC_EncodePriority(PriorityGroup, Plan[Entry_Idx].Preempt_Priority,
+												 Plan[Entry_Idx].Sub_Priority));
+		}
+		CORE_DSB();
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+  @brief   Empty IRQ Set
+  @details Removes every interrupt from an IRQ set.
+  @param [out]      Set  The IRQ set.
+ */
+void NVIC_IRQSet_Init(NVIC_IRQSet_t * Set)
+{
+	uint32_t Word_Idx = 0;
+	if(NULL != Set)
+	{
+		for(Word_Idx = 0; Word_Idx < NVIC_IRQ_REGS; Word_Idx++)
+			{ Set->Words[Word_Idx] = 0; }
+	}
+}
+/**
+  @brief   Add to IRQ Set
+  @details Adds a device specific interrupt to an IRQ set, no register is written.
+  @param [in,out]   Set  The IRQ set.
+  @param [in]      IRQn  Device specific interrupt number.
+  @return          E_OK  The interrupt has been added.
+  @return      E_NOT_OK  NULL set, or IRQn not a device interrupt of the STM32F401.
+ */
+Std_ReturnType_t NVIC_IRQSet_Add(NVIC_IRQSet_t * Set, IRQn_t IRQn)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Set) || (0 > IRQn) || (NVIC_LAST_IRQN < (uint32_t)IRQn))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Set->Words[((uint32_t)IRQn) >> 5UL] |= ((uint32_t)1UL << ((uint32_t)IRQn % REG_WIDTH));
+	}
+	return retVal;
+}
+/**
+  @brief   Remove from IRQ Set
+  @details Removes a device specific interrupt from an IRQ set, no register is written.
+  @param [in,out]   Set  The IRQ set.
+  @param [in]      IRQn  Device specific interrupt number.
+  @return          E_OK  The interrupt has been removed.
+  @return      E_NOT_OK  NULL set, or IRQn not a device interrupt of the STM32F401.
+ */
+Std_ReturnType_t NVIC_IRQSet_Remove(NVIC_IRQSet_t * Set, IRQn_t IRQn)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Set) || (0 > IRQn) || (NVIC_LAST_IRQN < (uint32_t)IRQn))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Set->Words[((uint32_t)IRQn) >> 5UL] &= ~((uint32_t)1UL << ((uint32_t)IRQn % REG_WIDTH));
+	}
+	return retVal;
+}
+/**
+  @brief   Enable IRQ Set
+  @details Enables all the interrupts of the set, writing each ISER word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_EnableIRQSet(const NVIC_IRQSet_t * Set)
+{
+	NVIC_Write_IRQSet(NVIC->ISER, Set);
+}
+/**
+  @brief   Disable IRQ Set
+  @details Disables all the interrupts of the set, writing each ICER word once.
+           None of them is taken after the function returns.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_DisableIRQSet(const NVIC_IRQSet_t * Set)
+{
+	NVIC_Write_IRQSet(NVIC->ICER, Set);
+	/* The disable takes effect before the next instruction */
+	CORE_DSB();
+	CORE_ISB();
+}
+/**
+  @brief   Set Pending IRQ Set
+  @details Sets the pending bit of all the interrupts of the set, writing each ISPR word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_SetPendingIRQSet(const NVIC_IRQSet_t * Set)
+{
+	NVIC_Write_IRQSet(NVIC->ISPR, Set);
+}
+/**
+  @brief   Clear Pending IRQ Set
+  @details Clears the pending bit of all the interrupts of the set, writing each ICPR word once.
+  @param [in]       Set  The IRQ set.
+ */
+void NVIC_ClearPendingIRQSet(const NVIC_IRQSet_t * Set)
+{
+	NVIC_Write_IRQSet(NVIC->ICPR, Set);
+}
+/**
+  @brief   Mask IRQ Set
+  @details Saves which interrupts of the set are enabled, then disables the whole set at once,
+           e.g. while reconfiguring a subsystem. NVIC_RestoreIRQSet() enables back only
+           the interrupts that were enabled.
+  @param [in]       Set  The IRQ set.
+  @param [out] Snapshot  Receives the enabled interrupts of the set.
+ */
+void NVIC_MaskIRQSet(const NVIC_IRQSet_t * Set, NVIC_IRQSet_t * Snapshot)
+{
+	uint32_t Word_Idx = 0;
+	uint32_t Irq_State = 0;
+
+	if((NULL != Set) && (NULL != Snapshot))
+	{
+		/* Nothing may enable one of them between the read and the disable */
+		Irq_State = Core_Enter_Critical();
+		for(Word_Idx = 0; Word_Idx < NVIC_IRQ_REGS; Word_Idx++)
+			{ Snapshot->Words[Word_Idx] = NVIC->ISER[Word_Idx] & Set->Words[Word_Idx]; }
+		NVIC_DisableIRQSet(Set);
+		Core_Exit_Critical(Irq_State);
+	}
+}
+/**
+  @brief   Restore IRQ Set
+  @details Enables back the interrupts saved by NVIC_MaskIRQSet() at once.
+  @param [in]  Snapshot  The snapshot taken by NVIC_MaskIRQSet().
+ */
+void NVIC_RestoreIRQSet(const NVIC_IRQSet_t * Snapshot)
+{
+	NVIC_Write_IRQSet(NVIC->ISER, Snapshot);
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void NVIC_Get_Priority_Split(uint32_t PriorityGroup, uint32_t * PreemptBits, uint32_t * SubBits)
+{
+	/* PRIGROUP n puts the split after bit n of the priority byte,
+	 * only the upper NVIC_PRIO_BITS bits are implemented */
+	*PreemptBits = ((7UL - PriorityGroup) > NVIC_PRIO_BITS) ? NVIC_PRIO_BITS : (7UL - PriorityGroup);
+	*SubBits = NVIC_PRIO_BITS - *PreemptBits;
+}
+
+static void NVIC_Write_IRQSet(volatile uint32_t * Registers, const NVIC_IRQSet_t * Set)
+{
+	uint32_t Word_Idx = 0;
+	if(NULL != Set)
+	{
+		/* Write-one registers: one store per word with bits, zeros have no effect */
+		for(Word_Idx = 0; Word_Idx < NVIC_IRQ_REGS; Word_Idx++)
+		{
+			if(0 != Set->Words[Word_Idx])
+				{ Registers[Word_Idx] = Set->Words[Word_Idx]; }
+		}
+	}
+}
@@ -5,3 +5,145 @@
  * @brief          : System-Control-Block Devicce-Driver Code Implementation File.
  ******************************************************************************
  */
+/* --------------- Section : Includes --------------- */
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/Core/Core.h"
+/*---------------  Section: Static Global Variables --------------- */
+static Interrupt_Handler_t SCB_Ram_Vectors[SCB_VECTORS_NUMBER] __attribute__((aligned(SCB_VECTOR_TABLE_ALIGNMENT)));
+static volatile uint8_t SCB_Vectors_Relocated = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static inline __attribute__((always_inline)) uint8_t SCB_Vector_Is_Valid(int32_t IRQn);
+/*---------------  Section: Function Definitions --------------- */
+
+/*
+ * @brief A software interface copies the active vector table into aligned
+ * SRAM and points VTOR at the copy. Calling it again does nothing.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SCB_VectorTable_Relocate(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const Interrupt_Handler_t * Active_Vectors = (const Interrupt_Handler_t *)SCB->VTOR;
+	uint32_t Vector_Idx = 0;
+	uint32_t Irq_State = 0;
+
+	if(0 == SCB_Vectors_Relocated)
+	{
+		Irq_State = Core_Enter_Critical();
+
+		/* 1. Copy the table VTOR points at (flash, or a bootloader table) */
+		for(Vector_Idx = 0; Vector_Idx < SCB_VECTORS_NUMBER; Vector_Idx++)
+			{ SCB_Ram_Vectors[Vector_Idx] = Active_Vectors[Vector_Idx]; }
+
+		/* 2. Switch to the copy, the next exception fetches from SRAM */
+		CORE_DSB();
+		SCB->VTOR = (uint32_t)SCB_Ram_Vectors;
+		CORE_DSB();
+		CORE_ISB();
+
+		if(SCB->VTOR != (uint32_t)SCB_Ram_Vectors)
+			{ retVal = E_NOT_OK; }
+		else
+			{ SCB_Vectors_Relocated = 1; }
+
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface writes a handler straight into the vector slot
+ * of an interrupt, so the exception entry branches to it with no dispatcher
+ * in between. The handler has to clear the interrupt flag of its peripheral.
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @param Handler: The interrupt handler.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid IRQn or NULL handler
+ */
+Std_ReturnType_t SCB_VectorTable_Install(int32_t IRQn, Interrupt_Handler_t Handler)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((0 == SCB_Vectors_Relocated) || (NULL == Handler) || !SCB_Vector_Is_Valid(IRQn))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* A single word store, a pending interrupt sees either handler */
+		SCB_Ram_Vectors[IRQn + 16] = Handler;
+		CORE_DSB();
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface reads the handler of a vector slot.
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @return The handler, NULL for an invalid IRQn.
+ */
+Interrupt_Handler_t SCB_VectorTable_Get(int32_t IRQn)
+{
+	Interrupt_Handler_t Handler = NULL;
+	if(SCB_Vector_Is_Valid(IRQn))
+		{ Handler = ((const Interrupt_Handler_t *)SCB->VTOR)[IRQn + 16]; }
+	return Handler;
+}
+/*
+ * @brief A software interface installs a handler temporarily,
+ * keeping the previous one for SCB_VectorTable_Restore().
+ * @param IRQn: The interrupt number (IRQn_t), negative for a system exception.
+ * @param Handler: The temporary interrupt handler.
+ * @param Saved: Returns the previous content of the slot.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid parameters
+ */
+Std_ReturnType_t SCB_VectorTable_Swap(int32_t IRQn, Interrupt_Handler_t Handler, SCB_Vector_Save_t * Saved)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Saved) || (0 == SCB_Vectors_Relocated) || (NULL == Handler) || !SCB_Vector_Is_Valid(IRQn))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Saved->IRQn = IRQn;
+		Saved->Handler = SCB_Ram_Vectors[IRQn + 16];
+		retVal = SCB_VectorTable_Install(IRQn, Handler);
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface puts back a handler saved by SCB_VectorTable_Swap(),
+ * an empty (NULL) slot included.
+ * @param Saved: The saved slot.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : Table not relocated, invalid parameters
+ */
+Std_ReturnType_t SCB_VectorTable_Restore(const SCB_Vector_Save_t * Saved)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Saved) || (0 == SCB_Vectors_Relocated) || !SCB_Vector_Is_Valid(Saved->IRQn))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* Written as saved, the slot may have held no handler (NULL) */
+		SCB_Ram_Vectors[Saved->IRQn + 16] = Saved->Handler;
+		CORE_DSB();
+	}
+	return retVal;
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static inline uint8_t SCB_Vector_Is_Valid(int32_t IRQn)
+{
+	/* Slots 1 (reset) to 15, the initial MSP in slot 0 is not a handler */
+	return ((IRQn >= -15) && (IRQn < (int32_t)(SCB_VECTORS_NUMBER - 16UL))) ? 1 : 0;
+}
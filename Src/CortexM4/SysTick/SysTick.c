@@ -7,9 +7,25 @@
  */
 /* --------------- Section : Includes --------------- */
 #include "CortexM4/SysTick/SysTick.h"
+#include "CortexM4/DWT/DWT.h"
+#include "MCAL/RCC/rcc.h"
 /*---------------  Section: Global Variables --------------- */
 static Interrupt_Handler_t SysTick_Default_Interrupt_Handler = NULL;
 static volatile uint8_t SysTick_Mode = SYSTICK_MODE_INIT_VALUE;
+static volatile uint64_t SysTick_Tick_Count = 0;
+static uint32_t SysTick_Reload_Value = 0;
+/* Counts reached at the last HCLK change: the cycles and nanoseconds (the
+ * microseconds would lose up to 1 us at each change), the tick count, and
+ * the part of the period in progress already in the cycles */
+static uint64_t SysTick_Cycle_Base = 0;
+static uint64_t SysTick_Nanos_Base = 0;
+static uint64_t SysTick_Base_Ticks = 0;
+static uint32_t SysTick_Base_Offset = 0;
+static Interrupt_Handler_t SysTick_Tick_Hooks[SYSTICK_MAX_TICK_HOOKS];
+static volatile uint8_t SysTick_Tick_Hooks_Count = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void SysTick_Delay(const uint64_t Time, const uint32_t Units_Per_Second);
+static uint64_t SysTick_Cycles_To_Nanos(uint64_t Cycles, uint32_t Input_Clock);
 /*---------------  Section: Function Definitions --------------- */
 
 /*
@@ -69,36 +85,70 @@ Std_ReturnType_t SysTick_DeInit(void)
 /*
  * @brief A software interface halts the processor execution for a
  * defined interval.
+ * The interval is converted with the live clock frequency. The delay reads
+ * the DWT cycle counter, so it holds with the SysTick exception masked or
+ * pending, and never reprograms the SysTick registers.
  * @param delay_ms: The delay time in milliseconds.
  * @return Status of the function
  *          (E_OK) : The function done successfully
  *          (E_NOT_OK) : The function has issue to perform this action
  */
-Std_ReturnType_t SysTick_Delay_ms(uint32_t No_Of_Ticks)
+Std_ReturnType_t SysTick_Delay_ms(uint32_t delay_ms)
 {
 	Std_ReturnType_t retVal = E_OK;
-	if((No_Of_Ticks > (16777215UL)) || (No_Of_Ticks == 0))
+	if(0 == delay_ms)
 	{
 		retVal = E_NOT_OK;
 	}
 	else
 	{
-		/* Set the re-load value */
-		SysTick->RVR = No_Of_Ticks;
-		/* Enable SysTick Timer */
-		SYSTICK_TIMER_ENABLE();
-		/* Wait */
-		while(0 == SYSTICK_GET_COUNTFLAG());
-		/* Disable the Systick */
-		SYSTICK_TIMER_DISABLE();
-		/* Reset the LOAD value */
-		SysTick->RVR = 0;
-		/* Reset the Counter Register */
-		SysTick->CVR = 0;
+		SysTick_Delay(delay_ms, 1000UL);
 	}
 
 	return retVal;
 }
+/*
+ * @brief A software interface halts the processor execution for a
+ * defined interval, like SysTick_Delay_ms().
+ * Use DWT_Delay_ns() for sub-microsecond delays.
+ * @param delay_us: The delay time in microseconds.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SysTick_Delay_us(uint32_t delay_us)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(0 == delay_us)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		SysTick_Delay(delay_us, 1000000UL);
+	}
+
+	return retVal;
+}
+/*
+ * @brief A software interface returns the frequency of the SysTick counter,
+ * derived from the live HCLK and SYSTICK_CLOCK_SOURCE.
+ * @return The counter frequency in Hz.
+ */
+uint32_t SysTick_Get_InputClock(void)
+{
+	return SYSTICK_INPUT_CLOCK(RCC_Get_HCLK_Freq());
+}
+/*
+ * @brief A software interface converts a time to SysTick counter ticks
+ * with the live clock frequency, e.g. for SysTick_Timebase_Start().
+ * @param Time_us: The time in microseconds.
+ * @return The number of counter ticks (rounded to the nearest).
+ */
+uint32_t SysTick_Micros_To_Ticks(uint32_t Time_us)
+{
+	return (uint32_t)((((uint64_t)Time_us * SysTick_Get_InputClock()) + 500000UL) / 1000000UL);
+}
 /*
  * @brief A software interface fires one interrupt request
  * for one interval only.
@@ -165,12 +215,292 @@ Std_ReturnType_t SysTick_PeriodicInterval(uint32_t No_Of_Ticks, Interrupt_Handle
 	}
 	return retVal;
 }
+/*
+ * @brief A software interface starts the free-running timebase.
+ * The timer interrupts every No_Of_Ticks counts and the interrupt
+ * extends the counter to 64 bits.
+ * @param No_Of_Ticks: Number of timer ticks of one timebase period.
+ * @param isr: Pointer to the callback function, called every period (may be NULL).
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : The function has issue to perform this action
+ */
+Std_ReturnType_t SysTick_Timebase_Start(uint32_t No_Of_Ticks, Interrupt_Handler_t isr)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((No_Of_Ticks > (SYSTICK_MAX_RELOAD + 1UL)) || (No_Of_Ticks < 2UL))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Stop the timer and restart the count */
+		SYSTICK_TIMER_DISABLE();
+		SysTick_Tick_Count = 0;
+		SysTick_Cycle_Base = 0;
+		SysTick_Nanos_Base = 0;
+		SysTick_Base_Ticks = 0;
+		SysTick_Base_Offset = 0;
+		/* 2. The counter runs from RVR down to 0, so the period is RVR + 1 */
+		SysTick_Reload_Value = No_Of_Ticks - 1UL;
+		SysTick->RVR = SysTick_Reload_Value;
+		SysTick->CVR = 0;
+		/* 3. Configure the SysTick Clock */
+#if SYSTICK_CLOCK_SOURCE == SYSTICK_EXTERNAL_CLOCK
+		SYSTICK_CLK_WITH_PRESCALER();
+#elif SYSTICK_CLOCK_SOURCE == SYSTICK_PROCESSOR_CLOCK
+		SYSTICK_CLK_WITHOUT_PRESCALER();
+#else
+#error "Invalid SysTick Clock Source Configurations"
+#endif
+		/* 4. Assign the Callback Function */
+		SysTick_Default_Interrupt_Handler = isr;
+		/* 5. Set the SysTic Mode flag to timebase */
+		SysTick_Mode = SYSTICK_MODE_TIMEBASE;
+		/* 6. Enable the SysTic timer exception */
+		SYSTICK_EXCEPTION_ENABLE();
+		/* 7. Enable the SysTic timer */
+		SYSTICK_TIMER_ENABLE();
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface returns the number of timebase periods
+ * elapsed since SysTick_Timebase_Start().
+ * @return The 64-bit period count.
+ */
+uint64_t SysTick_Get_Ticks(void)
+{
+	uint64_t Ticks = 0;
+	/* Re-read until the 64-bit value was not updated in between */
+	do
+	{
+		Ticks = SysTick_Tick_Count;
+	} while(Ticks != SysTick_Tick_Count);
+	return Ticks;
+}
+/*
+ * @brief A software interface returns the number of SysTick counter
+ * cycles elapsed since SysTick_Timebase_Start().
+ * It is lock-free and safe from any context. With the SysTick exception
+ * masked or pending it stays right for one period past the pending wrap
+ * only: a second wrap before the handler runs is not seen, and the count
+ * goes back by a whole period.
+ * Across an HCLK change (SysTick_Rescale()) the cycles of each clock add
+ * up, the count never goes back.
+ * @return The 64-bit cycle count.
+ */
+uint64_t SysTick_Get_Cycles(void)
+{
+	uint64_t Period = 0;
+	uint64_t Cycle_Base = 0;
+	uint64_t Base_Ticks = 0;
+	uint32_t Base_Offset = 0;
+	uint64_t Since_Base = 0;
+	uint64_t Ticks_Before = 0;
+	uint64_t Ticks_After = 0;
+	uint32_t Current_Before = 0;
+	uint32_t Current_After = 0;
+	uint32_t Wrap_Pending = 0;
 
+	do
+	{
+		Ticks_Before = SysTick_Tick_Count;
+		Period = (uint64_t)SysTick_Reload_Value + 1UL;
+		Cycle_Base = SysTick_Cycle_Base;
+		Base_Ticks = SysTick_Base_Ticks;
+		Base_Offset = SysTick_Base_Offset;
+		Current_Before = SysTick->CVR;
+		/* PENDSTSET is read rather than COUNTFLAG, reading COUNTFLAG clears it */
+		Wrap_Pending = READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS);
+		Current_After = SysTick->CVR;
+		Ticks_After = SysTick_Tick_Count;
+	} while(Ticks_Before != Ticks_After);	/* The handler ran in between, retry */
+
+	if(Wrap_Pending)
+	{
+		/* The counter wrapped before the flag was read but the handler did not
+		 * run yet (masked or lower priority): count the period ourselves and
+		 * use the value read after the flag, which is past the wrap. */
+		Ticks_Before++;
+		Current_Before = Current_After;
+	}
+	/* The counter runs Reload .. 1, 0 and wraps on reaching 0, so 0 is the
+	 * first count of the next period (already counted by the handler) */
+	Since_Base = ((Ticks_Before - Base_Ticks) * Period) + ((Period - Current_Before) % Period);
+	/* The first period after a rescale is shortened by the offset, the
+	 * counter may still read the cleared value right after it */
+	return Cycle_Base + ((Since_Base > Base_Offset) ? (Since_Base - Base_Offset) : 0UL);
+}
+/*
+ * @brief A software interface returns the time elapsed since
+ * SysTick_Timebase_Start() in microseconds.
+ * @return The 64-bit time in microseconds.
+ */
+uint64_t SysTick_Get_Micros(void)
+{
+	uint64_t Cycles = SysTick_Get_Cycles();
+	/* Only the cycles since the last HCLK change run at the live clock */
+	return (SysTick_Nanos_Base + SysTick_Cycles_To_Nanos(Cycles - SysTick_Cycle_Base, SysTick_Get_InputClock())) / 1000UL;
+}
+/*
+ * @brief A software interface registers a function called from the
+ * SysTick interrupt on every period, before the interval callback.
+ * It lets several services share the timer (software timers, dispatchers...).
+ * Registering a hook again does nothing.
+ * @param Hook: Pointer to the hook function.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully
+ *          (E_NOT_OK) : NULL hook or all the SYSTICK_MAX_TICK_HOOKS slots are used
+ */
+Std_ReturnType_t SysTick_Register_TickHook(Interrupt_Handler_t Hook)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint8_t Hook_Idx = 0;
+	uint8_t Registered = 0;
+
+	/* A service initialized again keeps its slot, it must not tick twice */
+	for(Hook_Idx = 0; Hook_Idx < SysTick_Tick_Hooks_Count; Hook_Idx++)
+	{
+		if(Hook == SysTick_Tick_Hooks[Hook_Idx])
+			{ Registered = 1; }
+	}
+
+	if((NULL == Hook) || ((0 == Registered) && (SysTick_Tick_Hooks_Count >= SYSTICK_MAX_TICK_HOOKS)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else if(0 == Registered)
+	{
+		/* Fill the slot before publishing it to the handler */
+		SysTick_Tick_Hooks[SysTick_Tick_Hooks_Count] = Hook;
+		SysTick_Tick_Hooks_Count++;
+	}
+	return retVal;
+}
+/*
+ * @brief A software interface sleeps (WFI) for up to Idle_Ticks timebase
+ * periods without waking up on the periods in between (tickless idle).
+ * The reload register is programmed to the deadline, several 24-bit
+ * reloads are chained for longer deadlines, and the timebase is
+ * corrected for the elapsed time on wake-up.
+ * The SysTick interrupt still fires for the period that ends the sleep,
+ * the periods before it are not seen by the tick hooks: the caller
+ * catches up with the returned count. Other tick consumers (another hook
+ * or the timebase callback, e.g. the dispatcher or the kernel) cannot,
+ * so while one is registered the sleep is a plain WFI.
+ * Call it with interrupts masked, after checking there is nothing to do,
+ * so a wake-up event cannot be missed. Less than 2 ticks is a plain WFI.
+ * @param Idle_Ticks: Number of periods until the next deadline.
+ * @param Caller_Hook: Tick hook of the caller, the only one allowed to miss ticks.
+ * @return Number of periods elapsed without a SysTick interrupt.
+ */
+uint32_t SysTick_Tickless_Sleep(uint32_t Idle_Ticks, Interrupt_Handler_t Caller_Hook)
+{
+	const uint32_t Period = SysTick_Reload_Value + 1UL;
+	uint32_t Irq_State = Core_Enter_Critical();
+	uint32_t Silent_Ticks = 0;
+	uint32_t Current = 0;
+	uint32_t Chunk_Ticks = 0;
+	uint32_t Sleep_Cycles = 0;
+	uint32_t Elapsed = 0;
+	uint32_t Elapsed_Ticks = 0;
+	uint32_t Left = 0;
+	uint32_t Wrapped = 0;
+	uint8_t Hook_Idx = 0;
+	uint8_t Other_Consumer = (NULL != SysTick_Default_Interrupt_Handler) ? 1U : 0U;
+
+	for(Hook_Idx = 0; Hook_Idx < SysTick_Tick_Hooks_Count; Hook_Idx++)
+	{
+		if(Caller_Hook != SysTick_Tick_Hooks[Hook_Idx])
+			{ Other_Consumer = 1U; }
+	}
+
+	if((SYSTICK_MODE_TIMEBASE != SysTick_Mode) || (Idle_Ticks < 2UL) || Other_Consumer)
+	{
+		CORE_DSB();
+		CORE_WFI();
+		Core_Exit_Critical(Irq_State);
+		return 0;
+	}
+
+	while(Idle_Ticks > 0)
+	{
+		/* 1. Freeze the counter, Current is the distance to the next period */
+		SYSTICK_TIMER_DISABLE();
+		Current = SysTick->CVR;
+		if(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS) || (0 == Current))
+		{
+			/* A period just ended, let the handler count it */
+			SYSTICK_TIMER_ENABLE();
+			break;
+		}
+
+		/* 2. Reload up to the deadline, within the 24-bit counter */
+		Chunk_Ticks = ((SYSTICK_MAX_RELOAD + 1UL - Current) / Period) + 1UL;
+		if(Chunk_Ticks > Idle_Ticks)
+			{ Chunk_Ticks = Idle_Ticks; }
+		Sleep_Cycles = Current + ((Chunk_Ticks - 1UL) * Period);
+		SysTick->RVR = Sleep_Cycles - 1UL;
+		SysTick->CVR = 0;
+		SYSTICK_TIMER_ENABLE();
+
+		/* 3. Sleep, the masked interrupts still wake the core */
+		CORE_DSB();
+		CORE_WFI();
+		CORE_ISB();
+
+		/* 4. Measure the time slept. The wrap is read from PENDSTSET (clear
+		 *    before the sleep): COUNTFLAG is already cleared by the CSR read
+		 *    of the disable */
+		SYSTICK_TIMER_DISABLE();
+		Wrapped = READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS);
+		Elapsed = SysTick->CVR;
+		Elapsed = (Wrapped) ? (Sleep_Cycles + ((Sleep_Cycles - Elapsed) % Sleep_Cycles)) : (Sleep_Cycles - Elapsed);
+		Elapsed_Ticks = (Elapsed >= Current) ? (1UL + ((Elapsed - Current) / Period)) : 0UL;
+
+		/* 5. Finish the running period on the original grid so no time drifts,
+		 *    then go back to the normal reload */
+		Left = Current + (Elapsed_Ticks * Period) - Elapsed;
+		if(Left < 2UL)
+			{ Left = 2UL; }
+		SysTick->RVR = Left - 1UL;
+		SysTick->CVR = 0;
+		SYSTICK_TIMER_ENABLE();
+		SysTick->RVR = SysTick_Reload_Value;
+
+		if(!Wrapped)
+		{
+			/* Woken early by another interrupt */
+			Silent_Ticks += Elapsed_Ticks;
+			break;
+		}
+		Idle_Ticks = (Elapsed_Ticks < Idle_Ticks) ? (Idle_Ticks - Elapsed_Ticks) : 0UL;
+		if((0UL == Idle_Ticks) || READ_BIT(SCB->ICSR, SCB_ICSR_ISRPENDING_POS))
+		{
+			/* Deadline reached (or other work pending): the pending SysTick
+			 * interrupt counts the last period and runs the hooks */
+			Silent_Ticks += Elapsed_Ticks - 1UL;
+			break;
+		}
+		/* 6. Chain the next reload, this wrap is only an intermediate step */
+		SCB->ICSR = (1UL << SCB_ICSR_PENDSTCLR_POS);
+		Silent_Ticks += Elapsed_Ticks;
+	}
+
+	SysTick_Tick_Count += Silent_Ticks;
+	Core_Exit_Critical(Irq_State);
+	return Silent_Ticks;
+}
 
 
 
 void SysTick_Handler(void)
 {
+	uint8_t Hook_Idx = 0;
+
+	SysTick_Tick_Count++;
+
 	if(SYSTICK_MODE_SINGLE_INTERVAL == SysTick_Mode)
 	{
 		/* Disable the SysTic timer */
@@ -183,7 +513,109 @@ void SysTick_Handler(void)
 		SYSTICK_EXCEPTION_DISABLE();
 	}
 
+	for(Hook_Idx = 0; Hook_Idx < SysTick_Tick_Hooks_Count; Hook_Idx++)
+		{ SysTick_Tick_Hooks[Hook_Idx](); }
+
 	if(SysTick_Default_Interrupt_Handler)
 		SysTick_Default_Interrupt_Handler();
 }
+/*
+ * @brief A software interface keeps the period of a running interval or
+ * timebase in time across an HCLK change, by scaling the reload value.
+ * The period in progress keeps the time it has left, and the cycle and
+ * microsecond counts go on from where they are. Call it right after the switch.
+ * @param Old_HCLK: HCLK before the change in Hz.
+ * @param New_HCLK: HCLK after the change in Hz.
+ * @return Status of the function
+ *          (E_OK) : The function done successfully, or the timer is stopped
+ *          (E_NOT_OK) : Null frequency or the scaled period does not fit 24 bits
+ */
+Std_ReturnType_t SysTick_Rescale(uint32_t Old_HCLK, uint32_t New_HCLK)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint64_t Period = 0;
+	uint64_t Left = 0;
+	uint64_t Cycles = 0;
+	uint32_t Wrap_Pending = 0;
+	uint32_t Irq_State = 0;
+
+	if((0 == Old_HCLK) || (0 == New_HCLK))
+	{
+		retVal = E_NOT_OK;
+	}
+	else if(READ_BIT(SysTick->CSR, SYSTICK_ENABLE_BIT_POS))
+	{
+		Irq_State = Core_Enter_Critical();
+		/* 1. Same period in time, rounded to the nearest tick */
+		Period = ((((uint64_t)SysTick->RVR + 1UL) * New_HCLK) + (Old_HCLK / 2UL)) / Old_HCLK;
+		if((Period < 2UL) || (Period > (SYSTICK_MAX_RELOAD + 1UL)))
+		{
+			retVal = E_NOT_OK;
+		}
+		else
+		{
+			/* 2. Freeze the counter and take the counts reached at the old clock */
+			SYSTICK_TIMER_DISABLE();
+			Wrap_Pending = READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS);
+			Cycles = SysTick_Get_Cycles();
+
+			/* 3. The time left in the running period, at the new clock (0 is
+			 *    the first count of the next period, a full one is left) */
+			Left = (0UL != SysTick->CVR) ? ((((uint64_t)SysTick->CVR * New_HCLK) + (Old_HCLK / 2UL)) / Old_HCLK) : Period;
+			if(Left < 2UL)
+				{ Left = 2UL; }
+			if(Left > Period)
+				{ Left = Period; }
+
+			/* 4. Finish it with a one-off reload, then back to the scaled one */
+			SysTick->RVR = (uint32_t)Left - 1UL;
+			SysTick->CVR = 0;
+			SYSTICK_TIMER_ENABLE();
+			SysTick->RVR = (uint32_t)Period - 1UL;
+
+			if(SYSTICK_MODE_TIMEBASE == SysTick_Mode)
+			{
+				/* 5. New base, a pending wrap is already in the cycles */
+				SysTick_Nanos_Base += SysTick_Cycles_To_Nanos(Cycles - SysTick_Cycle_Base, SYSTICK_INPUT_CLOCK(Old_HCLK));
+				SysTick_Cycle_Base = Cycles;
+				SysTick_Base_Ticks = SysTick_Tick_Count + ((Wrap_Pending) ? 1UL : 0UL);
+				SysTick_Base_Offset = (uint32_t)(Period - Left);
+				SysTick_Reload_Value = (uint32_t)Period - 1UL;
+			}
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+
+/*---------------  Section: Helper Function Definitions --------------- */
+/* Splits the conversion so (Cycles * 1000000000) never overflows */
+static uint64_t SysTick_Cycles_To_Nanos(uint64_t Cycles, uint32_t Input_Clock)
+{
+	return ((Cycles / Input_Clock) * 1000000000UL) + (((Cycles % Input_Clock) * 1000000000UL) / Input_Clock);
+}
 
+/*
+ * The DWT cycle counter rather than the timebase: the timebase needs the
+ * SysTick handler within a period, a delay with the exception masked for
+ * longer would see it step back.
+ */
+static void SysTick_Delay(const uint64_t Time, const uint32_t Units_Per_Second)
+{
+	uint64_t Cycles = 0;
+	uint64_t Elapsed_Cycles = 0;
+	uint32_t Last_Count = 0;
+	uint32_t Now_Count = 0;
+
+	/* Count processor cycles, 32-bit wraps accumulated, rounding up */
+	Cycles = ((Time * RCC_Get_HCLK_Freq()) + Units_Per_Second - 1UL) / Units_Per_Second;
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ (void)DWT_CycleCounter_Init(); }
+	Last_Count = DWT_GET_CYCCNT();
+	while(Elapsed_Cycles < Cycles)
+	{
+		Now_Count = DWT_GET_CYCCNT();
+		Elapsed_Cycles += (uint32_t)(Now_Count - Last_Count);
+		Last_Count = Now_Count;
+	}
+}
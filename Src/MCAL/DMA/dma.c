@@ -7,27 +7,39 @@
  */
 /* --------------- Section : Includes --------------- */
 #include "MCAL/DMA/dma.h"
+#include "MCAL/RCC/rcc.h"
+#include "CortexM4/Core/Core.h"
 /*---------------  Section: Staatic Global Variables --------------- */
 
 static Interrupt_Handler_t DMA1_Streams_DefaultInterruptHandlers[8];
 static Interrupt_Handler_t DMA2_Streams_DefaultInterruptHandlers[8];
+/* !< One bit per initialized stream, each controller holds a clock reference while any is set */
+static uint8_t DMA1_Streams_Clocked = 0;
+static uint8_t DMA2_Streams_Clocked = 0;
 
 
 /*---------------  Section: Function Definitions --------------- */
 Std_ReturnType_t DMA1_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs)
 {
 	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
 	if((NULL == StreamCfgs) || (NULL == dma_cfgs) || (StreamCfgs->Stream_Idx >= 8))
 	{
 		retVal = E_NOT_OK;
 	}
 	else
 	{
-		/* 1. Disable the DMA Stream */
+		/* 1. Enable the DMA Clock first, the registers ignore writes without it.
+		 * 	  The controller holds one reference for all its streams, shared with
+		 * 	  the streams set up from an interrupt */
+		Irq_State = Core_Enter_Critical();
+		if(0 == DMA1_Streams_Clocked)
+			{ retVal |= RCC_Periph_Clock_Acquire(RCC_PERIPH_DMA1); }
+		DMA1_Streams_Clocked |= (uint8_t)(1U << StreamCfgs->Stream_Idx);
+		Core_Exit_Critical(Irq_State);
+		/* 2. Disable the DMA Stream */
 		CLEAR_BIT(DMA1->Streams[StreamCfgs->Stream_Idx].CR, 0);
 		DMA1->Streams[StreamCfgs->Stream_Idx].CR = DMA_SxCR_RESET_VALUE;
-		/* 2. Enable the DMA Clock */
-		RCC->AHB1ENR |= (1UL << 21);
 		/* 3. Peripheral address */
 		DMA1->Streams[StreamCfgs->Stream_Idx].PAR = StreamCfgs->Peripheral_Address;
 		/* 4. Memory address */
@@ -51,6 +63,15 @@ Std_ReturnType_t DMA1_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
 		DMA1->Streams[StreamCfgs->Stream_Idx].CR |= (((uint32_t)(dma_cfgs->Direction) & (3UL)) << 6);
 		/* 10. Select the channel */
 		DMA1->Streams[StreamCfgs->Stream_Idx].CR |= ((uint32_t)((dma_cfgs->Channel) & (7UL)) << 25);
+		/* 10.1 Data sizes, circular or peripheral flow control mode, bursts */
+		DMA1->Streams[StreamCfgs->Stream_Idx].CR |= ((dma_cfgs->PeriphDataAlignment & 3UL) << 11) |
+													((dma_cfgs->MemDataAlignment & 3UL) << 13) |
+													((dma_cfgs->PeriphBurst & 3UL) << 21) |
+													((dma_cfgs->MemBurst & 3UL) << 23);
+		if(DMA_CIRCULAR == dma_cfgs->Mode)
+			{ SET_BIT(DMA1->Streams[StreamCfgs->Stream_Idx].CR, 8); }
+		else if(DMA_PFCTRL == dma_cfgs->Mode)
+			{ SET_BIT(DMA1->Streams[StreamCfgs->Stream_Idx].CR, 5); }
 		/* 11. Configure the FIFO Mode */
 		// Reset the FIFO Control Register First
 		DMA1->Streams[StreamCfgs->Stream_Idx].FCR = DMA_SxFCR_RESET_VALUE;
@@ -78,6 +99,7 @@ Std_ReturnType_t DMA1_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
 Std_ReturnType_t DMA1_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs)
 {
 	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
 	if((NULL == StreamCfgs) || (NULL == dma_cfgs) || (StreamCfgs->Stream_Idx >= 8))
 	{
 		retVal = E_NOT_OK;
@@ -93,6 +115,15 @@ Std_ReturnType_t DMA1_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_
 		DMA1->Streams[StreamCfgs->Stream_Idx].M1AR = DMA_SxM1AR_RESET_VALUE;
 		DMA1->Streams[StreamCfgs->Stream_Idx].NDTR = DMA_SxNDTR_RESET_VALUE;
 		DMA1->Streams[StreamCfgs->Stream_Idx].PAR = DMA_SxPAR_RESET_VALUE;
+		/* 3. Release the DMA Clock with the last stream */
+		Irq_State = Core_Enter_Critical();
+		if(DMA1_Streams_Clocked & (1U << StreamCfgs->Stream_Idx))
+		{
+			DMA1_Streams_Clocked &= (uint8_t)~(1U << StreamCfgs->Stream_Idx);
+			if(0 == DMA1_Streams_Clocked)
+				{ retVal |= RCC_Periph_Clock_Release(RCC_PERIPH_DMA1); }
+		}
+		Core_Exit_Critical(Irq_State);
 	}
 	return retVal;
 }
@@ -100,17 +131,24 @@ Std_ReturnType_t DMA1_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_
 Std_ReturnType_t DMA2_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs)
 {
 	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
 	if((NULL == StreamCfgs) || (NULL == dma_cfgs) || (StreamCfgs->Stream_Idx >= 8))
 	{
 		retVal = E_NOT_OK;
 	}
 	else
 	{
-		/* 1. Disable the DMA Stream */
+		/* 1. Enable the DMA Clock first, the registers ignore writes without it.
+		 * 	  The controller holds one reference for all its streams, shared with
+		 * 	  the streams set up from an interrupt */
+		Irq_State = Core_Enter_Critical();
+		if(0 == DMA2_Streams_Clocked)
+			{ retVal |= RCC_Periph_Clock_Acquire(RCC_PERIPH_DMA2); }
+		DMA2_Streams_Clocked |= (uint8_t)(1U << StreamCfgs->Stream_Idx);
+		Core_Exit_Critical(Irq_State);
+		/* 2. Disable the DMA Stream */
 		CLEAR_BIT(DMA2->Streams[StreamCfgs->Stream_Idx].CR, 0);
 		DMA2->Streams[StreamCfgs->Stream_Idx].CR = DMA_SxCR_RESET_VALUE;
-		/* 2. Enable the DMA Clock */
-		RCC->AHB1ENR |= (1UL << 22);
 		/* 3. Peripheral address */
 		DMA2->Streams[StreamCfgs->Stream_Idx].PAR = StreamCfgs->Peripheral_Address;
 		/* 4. Memory address */
@@ -134,6 +172,15 @@ Std_ReturnType_t DMA2_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
 		DMA2->Streams[StreamCfgs->Stream_Idx].CR |= (((uint32_t)(dma_cfgs->Direction) & (3UL)) << 6);
 		/* 10. Select the channel */
 		DMA2->Streams[StreamCfgs->Stream_Idx].CR |= ((uint32_t)((dma_cfgs->Channel) & (7UL)) << 25);
+		/* 10.1 Data sizes, circular or peripheral flow control mode, bursts */
+		DMA2->Streams[StreamCfgs->Stream_Idx].CR |= ((dma_cfgs->PeriphDataAlignment & 3UL) << 11) |
+													((dma_cfgs->MemDataAlignment & 3UL) << 13) |
+													((dma_cfgs->PeriphBurst & 3UL) << 21) |
+													((dma_cfgs->MemBurst & 3UL) << 23);
+		if(DMA_CIRCULAR == dma_cfgs->Mode)
+			{ SET_BIT(DMA2->Streams[StreamCfgs->Stream_Idx].CR, 8); }
+		else if(DMA_PFCTRL == dma_cfgs->Mode)
+			{ SET_BIT(DMA2->Streams[StreamCfgs->Stream_Idx].CR, 5); }
 		/* 11. Configure the FIFO Mode */
 		// Reset the FIFO Control Register First
 		DMA2->Streams[StreamCfgs->Stream_Idx].FCR = DMA_SxFCR_RESET_VALUE;
@@ -162,6 +209,7 @@ Std_ReturnType_t DMA2_Init(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_In
 Std_ReturnType_t DMA2_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs)
 {
 	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
 	if((NULL == StreamCfgs) || (NULL == dma_cfgs) || (StreamCfgs->Stream_Idx >= 8))
 	{
 		retVal = E_NOT_OK;
@@ -177,6 +225,54 @@ Std_ReturnType_t DMA2_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_
 		DMA2->Streams[StreamCfgs->Stream_Idx].M1AR = DMA_SxM1AR_RESET_VALUE;
 		DMA2->Streams[StreamCfgs->Stream_Idx].NDTR = DMA_SxNDTR_RESET_VALUE;
 		DMA2->Streams[StreamCfgs->Stream_Idx].PAR = DMA_SxPAR_RESET_VALUE;
+		/* 3. Release the DMA Clock with the last stream */
+		Irq_State = Core_Enter_Critical();
+		if(DMA2_Streams_Clocked & (1U << StreamCfgs->Stream_Idx))
+		{
+			DMA2_Streams_Clocked &= (uint8_t)~(1U << StreamCfgs->Stream_Idx);
+			if(0 == DMA2_Streams_Clocked)
+				{ retVal |= RCC_Periph_Clock_Release(RCC_PERIPH_DMA2); }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+
+/**
+ * @brief  Restarts an initialized stream on a new memory buffer, for the
+ * 		   transfers of a normal mode stream one after the other.
+ * 		   The stream is stopped and its flags cleared before the reload.
+ * @param  DMAx: DMA1 or DMA2.
+ * @param  Stream_Idx: The stream, 0 .. 7.
+ * @param  Memory_Address: The new memory address.
+ * @param  No_Of_Items: The new number of items.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, or the stream did not stop
+ */
+Std_ReturnType_t DMA_Stream_Reload(DMA_Registers_t * DMAx, uint8_t Stream_Idx, uint32_t Memory_Address, uint16_t No_Of_Items)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	uint32_t Polls = 0;
+
+	if(((DMA1 == DMAx) || (DMA2 == DMAx)) && (Stream_Idx < 8))
+	{
+		/* 1. Stop the stream, EN reads 1 until the current item is done */
+		CLEAR_BIT(DMAx->Streams[Stream_Idx].CR, 0);
+		for(Polls = 0; (Polls < DMA_STREAM_STOP_TIMEOUT) && (E_NOT_OK == retVal); Polls++)
+		{
+			if(!DMA_STREAM_IS_ENABLED(DMAx, Stream_Idx))
+				{ retVal = E_OK; }
+		}
+		if(E_OK == retVal)
+		{
+			/* 2. No stale flag may be seen as the end of the new transfer */
+			DMA_CLEAR_ALL_FLAGS(DMAx, Stream_Idx);
+			/* 3. New buffer and restart */
+			DMAx->Streams[Stream_Idx].M0AR = Memory_Address;
+			DMAx->Streams[Stream_Idx].NDTR = No_Of_Items;
+			SET_BIT(DMAx->Streams[Stream_Idx].CR, 0);
+		}
 	}
 	return retVal;
 }
@@ -188,8 +284,8 @@ Std_ReturnType_t DMA2_DeInit(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_
  */
 void DMA1_Stream0_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->LIFCR, 5);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 0);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[0])
     	DMA1_Streams_DefaultInterruptHandlers[0]();
@@ -200,8 +296,8 @@ void DMA1_Stream0_IRQHandler(void)
  */
 void DMA1_Stream1_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->LIFCR, 11);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 1);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[1])
     	DMA1_Streams_DefaultInterruptHandlers[1]();
@@ -212,8 +308,8 @@ void DMA1_Stream1_IRQHandler(void)
  */
 void DMA1_Stream2_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->LIFCR, 21);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 2);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[2])
     	DMA1_Streams_DefaultInterruptHandlers[2]();
@@ -224,8 +320,8 @@ void DMA1_Stream2_IRQHandler(void)
  */
 void DMA1_Stream3_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->LIFCR, 27);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 3);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[3])
     	DMA1_Streams_DefaultInterruptHandlers[3]();
@@ -236,8 +332,8 @@ void DMA1_Stream3_IRQHandler(void)
  */
 void DMA1_Stream4_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->HIFCR, 5);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 4);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[4])
     	DMA1_Streams_DefaultInterruptHandlers[4]();
@@ -248,8 +344,8 @@ void DMA1_Stream4_IRQHandler(void)
  */
 void DMA1_Stream5_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->HIFCR, 11);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 5);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[5])
     	DMA1_Streams_DefaultInterruptHandlers[5]();
@@ -260,8 +356,8 @@ void DMA1_Stream5_IRQHandler(void)
  */
 void DMA1_Stream6_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->HIFCR, 21);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 6);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[6])
     	DMA1_Streams_DefaultInterruptHandlers[6]();
@@ -272,8 +368,8 @@ void DMA1_Stream6_IRQHandler(void)
  */
 void DMA1_Stream7_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-	SET_BIT(DMA1->HIFCR, 27);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+	DMA_CLEAR_ALL_FLAGS(DMA1, 7);
     /* Call the ISR */
     if(DMA1_Streams_DefaultInterruptHandlers[7])
     	DMA1_Streams_DefaultInterruptHandlers[7]();
@@ -284,8 +380,8 @@ void DMA1_Stream7_IRQHandler(void)
  */
 void DMA2_Stream0_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->LIFCR, 5);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 0);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[0])
         DMA2_Streams_DefaultInterruptHandlers[0]();
@@ -296,8 +392,8 @@ void DMA2_Stream0_IRQHandler(void)
  */
 void DMA2_Stream1_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->LIFCR, 11);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 1);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[1])
         DMA2_Streams_DefaultInterruptHandlers[1]();
@@ -308,8 +404,8 @@ void DMA2_Stream1_IRQHandler(void)
  */
 void DMA2_Stream2_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->LIFCR, 21);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 2);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[2])
         DMA2_Streams_DefaultInterruptHandlers[2]();
@@ -320,8 +416,8 @@ void DMA2_Stream2_IRQHandler(void)
  */
 void DMA2_Stream3_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->LIFCR, 27);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 3);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[3])
         DMA2_Streams_DefaultInterruptHandlers[3]();
@@ -332,8 +428,8 @@ void DMA2_Stream3_IRQHandler(void)
  */
 void DMA2_Stream4_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->HIFCR, 5);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 4);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[4])
         DMA2_Streams_DefaultInterruptHandlers[4]();
@@ -344,8 +440,8 @@ void DMA2_Stream4_IRQHandler(void)
  */
 void DMA2_Stream5_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->HIFCR, 11);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 5);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[5])
         DMA2_Streams_DefaultInterruptHandlers[5]();
@@ -356,8 +452,8 @@ void DMA2_Stream5_IRQHandler(void)
  */
 void DMA2_Stream6_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->HIFCR, 21);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 6);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[6])
         DMA2_Streams_DefaultInterruptHandlers[6]();
@@ -368,8 +464,8 @@ void DMA2_Stream6_IRQHandler(void)
  */
 void DMA2_Stream7_IRQHandler(void)
 {
-    /* Clear the interrupt flag */
-    SET_BIT(DMA2->HIFCR, 27);
+    /* Clear the interrupt flags, the stream may have the half transfer one enabled too */
+    DMA_CLEAR_ALL_FLAGS(DMA2, 7);
     /* Call the ISR */
     if(DMA2_Streams_DefaultInterruptHandlers[7])
         DMA2_Streams_DefaultInterruptHandlers[7]();
@@ -7,11 +7,58 @@
  */
 /* --------------- Section : Includes --------------- */
 #include "MCAL/FLASH/flash.h"
+#include "CortexM4/DWT/DWT.h"
 /*---------------  Section: Helper Function Declarations --------------- */
 static Std_ReturnType_t Flash_Unlock();
 static Std_ReturnType_t Flash_Lock();
 static Std_ReturnType_t OptionBytes_Unlock();
 static Std_ReturnType_t OptionBytes_Lock();
+static Std_ReturnType_t Flash_Sector_Erase_Operation(const uint32_t Sector_Idx);
+static Std_ReturnType_t Flash_Mass_Erase_Operation(void);
+static Std_ReturnType_t Flash_Program_Operation(uint32_t address, uint32_t data);
+static Std_ReturnType_t Flash_Program_Buffer_Operation(uint32_t address, const uint32_t * data, const uint32_t words);
+/*---------------  Section: Static Global Variables --------------- */
+static const uint32_t Flash_Sectors_Address[FLASH_SECTORS_NUMBER] =
+	{ 0x08000000UL, 0x08004000UL, 0x08008000UL, 0x0800C000UL, 0x08010000UL, 0x08020000UL };
+static const uint32_t Flash_Sectors_Size[FLASH_SECTORS_NUMBER] =
+	{ 0x4000UL, 0x4000UL, 0x4000UL, 0x4000UL, 0x10000UL, 0x20000UL };
+/* Operation started by Flash_Erase_Sector_Start() / Flash_Program_Start() */
+static volatile Flash_Async_Operation_t Flash_Async_Operation = FLASH_ASYNC_NONE;
+static uint32_t Flash_Async_Sector_Idx = 0;
+static uint32_t Flash_Async_Start_Cycles = 0;
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+/*---------------  Section: Statistics Types and Variables --------------- */
+typedef struct
+{
+	uint32_t Count;
+	uint32_t Worst_Cycles;
+	uint32_t Error_Count;
+	uint32_t Last_Error_Flags;
+	uint64_t Total_Cycles;
+} Flash_OpStats_Accumulator_t;
+
+/* !< Load address and bounds of .data, set by the linker script: the image ends after the .data image */
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+
+static uint32_t Flash_Erase_Counters[FLASH_SECTORS_NUMBER];
+static uint32_t Flash_Journal_Sector_Idx = FLASH_STATS_SECTOR_A;	/* !< Sector holding the current journal */
+static uint32_t Flash_Journal_Sequence = 0;
+static uint32_t Flash_Journal_Next_Address = 0;
+static uint8_t Flash_Stats_Initialized = 0;
+
+static Flash_OpStats_Accumulator_t Flash_Sector_Erase_Stats[FLASH_SECTORS_NUMBER];
+static Flash_OpStats_Accumulator_t Flash_Mass_Erase_Stats;
+static Flash_OpStats_Accumulator_t Flash_Program_Stats;
+
+static uint32_t Flash_Stats_Record(Flash_OpStats_Accumulator_t * Acc, const uint32_t Cycles);
+static void Flash_Stats_Report(const Flash_OpStats_Accumulator_t * Acc, Flash_OpStats_t * Stats);
+static void Flash_Stats_Journal_Append(const uint32_t Sector_Idx);
+static Std_ReturnType_t Flash_Stats_Journal_Evacuate(const uint32_t Sector_Idx);
+static Std_ReturnType_t Flash_Stats_Journal_Commit(const uint32_t Journal_Idx, const uint8_t Erase_Needed);
+static uint32_t Flash_Stats_Journal_Is_Valid(const uint32_t Journal_Idx);
+#endif
 /*---------------  Section: Function Definitions --------------- */
 
 /**
@@ -27,30 +74,28 @@ Std_ReturnType_t Flash_Erase_Sector(const Flash_Sector_t Sector)
 {
 	Std_ReturnType_t retVal = E_OK;
 
-	if((uint32_t)Sector > (uint32_t)FLASH_SECTOR_5)
+	if(((uint32_t)Sector < (uint32_t)FLASH_SECTOR_0) || ((uint32_t)Sector > (uint32_t)FLASH_SECTOR_5))
 		{ retVal |= E_NOT_OK; }
 	else
 	{
-		/* 1. Wait for the Flash Memory to be free */
-		FLASH_WAIT_FOR_COMPLETION();
-
-		/* 2. Unlock the Control register */
-		retVal |= Flash_Unlock();
-
-		/* 3. Set the SER bit */
-		FLASH->CR |= (1UL << 1);
-
-		/* 4. Select the Sector to be erased */
-		FLASH->CR |= (uint32_t) (((uint32_t)Sector & 0x0000000F) << 3);
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+		uint32_t Start_Cycles = 0;
+		uint32_t Sector_Idx = (uint32_t)Sector & 0x0000000F;
 
-		/* 5. Start the erase operation */
-		FLASH_START_OPERATION();
-
-		/* 6. Wait for the Flash to complete the operation */
-		FLASH_WAIT_FOR_COMPLETION();
+		/* The journal leaves the sector before the erase, a reset never finds it half written */
+		retVal |= Flash_Stats_Journal_Evacuate(Sector_Idx);
+		if(E_OK == retVal)
+		{
+			Start_Cycles = DWT_GET_CYCCNT();
+			retVal |= Flash_Sector_Erase_Operation(Sector_Idx);
 
-		/* 7. Lock the Control register */
-		retVal |= Flash_Lock();
+			/* Time the erase, and count it in the journal if it went through */
+			if(0 == Flash_Stats_Record(&Flash_Sector_Erase_Stats[Sector_Idx], DWT_GET_CYCCNT() - Start_Cycles))
+				{ Flash_Stats_Journal_Append(Sector_Idx); }
+		}
+#else
+		retVal |= Flash_Sector_Erase_Operation((uint32_t)Sector & 0x0000000F);
+#endif
 	}
 	return retVal;
 }
@@ -63,25 +108,23 @@ Std_ReturnType_t Flash_Erase_Sector(const Flash_Sector_t Sector)
 Std_ReturnType_t Flash_Erase_Mass(void)
 {
 	Std_ReturnType_t retVAl = E_OK;
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+	uint32_t Start_Cycles = DWT_GET_CYCCNT();
+	uint32_t Sector_Idx = 0;
 
-	/* 1. Wait for the Flash Memory to be free */
-	FLASH_WAIT_FOR_COMPLETION();
-
-	/* 2. Unlock the Control register */
-	retVAl |= Flash_Unlock();
-
-	/* 3. Set the MER bit */
-	FLASH->CR |= (1UL << 2);
-
-	/* 5. Start the erase operation */
-	FLASH_START_OPERATION();
-
-	/* 6. Wait for the Flash to complete the operation */
-	FLASH_WAIT_FOR_COMPLETION();
-
-	/* 7. Lock the Control register */
-	retVAl |= Flash_Lock();
+	retVAl |= Flash_Mass_Erase_Operation();
 
+	if(0 == Flash_Stats_Record(&Flash_Mass_Erase_Stats, DWT_GET_CYCCNT() - Start_Cycles))
+	{
+		/* Every sector got erased, the journal included */
+		for(Sector_Idx = 0; Sector_Idx < FLASH_SECTORS_NUMBER; Sector_Idx++)
+			{ Flash_Erase_Counters[Sector_Idx]++; }
+		if(Flash_Stats_Initialized)
+			{ retVAl |= Flash_Stats_Journal_Commit(FLASH_STATS_SECTOR_A, 0); }
+	}
+#else
+	retVAl |= Flash_Mass_Erase_Operation();
+#endif
 	return retVAl;
 }
 /**
@@ -103,34 +146,207 @@ Std_ReturnType_t Flash_Program(uint32_t address, uint32_t data)
 	}
 	else
 	{
-		/* 1. Wait for the Flash Memory to be free */
-		FLASH_WAIT_FOR_COMPLETION();
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+		uint32_t Start_Cycles = DWT_GET_CYCCNT();
 
-		/* 2. Unlock the Control register */
-		retVal |= Flash_Unlock();
-		if(E_NOT_OK == retVal)
-			{ return E_NOT_OK; }
+		retVal |= Flash_Program_Operation(address, data);
+
+		(void)Flash_Stats_Record(&Flash_Program_Stats, DWT_GET_CYCCNT() - Start_Cycles);
+#else
+		retVal |= Flash_Program_Operation(address, data);
+#endif
+	}
+
+	return retVal;
+}
+/**
+ * @brief  Programs consecutive words in the FLASH memory with a single
+ *         unlock/lock sequence, which is cheaper than one Flash_Program() per word.
+ * @param  address: Address in FLASH memory of the first word (word-aligned).
+ * @param  data: Pointer to the words to be programmed.
+ * @param  words: Number of words to program.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Operation failed (e.g., address not aligned, programming error)
+ */
+Std_ReturnType_t Flash_Program_Buffer(uint32_t address, const uint32_t * data, uint32_t words)
+{
+	Std_ReturnType_t retVal = E_OK;
 
-		/* 3. Set the parallelism size */
-		FLASH->CR |= (uint32_t)((FLASH_PARALLELISM_32 & 0x3UL) << FLASH_PSIIZE_POS);
+	if((address % 4 != 0) || (NULL == data) || (0 == words))
+	{
+		retVal |= E_NOT_OK;
+	}
+	else
+	{
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+		uint32_t Start_Cycles = DWT_GET_CYCCNT();
 
-		/* 4. Set the PG bit */
-		FLASH->CR |= (1UL);
+		retVal |= Flash_Program_Buffer_Operation(address, data, words);
 
-		/* 5. Start writing the data */
-		*((volatile uint32_t *)(address)) = data;
+		(void)Flash_Stats_Record(&Flash_Program_Stats, DWT_GET_CYCCNT() - Start_Cycles);
+#else
+		retVal |= Flash_Program_Buffer_Operation(address, data, words);
+#endif
+	}
 
-		/* 6. Wait for the Flash Memory to be free */
+	return retVal;
+}
+/**
+ * @brief  Starts the erase of a FLASH sector and returns without waiting.
+ *         Poll FLASH_IS_BUSY() (or await it) then call Flash_Operation_Finish().
+ *         The CPU still stalls on any FLASH read while the erase runs,
+ *         so the code doing other work meanwhile should run from RAM.
+ *         A sector holding the erase counters journal has it folded into the
+ *         other journal sector first, that part waits.
+ * @param  Sector: The sector to be erased.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation started
+ *         - E_NOT_OK: Invalid sector, FLASH busy, journal fold or unlock failed
+ */
+Std_ReturnType_t Flash_Erase_Sector_Start(const Flash_Sector_t Sector)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(((uint32_t)Sector < (uint32_t)FLASH_SECTOR_0) || ((uint32_t)Sector > (uint32_t)FLASH_SECTOR_5) ||
+	   (FLASH_ASYNC_NONE != Flash_Async_Operation) || FLASH_IS_BUSY())
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+		/* 1. Move the journal out of the sector first, synchronously */
+		retVal |= Flash_Stats_Journal_Evacuate((uint32_t)Sector & 0x0000000F);
+#endif
+		/* 2. Unlock the Control register */
+		if(E_OK == retVal)
+			{ retVal |= Flash_Unlock(); }
+		if(E_OK == retVal)
+		{
+			/* 3. Select the sector erase and the sector */
+			FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+			FLASH->CR |= (1UL << 1) | (uint32_t)(((uint32_t)Sector & 0x0000000F) << 3);
+
+			/* 4. Start the erase operation, Flash_Operation_Finish() does the rest */
+			Flash_Async_Sector_Idx = (uint32_t)Sector & 0x0000000F;
+			Flash_Async_Start_Cycles = DWT_GET_CYCCNT();
+			Flash_Async_Operation = FLASH_ASYNC_SECTOR_ERASE;
+			FLASH_START_OPERATION();
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Starts programming one word and returns without waiting.
+ *         Poll FLASH_IS_BUSY() (or await it) then call Flash_Operation_Finish().
+ * @param  address: Address in FLASH memory (word-aligned).
+ * @param  data: Data to be programmed.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation started
+ *         - E_NOT_OK: Address not aligned, FLASH busy or unlock failed
+ */
+Std_ReturnType_t Flash_Program_Start(uint32_t address, uint32_t data)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((address % 4 != 0) || (FLASH_ASYNC_NONE != Flash_Async_Operation) || FLASH_IS_BUSY())
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Unlock the Control register */
+		retVal |= Flash_Unlock();
+		if(E_OK == retVal)
+		{
+			/* 2. Set the parallelism size and the PG bit */
+			FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+			FLASH->CR |= (uint32_t)((FLASH_PARALLELISM_32 & 0x3UL) << FLASH_PSIIZE_POS);
+			FLASH->CR |= (1UL);
+
+			/* 3. Writing the data starts the operation */
+			Flash_Async_Start_Cycles = DWT_GET_CYCCNT();
+			Flash_Async_Operation = FLASH_ASYNC_PROGRAM;
+			*((volatile uint32_t *)address) = data;
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Completes the operation started by Flash_Erase_Sector_Start() or
+ *         Flash_Program_Start(): waits for the end if needed, checks the error
+ *         flags, locks the control register and updates the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No operation started or the operation failed
+ */
+Std_ReturnType_t Flash_Operation_Finish(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Error_Flags = 0;
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+	uint32_t Cycles = 0;
+#endif
+
+	if(FLASH_ASYNC_NONE == Flash_Async_Operation)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Returns at once when the caller awaited the end */
 		FLASH_WAIT_FOR_COMPLETION();
+		FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
 
-		/* 7. Check for errors */
-		if(FLASH_FLAG_PGAERR || FLASH_FLAG_PGPERR || FLASH_FLAG_PGSERR)
+		/* 2. Check for errors, then account the operation */
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+		Cycles = DWT_GET_CYCCNT() - Flash_Async_Start_Cycles;
+		if(FLASH_ASYNC_SECTOR_ERASE == Flash_Async_Operation)
+		{
+			Error_Flags = Flash_Stats_Record(&Flash_Sector_Erase_Stats[Flash_Async_Sector_Idx], Cycles);
+			if(0 == Error_Flags)
+				{ Flash_Stats_Journal_Append(Flash_Async_Sector_Idx); }
+		}
+		else
+		{
+			Error_Flags = Flash_Stats_Record(&Flash_Program_Stats, Cycles);
+		}
+#else
+		Error_Flags = FLASH_GET_ERRORS();
+		FLASH_CLEAR_ERRORS();
+#endif
+		if(0 != Error_Flags)
 			{ retVal |= E_NOT_OK; }
+		Flash_Async_Operation = FLASH_ASYNC_NONE;
 
-		/* 8. Lock the Control register */
+		/* 3. Lock the Control register */
 		retVal |= Flash_Lock();
 	}
-
+	return retVal;
+}
+/**
+ * @brief  Returns the memory range of a FLASH sector.
+ * @param  Sector: The sector to look up.
+ * @param  Address: Pointer receiving the first address of the sector.
+ * @param  Size: Pointer receiving the size of the sector in bytes.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid sector or NULL pointer
+ */
+Std_ReturnType_t Flash_Get_Sector_Range(const Flash_Sector_t Sector, uint32_t * Address, uint32_t * Size)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Address) || (NULL == Size) ||
+	   ((uint32_t)Sector < (uint32_t)FLASH_SECTOR_0) || ((uint32_t)Sector > (uint32_t)FLASH_SECTOR_5))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		*Address = Flash_Sectors_Address[(uint32_t)Sector & 0x0000000F];
+		*Size = Flash_Sectors_Size[(uint32_t)Sector & 0x0000000F];
+	}
 	return retVal;
 }
 /**
@@ -229,7 +445,387 @@ Std_ReturnType_t Flash_SetWriteProtection(const Flash_Sector_t Sector)
 	}
 	return retVal;
 }
+/**
+ * @brief  Sets the number of FLASH read wait states (ACR LATENCY).
+ *         Raise it before speeding HCLK up, lower it after slowing down.
+ * @param  Wait_States: Number of wait states, 0 to 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Out of range, or the new value did not read back
+ */
+Std_ReturnType_t Flash_Set_Latency(uint32_t Wait_States)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(Wait_States > FLASH_ACR_LATENCY_MASK)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY_MASK) | Wait_States;
+		/* The new latency is in use once it reads back */
+		if((FLASH->ACR & FLASH_ACR_LATENCY_MASK) != Wait_States)
+			{ retVal = E_NOT_OK; }
+	}
+	return retVal;
+}
+/**
+ * @brief  Returns the number of FLASH read wait states.
+ */
+uint32_t Flash_Get_Latency(void)
+{
+	return FLASH->ACR & FLASH_ACR_LATENCY_MASK;
+}
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+/**
+ * @brief  Loads the lifetime erase counters from the newest valid journal in
+ *         FLASH_STATS_SECTOR_A / B and starts the cycle counter used to time
+ *         the operations. Sector A is formatted if neither holds a journal.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: A journal sector overlaps the program image, or a flash operation failed
+ */
+Std_ReturnType_t Flash_Stats_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const uint32_t Image_End = (uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata);
+	uint32_t Journal_Start = 0;
+	uint32_t Journal_End = 0;
+	uint32_t Address = 0;
+	uint32_t Entry = 0;
+	uint32_t Sector_Idx = 0;
+
+	/* 1. Never format a sector holding code */
+	if((Flash_Sectors_Address[FLASH_STATS_SECTOR_A] < Image_End) || (Flash_Sectors_Address[FLASH_STATS_SECTOR_B] < Image_End))
+		{ return E_NOT_OK; }
+
+	/* 2. The operations are timed with the processor cycle counter */
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ retVal |= DWT_CycleCounter_Init(); }
+
+	/* 3. Pick the current journal: the valid one, or the newer of two valid ones */
+	if(Flash_Stats_Journal_Is_Valid(FLASH_STATS_SECTOR_A) && Flash_Stats_Journal_Is_Valid(FLASH_STATS_SECTOR_B))
+	{
+		Flash_Journal_Sector_Idx = ((int32_t)(*((volatile uint32_t *)(Flash_Sectors_Address[FLASH_STATS_SECTOR_B] + 4UL)) -
+										 *((volatile uint32_t *)(Flash_Sectors_Address[FLASH_STATS_SECTOR_A] + 4UL))) > 0)
+								   ? FLASH_STATS_SECTOR_B : FLASH_STATS_SECTOR_A;
+	}
+	else
+	{
+		Flash_Journal_Sector_Idx = Flash_Stats_Journal_Is_Valid(FLASH_STATS_SECTOR_B) ? FLASH_STATS_SECTOR_B : FLASH_STATS_SECTOR_A;
+	}
+
+	if(!Flash_Stats_Journal_Is_Valid(Flash_Journal_Sector_Idx))
+	{
+		/* 4. First boot: format sector A */
+		for(Sector_Idx = 0; Sector_Idx < FLASH_SECTORS_NUMBER; Sector_Idx++)
+			{ Flash_Erase_Counters[Sector_Idx] = 0; }
+		Flash_Journal_Sequence = 0;
+		retVal |= Flash_Stats_Journal_Commit(FLASH_STATS_SECTOR_A, 1);
+	}
+	else
+	{
+		/* 5. Load the counters folded in the header */
+		Journal_Start = Flash_Sectors_Address[Flash_Journal_Sector_Idx];
+		Journal_End = Journal_Start + Flash_Sectors_Size[Flash_Journal_Sector_Idx];
+		Flash_Journal_Sequence = *((volatile uint32_t *)(Journal_Start + 4UL));
+		for(Sector_Idx = 0; Sector_Idx < FLASH_SECTORS_NUMBER; Sector_Idx++)
+			{ Flash_Erase_Counters[Sector_Idx] = *((volatile uint32_t *)(Journal_Start + ((2UL + Sector_Idx) * 4UL))); }
+
+		/* 6. Replay the entries appended after the header */
+		Address = Journal_Start + (FLASH_STATS_HEADER_WORDS * 4UL);
+		while(Address < Journal_End)
+		{
+			Entry = *((volatile uint32_t *)(Address));
+			if(FLASH_ERASED_WORD == Entry)
+				{ break; }
+			/* A torn entry is skipped */
+			if(((Entry & FLASH_STATS_ENTRY_TAG_MASK) == FLASH_STATS_ENTRY_TAG) &&
+			   ((Entry & ~FLASH_STATS_ENTRY_TAG_MASK) < FLASH_SECTORS_NUMBER))
+				{ Flash_Erase_Counters[Entry & ~FLASH_STATS_ENTRY_TAG_MASK]++; }
+			Address += 4UL;
+		}
+		Flash_Journal_Next_Address = Address;
+	}
+
+	Flash_Stats_Initialized = (E_OK == retVal) ? 1 : 0;
+	return retVal;
+}
+/**
+ * @brief  Reports the erase count and the erase timing of a sector.
+ * @param  Sector: The sector to report.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid sector or NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetSector(const Flash_Sector_t Sector, Flash_SectorStats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Stats) || ((uint32_t)Sector < (uint32_t)FLASH_SECTOR_0) || ((uint32_t)Sector > (uint32_t)FLASH_SECTOR_5))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Stats->Erase_Count = Flash_Erase_Counters[(uint32_t)Sector & 0x0000000F];
+		Flash_Stats_Report(&Flash_Sector_Erase_Stats[(uint32_t)Sector & 0x0000000F], &Stats->Erase);
+	}
+	return retVal;
+}
+/**
+ * @brief  Reports the timing and errors of the mass erase operations.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetMassErase(Flash_OpStats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(NULL == Stats)
+		{ retVal = E_NOT_OK; }
+	else
+		{ Flash_Stats_Report(&Flash_Mass_Erase_Stats, Stats); }
+	return retVal;
+}
+/**
+ * @brief  Reports the timing and errors of the program operations.
+ *         A Flash_Program_Buffer() call counts as one operation.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Flash_Stats_GetProgram(Flash_OpStats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(NULL == Stats)
+		{ retVal = E_NOT_OK; }
+	else
+		{ Flash_Stats_Report(&Flash_Program_Stats, Stats); }
+	return retVal;
+}
+/**
+ * @brief  Clears the timing and error statistics kept in RAM.
+ *         The lifetime erase counters are not affected.
+ */
+void Flash_Stats_ResetTiming(void)
+{
+	const Flash_OpStats_Accumulator_t Zero_Stats = { 0 };
+	uint32_t Sector_Idx = 0;
+
+	for(Sector_Idx = 0; Sector_Idx < FLASH_SECTORS_NUMBER; Sector_Idx++)
+		{ Flash_Sector_Erase_Stats[Sector_Idx] = Zero_Stats; }
+	Flash_Mass_Erase_Stats = Zero_Stats;
+	Flash_Program_Stats = Zero_Stats;
+}
+#endif
 /*---------------  Section: Helper Function Definitions --------------- */
+static Std_ReturnType_t Flash_Sector_Erase_Operation(const uint32_t Sector_Idx)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. Wait for the Flash Memory to be free */
+	FLASH_WAIT_FOR_COMPLETION();
+
+	/* 2. Unlock the Control register */
+	retVal |= Flash_Unlock();
+
+	/* 3. Set the SER bit */
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+	FLASH->CR |= (1UL << 1);
+
+	/* 4. Select the Sector to be erased */
+	FLASH->CR |= (uint32_t) ((Sector_Idx & 0x0000000F) << 3);
+
+	/* 5. Start the erase operation */
+	FLASH_START_OPERATION();
+
+	/* 6. Wait for the Flash to complete the operation */
+	FLASH_WAIT_FOR_COMPLETION();
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+
+	/* 7. Lock the Control register */
+	retVal |= Flash_Lock();
+
+	return retVal;
+}
+
+static Std_ReturnType_t Flash_Mass_Erase_Operation(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. Wait for the Flash Memory to be free */
+	FLASH_WAIT_FOR_COMPLETION();
+
+	/* 2. Unlock the Control register */
+	retVal |= Flash_Unlock();
+
+	/* 3. Set the MER bit */
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+	FLASH->CR |= (1UL << 2);
+
+	/* 4. Start the erase operation */
+	FLASH_START_OPERATION();
+
+	/* 5. Wait for the Flash to complete the operation */
+	FLASH_WAIT_FOR_COMPLETION();
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+
+	/* 6. Lock the Control register */
+	retVal |= Flash_Lock();
+
+	return retVal;
+}
+
+static Std_ReturnType_t Flash_Program_Operation(uint32_t address, uint32_t data)
+{
+	return Flash_Program_Buffer_Operation(address, &data, 1);
+}
+
+static Std_ReturnType_t Flash_Program_Buffer_Operation(uint32_t address, const uint32_t * data, const uint32_t words)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Word_Idx = 0;
+
+	/* 1. Wait for the Flash Memory to be free */
+	FLASH_WAIT_FOR_COMPLETION();
+
+	/* 2. Unlock the Control register */
+	retVal |= Flash_Unlock();
+	if(E_NOT_OK == retVal)
+		{ return E_NOT_OK; }
+
+	/* 3. Set the parallelism size */
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+	FLASH->CR |= (uint32_t)((FLASH_PARALLELISM_32 & 0x3UL) << FLASH_PSIIZE_POS);
+
+	/* 4. Set the PG bit */
+	FLASH->CR |= (1UL);
+
+	for(Word_Idx = 0; Word_Idx < words; Word_Idx++)
+	{
+		/* 5. Start writing the data */
+		*((volatile uint32_t *)(address + (Word_Idx * 4UL))) = data[Word_Idx];
+
+		/* 6. Wait for the Flash Memory to be free */
+		FLASH_WAIT_FOR_COMPLETION();
+
+		/* 7. Check for errors */
+		if(FLASH_FLAG_PGAERR || FLASH_FLAG_PGPERR || FLASH_FLAG_PGSERR)
+		{
+			retVal |= E_NOT_OK;
+			break;
+		}
+	}
+	FLASH->CR &= ~FLASH_CR_OPERATION_MASK;
+
+	/* 8. Lock the Control register */
+	retVal |= Flash_Lock();
+
+	return retVal;
+}
+
+#if FLASH_STATS_STATE == FLASH_STATS_ENABLED
+/* Accumulates one operation, returns (and clears) its error flags */
+static uint32_t Flash_Stats_Record(Flash_OpStats_Accumulator_t * Acc, const uint32_t Cycles)
+{
+	uint32_t Error_Flags = FLASH_GET_ERRORS();
+
+	Acc->Count++;
+	Acc->Total_Cycles += Cycles;
+	if(Cycles > Acc->Worst_Cycles)
+		{ Acc->Worst_Cycles = Cycles; }
+	if(Error_Flags)
+	{
+		Acc->Error_Count++;
+		Acc->Last_Error_Flags = Error_Flags;
+		/* Don't let a stale flag fail the next operation */
+		FLASH_CLEAR_ERRORS();
+	}
+	return Error_Flags;
+}
+
+static void Flash_Stats_Report(const Flash_OpStats_Accumulator_t * Acc, Flash_OpStats_t * Stats)
+{
+	Stats->Count = Acc->Count;
+	Stats->Worst_Cycles = Acc->Worst_Cycles;
+	Stats->Mean_Cycles = (Acc->Count) ? (uint32_t)(Acc->Total_Cycles / Acc->Count) : 0;
+	Stats->Error_Count = Acc->Error_Count;
+	Stats->Last_Error_Flags = Acc->Last_Error_Flags;
+}
+
+static void Flash_Stats_Journal_Append(const uint32_t Sector_Idx)
+{
+	const uint32_t Journal_End = Flash_Sectors_Address[Flash_Journal_Sector_Idx] + Flash_Sectors_Size[Flash_Journal_Sector_Idx];
+	const uint32_t Other_Idx = (FLASH_STATS_SECTOR_A == Flash_Journal_Sector_Idx) ? FLASH_STATS_SECTOR_B : FLASH_STATS_SECTOR_A;
+
+	Flash_Erase_Counters[Sector_Idx]++;
+
+	if(!Flash_Stats_Initialized)
+		{ return; }
+
+	/* The erased sector never holds the journal, Flash_Stats_Journal_Evacuate() moved it */
+	(void)Flash_Program_Operation(Flash_Journal_Next_Address, FLASH_STATS_ENTRY_TAG | Sector_Idx);
+	FLASH_CLEAR_ERRORS();
+	Flash_Journal_Next_Address += 4UL;
+
+	if(Flash_Journal_Next_Address >= (Journal_End - 4UL))
+	{
+		/* Full: the last word logs the erase of the other sector, so the
+		 * count survives a reset before the new copy is committed there */
+		(void)Flash_Program_Operation(Flash_Journal_Next_Address, FLASH_STATS_ENTRY_TAG | Other_Idx);
+		FLASH_CLEAR_ERRORS();
+		(void)Flash_Stats_Journal_Commit(Other_Idx, 1);
+	}
+}
+
+/* Folds the journal into the other sector when Sector_Idx, about to be erased, holds it.
+ * Every count is in the other sector before the erase starts, a reset during
+ * or after it only loses the count of that erase. */
+static Std_ReturnType_t Flash_Stats_Journal_Evacuate(const uint32_t Sector_Idx)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(Flash_Stats_Initialized && (Flash_Journal_Sector_Idx == Sector_Idx))
+	{
+		retVal |= Flash_Stats_Journal_Commit((FLASH_STATS_SECTOR_A == Sector_Idx) ? FLASH_STATS_SECTOR_B : FLASH_STATS_SECTOR_A, 1);
+	}
+	return retVal;
+}
+
+/* Writes the RAM counters as a new journal header in Journal_Idx, which becomes the current journal.
+ * The magic word goes last: until then the previous copy stays the valid one. */
+static Std_ReturnType_t Flash_Stats_Journal_Commit(const uint32_t Journal_Idx, const uint8_t Erase_Needed)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const uint32_t Journal_Start = Flash_Sectors_Address[Journal_Idx];
+	uint32_t Sector_Idx = 0;
+
+	if(Erase_Needed)
+	{
+		retVal |= Flash_Sector_Erase_Operation(Journal_Idx);
+		Flash_Erase_Counters[Journal_Idx]++;
+	}
+
+	Flash_Journal_Sequence++;
+	retVal |= Flash_Program_Operation(Journal_Start + 4UL, Flash_Journal_Sequence);
+	for(Sector_Idx = 0; Sector_Idx < FLASH_SECTORS_NUMBER; Sector_Idx++)
+		{ retVal |= Flash_Program_Operation(Journal_Start + ((2UL + Sector_Idx) * 4UL), Flash_Erase_Counters[Sector_Idx]); }
+	retVal |= Flash_Program_Operation(Journal_Start, FLASH_STATS_MAGIC);
+
+	FLASH_CLEAR_ERRORS();
+	Flash_Journal_Sector_Idx = Journal_Idx;
+	Flash_Journal_Next_Address = Journal_Start + (FLASH_STATS_HEADER_WORDS * 4UL);
+	return retVal;
+}
+
+static uint32_t Flash_Stats_Journal_Is_Valid(const uint32_t Journal_Idx)
+{
+	return (FLASH_STATS_MAGIC == *((volatile uint32_t *)(Flash_Sectors_Address[Journal_Idx]))) ? 1UL : 0UL;
+}
+#endif
 static Std_ReturnType_t Flash_Unlock()
 {
 	if(!READ_BIT(FLASH->CR, 31))
@@ -0,0 +1,352 @@
+/**
+ ******************************************************************************
+ * @file           : gpio.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : GPIO Device-Driver Static Code Implementation
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "MCAL/GPIO/gpio.h"
+#include "MCAL/RCC/rcc.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/Core/Core.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define GPIO_MAX_ALTERNATE					15U
+#define GPIO_EXTI_LINES_9_5					(0x000003E0UL)
+#define GPIO_EXTI_LINES_15_10				(0x0000FC00UL)
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+#define GPIO_IS_PORT(PORT)					(((PORT) <= GPIO_PORTE) || (GPIO_PORTH == (PORT)))
+#define GPIO_PORT_CLOCK(PORT)				((GPIO_PORTH == (PORT)) ? RCC_PERIPH_GPIOH : (RCC_Periph_Clock_t)(RCC_PERIPH_GPIOA + (PORT)))
+
+/*---------------  Section: Static Global Variables --------------- */
+/* !< Configured pins of each port, the port clock is held while any is set */
+static uint16_t GPIO_Configured_Pins[GPIO_PORTS_NUMBER];
+/* !< EXTI lines in use and their handlers, SYSCFG is clocked while any is used */
+static uint16_t GPIO_EXTI_Lines = 0;
+static Interrupt_Handler_t GPIO_EXTI_Handlers[GPIO_PINS_PER_PORT];
+
+/*---------------  Section: Helper Function Declarations --------------- */
+static Std_ReturnType_t GPIO_Check_Pin_Config(const GPIO_Pin_Config_t * Pin_Cfg);
+static IRQn_t GPIO_EXTI_IRQn(uint32_t Pin);
+static uint32_t GPIO_EXTI_IRQ_Lines(uint32_t Pin);
+static inline __attribute__((always_inline)) void GPIO_EXTI_Dispatch(uint32_t Lines);
+
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Configures one pin, turning its port clock on with the first pin.
+ * @param  Pin_Cfg: The pin configuration.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or invalid configuration
+ */
+Std_ReturnType_t GPIO_Pin_Init(const GPIO_Pin_Config_t * Pin_Cfg)
+{
+	return GPIO_Init_Table(Pin_Cfg, 1);
+}
+/**
+ * @brief  Configures a table of pins. The whole table is checked first, then each port
+ * 		   register is written once for all its pins, with the interrupts masked.
+ * @param  Table: The pin configurations, in any order. A pin given twice takes its last entry.
+ * @param  Count: Number of entries.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or an invalid entry (nothing is written)
+ */
+Std_ReturnType_t GPIO_Init_Table(const GPIO_Pin_Config_t * Table, uint32_t Count)
+{
+	Std_ReturnType_t retVal = E_OK;
+	GPIO_Registers_t * Regs = NULL;
+	uint32_t Entry_Idx = 0;
+	uint32_t Port = 0;
+	uint32_t Pins = 0;
+	uint32_t Field2_Mask = 0, Mode = 0, Speed = 0, Pull = 0, Open_Drain = 0;
+	uint32_t Af_Mask[2], Af_Value[2];
+	uint32_t Shift = 0;
+	uint32_t Irq_State = 0;
+
+	if(NULL == Table)
+		{ retVal = E_NOT_OK; }
+
+	/* 1. Check everything before writing anything */
+	for(Entry_Idx = 0; (E_OK == retVal) && (Entry_Idx < Count); Entry_Idx++)
+		{ retVal = GPIO_Check_Pin_Config(&Table[Entry_Idx]); }
+
+	/* 2. One pass per port, merging its pins into one write per register */
+	for(Port = 0; (E_OK == retVal) && (Port < GPIO_PORTS_NUMBER); Port++)
+	{
+		Pins = 0; Field2_Mask = 0; Mode = 0; Speed = 0; Pull = 0; Open_Drain = 0;
+		Af_Mask[0] = 0; Af_Mask[1] = 0; Af_Value[0] = 0; Af_Value[1] = 0;
+
+		for(Entry_Idx = 0; Entry_Idx < Count; Entry_Idx++)
+		{
+			if(Port == (uint32_t)Table[Entry_Idx].Port)
+			{
+				/* A pin given twice takes its last entry */
+				Shift = 2UL * Table[Entry_Idx].Pin;
+				Pins |= GPIO_PIN_MASK(Table[Entry_Idx].Pin);
+				Field2_Mask |= (3UL << Shift);
+				Mode = (Mode & ~(3UL << Shift)) | ((uint32_t)Table[Entry_Idx].Mode << Shift);
+				Speed = (Speed & ~(3UL << Shift)) | ((uint32_t)Table[Entry_Idx].Speed << Shift);
+				Pull = (Pull & ~(3UL << Shift)) | ((uint32_t)Table[Entry_Idx].Pull << Shift);
+				Open_Drain &= ~GPIO_PIN_MASK(Table[Entry_Idx].Pin);
+				if(GPIO_OUTPUT_OPEN_DRAIN == Table[Entry_Idx].Output_Type)
+					{ Open_Drain |= GPIO_PIN_MASK(Table[Entry_Idx].Pin); }
+				if(GPIO_MODE_ALTERNATE == Table[Entry_Idx].Mode)
+				{
+					Shift = 4UL * (Table[Entry_Idx].Pin & 7U);
+					Af_Mask[Table[Entry_Idx].Pin >> 3] |= (0xFUL << Shift);
+					Af_Value[Table[Entry_Idx].Pin >> 3] = (Af_Value[Table[Entry_Idx].Pin >> 3] & ~(0xFUL << Shift)) |
+														   ((uint32_t)Table[Entry_Idx].Alternate << Shift);
+				}
+			}
+		}
+
+		if(0 != Pins)
+		{
+			Regs = GPIO_PORT_REGS(Port);
+			Irq_State = Core_Enter_Critical();
+			/* 3. Clock the port with its first pin */
+			if(0 == GPIO_Configured_Pins[Port])
+				{ retVal |= RCC_Periph_Clock_Acquire(GPIO_PORT_CLOCK(Port)); }
+			GPIO_Configured_Pins[Port] |= (uint16_t)Pins;
+			/* 4. Alternate function, type, speed and pull before the mode, so the pin never drives a wrong state */
+			Regs->AFR[0] = (Regs->AFR[0] & ~Af_Mask[0]) | Af_Value[0];
+			Regs->AFR[1] = (Regs->AFR[1] & ~Af_Mask[1]) | Af_Value[1];
+			Regs->OTYPER = (Regs->OTYPER & ~Pins) | Open_Drain;
+			Regs->OSPEEDR = (Regs->OSPEEDR & ~Field2_Mask) | Speed;
+			Regs->PUPDR = (Regs->PUPDR & ~Field2_Mask) | Pull;
+			Regs->MODER = (Regs->MODER & ~Field2_Mask) | Mode;
+			Core_Exit_Critical(Irq_State);
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Returns a pin to analog mode (lowest consumption), the port clock
+ * 		   turns off with its last configured pin.
+ * @param  Port: The port.
+ * @param  Pin: The pin, 0 .. 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid port or pin
+ */
+Std_ReturnType_t GPIO_Pin_DeInit(GPIO_Port_t Port, uint32_t Pin)
+{
+	Std_ReturnType_t retVal = E_OK;
+	GPIO_Registers_t * Regs = NULL;
+	uint32_t Irq_State = 0;
+
+	if((!GPIO_IS_PORT(Port)) || (Pin >= GPIO_PINS_PER_PORT))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Regs = GPIO_PORT_REGS(Port);
+		Irq_State = Core_Enter_Critical();
+		if(GPIO_Configured_Pins[Port] & GPIO_PIN_MASK(Pin))
+		{
+			/* 1. Analog mode with no pull, the input Schmitt trigger is off */
+			Regs->MODER |= (3UL << (2UL * Pin));
+			Regs->PUPDR &= ~(3UL << (2UL * Pin));
+			/* 2. Release the port clock with the last pin */
+			GPIO_Configured_Pins[Port] &= (uint16_t)~GPIO_PIN_MASK(Pin);
+			if(0 == GPIO_Configured_Pins[Port])
+				{ retVal |= RCC_Periph_Clock_Release(GPIO_PORT_CLOCK(Port)); }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Routes a pin to its EXTI line and calls a handler on the selected edges.
+ * 		   A line serves one port at a time.
+ * @param  Port: The port.
+ * @param  Pin: The pin, 0 .. 15, also the EXTI line.
+ * @param  Edge: The trigger edges.
+ * @param  Handler: Called from the EXTI interrupt, the pending bit already cleared.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, or the line is in use
+ */
+Std_ReturnType_t GPIO_EXTI_Init(GPIO_Port_t Port, uint32_t Pin, GPIO_EXTI_Edge_t Edge, Interrupt_Handler_t Handler)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Shift = 0;
+	uint32_t Irq_State = 0;
+
+	if((!GPIO_IS_PORT(Port)) || (Pin >= GPIO_PINS_PER_PORT) || (NULL == Handler) ||
+	   (Edge < GPIO_EXTI_RISING) || (Edge > GPIO_EXTI_BOTH))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		if(GPIO_EXTI_Lines & GPIO_PIN_MASK(Pin))
+			{ retVal = E_NOT_OK; }
+		else
+		{
+			/* 1. SYSCFG holds the line to port routing */
+			if(0 == GPIO_EXTI_Lines)
+				{ retVal |= RCC_Periph_Clock_Acquire(RCC_PERIPH_SYSCFG); }
+			GPIO_EXTI_Lines |= (uint16_t)GPIO_PIN_MASK(Pin);
+			Shift = 4UL * (Pin & 3UL);
+			SYSCFG->EXTICR[Pin >> 2] = (SYSCFG->EXTICR[Pin >> 2] & ~(0xFUL << Shift)) | ((uint32_t)Port << Shift);
+			/* 2. Edges */
+			if((uint32_t)Edge & (uint32_t)GPIO_EXTI_RISING)
+				{ SET_BIT(EXTI->RTSR, Pin); }
+			else
+				{ CLEAR_BIT(EXTI->RTSR, Pin); }
+			if((uint32_t)Edge & (uint32_t)GPIO_EXTI_FALLING)
+				{ SET_BIT(EXTI->FTSR, Pin); }
+			else
+				{ CLEAR_BIT(EXTI->FTSR, Pin); }
+			/* 3. Handler, then unmask without a stale pending edge */
+			GPIO_EXTI_Handlers[Pin] = Handler;
+			EXTI->PR = GPIO_PIN_MASK(Pin);
+			SET_BIT(EXTI->IMR, Pin);
+			NVIC_EnableIRQ(GPIO_EXTI_IRQn(Pin));
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Frees an EXTI line, its NVIC interrupt is disabled once no line of it is in use.
+ * @param  Pin: The EXTI line, 0 .. 15.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or unused line
+ */
+Std_ReturnType_t GPIO_EXTI_DeInit(uint32_t Pin)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if(Pin >= GPIO_PINS_PER_PORT)
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		if(0 == (GPIO_EXTI_Lines & GPIO_PIN_MASK(Pin)))
+			{ retVal = E_NOT_OK; }
+		else
+		{
+			/* 1. Mask and disarm the line */
+			CLEAR_BIT(EXTI->IMR, Pin);
+			CLEAR_BIT(EXTI->RTSR, Pin);
+			CLEAR_BIT(EXTI->FTSR, Pin);
+			EXTI->PR = GPIO_PIN_MASK(Pin);
+			GPIO_EXTI_Handlers[Pin] = NULL;
+			GPIO_EXTI_Lines &= (uint16_t)~GPIO_PIN_MASK(Pin);
+			/* 2. The shared vectors stay enabled while another of their lines is used */
+			if(0 == (GPIO_EXTI_Lines & GPIO_EXTI_IRQ_Lines(Pin)))
+				{ NVIC_DisableIRQ(GPIO_EXTI_IRQn(Pin)); }
+			if(0 == GPIO_EXTI_Lines)
+				{ retVal |= RCC_Periph_Clock_Release(RCC_PERIPH_SYSCFG); }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+
+/*---------------  Section: Helper Function Definitions --------------- */
+static Std_ReturnType_t GPIO_Check_Pin_Config(const GPIO_Pin_Config_t * Pin_Cfg)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((!GPIO_IS_PORT(Pin_Cfg->Port)) || (Pin_Cfg->Pin >= GPIO_PINS_PER_PORT) ||
+	   (Pin_Cfg->Mode > GPIO_MODE_ANALOG) || (Pin_Cfg->Output_Type > GPIO_OUTPUT_OPEN_DRAIN) ||
+	   (Pin_Cfg->Speed > GPIO_SPEED_VERY_HIGH) || (Pin_Cfg->Pull > GPIO_PULL_DOWN) ||
+	   (Pin_Cfg->Alternate > GPIO_MAX_ALTERNATE))
+		{ retVal = E_NOT_OK; }
+
+	return retVal;
+}
+
+static IRQn_t GPIO_EXTI_IRQn(uint32_t Pin)
+{
+	IRQn_t IRQn = EXTI15_10_IRQn;
+
+	if(Pin <= 4UL)
+		{ IRQn = (IRQn_t)(EXTI0_IRQn + (int32_t)Pin); }
+	else if(Pin <= 9UL)
+		{ IRQn = EXTI9_5_IRQn; }
+
+	return IRQn;
+}
+
+/* The lines sharing the vector of a line */
+static uint32_t GPIO_EXTI_IRQ_Lines(uint32_t Pin)
+{
+	uint32_t Lines = GPIO_EXTI_LINES_15_10;
+
+	if(Pin <= 4UL)
+		{ Lines = GPIO_PIN_MASK(Pin); }
+	else if(Pin <= 9UL)
+		{ Lines = GPIO_EXTI_LINES_9_5; }
+
+	return Lines;
+}
+
+/* Clears all the pending lines of a shared vector in one store, then calls them lowest line first */
+static inline void GPIO_EXTI_Dispatch(uint32_t Lines)
+{
+	uint32_t Pending = EXTI->PR & EXTI->IMR & Lines;
+	uint32_t Line = 0;
+
+	EXTI->PR = Pending;
+	while(0 != Pending)
+	{
+		Line = (uint32_t)__builtin_ctz(Pending);
+		Pending &= (Pending - 1UL);
+		if(NULL != GPIO_EXTI_Handlers[Line])
+			{ GPIO_EXTI_Handlers[Line](); }
+	}
+}
+
+/*---------------  Section: Interrupt Handlers --------------- */
+/* Single line vectors: nothing to search, clear and call */
+void EXTI0_IRQHandler(void)
+{
+	EXTI->PR = GPIO_PIN_MASK(0);
+	if(NULL != GPIO_EXTI_Handlers[0])
+		{ GPIO_EXTI_Handlers[0](); }
+}
+
+void EXTI1_IRQHandler(void)
+{
+	EXTI->PR = GPIO_PIN_MASK(1);
+	if(NULL != GPIO_EXTI_Handlers[1])
+		{ GPIO_EXTI_Handlers[1](); }
+}
+
+void EXTI2_IRQHandler(void)
+{
+	EXTI->PR = GPIO_PIN_MASK(2);
+	if(NULL != GPIO_EXTI_Handlers[2])
+		{ GPIO_EXTI_Handlers[2](); }
+}
+
+void EXTI3_IRQHandler(void)
+{
+	EXTI->PR = GPIO_PIN_MASK(3);
+	if(NULL != GPIO_EXTI_Handlers[3])
+		{ GPIO_EXTI_Handlers[3](); }
+}
+
+void EXTI4_IRQHandler(void)
+{
+	EXTI->PR = GPIO_PIN_MASK(4);
+	if(NULL != GPIO_EXTI_Handlers[4])
+		{ GPIO_EXTI_Handlers[4](); }
+}
+
+void EXTI9_5_IRQHandler(void)
+{
+	GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_9_5);
+}
+
+void EXTI15_10_IRQHandler(void)
+{
+	GPIO_EXTI_Dispatch(GPIO_EXTI_LINES_15_10);
+}
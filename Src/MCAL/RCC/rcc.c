@@ -8,36 +8,117 @@
 
 /* --------------- Section : Includes --------------- */
 #include "MCAL/RCC/rcc.h"
+#include "CortexM4/Core/Core.h"
+/* --------------- Section: Macro Declarations --------------- */
+/* !< Bus in the upper 3 bits, enable bit position in the lower 5 */
+#define RCC_PERIPH_MAP(BUS, POS)			((uint8_t)(((BUS) << 5) | (POS)))
+#define RCC_PERIPH_MAP_BUS(MAP)				((RCC_Bus_t)((MAP) >> 5))
+#define RCC_PERIPH_MAP_POS(MAP)				((uint32_t)((MAP) & 0x1FU))
+#define RCC_PERIPH_MAX_USERS				0xFFU
+/*---------------  Section: Global Variables --------------- */
+/* Reset state: HSI with no prescaler */
+RCC_Clock_Freqs_t RCC_Clock_Freqs_Cache =
+{
+	.SYSCLK = RCC_HSI_VALUE,
+	.HCLK = RCC_HSI_VALUE,
+	.PCLK1 = RCC_HSI_VALUE,
+	.PCLK2 = RCC_HSI_VALUE,
+	.APB1_Timer = RCC_HSI_VALUE,
+	.APB2_Timer = RCC_HSI_VALUE
+};
+/*---------------  Section: Static Global Variables --------------- */
+/* !< Indexed by RCC_Periph_Clock_t, bit positions from RM0368 6.3.9 .. 6.3.18 */
+static const uint8_t RCC_Periph_Clock_Map[RCC_PERIPH_COUNT] =
+{
+	[RCC_PERIPH_GPIOA] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 0),
+	[RCC_PERIPH_GPIOB] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 1),
+	[RCC_PERIPH_GPIOC] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 2),
+	[RCC_PERIPH_GPIOD] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 3),
+	[RCC_PERIPH_GPIOE] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 4),
+	[RCC_PERIPH_GPIOH] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 7),
+	[RCC_PERIPH_CRC] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 12),
+	[RCC_PERIPH_DMA1] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 21),
+	[RCC_PERIPH_DMA2] = RCC_PERIPH_MAP(RCC_BUS_AHB1, 22),
+	[RCC_PERIPH_OTGFS] = RCC_PERIPH_MAP(RCC_BUS_AHB2, 7),
+	[RCC_PERIPH_TIM2] = RCC_PERIPH_MAP(RCC_BUS_APB1, 0),
+	[RCC_PERIPH_TIM3] = RCC_PERIPH_MAP(RCC_BUS_APB1, 1),
+	[RCC_PERIPH_TIM4] = RCC_PERIPH_MAP(RCC_BUS_APB1, 2),
+	[RCC_PERIPH_TIM5] = RCC_PERIPH_MAP(RCC_BUS_APB1, 3),
+	[RCC_PERIPH_WWDG] = RCC_PERIPH_MAP(RCC_BUS_APB1, 11),
+	[RCC_PERIPH_SPI2] = RCC_PERIPH_MAP(RCC_BUS_APB1, 14),
+	[RCC_PERIPH_SPI3] = RCC_PERIPH_MAP(RCC_BUS_APB1, 15),
+	[RCC_PERIPH_USART2] = RCC_PERIPH_MAP(RCC_BUS_APB1, 17),
+	[RCC_PERIPH_I2C1] = RCC_PERIPH_MAP(RCC_BUS_APB1, 21),
+	[RCC_PERIPH_I2C2] = RCC_PERIPH_MAP(RCC_BUS_APB1, 22),
+	[RCC_PERIPH_I2C3] = RCC_PERIPH_MAP(RCC_BUS_APB1, 23),
+	[RCC_PERIPH_PWR] = RCC_PERIPH_MAP(RCC_BUS_APB1, 28),
+	[RCC_PERIPH_TIM1] = RCC_PERIPH_MAP(RCC_BUS_APB2, 0),
+	[RCC_PERIPH_USART1] = RCC_PERIPH_MAP(RCC_BUS_APB2, 4),
+	[RCC_PERIPH_USART6] = RCC_PERIPH_MAP(RCC_BUS_APB2, 5),
+	[RCC_PERIPH_ADC1] = RCC_PERIPH_MAP(RCC_BUS_APB2, 8),
+	[RCC_PERIPH_SDIO] = RCC_PERIPH_MAP(RCC_BUS_APB2, 11),
+	[RCC_PERIPH_SPI1] = RCC_PERIPH_MAP(RCC_BUS_APB2, 12),
+	[RCC_PERIPH_SPI4] = RCC_PERIPH_MAP(RCC_BUS_APB2, 13),
+	[RCC_PERIPH_SYSCFG] = RCC_PERIPH_MAP(RCC_BUS_APB2, 14),
+	[RCC_PERIPH_TIM9] = RCC_PERIPH_MAP(RCC_BUS_APB2, 16),
+	[RCC_PERIPH_TIM10] = RCC_PERIPH_MAP(RCC_BUS_APB2, 17),
+	[RCC_PERIPH_TIM11] = RCC_PERIPH_MAP(RCC_BUS_APB2, 18)
+};
+static uint8_t RCC_Periph_Clock_Users[RCC_PERIPH_COUNT];
 /*---------------  Section: Static Functions Decllaration --------------- */
 static inline __attribute__((always_inline)) void RCC_Osc_Config(const RCC_InitConfigs_t * rcc_cfgs);
-static inline __attribute__((always_inline)) void RCC_ClockSource_Config(const RCC_Clock_Source_t Clock_Source);
+static inline __attribute__((always_inline)) Std_ReturnType_t RCC_ClockSource_Config(const RCC_Clock_Source_t Clock_Source);
 static inline __attribute__((always_inline)) void RCC_Bus_Pre_Config(const RCC_InitConfigs_t * rcc_cfgs);
 static inline __attribute__((always_inline)) void RCC_PLL_Config(const RCC_InitConfigs_t * rcc_cfgs);
+static Std_ReturnType_t RCC_Wait_Field(volatile uint32_t * Reg, uint32_t Pos, uint32_t Mask, uint32_t State);
+static Std_ReturnType_t RCC_PLL_Keep_Best(uint32_t Input_Freq, uint32_t Target_SYSCLK, const RCC_PLL_Cfgs_t * Candidate,
+										  RCC_PLL_Cfgs_t * Best, uint32_t * Best_Error);
+static void RCC_Decode_Bus_Freqs(uint32_t SYSCLK_Freq, uint32_t HPRE, uint32_t PPRE1, uint32_t PPRE2, RCC_Clock_Freqs_t * Freqs);
+static volatile uint32_t * RCC_Bus_Enable_Reg(RCC_Bus_t Bus, uint32_t Sleep);
 /*---------------  Section: Function Definitions --------------- */
 Std_ReturnType_t RCC_Init(const RCC_InitConfigs_t * rcc_cfgs)
 {
 	Std_ReturnType_t Ret_Value = E_OK;
 	if(NULL == rcc_cfgs)
 		{ Ret_Value = E_NOT_OK; }
+	else if((RCC_CLOCK_SOURCE_PLL == rcc_cfgs->Clock_Source) &&
+			(E_OK != RCC_PLL_Check((RCC_PLL_SOURE_HSE == rcc_cfgs->PLL_Configurations.Pll_Clk_Src) ? RCC_HSE_VALUE : RCC_HSI_VALUE,
+								   &rcc_cfgs->PLL_Configurations, NULL)))
+		{ Ret_Value = E_NOT_OK; }
 	else
 	{
-		/* 1. Configure the Oscillator */
+		/* 1. Configure the Oscillator and wait for it to be stable */
 		RCC_Osc_Config(rcc_cfgs);
+		if(RCC_HSI_ON == rcc_cfgs->Oscillator_Configurations.HSI_State)
+			{ Ret_Value |= RCC_Wait_Field(&RCC->CR, RCC_CR_HSIRDY_POS, 1UL, 1UL); }
+		if(RCC_HSE_ON == rcc_cfgs->Oscillator_Configurations.HSE_State)
+			{ Ret_Value |= RCC_Wait_Field(&RCC->CR, RCC_CR_HSERDY_POS, 1UL, 1UL); }
 
-		/* 2. Configure the Clock Source */
-		if(rcc_cfgs->Clock_Source == RCC_CLOCK_SOURCE_PLL)
-			{ RCC_PLL_Config(rcc_cfgs); }
-		RCC_ClockSource_Config(rcc_cfgs->Clock_Source);
+		/* 2. Configure the PLL, it can not be changed while it clocks the system */
+		if((E_OK == Ret_Value) && (rcc_cfgs->Clock_Source == RCC_CLOCK_SOURCE_PLL))
+		{
+			Ret_Value |= RCC_PLL_Stop();
+			RCC_PLL_Config(rcc_cfgs);
+			Ret_Value |= RCC_Wait_Field(&RCC->CR, RCC_CR_PLLRDY_POS, 1UL, 1UL);
+		}
 
-		/* 3. Configure all the Prescalers */
+		/* 3. Configure all the Prescalers, before the new source so no bus runs above its limit */
 		RCC_Bus_Pre_Config(rcc_cfgs);
+
+		/* 4. Configure the Clock Source */
+		if(E_OK == Ret_Value)
+			{ Ret_Value = RCC_ClockSource_Config(rcc_cfgs->Clock_Source); }
+
+		/* 5. The drivers read the new frequencies from the cache */
+		RCC_Update_Clock_Freqs();
 	}
 	return Ret_Value;
 }
 
 void RCC_Switch_Systen_Clock(const RCC_Clock_Source_t Clock_Source)
 {
-	RCC_ClockSource_Config(Clock_Source);
+	(void)RCC_ClockSource_Config(Clock_Source);
+	RCC_Update_Clock_Freqs();
 }
 
 RCC_Clock_Source_t RCC_Get_Systen_Clock(void)
@@ -45,7 +126,381 @@ RCC_Clock_Source_t RCC_Get_Systen_Clock(void)
 	return (RCC->CFGR & (3UL << 2)) >> 2;
 }
 
+void RCC_Update_Clock_Freqs(void)
+{
+	uint32_t SYSCLK_Freq = RCC_HSI_VALUE;
+	uint32_t PLL_Input = 0;
+	uint32_t PLL_M = 0;
+	uint32_t PLL_N = 0;
+	uint32_t PLL_P = 0;
+	uint32_t CFGR_Value = RCC->CFGR;
+	uint32_t HPRE = (CFGR_Value >> RCC_HPRE_POS) & 0xFUL;
+	uint32_t PPRE1 = (CFGR_Value >> RCC_PPRE1_POS) & 0x7UL;
+	uint32_t PPRE2 = (CFGR_Value >> RCC_PPRE2_POS) & 0x7UL;
+
+	/* 1. SYSCLK from the switch status */
+	switch((CFGR_Value >> RCC_SWS_POS) & RCC_SW_MASK)
+	{
+		case RCC_HSE_SW_MASK:
+			SYSCLK_Freq = RCC_HSE_VALUE;
+			break;
+		case RCC_PLL_SW_MASK:
+			PLL_Input = (READ_BIT(RCC->PLLCFGR, 22)) ? RCC_HSE_VALUE : RCC_HSI_VALUE;
+			PLL_M = RCC->PLLCFGR & 0x3FUL;
+			PLL_N = (RCC->PLLCFGR >> 6) & 0x1FFUL;
+			PLL_P = (((RCC->PLLCFGR >> 16) & 0x3UL) * 2UL) + 2UL;
+			/* f = (f_in / M) * N / P, in 64 bits as f_in * N exceeds 32 bits */
+			SYSCLK_Freq = (PLL_M) ? (uint32_t)(((uint64_t)PLL_Input * PLL_N) / (PLL_M * PLL_P)) : 0;
+			break;
+		default:
+			break;
+	}
+
+	/* 2. Bus and timer clocks */
+	RCC_Decode_Bus_Freqs(SYSCLK_Freq, HPRE, PPRE1, PPRE2, &RCC_Clock_Freqs_Cache);
+}
+
+Std_ReturnType_t RCC_Compute_Clock_Freqs(const RCC_InitConfigs_t * rcc_cfgs, RCC_Clock_Freqs_t * Freqs)
+{
+	Std_ReturnType_t retVal = E_OK;
+	RCC_PLL_Freqs_t PLL_Freqs;
+	uint32_t SYSCLK_Freq = RCC_HSI_VALUE;
+
+	if((NULL == rcc_cfgs) || (NULL == Freqs))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		switch(rcc_cfgs->Clock_Source)
+		{
+			case RCC_CLOCK_SOURCE_HSE:
+				SYSCLK_Freq = RCC_HSE_VALUE;
+				break;
+			case RCC_CLOCK_SOURCE_PLL:
+				retVal = RCC_PLL_Check((RCC_PLL_SOURE_HSE == rcc_cfgs->PLL_Configurations.Pll_Clk_Src) ? RCC_HSE_VALUE : RCC_HSI_VALUE,
+									   &rcc_cfgs->PLL_Configurations, &PLL_Freqs);
+				SYSCLK_Freq = PLL_Freqs.SYSCLK;
+				break;
+			default:
+				break;
+		}
+		if(E_OK == retVal)
+		{
+			RCC_Decode_Bus_Freqs(SYSCLK_Freq, (uint32_t)rcc_cfgs->AHB_Prescaler, (uint32_t)rcc_cfgs->APB1_Prescaler,
+								 (uint32_t)rcc_cfgs->APB2_Prescaler, Freqs);
+			if((Freqs->PCLK1 > RCC_PCLK1_MAX) || (Freqs->PCLK2 > RCC_PCLK2_MAX))
+				{ retVal = E_NOT_OK; }
+		}
+	}
+	return retVal;
+}
+
+Std_ReturnType_t RCC_PLL_Stop(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. Move SYSCLK away from the PLL */
+	if(RCC_CLOCK_SOURCE_PLL == RCC_Get_Systen_Clock())
+	{
+		SET_BIT(RCC->CR, RCC_CR_HSION_POS);
+		retVal |= RCC_Wait_Field(&RCC->CR, RCC_CR_HSIRDY_POS, 1UL, 1UL);
+		if(E_OK == retVal)
+		{
+			retVal |= RCC_ClockSource_Config(RCC_CLOCK_SOURCE_HSI);
+			RCC_Update_Clock_Freqs();
+		}
+	}
+
+	/* 2. Stop it */
+	if(E_OK == retVal)
+	{
+		RCC_PLL_DISABLE();
+		retVal |= RCC_Wait_Field(&RCC->CR, RCC_CR_PLLRDY_POS, 1UL, 0UL);
+	}
+	return retVal;
+}
+
+Std_ReturnType_t RCC_Get_Clock_Freqs(RCC_Clock_Freqs_t * Freqs)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(NULL == Freqs)
+		{ retVal = E_NOT_OK; }
+	else
+		{ *Freqs = RCC_Clock_Freqs_Cache; }
+
+	return retVal;
+}
+
+/**
+ * @brief  Checks a PLL configuration against the clock tree limits
+ * 		   (M, N, P, Q ranges, VCO input 1..2 MHz, VCO output 192..432 MHz,
+ * 		   SYSCLK up to 84 MHz, PLL48CLK up to 48 MHz).
+ * @param  Input_Freq: The PLL source frequency in Hz.
+ * @param  Pll: The configuration, the source field is not used.
+ * @param  Freqs: Returns the resulting frequencies, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: The configuration is valid
+ *         - E_NOT_OK: Out of range or NULL configuration
+ */
+Std_ReturnType_t RCC_PLL_Check(uint32_t Input_Freq, const RCC_PLL_Cfgs_t * Pll, RCC_PLL_Freqs_t * Freqs)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t P_Div = 0;
+	uint64_t VCO_Output = 0;
+
+	if((NULL == Pll) || (Input_Freq < RCC_HSE_MIN) || (Input_Freq > RCC_HSE_MAX) ||
+	   (Pll->PLL_M < RCC_PLL_M_MIN) || (Pll->PLL_M > RCC_PLL_M_MAX) ||
+	   (Pll->PLL_N < RCC_PLL_N_MIN) || (Pll->PLL_N > RCC_PLL_N_MAX) ||
+	   (Pll->PLL_Q < RCC_PLL_Q_MIN) || (Pll->PLL_Q > RCC_PLL_Q_MAX) ||
+	   (Pll->PLL_P > RCC_PLL_P_DIVIDE_BY_8))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		P_Div = ((uint32_t)Pll->PLL_P * 2UL) + 2UL;
+		VCO_Output = RCC_PLL_VCO_OUT(Input_Freq, Pll->PLL_M, Pll->PLL_N);
+
+		/* Products instead of quotients, the limits are checked exactly */
+		if((Input_Freq < (RCC_PLL_VCO_IN_MIN * Pll->PLL_M)) || (Input_Freq > (RCC_PLL_VCO_IN_MAX * Pll->PLL_M)) ||
+		   (VCO_Output < RCC_PLL_VCO_OUT_MIN) || (VCO_Output > RCC_PLL_VCO_OUT_MAX) ||
+		   ((VCO_Output / P_Div) > RCC_SYSCLK_MAX) || ((VCO_Output / Pll->PLL_Q) > RCC_PLL48CLK_VALUE))
+		{
+			retVal = E_NOT_OK;
+		}
+		if(NULL != Freqs)
+		{
+			Freqs->VCO_Input = Input_Freq / Pll->PLL_M;
+			Freqs->VCO_Output = (uint32_t)VCO_Output;
+			Freqs->SYSCLK = (uint32_t)RCC_PLL_SYSCLK(Input_Freq, Pll->PLL_M, Pll->PLL_N, P_Div);
+			Freqs->PLL48CLK = (uint32_t)RCC_PLL_48CLK(Input_Freq, Pll->PLL_M, Pll->PLL_N, Pll->PLL_Q);
+		}
+	}
+	return retVal;
+}
+
+/**
+ * @brief  Picks the M, N, P and Q giving the SYSCLK closest to a target.
+ * 		   On a tie the highest VCO input (lowest jitter) is kept.
+ * @param  Input_Freq: The PLL source frequency in Hz (HSI, or a 4..26 MHz HSE).
+ * @param  Target_SYSCLK: The wanted SYSCLK in Hz, up to 84 MHz.
+ * @param  Require_48MHz: Non zero to accept only an exact 48 MHz PLL48CLK (USB).
+ * @param  Pll: Returns M, N, P and Q, the source field is left untouched.
+ * @param  Freqs: Returns the achieved frequencies, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Parameters out of range or no configuration found
+ */
+Std_ReturnType_t RCC_PLL_Solve(uint32_t Input_Freq, uint32_t Target_SYSCLK, uint32_t Require_48MHz,
+							   RCC_PLL_Cfgs_t * Pll, RCC_PLL_Freqs_t * Freqs)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	RCC_PLL_Cfgs_t Candidate = { 0 };
+	uint32_t Best_Error = 0xFFFFFFFFUL;
+	uint32_t P_Div = 0;
+	uint32_t N_Near = 0;
+	uint32_t N_Low = 0;
+	uint32_t N_High = 0;
+
+	/* Out of range inputs end the search at once */
+	if((NULL == Pll) || (Input_Freq < RCC_HSE_MIN) || (Input_Freq > RCC_HSE_MAX) ||
+	   (Target_SYSCLK > RCC_SYSCLK_MAX) || (Target_SYSCLK < (RCC_PLL_VCO_OUT_MIN / 8UL)))
+		{ Best_Error = 0; }
+
+	/* 1. Smallest M first, the highest VCO input has the lowest jitter */
+	for(Candidate.PLL_M = RCC_PLL_M_MIN; (Candidate.PLL_M <= RCC_PLL_M_MAX) && (0 != Best_Error); Candidate.PLL_M++)
+	{
+		if((Input_Freq > (RCC_PLL_VCO_IN_MAX * Candidate.PLL_M)) || (Input_Freq < (RCC_PLL_VCO_IN_MIN * Candidate.PLL_M)))
+			{ continue; }
+
+		for(P_Div = 2UL; (P_Div <= 8UL) && (0 != Best_Error); P_Div += 2UL)
+		{
+			Candidate.PLL_P = (RCC_PLL_P_t)((P_Div - 2UL) / 2UL);
+			if(Require_48MHz)
+			{
+				/* 2. An exact 48 MHz fixes the VCO output to 48 MHz * Q, and N with it */
+				for(Candidate.PLL_Q = RCC_PLL_Q_MIN; Candidate.PLL_Q <= RCC_PLL_Q_MAX; Candidate.PLL_Q++)
+				{
+					if(0 != (((uint64_t)RCC_PLL48CLK_VALUE * Candidate.PLL_M * Candidate.PLL_Q) % Input_Freq))
+						{ continue; }
+					Candidate.PLL_N = (uint32_t)(((uint64_t)RCC_PLL48CLK_VALUE * Candidate.PLL_M * Candidate.PLL_Q) / Input_Freq);
+					if(E_OK == RCC_PLL_Keep_Best(Input_Freq, Target_SYSCLK, &Candidate, Pll, &Best_Error))
+						{ retVal = E_OK; }
+				}
+			}
+			else
+			{
+				/* 2. Nearest N for the target: N = Target * M * P / f_in, rounded, then clamped
+				 *    into the N giving a VCO output of 192..432 MHz and a SYSCLK up to 84 MHz */
+				N_Near = (uint32_t)((((uint64_t)Target_SYSCLK * Candidate.PLL_M * P_Div) + (Input_Freq / 2UL)) / Input_Freq);
+				N_Low = (uint32_t)((((uint64_t)RCC_PLL_VCO_OUT_MIN * Candidate.PLL_M) + Input_Freq - 1UL) / Input_Freq);
+				N_High = (uint32_t)(((((uint64_t)RCC_PLL_VCO_OUT_MAX + 1UL) * Candidate.PLL_M) - 1UL) / Input_Freq);
+				if(N_High > (uint32_t)(((((uint64_t)RCC_SYSCLK_MAX + 1UL) * Candidate.PLL_M * P_Div) - 1UL) / Input_Freq))
+					{ N_High = (uint32_t)(((((uint64_t)RCC_SYSCLK_MAX + 1UL) * Candidate.PLL_M * P_Div) - 1UL) / Input_Freq); }
+				if(N_Near > N_High)
+					{ N_Near = N_High; }
+				if(N_Near < N_Low)
+					{ N_Near = N_Low; }
+
+				/* 3. The SYSCLK is truncated, the closest one is within one step of the rounded N.
+				 *    Q is the smallest keeping 48 MHz at most */
+				for(Candidate.PLL_N = N_Near - 1UL; Candidate.PLL_N <= (N_Near + 1UL); Candidate.PLL_N++)
+				{
+					Candidate.PLL_Q = (uint32_t)((RCC_PLL_VCO_OUT(Input_Freq, Candidate.PLL_M, Candidate.PLL_N) +
+												  RCC_PLL48CLK_VALUE - 1UL) / RCC_PLL48CLK_VALUE);
+					if(Candidate.PLL_Q < RCC_PLL_Q_MIN)
+						{ Candidate.PLL_Q = RCC_PLL_Q_MIN; }
+					if(E_OK == RCC_PLL_Keep_Best(Input_Freq, Target_SYSCLK, &Candidate, Pll, &Best_Error))
+						{ retVal = E_OK; }
+				}
+			}
+		}
+	}
+
+	if(E_OK == retVal)
+		{ (void)RCC_PLL_Check(Input_Freq, Pll, Freqs); }
+
+	return retVal;
+}
+
+/**
+ * @brief  Takes a reference on a peripheral clock, the first one turns the clock on.
+ * 		   Every driver acquires the clocks it uses in its init and releases them in its de-init.
+ * @param  Clock: The peripheral clock.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or reference counter full
+ */
+Std_ReturnType_t RCC_Periph_Clock_Acquire(RCC_Periph_Clock_t Clock)
+{
+	Std_ReturnType_t retVal = E_OK;
+	volatile uint32_t * Enable_Reg = NULL;
+	uint32_t Irq_State = 0;
+
+	if(Clock >= RCC_PERIPH_COUNT)
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Enable_Reg = RCC_Bus_Enable_Reg(RCC_PERIPH_MAP_BUS(RCC_Periph_Clock_Map[Clock]), 0);
+		Irq_State = Core_Enter_Critical();
+		if(RCC_PERIPH_MAX_USERS == RCC_Periph_Clock_Users[Clock])
+			{ retVal = E_NOT_OK; }
+		else if(0 == RCC_Periph_Clock_Users[Clock]++)
+		{
+			SET_BIT(*Enable_Reg, RCC_PERIPH_MAP_POS(RCC_Periph_Clock_Map[Clock]));
+			/* The peripheral is usable 2 bus cycles after the enable, the read back covers it */
+			(void)*Enable_Reg;
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Drops a reference on a peripheral clock, the last one turns the clock off.
+ * @param  Clock: The peripheral clock.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or no reference held
+ */
+Std_ReturnType_t RCC_Periph_Clock_Release(RCC_Periph_Clock_t Clock)
+{
+	Std_ReturnType_t retVal = E_OK;
+	volatile uint32_t * Enable_Reg = NULL;
+	uint32_t Irq_State = 0;
+
+	if(Clock >= RCC_PERIPH_COUNT)
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Enable_Reg = RCC_Bus_Enable_Reg(RCC_PERIPH_MAP_BUS(RCC_Periph_Clock_Map[Clock]), 0);
+		Irq_State = Core_Enter_Critical();
+		if(0 == RCC_Periph_Clock_Users[Clock])
+			{ retVal = E_NOT_OK; }
+		else if(0 == --RCC_Periph_Clock_Users[Clock])
+			{ CLEAR_BIT(*Enable_Reg, RCC_PERIPH_MAP_POS(RCC_Periph_Clock_Map[Clock])); }
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Chooses whether an enabled peripheral clock keeps running in Sleep mode
+ * 		   (*LPENR bit, all of them are on out of reset).
+ * @param  Clock: The peripheral clock.
+ * @param  State: @ref RCC_Periph_Sleep_Config
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid clock or state
+ */
+Std_ReturnType_t RCC_Periph_Clock_Sleep_Config(RCC_Periph_Clock_t Clock, uint32_t State)
+{
+	Std_ReturnType_t retVal = E_OK;
+	volatile uint32_t * Sleep_Reg = NULL;
+	uint32_t Irq_State = 0;
+
+	if((Clock >= RCC_PERIPH_COUNT) || (State > RCC_PERIPH_SLEEP_CLOCK_ON))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Sleep_Reg = RCC_Bus_Enable_Reg(RCC_PERIPH_MAP_BUS(RCC_Periph_Clock_Map[Clock]), 1);
+		Irq_State = Core_Enter_Critical();
+		if(RCC_PERIPH_SLEEP_CLOCK_ON == State)
+			{ SET_BIT(*Sleep_Reg, RCC_PERIPH_MAP_POS(RCC_Periph_Clock_Map[Clock])); }
+		else
+			{ CLEAR_BIT(*Sleep_Reg, RCC_PERIPH_MAP_POS(RCC_Periph_Clock_Map[Clock])); }
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Returns the number of references held on a peripheral clock, 0 for an invalid clock.
+ */
+uint8_t RCC_Periph_Clock_Get_Users(RCC_Periph_Clock_t Clock)
+{
+	return (Clock < RCC_PERIPH_COUNT) ? RCC_Periph_Clock_Users[Clock] : 0;
+}
+/**
+ * @brief  Returns 1 if a peripheral clock is on, whoever turned it on, 0 otherwise.
+ */
+uint32_t RCC_Periph_Clock_Is_Enabled(RCC_Periph_Clock_t Clock)
+{
+	uint32_t Enabled = 0;
+
+	if(Clock < RCC_PERIPH_COUNT)
+	{
+		Enabled = READ_BIT(*RCC_Bus_Enable_Reg(RCC_PERIPH_MAP_BUS(RCC_Periph_Clock_Map[Clock]), 0),
+						   RCC_PERIPH_MAP_POS(RCC_Periph_Clock_Map[Clock]));
+	}
+	return Enabled;
+}
+/**
+ * @brief  Returns the enable register of a bus, one bit per enabled clock (0 for an invalid bus).
+ * @param  Bus: The bus.
+ * @param  Sleep: 0 for the run mode *ENR register, 1 for the Sleep mode *LPENR one.
+ */
+uint32_t RCC_Get_Enabled_Clocks(RCC_Bus_t Bus, uint32_t Sleep)
+{
+	volatile uint32_t * Reg = RCC_Bus_Enable_Reg(Bus, Sleep);
+
+	return (NULL == Reg) ? 0UL : *Reg;
+}
+
 /*---------------  Section: Static Functions Definitions --------------- */
+static volatile uint32_t * RCC_Bus_Enable_Reg(RCC_Bus_t Bus, uint32_t Sleep)
+{
+	volatile uint32_t * Reg = NULL;
+
+	switch(Bus)
+	{
+		case RCC_BUS_AHB1: Reg = (0 != Sleep) ? &RCC->AHB1LPENR : &RCC->AHB1ENR; break;
+		case RCC_BUS_AHB2: Reg = (0 != Sleep) ? &RCC->AHB2LPENR : &RCC->AHB2ENR; break;
+		case RCC_BUS_APB1: Reg = (0 != Sleep) ? &RCC->APB1LPENR : &RCC->APB1ENR; break;
+		case RCC_BUS_APB2: Reg = (0 != Sleep) ? &RCC->APB2LPENR : &RCC->APB2ENR; break;
+		default: break;
+	}
+	return Reg;
+}
 static inline void RCC_Osc_Config(const RCC_InitConfigs_t * rcc_cfgs)
 {
 	if(RCC_HSE_ON == rcc_cfgs->Oscillator_Configurations.HSE_State)
@@ -64,33 +519,37 @@ static inline void RCC_Osc_Config(const RCC_InitConfigs_t * rcc_cfgs)
 		{ CLEAR_BIT(RCC->CR, 26); }
 }
 
-static inline void RCC_ClockSource_Config(const RCC_Clock_Source_t Clock_Source)
+static inline Std_ReturnType_t RCC_ClockSource_Config(const RCC_Clock_Source_t Clock_Source)
 {
-	RCC->CFGR &= ~((uint32_t)(RCC_SW_MASK << RCC_SW_POS));
+	uint32_t Switch_Mask = RCC_HSI_SW_MASK;
+
 	switch(Clock_Source)
 	{
-		case RCC_CLOCK_SOURCE_HSI:
-			RCC->CFGR |= (RCC_HSI_SW_MASK << RCC_SW_POS);
-			break;
 		case RCC_CLOCK_SOURCE_HSE:
-			RCC->CFGR |= (RCC_HSE_SW_MASK << RCC_SW_POS);
+			Switch_Mask = RCC_HSE_SW_MASK;
 			break;
 		case RCC_CLOCK_SOURCE_PLL:
-			RCC->CFGR |= (RCC_PLL_SW_MASK << RCC_SW_POS);
+			Switch_Mask = RCC_PLL_SW_MASK;
+			break;
+		case RCC_CLOCK_SOURCE_HSI:
+		default:
+			Switch_Mask = RCC_HSI_SW_MASK;
 			break;
-		default: RCC->CFGR |= (RCC_HSI_SW_MASK << RCC_SW_POS);
-				break;
 	}
+	RCC->CFGR = (RCC->CFGR & ~((uint32_t)(RCC_SW_MASK << RCC_SW_POS))) | (Switch_Mask << RCC_SW_POS);
+
+	/* The switch is done once the status reports the new source */
+	return RCC_Wait_Field(&RCC->CFGR, RCC_SWS_POS, RCC_SW_MASK, Switch_Mask);
 }
 
 static inline void RCC_Bus_Pre_Config(const RCC_InitConfigs_t * rcc_cfgs)
 {
 	// 1. AHB Prescaler:
-	RCC->CFGR |= (rcc_cfgs->AHB_Prescaler << RCC_HPRE_POS);
+	RCC->CFGR = (RCC->CFGR & ~(0xFUL << RCC_HPRE_POS)) | ((uint32_t)rcc_cfgs->AHB_Prescaler << RCC_HPRE_POS);
 	// 2. APB1 Prescaler:
-	RCC->CFGR |= (rcc_cfgs->APB1_Prescaler << RCC_PPRE1_POS);
+	RCC->CFGR = (RCC->CFGR & ~(0x7UL << RCC_PPRE1_POS)) | ((uint32_t)rcc_cfgs->APB1_Prescaler << RCC_PPRE1_POS);
 	// 3. APB2 Prescaler:
-	RCC->CFGR |= (rcc_cfgs->APB2_Prescaler << RCC_PPRE2_POS);
+	RCC->CFGR = (RCC->CFGR & ~(0x7UL << RCC_PPRE2_POS)) | ((uint32_t)rcc_cfgs->APB2_Prescaler << RCC_PPRE2_POS);
 }
 
 static inline void RCC_PLL_Config(const RCC_InitConfigs_t * rcc_cfgs)
@@ -120,6 +579,58 @@ static inline void RCC_PLL_Config(const RCC_InitConfigs_t * rcc_cfgs)
 	RCC_PLL_ENABLE();
 }
 
+/* Polls a register field until it holds State, gives up after RCC_READY_TIMEOUT reads */
+static Std_ReturnType_t RCC_Wait_Field(volatile uint32_t * Reg, uint32_t Pos, uint32_t Mask, uint32_t State)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	uint32_t Polls = 0;
+
+	for(Polls = 0; (Polls < RCC_READY_TIMEOUT) && (E_NOT_OK == retVal); Polls++)
+	{
+		if(((*Reg >> Pos) & Mask) == State)
+			{ retVal = E_OK; }
+	}
+	return retVal;
+}
+
+/* Keeps Candidate in Best if it is valid and strictly closer to the target, the first found wins a tie */
+static Std_ReturnType_t RCC_PLL_Keep_Best(uint32_t Input_Freq, uint32_t Target_SYSCLK, const RCC_PLL_Cfgs_t * Candidate,
+										  RCC_PLL_Cfgs_t * Best, uint32_t * Best_Error)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	RCC_PLL_Freqs_t Candidate_Freqs;
+	uint32_t Error = 0;
+
+	if(E_OK == RCC_PLL_Check(Input_Freq, Candidate, &Candidate_Freqs))
+	{
+		Error = (Candidate_Freqs.SYSCLK > Target_SYSCLK) ? (Candidate_Freqs.SYSCLK - Target_SYSCLK) :
+														  (Target_SYSCLK - Candidate_Freqs.SYSCLK);
+		if(Error < *Best_Error)
+		{
+			*Best_Error = Error;
+			Best->PLL_M = Candidate->PLL_M;
+			Best->PLL_N = Candidate->PLL_N;
+			Best->PLL_P = Candidate->PLL_P;
+			Best->PLL_Q = Candidate->PLL_Q;
+			retVal = E_OK;
+		}
+	}
+	return retVal;
+}
+
+static void RCC_Decode_Bus_Freqs(uint32_t SYSCLK_Freq, uint32_t HPRE, uint32_t PPRE1, uint32_t PPRE2, RCC_Clock_Freqs_t * Freqs)
+{
+	/* HPRE 0xxx: not divided, 1000..1111: /2, /4, /8, /16, /64, /128, /256, /512 */
+	static const uint8_t AHB_Shift[8] = { 1, 2, 3, 4, 6, 7, 8, 9 };
 
+	Freqs->SYSCLK = SYSCLK_Freq;
+	Freqs->HCLK = (HPRE & 0x8UL) ? (SYSCLK_Freq >> AHB_Shift[HPRE & 0x7UL]) : SYSCLK_Freq;
 
+	/* PPRE 0xx: not divided, 100..111: /2, /4, /8, /16 */
+	Freqs->PCLK1 = (PPRE1 & 0x4UL) ? (Freqs->HCLK >> ((PPRE1 & 0x3UL) + 1UL)) : Freqs->HCLK;
+	Freqs->PCLK2 = (PPRE2 & 0x4UL) ? (Freqs->HCLK >> ((PPRE2 & 0x3UL) + 1UL)) : Freqs->HCLK;
 
+	/* The timers run at twice a divided APB clock */
+	Freqs->APB1_Timer = (PPRE1 & 0x4UL) ? (Freqs->PCLK1 * 2UL) : Freqs->PCLK1;
+	Freqs->APB2_Timer = (PPRE2 & 0x4UL) ? (Freqs->PCLK2 * 2UL) : Freqs->PCLK2;
+}
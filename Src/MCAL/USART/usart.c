@@ -0,0 +1,598 @@
+/**
+ ******************************************************************************
+ * @file           : usart.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : USART Device-Driver Static Code Implementation
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "MCAL/USART/usart.h"
+#include "MCAL/DMA/dma.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/Core/Core.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define USART_SR_PE_POS						0UL
+#define USART_SR_FE_POS						1UL
+#define USART_SR_NF_POS						2UL
+#define USART_SR_ORE_POS					3UL
+#define USART_SR_IDLE_POS					4UL
+#define USART_SR_TC_POS						6UL
+#define USART_SR_EVENTS_MASK				(0x1FUL)	/* !< PE, FE, NF, ORE, IDLE: cleared by reading SR then DR */
+#define USART_CR1_RE_POS					2UL
+#define USART_CR1_TE_POS					3UL
+#define USART_CR1_IDLEIE_POS				4UL
+#define USART_CR1_PEIE_POS					8UL
+#define USART_CR1_PS_POS					9UL
+#define USART_CR1_PCE_POS					10UL
+#define USART_CR1_M_POS						12UL
+#define USART_CR1_UE_POS					13UL
+#define USART_CR1_OVER8_POS					15UL
+#define USART_CR2_STOP_POS					12UL
+#define USART_CR3_EIE_POS					0UL
+#define USART_CR3_DMAR_POS					6UL
+#define USART_CR3_DMAT_POS					7UL
+/* !< Polls of TC before a divider change */
+#define USART_TC_TIMEOUT					100000UL
+
+/*---------------  Section: Data Type Declarations --------------- */
+typedef Std_ReturnType_t (*USART_Dma_Init_t)(const DMA_InitTypeDef * dma_cfgs, const DMA_Stream_InitCfgs_t * StreamCfgs);
+
+/* !< Fixed wiring of a USART */
+typedef struct
+{
+	USART_Registers_t * Regs;
+	DMA_Registers_t * Dma;
+	USART_Dma_Init_t Dma_Init;
+	USART_Dma_Init_t Dma_DeInit;
+	uint8_t Rx_Stream;
+	uint8_t Tx_Stream;
+	DMA_Channel_t Channel;
+	IRQn_t Irq;
+	RCC_Periph_Clock_t Clock;
+	uint8_t On_APB2;
+	Interrupt_Handler_t Rx_Dma_Handler;
+	Interrupt_Handler_t Tx_Dma_Handler;
+} USART_Hw_t;
+
+typedef struct
+{
+	const USART_Tx_Segment_t * Segments;
+	uint8_t Count;
+	USART_Tx_Done_t Done;
+} USART_Tx_Request_t;
+
+typedef struct
+{
+	uint8_t Initialized;
+	uint32_t Baud_Rate;
+	uint8_t * Rx_Buffer;
+	uint16_t Rx_Size;
+	uint16_t Rx_Last;				/* !< Buffer index of the first byte not delivered yet */
+	USART_Rx_Handler_t Rx_Handler;
+	USART_Tx_Request_t Tx_Queue[USART_TX_QUEUE_DEPTH];
+	uint8_t Tx_Head;
+	uint8_t Tx_Count;
+	uint8_t Tx_Segment;				/* !< Segment of the head request on the wire */
+	uint8_t Tx_Busy;
+	USART_Stats_t Stats;
+} USART_Ctx_t;
+
+/*---------------  Section: Helper Function Declarations --------------- */
+static void USART1_Rx_Dma_Handler(void);
+static void USART1_Tx_Dma_Handler(void);
+static void USART2_Rx_Dma_Handler(void);
+static void USART2_Tx_Dma_Handler(void);
+static void USART6_Rx_Dma_Handler(void);
+static void USART6_Tx_Dma_Handler(void);
+static Std_ReturnType_t USART_Set_Baud_Rate(USART_Id_t Id);
+static void USART_Dma_Configs(USART_Id_t Id, uint8_t Rx, DMA_InitTypeDef * Dma_Cfgs, DMA_Stream_InitCfgs_t * Stream_Cfgs);
+static IRQn_t USART_Dma_IRQn(const DMA_Registers_t * Dma, uint8_t Stream);
+static void USART_Stop(USART_Id_t Id);
+static void USART_Rx_Process(USART_Id_t Id, uint32_t Idle);
+static void USART_Tx_Kick(USART_Id_t Id);
+static void USART_Tx_Complete(USART_Id_t Id);
+static void USART_IRQ_Common(USART_Id_t Id);
+
+/*---------------  Section: Static Global Variables --------------- */
+static const USART_Hw_t USART_Hw[USART_COUNT] =
+{
+	[USART_1] = { USART1, DMA2, DMA2_Init, DMA2_DeInit, USART1_RX_DMA_STREAM, USART1_TX_DMA_STREAM, DMA_CHANNEL_4,
+				  USART1_IRQn, RCC_PERIPH_USART1, 1, USART1_Rx_Dma_Handler, USART1_Tx_Dma_Handler },
+	[USART_2] = { USART2, DMA1, DMA1_Init, DMA1_DeInit, USART2_RX_DMA_STREAM, USART2_TX_DMA_STREAM, DMA_CHANNEL_4,
+				  USART2_IRQn, RCC_PERIPH_USART2, 0, USART2_Rx_Dma_Handler, USART2_Tx_Dma_Handler },
+	[USART_6] = { USART6, DMA2, DMA2_Init, DMA2_DeInit, USART6_RX_DMA_STREAM, USART6_TX_DMA_STREAM, DMA_CHANNEL_5,
+				  USART6_IRQn, RCC_PERIPH_USART6, 1, USART6_Rx_Dma_Handler, USART6_Tx_Dma_Handler }
+};
+static USART_Ctx_t USART_Ctx[USART_COUNT];
+
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Initializes a USART: baud rate from the live PCLK, circular DMA reception
+ * 		   with IDLE line detection, DMA transmission, and the error interrupt.
+ * @param  Config: The configuration.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid configuration, baud rate out of reach, or a DMA stream failed
+ */
+Std_ReturnType_t USART_Init(const USART_Config_t * Config)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const USART_Hw_t * Hw = NULL;
+	USART_Ctx_t * Ctx = NULL;
+	DMA_InitTypeDef Dma_Cfgs;
+	DMA_Stream_InitCfgs_t Stream_Cfgs;
+
+	if((NULL == Config) || (Config->Id >= USART_COUNT) || (0 == Config->Baud_Rate) ||
+	   (NULL == Config->Rx_Buffer) || (0 == Config->Rx_Buffer_Size) || (NULL == Config->Rx_Handler) ||
+	   (Config->Parity > USART_PARITY_ODD) ||
+	   ((USART_STOP_BITS_1 != Config->Stop_Bits) && (USART_STOP_BITS_2 != Config->Stop_Bits)) ||
+	   (0 != USART_Ctx[Config->Id].Initialized))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Hw = &USART_Hw[Config->Id];
+		Ctx = &USART_Ctx[Config->Id];
+
+		/* 1. Clock and frame format, the USART disabled */
+		retVal |= RCC_Periph_Clock_Acquire(Hw->Clock);
+		Hw->Regs->CR1 = 0;
+		Hw->Regs->CR2 = ((uint32_t)Config->Stop_Bits << USART_CR2_STOP_POS);
+		Hw->Regs->CR3 = 0;
+		if(USART_PARITY_NONE != Config->Parity)
+		{
+			/* The parity takes the 9th bit, keeping 8 data bits */
+			Hw->Regs->CR1 = (1UL << USART_CR1_M_POS) | (1UL << USART_CR1_PCE_POS) | (1UL << USART_CR1_PEIE_POS) |
+							((USART_PARITY_ODD == Config->Parity) ? (1UL << USART_CR1_PS_POS) : 0UL);
+		}
+
+		/* 2. Baud rate from the live PCLK */
+		Ctx->Baud_Rate = Config->Baud_Rate;
+		retVal |= USART_Set_Baud_Rate(Config->Id);
+
+		/* 3. Context */
+		Ctx->Rx_Buffer = Config->Rx_Buffer;
+		Ctx->Rx_Size = Config->Rx_Buffer_Size;
+		Ctx->Rx_Last = 0;
+		Ctx->Rx_Handler = Config->Rx_Handler;
+		Ctx->Tx_Head = 0;
+		Ctx->Tx_Count = 0;
+		Ctx->Tx_Segment = 0;
+		Ctx->Tx_Busy = 0;
+		Ctx->Stats.Rx_Bytes = 0;
+		Ctx->Stats.Rx_Frames = 0;
+		Ctx->Stats.Tx_Bytes = 0;
+		Ctx->Stats.Overrun_Errors = 0;
+		Ctx->Stats.Framing_Errors = 0;
+		Ctx->Stats.Noise_Errors = 0;
+		Ctx->Stats.Parity_Errors = 0;
+
+		/* 4. Circular reception, interrupting at half and full buffer */
+		if(E_OK == retVal)
+		{
+			USART_Dma_Configs(Config->Id, 1, &Dma_Cfgs, &Stream_Cfgs);
+			retVal |= Hw->Dma_Init(&Dma_Cfgs, &Stream_Cfgs);
+			DMA_ENABLE_HT_IT(Hw->Dma, Hw->Rx_Stream);
+		}
+
+		/* 5. Transmission stream, stopped until the first segment */
+		if(E_OK == retVal)
+		{
+			USART_Dma_Configs(Config->Id, 0, &Dma_Cfgs, &Stream_Cfgs);
+			retVal |= Hw->Dma_Init(&Dma_Cfgs, &Stream_Cfgs);
+			CLEAR_BIT(Hw->Dma->Streams[Hw->Tx_Stream].CR, 0);
+			DMA_CLEAR_ALL_FLAGS(Hw->Dma, Hw->Tx_Stream);
+		}
+
+		if(E_OK == retVal)
+		{
+			/* 6. One priority for the three interrupts, the RX processing never nests */
+			NVIC_SetPriority(Hw->Irq, USART_IRQ_PRIORITY);
+			NVIC_SetPriority(USART_Dma_IRQn(Hw->Dma, Hw->Rx_Stream), USART_IRQ_PRIORITY);
+			NVIC_SetPriority(USART_Dma_IRQn(Hw->Dma, Hw->Tx_Stream), USART_IRQ_PRIORITY);
+			NVIC_EnableIRQ(Hw->Irq);
+			NVIC_EnableIRQ(USART_Dma_IRQn(Hw->Dma, Hw->Rx_Stream));
+			NVIC_EnableIRQ(USART_Dma_IRQn(Hw->Dma, Hw->Tx_Stream));
+
+			/* 7. DMA requests, errors with DMA reception, IDLE line, then start */
+			Hw->Regs->CR3 = (1UL << USART_CR3_DMAR_POS) | (1UL << USART_CR3_DMAT_POS) | (1UL << USART_CR3_EIE_POS);
+			Hw->Regs->CR1 |= (1UL << USART_CR1_TE_POS) | (1UL << USART_CR1_RE_POS) |
+							 (1UL << USART_CR1_IDLEIE_POS) | (1UL << USART_CR1_UE_POS);
+			Ctx->Initialized = 1;
+		}
+		else
+		{
+			USART_Stop(Config->Id);
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Stops a USART and its DMA streams and releases their clocks.
+ * 		   The queued transmissions are dropped without their callbacks.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or not initialized USART
+ */
+Std_ReturnType_t USART_DeInit(USART_Id_t Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((Id >= USART_COUNT) || (0 == USART_Ctx[Id].Initialized))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		NVIC_DisableIRQ(USART_Hw[Id].Irq);
+		NVIC_DisableIRQ(USART_Dma_IRQn(USART_Hw[Id].Dma, USART_Hw[Id].Rx_Stream));
+		NVIC_DisableIRQ(USART_Dma_IRQn(USART_Hw[Id].Dma, USART_Hw[Id].Tx_Stream));
+		USART_Stop(Id);
+		USART_Ctx[Id].Initialized = 0;
+	}
+	return retVal;
+}
+/**
+ * @brief  Queues a scatter list, sent by DMA one segment after the other
+ * 		   with one interrupt per segment. Empty segments are skipped.
+ * @param  Id: The USART.
+ * @param  Segments: The list, it and its data must stay valid until Done is called.
+ * @param  Count: Number of segments.
+ * @param  Done: Called when the list is sent, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameter, not initialized USART or queue full
+ */
+Std_ReturnType_t USART_Transmit(USART_Id_t Id, const USART_Tx_Segment_t * Segments, uint8_t Count, USART_Tx_Done_t Done)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	USART_Ctx_t * Ctx = NULL;
+	USART_Tx_Request_t * Request = NULL;
+	uint8_t Segment_Idx = 0;
+	uint32_t Irq_State = 0;
+
+	if((Id < USART_COUNT) && (0 != USART_Ctx[Id].Initialized) && (NULL != Segments))
+	{
+		/* 1. At least one byte to send, so Done only ever runs from the interrupt */
+		for(Segment_Idx = 0; (Segment_Idx < Count) && (E_NOT_OK == retVal); Segment_Idx++)
+		{
+			if((0 != Segments[Segment_Idx].Length) && (NULL != Segments[Segment_Idx].Data))
+				{ retVal = E_OK; }
+		}
+	}
+
+	if(E_OK == retVal)
+	{
+		Ctx = &USART_Ctx[Id];
+		Irq_State = Core_Enter_Critical();
+		if(Ctx->Tx_Count >= USART_TX_QUEUE_DEPTH)
+			{ retVal = E_NOT_OK; }
+		else
+		{
+			/* 2. Queue, and start if the line is free */
+			Request = &Ctx->Tx_Queue[(Ctx->Tx_Head + Ctx->Tx_Count) % USART_TX_QUEUE_DEPTH];
+			Request->Segments = Segments;
+			Request->Count = Count;
+			Request->Done = Done;
+			Ctx->Tx_Count++;
+			if(0 == Ctx->Tx_Busy)
+				{ USART_Tx_Kick(Id); }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Recomputes the baud rate divider from the live PCLK, after a clock change.
+ * 		   Waits for the current character to leave.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid or not initialized USART, or baud rate out of reach
+ */
+Std_ReturnType_t USART_Update_Baud_Rate(USART_Id_t Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((Id >= USART_COUNT) || (0 == USART_Ctx[Id].Initialized))
+		{ retVal = E_NOT_OK; }
+	else
+		{ retVal = USART_Set_Baud_Rate(Id); }
+
+	return retVal;
+}
+/**
+ * @brief  Clock change listener updating every initialized USART,
+ * 		   it matches the performance profiles listener type.
+ */
+void USART_Clock_Changed(const RCC_Clock_Freqs_t * Old_Freqs, const RCC_Clock_Freqs_t * New_Freqs)
+{
+	uint32_t Id = 0;
+
+	(void)Old_Freqs;
+	(void)New_Freqs;
+	for(Id = 0; Id < USART_COUNT; Id++)
+	{
+		if(0 != USART_Ctx[Id].Initialized)
+			{ (void)USART_Set_Baud_Rate((USART_Id_t)Id); }
+	}
+}
+/**
+ * @brief  Reads the statistics of a USART.
+ * @param  Id: The USART.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid USART or NULL pointer
+ */
+Std_ReturnType_t USART_Get_Stats(USART_Id_t Id, USART_Stats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((Id >= USART_COUNT) || (NULL == Stats))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		*Stats = USART_Ctx[Id].Stats;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Clears the counters of a USART, the baud rate error is kept.
+ * @param  Id: The USART.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid USART
+ */
+Std_ReturnType_t USART_Reset_Stats(USART_Id_t Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Baud_Error = 0;
+	uint32_t Irq_State = 0;
+
+	if(Id >= USART_COUNT)
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Baud_Error = USART_Ctx[Id].Stats.Baud_Error_Permille;
+		USART_Ctx[Id].Stats = (USART_Stats_t){ 0 };
+		USART_Ctx[Id].Stats.Baud_Error_Permille = Baud_Error;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+
+/*---------------  Section: Helper Function Definitions --------------- */
+static void USART1_Rx_Dma_Handler(void) { USART_Rx_Process(USART_1, 0); }
+static void USART1_Tx_Dma_Handler(void) { USART_Tx_Complete(USART_1); }
+static void USART2_Rx_Dma_Handler(void) { USART_Rx_Process(USART_2, 0); }
+static void USART2_Tx_Dma_Handler(void) { USART_Tx_Complete(USART_2); }
+static void USART6_Rx_Dma_Handler(void) { USART_Rx_Process(USART_6, 0); }
+static void USART6_Tx_Dma_Handler(void) { USART_Tx_Complete(USART_6); }
+
+/*
+ * PCLK / baud is the BRR value with 16x oversampling, and 8x the divider with 8x oversampling:
+ * both give the same resolution, 16x is kept while the divider allows it (better noise tolerance),
+ * 8x reaches PCLK / 8 (10.5 Mbaud on APB2 at 84 MHz, 5.25 Mbaud on APB1 at 42 MHz).
+ */
+static Std_ReturnType_t USART_Set_Baud_Rate(USART_Id_t Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const USART_Hw_t * Hw = &USART_Hw[Id];
+	uint32_t Baud_Rate = USART_Ctx[Id].Baud_Rate;
+	uint32_t Pclk = (0 != Hw->On_APB2) ? RCC_Get_PCLK2_Freq() : RCC_Get_PCLK1_Freq();
+	uint32_t Divider = (Pclk + (Baud_Rate / 2UL)) / Baud_Rate;
+	uint32_t Achieved = 0;
+	uint32_t Polls = 0;
+	uint32_t Cr1 = 0;
+
+	if((Divider < 8UL) || (Divider > 0xFFFFUL))
+		{ retVal = E_NOT_OK; }
+	else
+	{
+		/* 1. Let the current character leave */
+		for(Polls = 0; (Polls < USART_TC_TIMEOUT) && (0 == READ_BIT(Hw->Regs->SR, USART_SR_TC_POS)); Polls++);
+
+		/* 2. The oversampling only changes with the USART disabled */
+		Cr1 = Hw->Regs->CR1;
+		CLEAR_BIT(Hw->Regs->CR1, USART_CR1_UE_POS);
+		if(Divider >= 16UL)
+		{
+			Cr1 &= ~(1UL << USART_CR1_OVER8_POS);
+			Hw->Regs->BRR = Divider;
+		}
+		else
+		{
+			/* The fraction has 3 bits, bit 3 stays clear */
+			Cr1 |= (1UL << USART_CR1_OVER8_POS);
+			Hw->Regs->BRR = ((Divider >> 3) << 4) | (Divider & 7UL);
+		}
+		Hw->Regs->CR1 = Cr1;
+
+		/* 3. Deviation, the receiver tolerates about 3.75 % at 16x and 2.5 % at 8x */
+		Achieved = Pclk / Divider;
+		USART_Ctx[Id].Stats.Baud_Error_Permille = ((Achieved > Baud_Rate) ? (Achieved - Baud_Rate) : (Baud_Rate - Achieved)) /
+												  ((Baud_Rate / 1000UL) + 1UL);
+	}
+	return retVal;
+}
+
+static void USART_Dma_Configs(USART_Id_t Id, uint8_t Rx, DMA_InitTypeDef * Dma_Cfgs, DMA_Stream_InitCfgs_t * Stream_Cfgs)
+{
+	const USART_Hw_t * Hw = &USART_Hw[Id];
+
+	Dma_Cfgs->Channel = Hw->Channel;
+	Dma_Cfgs->Direction = (0 != Rx) ? DMA_PREPH_TO_MEMORY : DMA_MEMORY_TO_PREPH;
+	Dma_Cfgs->PeriphInc = DMA_PINC_DISABLE;
+	Dma_Cfgs->MemInc = DMA_MINC_ENABLE;
+	Dma_Cfgs->PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	Dma_Cfgs->MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	Dma_Cfgs->Mode = (0 != Rx) ? DMA_CIRCULAR : DMA_NORMAL;
+	Dma_Cfgs->Priority = (0 != Rx) ? DMA_PRIORITY_VERY_HIGH : DMA_PRIORITY_HIGH;
+	Dma_Cfgs->FIFOMode = DMA_FIFOMODE_DISABLE;
+	Dma_Cfgs->FIFOThreshold = DMA_FIFO_THRESHOLD_HALFFULL;
+	Dma_Cfgs->MemBurst = DMA_MBURST_SINGLE;
+	Dma_Cfgs->PeriphBurst = DMA_PBURST_SINGLE;
+	Dma_Cfgs->DMA_DefaultHandler = (0 != Rx) ? Hw->Rx_Dma_Handler : Hw->Tx_Dma_Handler;
+
+	Stream_Cfgs->Peripheral_Address = (uint32_t)&Hw->Regs->DR;
+	Stream_Cfgs->Memory_Address = (0 != Rx) ? (uint32_t)USART_Ctx[Id].Rx_Buffer : 0UL;
+	Stream_Cfgs->No_Of_Items = (0 != Rx) ? USART_Ctx[Id].Rx_Size : 0U;
+	Stream_Cfgs->Stream_Idx = (0 != Rx) ? Hw->Rx_Stream : Hw->Tx_Stream;
+}
+
+static IRQn_t USART_Dma_IRQn(const DMA_Registers_t * Dma, uint8_t Stream)
+{
+	IRQn_t IRQn = DMA2_Stream5_IRQn;
+
+	if(DMA1 == Dma)
+		{ IRQn = (Stream < 7U) ? (IRQn_t)(DMA1_Stream0_IRQn + Stream) : DMA1_Stream7_IRQn; }
+	else if(Stream < 5U)
+		{ IRQn = (IRQn_t)(DMA2_Stream0_IRQn + Stream); }
+	else
+		{ IRQn = (IRQn_t)(DMA2_Stream5_IRQn + (Stream - 5U)); }
+
+	return IRQn;
+}
+
+static void USART_Stop(USART_Id_t Id)
+{
+	const USART_Hw_t * Hw = &USART_Hw[Id];
+	DMA_InitTypeDef Dma_Cfgs;
+	DMA_Stream_InitCfgs_t Stream_Cfgs;
+
+	Hw->Regs->CR1 = 0;
+	Hw->Regs->CR3 = 0;
+	USART_Dma_Configs(Id, 1, &Dma_Cfgs, &Stream_Cfgs);
+	(void)Hw->Dma_DeInit(&Dma_Cfgs, &Stream_Cfgs);
+	USART_Dma_Configs(Id, 0, &Dma_Cfgs, &Stream_Cfgs);
+	(void)Hw->Dma_DeInit(&Dma_Cfgs, &Stream_Cfgs);
+	(void)RCC_Periph_Clock_Release(Hw->Clock);
+}
+
+/*
+ * Delivers what the DMA wrote since the last call, from its position (NDTR counts down).
+ * Runs on the IDLE line, and on the half / full buffer interrupts so a long
+ * burst is drained before the DMA laps it.
+ */
+static void USART_Rx_Process(USART_Id_t Id, uint32_t Idle)
+{
+	USART_Ctx_t * Ctx = &USART_Ctx[Id];
+	uint32_t Position = Ctx->Rx_Size - USART_Hw[Id].Dma->Streams[USART_Hw[Id].Rx_Stream].NDTR;
+
+	if(Position >= Ctx->Rx_Size)
+		{ Position = 0; }
+
+	if(Position != Ctx->Rx_Last)
+	{
+		if(Position > Ctx->Rx_Last)
+		{
+			Ctx->Rx_Handler(&Ctx->Rx_Buffer[Ctx->Rx_Last], Position - Ctx->Rx_Last);
+			Ctx->Stats.Rx_Bytes += Position - Ctx->Rx_Last;
+		}
+		else
+		{
+			/* Wrapped: the tail of the buffer, then its head */
+			Ctx->Rx_Handler(&Ctx->Rx_Buffer[Ctx->Rx_Last], Ctx->Rx_Size - Ctx->Rx_Last);
+			Ctx->Stats.Rx_Bytes += Ctx->Rx_Size - Ctx->Rx_Last;
+			if(0 != Position)
+			{
+				Ctx->Rx_Handler(&Ctx->Rx_Buffer[0], Position);
+				Ctx->Stats.Rx_Bytes += Position;
+			}
+		}
+		Ctx->Rx_Last = (uint16_t)Position;
+		if(0 != Idle)
+			{ Ctx->Stats.Rx_Frames++; }
+	}
+}
+
+/* Starts the next non empty segment, completing the lists that have none left */
+static void USART_Tx_Kick(USART_Id_t Id)
+{
+	USART_Ctx_t * Ctx = &USART_Ctx[Id];
+	USART_Tx_Request_t * Request = NULL;
+	USART_Tx_Done_t Done = NULL;
+
+	Ctx->Tx_Busy = 0;
+	while((0 != Ctx->Tx_Count) && (0 == Ctx->Tx_Busy))
+	{
+		Request = &Ctx->Tx_Queue[Ctx->Tx_Head];
+		while((Ctx->Tx_Segment < Request->Count) &&
+			  ((0 == Request->Segments[Ctx->Tx_Segment].Length) || (NULL == Request->Segments[Ctx->Tx_Segment].Data)))
+			{ Ctx->Tx_Segment++; }
+
+		if(Ctx->Tx_Segment < Request->Count)
+		{
+			(void)DMA_Stream_Reload(USART_Hw[Id].Dma, USART_Hw[Id].Tx_Stream,
+									(uint32_t)Request->Segments[Ctx->Tx_Segment].Data,
+									Request->Segments[Ctx->Tx_Segment].Length);
+			Ctx->Tx_Busy = 1;
+		}
+		else
+		{
+			Done = Request->Done;
+			Ctx->Tx_Head = (uint8_t)((Ctx->Tx_Head + 1U) % USART_TX_QUEUE_DEPTH);
+			Ctx->Tx_Count--;
+			Ctx->Tx_Segment = 0;
+			if(NULL != Done)
+				{ Done(); }
+		}
+	}
+}
+
+static void USART_Tx_Complete(USART_Id_t Id)
+{
+	USART_Ctx_t * Ctx = &USART_Ctx[Id];
+
+	if(0 != Ctx->Tx_Busy)
+	{
+		Ctx->Stats.Tx_Bytes += Ctx->Tx_Queue[Ctx->Tx_Head].Segments[Ctx->Tx_Segment].Length;
+		Ctx->Tx_Segment++;
+		USART_Tx_Kick(Id);
+	}
+}
+
+static void USART_IRQ_Common(USART_Id_t Id)
+{
+	USART_Registers_t * Regs = USART_Hw[Id].Regs;
+	uint32_t Status = Regs->SR;
+
+	if(Status & USART_SR_EVENTS_MASK)
+	{
+		/* SR then DR clears IDLE and the errors. After an IDLE line the DMA has taken
+		 * the last byte already, so this read does not steal one */
+		(void)Regs->DR;
+		if(READ_BIT(Status, USART_SR_ORE_POS))
+			{ USART_Ctx[Id].Stats.Overrun_Errors++; }
+		if(READ_BIT(Status, USART_SR_FE_POS))
+			{ USART_Ctx[Id].Stats.Framing_Errors++; }
+		if(READ_BIT(Status, USART_SR_NF_POS))
+			{ USART_Ctx[Id].Stats.Noise_Errors++; }
+		if(READ_BIT(Status, USART_SR_PE_POS))
+			{ USART_Ctx[Id].Stats.Parity_Errors++; }
+		if(READ_BIT(Status, USART_SR_IDLE_POS))
+			{ USART_Rx_Process(Id, 1); }
+	}
+}
+
+/*---------------  Section: Interrupt Handlers --------------- */
+void USART1_IRQHandler(void)
+{
+	USART_IRQ_Common(USART_1);
+}
+
+void USART2_IRQHandler(void)
+{
+	USART_IRQ_Common(USART_2);
+}
+
+void USART6_IRQHandler(void)
+{
+	USART_IRQ_Common(USART_6);
+}
@@ -0,0 +1,275 @@
+/**
+ ******************************************************************************
+ * @file           : deferred.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Deferred Interrupt Work Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/Deferred/deferred.h"
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/SCB/SCB.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define DEFERRED_PEND_RUN()			(SCB->ICSR = (1UL << SCB_ICSR_PENDSVSET_POS))
+/*---------------  Section: Static Global Variables --------------- */
+/* Treiber stack of the posted items, newest first. Only the producers push
+ * and the single consumer takes the whole list, so there is no ABA case. */
+static volatile uint32_t Deferred_Head = 0;
+static volatile uint32_t Deferred_Depth = 0;
+static volatile Deferred_Stats_t Deferred_Stats;
+static void (*volatile Deferred_Notify)(void) = NULL;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Deferred_Atomic_Add(volatile uint32_t * Counter, uint32_t Value);
+static void Deferred_Atomic_Max(volatile uint32_t * Counter, uint32_t Value);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Initializes the queue and, when owned, the PendSV priority.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Operation failed
+ */
+Std_ReturnType_t Deferred_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	Deferred_Head = 0;
+	Deferred_Depth = 0;
+	Deferred_Notify = NULL;
+	Deferred_Reset_Stats();
+#if DEFERRED_PENDSV_STATE == DEFERRED_PENDSV_OWNED
+	NVIC_SetPriority(PendSV_IRQn, DEFERRED_PENDSV_PRIORITY);
+#endif
+	return retVal;
+}
+/**
+ * @brief  Sets up a work item.
+ * @param  Work: The work item.
+ * @param  Handler: Runs in the deferred context.
+ * @param  Arg: Passed to the handler.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or the item is pending
+ */
+Std_ReturnType_t Deferred_Work_Init(Deferred_Work_t * Work, Deferred_Handler_t Handler, void * Arg)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((NULL == Work) || (NULL == Handler) || (0 != Work->Pending))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Work->Handler = Handler;
+		Work->Arg = Arg;
+		Work->Next = NULL;
+	}
+	return retVal;
+}
+/**
+ * @brief  Queues a work item, lock-free, from any interrupt or thread.
+ * 		   The item runs once however many times it is posted before it runs.
+ * @param  Work: The work item.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Queued or coalesced
+ *         - E_NOT_OK: NULL pointer or queue full (counted as dropped)
+ */
+Std_ReturnType_t Deferred_Post(Deferred_Work_t * Work)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Claimed = 0;
+	uint32_t Depth = 0;
+	uint32_t Head = 0;
+
+	if(NULL == Work)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Claim the item, a post finding it pending only coalesces */
+		do
+		{
+			Claimed = (0 == Core_LDREXW(&Work->Pending)) ? 1U : 0U;
+			if(0 == Claimed)
+			{
+				Core_CLREX();
+				break;
+			}
+		} while(0 != Core_STREXW(1, &Work->Pending));
+
+		if(0 == Claimed)
+		{
+			Deferred_Atomic_Add(&Deferred_Stats.Coalesced, 1);
+		}
+		else
+		{
+			/* 2. Reserve a place in the queue */
+			do
+			{
+				Depth = Core_LDREXW(&Deferred_Depth);
+				if(Depth >= DEFERRED_QUEUE_DEPTH)
+				{
+					Core_CLREX();
+					retVal = E_NOT_OK;
+					break;
+				}
+			} while(0 != Core_STREXW(Depth + 1U, &Deferred_Depth));
+
+			if(E_NOT_OK == retVal)
+			{
+				Work->Pending = 0;
+				Deferred_Atomic_Add(&Deferred_Stats.Dropped, 1);
+			}
+			else
+			{
+				Deferred_Atomic_Max(&Deferred_Stats.High_Water, Depth + 1U);
+
+				/* 3. Push it */
+				do
+				{
+					Head = Core_LDREXW(&Deferred_Head);
+					Work->Next = (Deferred_Work_t *)Head;
+					CORE_DMB();
+				} while(0 != Core_STREXW((uint32_t)Work, &Deferred_Head));
+				Deferred_Atomic_Add(&Deferred_Stats.Posted, 1);
+
+				/* 4. Wake up the consumer */
+#if DEFERRED_PENDSV_STATE == DEFERRED_PENDSV_OWNED
+				DEFERRED_PEND_RUN();
+#endif
+				if(NULL != Deferred_Notify)
+					{ Deferred_Notify(); }
+			}
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Runs all the queued work in posting order.
+ * 		   Called by PendSV_Handler when owned, by the application otherwise.
+ * 		   Must not preempt itself.
+ */
+void Deferred_Run(void)
+{
+	Deferred_Work_t * List = NULL;
+	Deferred_Work_t * Fifo = NULL;
+	Deferred_Work_t * Next = NULL;
+
+	/* Items posted by the handlers are taken on the next round */
+	do
+	{
+		/* 1. Detach the whole stack */
+		do
+		{
+			List = (Deferred_Work_t *)Core_LDREXW(&Deferred_Head);
+		} while(0 != Core_STREXW(0, &Deferred_Head));
+
+		/* 2. Reverse it to the posting order */
+		Fifo = NULL;
+		while(NULL != List)
+		{
+			Next = List->Next;
+			List->Next = Fifo;
+			Fifo = List;
+			List = Next;
+		}
+
+		/* 3. Run it, a post from here on queues the item again */
+		while(NULL != Fifo)
+		{
+			Next = Fifo->Next;
+			Deferred_Atomic_Add(&Deferred_Depth, (uint32_t)-1);
+			CORE_DMB();
+			Fifo->Pending = 0;
+			Fifo->Handler(Fifo->Arg);
+			Deferred_Stats.Executed++;
+			Fifo = Next;
+		}
+	} while(0 != Deferred_Head);
+}
+/**
+ * @brief  Registers a hook called on every post that queued an item, to wake
+ * 		   up the context calling Deferred_Run() when PendSV is not owned.
+ * @param  Notify: The hook, called from the posting context, NULL to remove it.
+ */
+void Deferred_Register_Notify(void (*Notify)(void))
+{
+	Deferred_Notify = Notify;
+}
+/**
+ * @brief  Reads the queue statistics.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Deferred_Get_Stats(Deferred_Stats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if(NULL == Stats)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Stats->Posted = Deferred_Stats.Posted;
+		Stats->Coalesced = Deferred_Stats.Coalesced;
+		Stats->Dropped = Deferred_Stats.Dropped;
+		Stats->Executed = Deferred_Stats.Executed;
+		Stats->High_Water = Deferred_Stats.High_Water;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Clears the statistics, the high-water mark restarts from the current depth.
+ */
+void Deferred_Reset_Stats(void)
+{
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	Deferred_Stats.Posted = 0;
+	Deferred_Stats.Coalesced = 0;
+	Deferred_Stats.Dropped = 0;
+	Deferred_Stats.Executed = 0;
+	Deferred_Stats.High_Water = Deferred_Depth;
+	Core_Exit_Critical(Irq_State);
+}
+#if DEFERRED_PENDSV_STATE == DEFERRED_PENDSV_OWNED
+/**
+ * @brief  Lowest priority exception, drains the queue once every
+ * 		   interrupt that posted to it has returned.
+ */
+void PendSV_Handler(void)
+{
+	Deferred_Run();
+}
+#endif
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Deferred_Atomic_Add(volatile uint32_t * Counter, uint32_t Value)
+{
+	uint32_t Current = 0;
+
+	do
+	{
+		Current = Core_LDREXW(Counter);
+	} while(0 != Core_STREXW(Current + Value, Counter));
+}
+
+static void Deferred_Atomic_Max(volatile uint32_t * Counter, uint32_t Value)
+{
+	do
+	{
+		if(Core_LDREXW(Counter) >= Value)
+		{
+			Core_CLREX();
+			break;
+		}
+	} while(0 != Core_STREXW(Value, Counter));
+}
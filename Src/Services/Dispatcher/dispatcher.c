@@ -0,0 +1,233 @@
+/**
+ ******************************************************************************
+ * @file           : dispatcher.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Rate-Monotonic Periodic Task Dispatcher Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/Dispatcher/dispatcher.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "CortexM4/DWT/DWT.h"
+#include "CortexM4/Core/Core.h"
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	Dispatcher_Task_t Task;
+	uint32_t Period;
+	uint32_t Countdown;				/* !< Ticks left to the next release */
+	volatile uint8_t Pending;		/* !< Released, not started yet */
+	volatile uint8_t Running;
+	Dispatcher_TaskStats_t Stats;
+} Dispatcher_Entry_t;
+/*---------------  Section: Static Global Variables --------------- */
+
+/* Sorted by period, index 0 is the highest priority */
+static Dispatcher_Entry_t Dispatcher_Table[DISPATCHER_MAX_TASKS];
+static volatile uint8_t Dispatcher_Tasks_Count = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Dispatcher_Execute(Dispatcher_Entry_t * Entry);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Clears the task table, starts the DWT cycle counter and hooks
+ *         the service to the SysTick interrupt.
+ *         The SysTick timebase must be started to make the tasks run.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t Dispatcher_Init(void)
+{
+	Dispatcher_Tasks_Count = 0;
+
+	/* The execution time accounting reads the cycle counter */
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ (void)DWT_CycleCounter_Init(); }
+
+	return SysTick_Register_TickHook(Dispatcher_Tick);
+}
+/**
+ * @brief  Adds a periodic task to the table. Tasks are kept sorted by period,
+ *         the shortest period runs first (rate-monotonic priority).
+ *         Give tasks of the same rate different phases to spread them over the ticks,
+ *         e.g. 100 Hz at phase 3 and 10 Hz at phase 7 with a 1 kHz tick.
+ * @param  Task: The task body.
+ * @param  Period_Ticks: Release period in SysTick ticks.
+ * @param  Phase_Ticks: Offset of the first release, less than the period.
+ * @param  Task_Id: Returns the task id used by the statistics API, may be NULL.
+ *         Ids of tasks added before are shifted by a shorter period task.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters or table full
+ */
+Std_ReturnType_t Dispatcher_Add_Task(Dispatcher_Task_t Task, uint32_t Period_Ticks,
+									 uint32_t Phase_Ticks, uint8_t * Task_Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint8_t Entry_Idx = 0;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Task) || (0 == Period_Ticks) || (Phase_Ticks >= Period_Ticks) ||
+	   (Dispatcher_Tasks_Count >= DISPATCHER_MAX_TASKS))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+
+		/* 1. Insertion sort by period, equal periods keep their adding order */
+		Entry_Idx = Dispatcher_Tasks_Count;
+		while((Entry_Idx > 0) && (Dispatcher_Table[Entry_Idx - 1].Period > Period_Ticks))
+		{
+			Dispatcher_Table[Entry_Idx] = Dispatcher_Table[Entry_Idx - 1];
+			Entry_Idx--;
+		}
+
+		/* 2. First release after Phase_Ticks + 1 ticks, then every period */
+		Dispatcher_Table[Entry_Idx].Task = Task;
+		Dispatcher_Table[Entry_Idx].Period = Period_Ticks;
+		Dispatcher_Table[Entry_Idx].Countdown = Phase_Ticks + 1UL;
+		Dispatcher_Table[Entry_Idx].Pending = 0;
+		Dispatcher_Table[Entry_Idx].Running = 0;
+		Dispatcher_Table[Entry_Idx].Stats = (Dispatcher_TaskStats_t){ 0 };
+		Dispatcher_Tasks_Count++;
+
+		Core_Exit_Critical(Irq_State);
+
+		if(NULL != Task_Id)
+			{ *Task_Id = Entry_Idx; }
+	}
+	return retVal;
+}
+/**
+ * @brief  Advances the dispatcher by one tick and releases the due tasks.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void Dispatcher_Tick(void)
+{
+	uint8_t Entry_Idx = 0;
+	Dispatcher_Entry_t * Entry = NULL;
+
+	for(Entry_Idx = 0; Entry_Idx < Dispatcher_Tasks_Count; Entry_Idx++)
+	{
+		Entry = &Dispatcher_Table[Entry_Idx];
+		if(0 != --Entry->Countdown)
+			{ continue; }
+		Entry->Countdown = Entry->Period;
+		Entry->Stats.Releases++;
+
+#if DISPATCHER_RUN_MODE == DISPATCHER_RUN_IN_ISR
+		Dispatcher_Execute(Entry);
+		/* The tick work outlasted the tick: the next releases are late */
+		if(READ_BIT(SCB->ICSR, SCB_ICSR_PENDSTSET_POS))
+			{ Entry->Stats.Overruns++; }
+#else
+		/* Implicit deadline: the previous release must be done by now */
+		if(Entry->Pending || Entry->Running)
+			{ Entry->Stats.Overruns++; }
+		Entry->Pending = 1;
+#endif
+	}
+}
+/**
+ * @brief  Runs the released tasks, highest priority first, until none is pending.
+ *         Call it from the main loop when DISPATCHER_RUN_MODE is DISPATCHER_RUN_IN_THREAD,
+ *         it does nothing in the other mode.
+ * @return The number of tasks executed.
+ */
+uint32_t Dispatcher_Run(void)
+{
+	uint32_t Runs = 0;
+#if DISPATCHER_RUN_MODE == DISPATCHER_RUN_IN_THREAD
+	uint8_t Entry_Idx = 0;
+	uint8_t Released = 0;
+	uint32_t Irq_State = 0;
+
+	/* Restart from the top after each run, a higher priority task
+	 * may have been released meanwhile */
+	while(Entry_Idx < Dispatcher_Tasks_Count)
+	{
+		/* Test-and-clear with the tick masked, a release arriving between
+		 * the two flags would be counted as an overrun and then lost */
+		Irq_State = Core_Enter_Critical();
+		Released = Dispatcher_Table[Entry_Idx].Pending;
+		if(Released)
+		{
+			Dispatcher_Table[Entry_Idx].Pending = 0;
+			Dispatcher_Table[Entry_Idx].Running = 1;
+		}
+		Core_Exit_Critical(Irq_State);
+
+		if(Released)
+		{
+			Dispatcher_Execute(&Dispatcher_Table[Entry_Idx]);
+			Dispatcher_Table[Entry_Idx].Running = 0;
+			Runs++;
+			Entry_Idx = 0;
+		}
+		else
+		{
+			Entry_Idx++;
+		}
+	}
+#endif
+	return Runs;
+}
+/**
+ * @brief  Reads the statistics of a task.
+ * @param  Task_Id: The task id.
+ * @param  Stats: Returns a consistent copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Unknown task or NULL pointer
+ */
+Std_ReturnType_t Dispatcher_Get_Stats(uint8_t Task_Id, Dispatcher_TaskStats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Stats) || (Task_Id >= Dispatcher_Tasks_Count))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		*Stats = Dispatcher_Table[Task_Id].Stats;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Clears the statistics of all tasks.
+ */
+void Dispatcher_Reset_Stats(void)
+{
+	uint8_t Entry_Idx = 0;
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	for(Entry_Idx = 0; Entry_Idx < Dispatcher_Tasks_Count; Entry_Idx++)
+		{ Dispatcher_Table[Entry_Idx].Stats = (Dispatcher_TaskStats_t){ 0 }; }
+	Core_Exit_Critical(Irq_State);
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Dispatcher_Execute(Dispatcher_Entry_t * Entry)
+{
+	uint32_t Start_Cycles = DWT_GET_CYCCNT();
+	uint32_t Cycles = 0;
+	uint32_t Irq_State = 0;
+
+	Entry->Task();
+	Cycles = DWT_GET_CYCCNT() - Start_Cycles;
+
+	/* Interrupts preempting the task are part of its response time */
+	Irq_State = Core_Enter_Critical();
+	Entry->Stats.Runs++;
+	Entry->Stats.Last_Cycles = Cycles;
+	Entry->Stats.Total_Cycles += Cycles;
+	if(Cycles > Entry->Stats.Worst_Cycles)
+		{ Entry->Stats.Worst_Cycles = Cycles; }
+	Core_Exit_Critical(Irq_State);
+}
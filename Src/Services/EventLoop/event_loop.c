@@ -0,0 +1,236 @@
+/**
+ ******************************************************************************
+ * @file           : event_loop.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Low-Power Event Loop Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/EventLoop/event_loop.h"
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/DWT/DWT.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "MCAL/RCC/rcc.h"
+/*---------------  Section: Static Global Variables --------------- */
+static Interrupt_Handler_t Event_Loop_Handlers[EVENT_LOOP_MAX_EVENTS];
+static volatile uint32_t Event_Loop_Pending = 0;
+static Event_Loop_Stats_t Event_Loop_Stats;
+static uint64_t Event_Loop_Window_Start = 0;
+/* HCLK cycles per SysTick input clock cycle (1 or 8) */
+static uint32_t Event_Loop_Clock_Ratio = 1;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Event_Loop_Sleep(void);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Initializes the loop and the sleep configuration (SCB->SCR).
+ * 		   The SysTick timebase must be running for the idle accounting.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No cycle counter
+ */
+Std_ReturnType_t Event_Loop_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Event_Idx = 0;
+
+	for(Event_Idx = 0; Event_Idx < EVENT_LOOP_MAX_EVENTS; Event_Idx++)
+		{ Event_Loop_Handlers[Event_Idx] = NULL; }
+	Event_Loop_Pending = 0;
+
+#if EVENT_LOOP_SLEEP_MODE == EVENT_LOOP_SLEEP_WFE
+	SET_BIT(SCB->SCR, SCB_SCR_SEVONPEND_POS);
+#elif EVENT_LOOP_SLEEP_MODE == EVENT_LOOP_SLEEP_WFI
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SEVONPEND_POS);
+#else
+#error "Invalid Event Loop Sleep Mode Configurations"
+#endif
+	/* Sleep, not deep sleep: the clocks and the SysTick keep running */
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_POS);
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPONEXIT_POS);
+
+	Event_Loop_Clock_Ratio = RCC_Get_HCLK_Freq() / SysTick_Get_InputClock();
+	Event_Loop_Reset_Stats();
+
+	/* A running cycle counter carries the boot stamps, it is only started when stopped */
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ retVal |= DWT_CycleCounter_Init(); }
+
+	return retVal;
+}
+/**
+ * @brief  Registers the handler of an event, run in the loop (thread mode).
+ * @param  Event_Id: The event, 0 to EVENT_LOOP_MAX_EVENTS - 1.
+ * @param  Handler: The handler, NULL to remove it.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid event
+ */
+Std_ReturnType_t Event_Loop_Register(uint8_t Event_Id, Interrupt_Handler_t Handler)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(Event_Id >= EVENT_LOOP_MAX_EVENTS)
+		{ retVal = E_NOT_OK; }
+	else
+		{ Event_Loop_Handlers[Event_Id] = Handler; }
+
+	return retVal;
+}
+/**
+ * @brief  Posts an event, from an interrupt or the loop itself.
+ * 		   Posts of the same event before it runs are merged.
+ * @param  Event_Id: The event.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid event
+ */
+Std_ReturnType_t Event_Loop_Post(uint8_t Event_Id)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Events = 0;
+
+	if(Event_Id >= EVENT_LOOP_MAX_EVENTS)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Set the event bit, lock-free against the other posting interrupts */
+		do
+		{
+			Events = Core_LDREXW(&Event_Loop_Pending);
+		} while(0 != Core_STREXW(Events | (1UL << Event_Id), &Event_Loop_Pending));
+
+		/* 2. Return to the loop instead of sleeping on exit */
+#if EVENT_LOOP_SLEEP_ON_EXIT_STATE == EVENT_LOOP_SLEEP_ON_EXIT_ENABLED
+		CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPONEXIT_POS);
+#endif
+		/* 3. A WFE about to execute returns at once */
+		CORE_DSB();
+		CORE_SEV();
+	}
+	return retVal;
+}
+/**
+ * @brief  Runs the handlers of the posted events, or sleeps until an interrupt
+ * 		   when none is posted. For a loop that does other work too.
+ */
+void Event_Loop_Run_Once(void)
+{
+	uint32_t Events = 0;
+	uint32_t Event_Id = 0;
+
+	/* 1. Take all the posted events at once */
+	do
+	{
+		Events = Core_LDREXW(&Event_Loop_Pending);
+	} while(0 != Core_STREXW(0, &Event_Loop_Pending));
+
+	if(0 == Events)
+	{
+		Event_Loop_Sleep();
+	}
+	else
+	{
+		/* 2. Lowest event first */
+		while(0 != Events)
+		{
+			Event_Id = 31UL - Core_CLZ(Events & (~Events + 1UL));
+			Events &= ~(1UL << Event_Id);
+			if(NULL != Event_Loop_Handlers[Event_Id])
+			{
+				Event_Loop_Handlers[Event_Id]();
+				Event_Loop_Stats.Dispatched++;
+			}
+		}
+	}
+}
+/**
+ * @brief  Runs the loop forever.
+ */
+void Event_Loop_Run(void)
+{
+	while(1)
+		{ Event_Loop_Run_Once(); }
+}
+/**
+ * @brief  Reads the loop statistics.
+ * @param  Stats: Returns a copy of the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Event_Loop_Get_Stats(Event_Loop_Stats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(NULL == Stats)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		*Stats = Event_Loop_Stats;
+		Stats->Elapsed_Cycles = SysTick_Get_Cycles() - Event_Loop_Window_Start;
+		Stats->Load_Permille = 0;
+		if((0 != Stats->Elapsed_Cycles) && (Stats->Idle_Cycles <= Stats->Elapsed_Cycles))
+			{ Stats->Load_Permille = (uint32_t)(1000ULL - ((Stats->Idle_Cycles * 1000ULL) / Stats->Elapsed_Cycles)); }
+	}
+	return retVal;
+}
+/**
+ * @brief  Clears the statistics and starts a new measurement window.
+ */
+void Event_Loop_Reset_Stats(void)
+{
+	Event_Loop_Stats.Wakeups = 0;
+	Event_Loop_Stats.Dispatched = 0;
+	Event_Loop_Stats.Idle_Cycles = 0;
+	Event_Loop_Stats.Elapsed_Cycles = 0;
+	Event_Loop_Stats.Load_Permille = 0;
+	Event_Loop_Window_Start = SysTick_Get_Cycles();
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Event_Loop_Sleep(void)
+{
+	uint64_t Sleep_Start = 0;
+	uint64_t Sleep_Time = 0;
+	uint32_t Awake_Start = 0;
+	uint32_t Awake_Cycles = 0;
+	/* Masked, an interrupt posting from here on still wakes the core
+	 * (pending interrupt) but is only taken once the sleep is entered */
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	if(0 != Event_Loop_Pending)
+	{
+		Core_Exit_Critical(Irq_State);
+	}
+	else
+	{
+		Sleep_Start = SysTick_Get_Cycles();
+		Awake_Start = DWT_GET_CYCCNT();
+#if EVENT_LOOP_SLEEP_ON_EXIT_STATE == EVENT_LOOP_SLEEP_ON_EXIT_ENABLED
+		SET_BIT(SCB->SCR, SCB_SCR_SLEEPONEXIT_POS);
+#endif
+		CORE_DSB();
+#if EVENT_LOOP_SLEEP_MODE == EVENT_LOOP_SLEEP_WFE
+		CORE_WFE();
+#else
+		CORE_WFI();
+#endif
+		/* The handlers run here, each one that posts nothing sleeps again on exit */
+		Core_Exit_Critical(Irq_State);
+#if EVENT_LOOP_SLEEP_ON_EXIT_STATE == EVENT_LOOP_SLEEP_ON_EXIT_ENABLED
+		CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPONEXIT_POS);
+#endif
+
+		/* The cycle counter only ran for the handlers, the SysTick for the whole window */
+		Awake_Cycles = DWT_GET_CYCCNT() - Awake_Start;
+		Sleep_Time = SysTick_Get_Cycles() - Sleep_Start;
+		if(Sleep_Time > (Awake_Cycles / Event_Loop_Clock_Ratio))
+			{ Event_Loop_Stats.Idle_Cycles += Sleep_Time - (Awake_Cycles / Event_Loop_Clock_Ratio); }
+		Event_Loop_Stats.Wakeups++;
+	}
+}
@@ -0,0 +1,242 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Compressed Append-Only Flash Data Logger Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/FlashLog/flash_log.h"
+#include "CortexM4/DWT/DWT.h"
+/*---------------  Section: Static Global Variables --------------- */
+/* !< Load address and bounds of .data, set by the linker script: the image ends after the .data image */
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+
+static uint32_t FlashLog_Block_Buffer[FLASH_LOG_BLOCK_SIZE / 4UL];
+static FlashLog_Encoder_t FlashLog_Encoder;
+
+static Flash_Sector_t FlashLog_Sector = FLASH_LOG_FIRST_SECTOR;
+static uint32_t FlashLog_Write_Address = 0;
+static uint32_t FlashLog_Sector_End = 0;
+static uint32_t FlashLog_Sequence = 0;
+static uint8_t FlashLog_Initialized = 0;
+
+static uint32_t FlashLog_Samples = 0;
+static uint32_t FlashLog_Flash_Bytes = 0;
+static uint32_t FlashLog_Blocks = 0;
+static uint32_t FlashLog_Sector_Erases = 0;
+static uint64_t FlashLog_Write_Cycles = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static Std_ReturnType_t FlashLog_Commit(void);
+static Std_ReturnType_t FlashLog_Open_Sector(const Flash_Sector_t Sector);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Finds the end of the log in the configured sectors and
+ *         resumes appending after the newest valid block.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: A log sector overlaps the program image, or a flash operation failed
+ */
+Std_ReturnType_t FlashLog_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	const uint32_t Image_End = (uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata);
+	uint32_t Sector = 0;
+	uint32_t Start = 0;
+	uint32_t Size = 0;
+	uint32_t Address = 0;
+	uint32_t Sample_Count = 0;
+	uint32_t Sequence = 0;
+	uint32_t Block_Size = 0;
+	uint8_t Found = 0;
+
+	/* 1. Never erase a sector holding code, the ring erases each one in turn */
+	retVal |= Flash_Get_Sector_Range(FLASH_LOG_FIRST_SECTOR, &Start, &Size);
+	if(Start < Image_End)
+		{ retVal = E_NOT_OK; }
+
+	if(E_OK == retVal)
+	{
+		if(!DWT_CYCCNT_IS_ENABLED())
+			{ retVal |= DWT_CycleCounter_Init(); }
+
+		/* 2. Walk the blocks of every sector looking for the newest one */
+		for(Sector = (uint32_t)FLASH_LOG_FIRST_SECTOR; Sector <= (uint32_t)FLASH_LOG_LAST_SECTOR; Sector++)
+		{
+			retVal |= Flash_Get_Sector_Range((Flash_Sector_t)Sector, &Start, &Size);
+			Address = Start;
+			while((Address + FLASH_LOG_BLOCK_OVERHEAD) <= (Start + Size))
+			{
+				if(FLASH_ERASED_WORD == *((volatile uint32_t *)(Address)))
+					{ break; }
+				/* A torn block ends the sector */
+				if(E_OK != FlashLog_Codec_Decode((const uint8_t *)Address, (Start + Size) - Address,
+												 NULL, 0, &Sample_Count, &Sequence, &Block_Size))
+					{ break; }
+				if((!Found) || ((int32_t)(Sequence - FlashLog_Sequence) >= 0))
+				{
+					Found = 1;
+					FlashLog_Sequence = Sequence;
+					FlashLog_Sector = (Flash_Sector_t)Sector;
+					FlashLog_Write_Address = Address + Block_Size;
+					FlashLog_Sector_End = Start + Size;
+				}
+				Address += Block_Size;
+			}
+		}
+	}
+
+	if(E_OK == retVal)
+	{
+		/* 3. Resume after the newest block, or start a fresh log */
+		if(Found)
+		{
+			FlashLog_Sequence++;
+			if((FlashLog_Write_Address < FlashLog_Sector_End) &&
+			   (FLASH_ERASED_WORD != *((volatile uint32_t *)(FlashLog_Write_Address))))
+			{
+				/* Leftovers of an interrupted write, continue in the next sector */
+				FlashLog_Write_Address = FlashLog_Sector_End;
+			}
+		}
+		else
+		{
+			FlashLog_Sequence = 0;
+			retVal |= FlashLog_Open_Sector(FLASH_LOG_FIRST_SECTOR);
+		}
+	}
+
+	retVal |= FlashLog_Codec_Begin(&FlashLog_Encoder, (uint8_t *)FlashLog_Block_Buffer, FLASH_LOG_BLOCK_SIZE);
+	FlashLog_Initialized = (E_OK == retVal) ? 1 : 0;
+	return retVal;
+}
+/**
+ * @brief  Appends a sample to the RAM block, the block is
+ *         programmed in one batch once it is full.
+ * @param  Sample: The sample to log.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Logger not initialized or flash failure
+ */
+Std_ReturnType_t FlashLog_Append(int32_t Sample)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(!FlashLog_Initialized)
+	{
+		retVal = E_NOT_OK;
+	}
+	else if(E_OK != FlashLog_Codec_Append(&FlashLog_Encoder, Sample))
+	{
+		/* Block full: program it and start the next one with this sample */
+		retVal |= FlashLog_Commit();
+		retVal |= FlashLog_Codec_Append(&FlashLog_Encoder, Sample);
+	}
+	return retVal;
+}
+/**
+ * @brief  Programs the partially filled RAM block now (e.g. before a reset).
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Logger not initialized or flash failure
+ */
+Std_ReturnType_t FlashLog_Flush(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(!FlashLog_Initialized)
+		{ retVal = E_NOT_OK; }
+	else
+		{ retVal |= FlashLog_Commit(); }
+	return retVal;
+}
+/**
+ * @brief  Reports the compression ratio and the write throughput.
+ * @param  Stats: Pointer to the structure receiving the statistics.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t FlashLog_GetStats(FlashLog_Stats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if(NULL == Stats)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Stats->Samples = FlashLog_Samples;
+		Stats->Raw_Bytes = FlashLog_Samples * 4UL;
+		Stats->Flash_Bytes = FlashLog_Flash_Bytes;
+		Stats->Blocks = FlashLog_Blocks;
+		Stats->Sector_Erases = FlashLog_Sector_Erases;
+		Stats->Compression_Ratio_x100 = (FlashLog_Flash_Bytes) ?
+			(uint32_t)(((uint64_t)Stats->Raw_Bytes * 100UL) / FlashLog_Flash_Bytes) : 0;
+		Stats->Write_Cycles = FlashLog_Write_Cycles;
+		Stats->Bytes_Per_MCycle = (FlashLog_Write_Cycles) ?
+			(uint32_t)(((uint64_t)FlashLog_Flash_Bytes * 1000000UL) / FlashLog_Write_Cycles) : 0;
+	}
+	return retVal;
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static Std_ReturnType_t FlashLog_Commit(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Start_Cycles = DWT_GET_CYCCNT();
+	uint32_t Block_Size = FlashLog_Codec_Seal(&FlashLog_Encoder, FlashLog_Sequence);
+	Flash_Sector_t Next_Sector = FLASH_LOG_FIRST_SECTOR;
+
+	if(0 == Block_Size)
+		{ return E_OK; }
+
+	/* 1. Move to the next sector of the ring when this one is full */
+	if((FlashLog_Write_Address + Block_Size) > FlashLog_Sector_End)
+	{
+		Next_Sector = (FLASH_LOG_LAST_SECTOR == FlashLog_Sector) ?
+				FLASH_LOG_FIRST_SECTOR : (Flash_Sector_t)((uint32_t)FlashLog_Sector + 1UL);
+		retVal |= FlashLog_Open_Sector(Next_Sector);
+	}
+
+	/* 2. Program the whole block in one batch */
+	if(E_OK == retVal)
+		{ retVal |= Flash_Program_Buffer(FlashLog_Write_Address, FlashLog_Block_Buffer, Block_Size / 4UL); }
+
+	FlashLog_Write_Cycles += (uint32_t)(DWT_GET_CYCCNT() - Start_Cycles);
+
+	if(E_OK == retVal)
+	{
+		FlashLog_Samples += FlashLog_Encoder.Sample_Count;
+		FlashLog_Flash_Bytes += Block_Size;
+		FlashLog_Blocks++;
+	}
+	/* A failed block is dropped, the sequence still moves on */
+	FlashLog_Write_Address += Block_Size;
+	FlashLog_Sequence++;
+	(void)FlashLog_Codec_Begin(&FlashLog_Encoder, (uint8_t *)FlashLog_Block_Buffer, FLASH_LOG_BLOCK_SIZE);
+
+	return retVal;
+}
+
+static Std_ReturnType_t FlashLog_Open_Sector(const Flash_Sector_t Sector)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Start = 0;
+	uint32_t Size = 0;
+
+	retVal |= Flash_Get_Sector_Range(Sector, &Start, &Size);
+	if(E_OK == retVal)
+	{
+		/* Erase only if needed, a blank sector costs no wear */
+		if(FLASH_ERASED_WORD != *((volatile uint32_t *)(Start)))
+		{
+			retVal |= Flash_Erase_Sector(Sector);
+			FlashLog_Sector_Erases++;
+		}
+		FlashLog_Sector = Sector;
+		FlashLog_Write_Address = Start;
+		FlashLog_Sector_End = Start + Size;
+	}
+	return retVal;
+}
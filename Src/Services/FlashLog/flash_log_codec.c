@@ -0,0 +1,236 @@
+/**
+ ******************************************************************************
+ * @file           : flash_log_codec.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Flash Data Logger Block Codec Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/FlashLog/flash_log_codec.h"
+/*---------------  Section: Static Global Variables --------------- */
+
+/* Nibble table of the reflected 0xEDB88320 polynomial, 64 bytes instead of 1 KB */
+static const uint32_t FlashLog_CRC32_Table[16] =
+{
+	0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+	0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+	0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+	0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+/*---------------  Section: Helper Function Declarations --------------- */
+static void FlashLog_Put_U16(uint8_t * Dest, uint32_t Value);
+static void FlashLog_Put_U32(uint8_t * Dest, uint32_t Value);
+static uint32_t FlashLog_Get_U16(const uint8_t * Src);
+static uint32_t FlashLog_Get_U32(const uint8_t * Src);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Starts a new empty block in the encoder buffer.
+ * @param  Encoder: The encoder state.
+ * @param  Buffer: Word aligned buffer holding the block.
+ * @param  Capacity: Buffer size, at least one header, one sample and the CRC.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or buffer too small
+ */
+Std_ReturnType_t FlashLog_Codec_Begin(FlashLog_Encoder_t * Encoder, uint8_t * Buffer, uint32_t Capacity)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Encoder) || (NULL == Buffer) ||
+	   (Capacity < FLASH_LOG_WORD_ALIGN(FLASH_LOG_BLOCK_OVERHEAD + FLASH_LOG_MAX_SAMPLE_SIZE)) ||
+	   (Capacity > (0xFFFFUL + FLASH_LOG_BLOCK_OVERHEAD)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Encoder->Buffer = Buffer;
+		Encoder->Capacity = Capacity;
+		Encoder->Length = FLASH_LOG_HEADER_SIZE;
+		Encoder->Sample_Count = 0;
+		Encoder->Previous_Sample = 0;
+	}
+	return retVal;
+}
+/**
+ * @brief  Appends one sample to the current block.
+ * @param  Encoder: The encoder state.
+ * @param  Sample: The sample to encode.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: The sample is in the block
+ *         - E_NOT_OK: The block is full, seal it and begin a new one
+ */
+Std_ReturnType_t FlashLog_Codec_Append(FlashLog_Encoder_t * Encoder, int32_t Sample)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Value = 0;
+	uint8_t * Dest = NULL;
+
+	/* Keep room for a worst case varint and the CRC, the sealed size still fits Capacity */
+	if((NULL == Encoder) || (0xFFFFUL == Encoder->Sample_Count) ||
+	   ((Encoder->Length + FLASH_LOG_MAX_SAMPLE_SIZE + FLASH_LOG_CRC_SIZE) > (Encoder->Capacity & ~3UL)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 1. Delta against the previous sample, the first sample is stored as is */
+		Value = FLASH_LOG_ZIGZAG_ENCODE((uint32_t)Sample - (uint32_t)Encoder->Previous_Sample);
+
+		/* 2. Variable-length encoding, 7 bits per byte */
+		Dest = &Encoder->Buffer[Encoder->Length];
+		while(Value >= 0x80UL)
+		{
+			*Dest++ = (uint8_t)(Value | 0x80UL);
+			Value >>= 7;
+		}
+		*Dest++ = (uint8_t)Value;
+
+		Encoder->Length = (uint32_t)(Dest - Encoder->Buffer);
+		Encoder->Previous_Sample = Sample;
+		Encoder->Sample_Count++;
+	}
+	return retVal;
+}
+/**
+ * @brief  Writes the header and the CRC, and pads the block to a word boundary.
+ * @param  Encoder: The encoder state.
+ * @param  Sequence: Sequence number of the block.
+ * @return Size of the sealed block in bytes (multiple of 4), 0 for an empty block.
+ */
+uint32_t FlashLog_Codec_Seal(FlashLog_Encoder_t * Encoder, uint32_t Sequence)
+{
+	uint32_t Block_Size = 0;
+	uint32_t Idx = 0;
+
+	if((NULL != Encoder) && (0 != Encoder->Sample_Count))
+	{
+		/* 1. Header */
+		FlashLog_Put_U16(&Encoder->Buffer[0], FLASH_LOG_BLOCK_MAGIC);
+		FlashLog_Put_U16(&Encoder->Buffer[2], Encoder->Length - FLASH_LOG_HEADER_SIZE);
+		FlashLog_Put_U32(&Encoder->Buffer[4], Sequence);
+		FlashLog_Put_U16(&Encoder->Buffer[8], Encoder->Sample_Count);
+		FlashLog_Put_U16(&Encoder->Buffer[10], 0xFFFFUL);
+
+		/* 2. CRC over header and payload */
+		FlashLog_Put_U32(&Encoder->Buffer[Encoder->Length], FlashLog_Codec_CRC32(Encoder->Buffer, Encoder->Length));
+
+		/* 3. Pad with the erased value so the padding costs no programming */
+		Block_Size = FLASH_LOG_WORD_ALIGN(Encoder->Length + FLASH_LOG_CRC_SIZE);
+		for(Idx = Encoder->Length + FLASH_LOG_CRC_SIZE; Idx < Block_Size; Idx++)
+			{ Encoder->Buffer[Idx] = 0xFFU; }
+	}
+	return Block_Size;
+}
+/**
+ * @brief  Checks and decodes one block.
+ * @param  Block: Pointer to the first byte of the block.
+ * @param  Available: Bytes readable from Block.
+ * @param  Samples: Array receiving the samples, may be NULL to only validate.
+ * @param  Max_Samples: Size of the Samples array.
+ * @param  Sample_Count: Receives the number of samples in the block.
+ * @param  Sequence: Receives the sequence number, may be NULL.
+ * @param  Block_Size: Receives the block size in flash, may be NULL.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Valid block
+ *         - E_NOT_OK: Bad magic, length, CRC or too many samples
+ */
+Std_ReturnType_t FlashLog_Codec_Decode(const uint8_t * Block, uint32_t Available,
+									   int32_t * Samples, uint32_t Max_Samples, uint32_t * Sample_Count,
+									   uint32_t * Sequence, uint32_t * Block_Size)
+{
+	uint32_t Payload_Length = 0;
+	uint32_t Count = 0;
+	uint32_t Position = FLASH_LOG_HEADER_SIZE;
+	uint32_t Decoded = 0;
+	uint32_t Value = 0;
+	uint32_t Shift = 0;
+	int32_t Previous = 0;
+
+	if((NULL == Block) || (NULL == Sample_Count) || (Available < FLASH_LOG_BLOCK_OVERHEAD))
+		{ return E_NOT_OK; }
+
+	/* 1. Frame checks */
+	Payload_Length = FlashLog_Get_U16(&Block[2]);
+	Count = FlashLog_Get_U16(&Block[8]);
+	if((FLASH_LOG_BLOCK_MAGIC != FlashLog_Get_U16(&Block[0])) ||
+	   ((FLASH_LOG_HEADER_SIZE + Payload_Length + FLASH_LOG_CRC_SIZE) > Available) ||
+	   (FlashLog_Get_U32(&Block[FLASH_LOG_HEADER_SIZE + Payload_Length]) !=
+		FlashLog_Codec_CRC32(Block, FLASH_LOG_HEADER_SIZE + Payload_Length)) ||
+	   ((NULL != Samples) && (Count > Max_Samples)))
+		{ return E_NOT_OK; }
+
+	/* 2. Varint + zig-zag + delta decoding */
+	if(NULL != Samples)
+	{
+		while((Position < (FLASH_LOG_HEADER_SIZE + Payload_Length)) && (Decoded < Count))
+		{
+			Value |= (uint32_t)(Block[Position] & 0x7FU) << Shift;
+			if(Block[Position++] & 0x80U)
+			{
+				Shift += 7;
+				if(Shift > 28)
+					{ return E_NOT_OK; }
+			}
+			else
+			{
+				Previous = FLASH_LOG_S32((uint32_t)Previous + (uint32_t)FLASH_LOG_ZIGZAG_DECODE(Value));
+				Samples[Decoded++] = Previous;
+				Value = 0;
+				Shift = 0;
+			}
+		}
+		if(Decoded != Count)
+			{ return E_NOT_OK; }
+	}
+
+	*Sample_Count = Count;
+	if(NULL != Sequence)
+		{ *Sequence = FlashLog_Get_U32(&Block[4]); }
+	if(NULL != Block_Size)
+		{ *Block_Size = FLASH_LOG_WORD_ALIGN(FLASH_LOG_HEADER_SIZE + Payload_Length + FLASH_LOG_CRC_SIZE); }
+	return E_OK;
+}
+/**
+ * @brief  Computes the CRC-32 (IEEE 802.3) of a byte buffer.
+ * @param  Data: Pointer to the data.
+ * @param  Length: Number of bytes.
+ * @return The CRC value.
+ */
+uint32_t FlashLog_Codec_CRC32(const uint8_t * Data, uint32_t Length)
+{
+	uint32_t CRC = 0xFFFFFFFFUL;
+	uint32_t Idx = 0;
+
+	for(Idx = 0; Idx < Length; Idx++)
+	{
+		CRC ^= Data[Idx];
+		CRC = (CRC >> 4) ^ FlashLog_CRC32_Table[CRC & 0x0FUL];
+		CRC = (CRC >> 4) ^ FlashLog_CRC32_Table[CRC & 0x0FUL];
+	}
+	return FLASH_LOG_U32(~CRC);
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void FlashLog_Put_U16(uint8_t * Dest, uint32_t Value)
+{
+	Dest[0] = (uint8_t)(Value);
+	Dest[1] = (uint8_t)(Value >> 8);
+}
+
+static void FlashLog_Put_U32(uint8_t * Dest, uint32_t Value)
+{
+	Dest[0] = (uint8_t)(Value);
+	Dest[1] = (uint8_t)(Value >> 8);
+	Dest[2] = (uint8_t)(Value >> 16);
+	Dest[3] = (uint8_t)(Value >> 24);
+}
+
+static uint32_t FlashLog_Get_U16(const uint8_t * Src)
+{
+	return ((uint32_t)Src[0]) | ((uint32_t)Src[1] << 8);
+}
+
+static uint32_t FlashLog_Get_U32(const uint8_t * Src)
+{
+	return ((uint32_t)Src[0]) | ((uint32_t)Src[1] << 8) | ((uint32_t)Src[2] << 16) | ((uint32_t)Src[3] << 24);
+}
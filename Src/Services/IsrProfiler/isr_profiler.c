@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file           : isr_profiler.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Interrupt Latency and Duration Profiler Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/IsrProfiler/isr_profiler.h"
+#if ISR_PROFILER_STATE == ISR_PROFILER_ENABLED
+#include "CortexM4/DWT/DWT.h"
+#include "CortexM4/Core/Core.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define ISR_PROFILER_VECTORS			(16U + 85U)
+#define ISR_PROFILER_NO_SLOT			(0xFFU)
+/* --------------- Section: Data Type Declarations --------------- */
+typedef struct
+{
+	uint32_t Start;					/* !< CYCCNT at entry */
+	uint32_t Nested_Cycles;			/* !< Time spent in the interrupts preempting this one */
+	IRQn_t IRQn;					/* !< Matched by the exit */
+	uint8_t Slot;					/* !< ISR_PROFILER_NO_SLOT: entered but not profiled */
+} ISR_Profiler_Frame_t;
+/*---------------  Section: Static Global Variables --------------- */
+/* Vector number to profile slot, filled on the first entry */
+static uint8_t ISR_Profiler_Slot_Of[ISR_PROFILER_VECTORS];
+static ISR_Profiler_Stats_t ISR_Profiler_Stats[ISR_PROFILER_MAX_IRQS];
+static uint32_t ISR_Profiler_Trigger[ISR_PROFILER_MAX_IRQS];
+static uint8_t ISR_Profiler_Triggered[ISR_PROFILER_MAX_IRQS];
+static uint8_t ISR_Profiler_Slots_Used = 0;
+/* Interrupts in progress, innermost last. The ones without a slot keep a
+ * frame too, so their time is not charged to the interrupt they preempted */
+static ISR_Profiler_Frame_t ISR_Profiler_Frames[ISR_PROFILER_MAX_NESTING];
+static uint8_t ISR_Profiler_Depth = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static uint8_t ISR_Profiler_Get_Slot(IRQn_t IRQn, uint8_t Allocate);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Starts the DWT cycle counter if it is stopped, and clears all the profiles.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No cycle counter
+ */
+Std_ReturnType_t ISR_Profiler_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Vector_Idx = 0;
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	for(Vector_Idx = 0; Vector_Idx < ISR_PROFILER_VECTORS; Vector_Idx++)
+		{ ISR_Profiler_Slot_Of[Vector_Idx] = ISR_PROFILER_NO_SLOT; }
+	ISR_Profiler_Slots_Used = 0;
+	ISR_Profiler_Depth = 0;
+	ISR_Profiler_Reset();
+	Core_Exit_Critical(Irq_State);
+
+	/* A running counter is shared with the boot stamps and the other measurements */
+	if(!DWT_CYCCNT_IS_ENABLED())
+		{ retVal |= DWT_CycleCounter_Init(); }
+
+	return retVal;
+}
+/**
+ * @brief  Marks the entry of a profiled interrupt, first thing in the handler.
+ * @param  IRQn: The interrupt number, negative for a system exception.
+ */
+void ISR_Profiler_Enter(IRQn_t IRQn)
+{
+	uint32_t Now = DWT_GET_CYCCNT();
+	uint32_t Irq_State = Core_Enter_Critical();
+	uint8_t Slot = ISR_Profiler_Get_Slot(IRQn, 1);
+	ISR_Profiler_Frame_t * Frame = NULL;
+
+	/* Too deep: not accounted, its exit finds no frame */
+	if(ISR_Profiler_Depth < ISR_PROFILER_MAX_NESTING)
+	{
+		/* 1. The interrupt in progress, if any, is being preempted */
+		if((0 != ISR_Profiler_Depth) && (ISR_PROFILER_NO_SLOT != ISR_Profiler_Frames[ISR_Profiler_Depth - 1U].Slot))
+			{ ISR_Profiler_Stats[ISR_Profiler_Frames[ISR_Profiler_Depth - 1U].Slot].Preemptions++; }
+
+		/* 2. Latency from the last trigger stamp, none without a slot */
+		if(ISR_PROFILER_NO_SLOT != Slot)
+		{
+			ISR_Profiler_Stats[Slot].Last_Entry = Now;
+			if(ISR_Profiler_Triggered[Slot])
+			{
+				ISR_Profiler_Triggered[Slot] = 0;
+				ISR_Profiler_Stats[Slot].Latency_Count++;
+				ISR_Profiler_Stats[Slot].Total_Latency += (Now - ISR_Profiler_Trigger[Slot]);
+				if((Now - ISR_Profiler_Trigger[Slot]) > ISR_Profiler_Stats[Slot].Max_Latency)
+					{ ISR_Profiler_Stats[Slot].Max_Latency = Now - ISR_Profiler_Trigger[Slot]; }
+			}
+		}
+
+		/* 3. Push the frame, the time spent here is charged at exit */
+		Frame = &ISR_Profiler_Frames[ISR_Profiler_Depth++];
+		Frame->IRQn = IRQn;
+		Frame->Slot = Slot;
+		Frame->Nested_Cycles = 0;
+		Frame->Start = DWT_GET_CYCCNT();
+	}
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Marks the exit of a profiled interrupt, last thing in the handler.
+ * @param  IRQn: The interrupt number given to ISR_Profiler_Enter(), the exit
+ *         closes the frame of that entry.
+ */
+void ISR_Profiler_Exit(IRQn_t IRQn)
+{
+	uint32_t Now = DWT_GET_CYCCNT();
+	uint32_t Irq_State = Core_Enter_Critical();
+	ISR_Profiler_Frame_t * Frame = NULL;
+	uint32_t Gross_Cycles = 0;
+	uint8_t Depth = ISR_Profiler_Depth;
+
+	/* 1. Find the frame of IRQn, an interrupt is never nested in itself.
+	 * None: its entry was too deep. The frames above it missed their exit. */
+	while((0 != Depth) && (IRQn != ISR_Profiler_Frames[Depth - 1U].IRQn))
+		{ Depth--; }
+	if(0 != Depth)
+	{
+		ISR_Profiler_Depth = Depth - 1U;
+		Frame = &ISR_Profiler_Frames[ISR_Profiler_Depth];
+		Gross_Cycles = Now - Frame->Start;
+
+		/* 2. Own time only, the preempting interrupts are taken out */
+		if(ISR_PROFILER_NO_SLOT != Frame->Slot)
+			{ ISR_Profiler_Stats_Record(&ISR_Profiler_Stats[Frame->Slot], Gross_Cycles - Frame->Nested_Cycles); }
+		if(0 != ISR_Profiler_Depth)
+			{ ISR_Profiler_Frames[ISR_Profiler_Depth - 1U].Nested_Cycles += Gross_Cycles; }
+	}
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Stamps the request of an interrupt, its next entry measures the latency.
+ * @param  IRQn: The interrupt number.
+ */
+void ISR_Profiler_Mark_Trigger(IRQn_t IRQn)
+{
+	uint32_t Irq_State = Core_Enter_Critical();
+	uint8_t Slot = ISR_Profiler_Get_Slot(IRQn, 1);
+
+	if(ISR_PROFILER_NO_SLOT != Slot)
+	{
+		ISR_Profiler_Triggered[Slot] = 1;
+		ISR_Profiler_Trigger[Slot] = DWT_GET_CYCCNT();
+	}
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Reads the profile of an interrupt.
+ * @param  IRQn: The interrupt number.
+ * @param  Stats: Returns a consistent copy of the profile.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Interrupt never profiled or NULL pointer
+ */
+Std_ReturnType_t ISR_Profiler_Get_Stats(IRQn_t IRQn, ISR_Profiler_Stats_t * Stats)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+	uint8_t Slot = ISR_PROFILER_NO_SLOT;
+
+	if(NULL == Stats)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Slot = ISR_Profiler_Get_Slot(IRQn, 0);
+		if(ISR_PROFILER_NO_SLOT == Slot)
+			{ retVal = E_NOT_OK; }
+		else
+			{ *Stats = ISR_Profiler_Stats[Slot]; }
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Clears the profiles, the slots stay assigned.
+ */
+void ISR_Profiler_Reset(void)
+{
+	const ISR_Profiler_Stats_t Zero_Stats = { .Min_Cycles = 0xFFFFFFFFUL };
+	uint32_t Slot_Idx = 0;
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	for(Slot_Idx = 0; Slot_Idx < ISR_PROFILER_MAX_IRQS; Slot_Idx++)
+	{
+		ISR_Profiler_Stats[Slot_Idx] = Zero_Stats;
+		ISR_Profiler_Triggered[Slot_Idx] = 0;
+	}
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Adds one run to a profile. Pure function, no register access.
+ * @param  Stats: The profile.
+ * @param  Cycles: Execution cycles of the run.
+ */
+void ISR_Profiler_Stats_Record(ISR_Profiler_Stats_t * Stats, uint32_t Cycles)
+{
+	Stats->Count++;
+	Stats->Total_Cycles += Cycles;
+	if(Cycles < Stats->Min_Cycles)
+		{ Stats->Min_Cycles = Cycles; }
+	if(Cycles > Stats->Max_Cycles)
+		{ Stats->Max_Cycles = Cycles; }
+	Stats->Histogram[ISR_Profiler_Hist_Bin(Cycles)]++;
+}
+/**
+ * @brief  Returns the histogram bin of an execution time. Pure function.
+ * @param  Cycles: Execution cycles.
+ * @return The bin index, 0 to ISR_PROFILER_HIST_BINS - 1.
+ */
+uint32_t ISR_Profiler_Hist_Bin(uint32_t Cycles)
+{
+	uint32_t Scaled = Cycles >> ISR_PROFILER_HIST_SHIFT;
+	/* Bit length of the scaled time: 0 below 2^SHIFT, then one bin per octave */
+	uint32_t Bin = (0 == Scaled) ? 0 : (32UL - (uint32_t)__builtin_clz(Scaled));
+
+	return (Bin < ISR_PROFILER_HIST_BINS) ? Bin : (ISR_PROFILER_HIST_BINS - 1U);
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static uint8_t ISR_Profiler_Get_Slot(IRQn_t IRQn, uint8_t Allocate)
+{
+	uint8_t Slot = ISR_PROFILER_NO_SLOT;
+	int32_t Vector_Idx = (int32_t)IRQn + 16;
+
+	if((Vector_Idx >= 0) && (Vector_Idx < (int32_t)ISR_PROFILER_VECTORS))
+	{
+		Slot = ISR_Profiler_Slot_Of[Vector_Idx];
+		if((ISR_PROFILER_NO_SLOT == Slot) && Allocate && (ISR_Profiler_Slots_Used < ISR_PROFILER_MAX_IRQS))
+		{
+			Slot = ISR_Profiler_Slots_Used++;
+			ISR_Profiler_Slot_Of[Vector_Idx] = Slot;
+		}
+	}
+	return Slot;
+}
+#endif
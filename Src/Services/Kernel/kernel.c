@@ -0,0 +1,712 @@
+/**
+ ******************************************************************************
+ * @file           : kernel.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Preemptive Priority-Based Micro-Kernel Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/Kernel/kernel.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "Services/Deferred/deferred_cfg.h"
+/* --------------- Section: Macro Declarations --------------- */
+/* The context switch is the PendSV handler, no other service may define it */
+#if DEFERRED_PENDSV_STATE == DEFERRED_PENDSV_OWNED
+#error "The kernel owns PendSV: set DEFERRED_PENDSV_STATE to DEFERRED_PENDSV_NOT_OWNED"
+#endif
+#define KERNEL_INITIAL_XPSR				0x01000000UL	/* !< Thumb state */
+#define KERNEL_INITIAL_EXC_RETURN		0xFFFFFFFDUL	/* !< Thread mode, PSP, no FPU frame */
+/* --------------- Section: Macro Functions Declarations --------------- */
+/* Priority 0 is kept in bit 31, so CLZ returns the highest ready priority */
+#define KERNEL_PRIORITY_BIT(PRIO)		(0x80000000UL >> (PRIO))
+#define KERNEL_PEND_SWITCH()			(SCB->ICSR = (1UL << SCB_ICSR_PENDSVSET_POS))
+/*---------------  Section: Static Global Variables --------------- */
+static Kernel_List_t Kernel_Ready[KERNEL_MAX_PRIORITIES];
+static volatile uint32_t Kernel_Ready_Bitmap = 0;
+/* Sleeping threads and threads waiting with a timeout */
+static Kernel_Thread_t * Kernel_Delay_Head = NULL;
+static Kernel_Thread_t * volatile Kernel_Current = NULL;
+static volatile uint32_t Kernel_Ticks = 0;
+static volatile uint32_t Kernel_Switch_Count = 0;
+static volatile uint8_t Kernel_Running = 0;
+
+static Kernel_Thread_t Kernel_Idle_Thread;
+static uint32_t Kernel_Idle_Stack[KERNEL_IDLE_STACK_WORDS] __attribute__((aligned(8)));
+/* Scratch PSP for the first switch, the context saved there is never resumed */
+static uint32_t Kernel_Boot_Stack[KERNEL_MIN_STACK_WORDS] __attribute__((aligned(8)));
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Kernel_Thread_Setup(Kernel_Thread_t * Thread, Kernel_Thread_Entry_t Entry, void * Arg,
+								uint8_t Priority, uint32_t * Stack, uint32_t Stack_Words);
+static void Kernel_Idle_Entry(void * Arg);
+static void Kernel_Thread_Exit(void);
+static void Kernel_Schedule(void);
+static void Kernel_Make_Ready(Kernel_Thread_t * Thread, uint8_t Wait_Result);
+static void Kernel_Make_Unready(Kernel_Thread_t * Thread);
+static Std_ReturnType_t Kernel_Wait(Kernel_List_t * List, uint32_t Timeout_Ticks, uint32_t Start_Tick, uint32_t * Irq_State);
+static void Kernel_Wake_First(Kernel_List_t * List);
+static void Kernel_List_Append(Kernel_List_t * List, Kernel_Thread_t * Thread);
+static void Kernel_List_Insert_By_Priority(Kernel_List_t * List, Kernel_Thread_t * Thread);
+static void Kernel_List_Remove(Kernel_Thread_t * Thread);
+static void Kernel_Delay_Link(Kernel_Thread_t * Thread);
+static void Kernel_Delay_Unlink(Kernel_Thread_t * Thread);
+static void Kernel_Copy(uint8_t * Destination, const uint8_t * Source, uint32_t Size);
+static uint32_t * Kernel_Switch_Stack(uint32_t * Stack_Pointer) __attribute__((used, noinline));
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Clears the ready queues, creates the idle thread and hooks
+ *         the kernel tick to the SysTick interrupt.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t Kernel_Init(void)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Prio_Idx = 0;
+
+	for(Prio_Idx = 0; Prio_Idx < KERNEL_MAX_PRIORITIES; Prio_Idx++)
+		{ Kernel_Ready[Prio_Idx].Head = NULL; }
+	Kernel_Ready_Bitmap = 0;
+	Kernel_Delay_Head = NULL;
+	Kernel_Current = NULL;
+	Kernel_Ticks = 0;
+	Kernel_Switch_Count = 0;
+	Kernel_Running = 0;
+
+	/* The idle thread keeps one ready thread at all times,
+	 * it is the only one allowed at the idle priority */
+	Kernel_Thread_Setup(&Kernel_Idle_Thread, Kernel_Idle_Entry, NULL, KERNEL_IDLE_PRIORITY,
+						Kernel_Idle_Stack, KERNEL_IDLE_STACK_WORDS);
+	Kernel_Make_Ready(&Kernel_Idle_Thread, E_OK);
+
+	retVal = SysTick_Register_TickHook(Kernel_Tick);
+	return retVal;
+}
+/**
+ * @brief  Creates a thread on a static stack, ready to run.
+ *         It can be called before or after Kernel_Start().
+ * @param  Thread: The thread control block.
+ * @param  Entry: The thread body.
+ * @param  Arg: Argument handed to the body.
+ * @param  Priority: 0 (highest) to KERNEL_IDLE_PRIORITY - 1.
+ * @param  Stack: The stack array.
+ * @param  Stack_Words: Size of the stack in words, at least KERNEL_MIN_STACK_WORDS.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Thread_Create(Kernel_Thread_t * Thread, Kernel_Thread_Entry_t Entry, void * Arg,
+									  uint8_t Priority, uint32_t * Stack, uint32_t Stack_Words)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Thread) || (NULL == Entry) || (NULL == Stack) ||
+	   (Priority >= KERNEL_IDLE_PRIORITY) || (Stack_Words < KERNEL_MIN_STACK_WORDS))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Kernel_Thread_Setup(Thread, Entry, Arg, Priority, Stack, Stack_Words);
+
+		/* Preempts the caller if it has a higher priority */
+		Irq_State = Core_Enter_Critical();
+		Kernel_Make_Ready(Thread, E_OK);
+		Kernel_Schedule();
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Sets the PendSV priority and switches to the highest priority thread.
+ *         The SysTick timebase should be started before, it drives the sleeps
+ *         and the timeouts. The caller (main) is never resumed.
+ */
+void Kernel_Start(void)
+{
+	CORE_DISABLE_IRQ();
+
+	/* 1. PendSV at the lowest priority */
+	NVIC_SetPriority(PendSV_IRQn, KERNEL_PENDSV_PRIORITY);
+
+	/* 2. The first PendSV saves a dummy context on the boot stack */
+	Core_Set_PSP((uint32_t)&Kernel_Boot_Stack[KERNEL_MIN_STACK_WORDS]);
+	Kernel_Current = NULL;
+	Kernel_Running = 1;
+	KERNEL_PEND_SWITCH();
+
+	CORE_DSB();
+	CORE_ISB();
+	CORE_ENABLE_IRQ();
+	while(1);
+}
+/**
+ * @brief  Hands the CPU to the next ready thread of the same priority.
+ */
+void Kernel_Yield(void)
+{
+	uint32_t Irq_State = Core_Enter_Critical();
+	Kernel_List_t * Ready_List = NULL;
+
+	if(NULL != Kernel_Current)
+	{
+		Ready_List = &Kernel_Ready[Kernel_Current->Priority];
+		if(Ready_List->Head == Kernel_Current)
+			{ Ready_List->Head = Kernel_Current->Next; }
+		Kernel_Schedule();
+	}
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Blocks the calling thread for a number of ticks.
+ * @param  Ticks: Ticks to sleep, 0 is the same as Kernel_Yield().
+ */
+void Kernel_Sleep(uint32_t Ticks)
+{
+	uint32_t Irq_State = 0;
+
+	if((0 == Ticks) || (NULL == Kernel_Current) || (Kernel_Current == &Kernel_Idle_Thread))
+	{
+		Kernel_Yield();
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Kernel_Make_Unready(Kernel_Current);
+		Kernel_Current->State = KERNEL_THREAD_SLEEPING;
+		Kernel_Current->Wake_Tick = Kernel_Ticks + Ticks;
+		Kernel_Delay_Link(Kernel_Current);
+		Kernel_Schedule();
+		/* The switch happens here */
+		Core_Exit_Critical(Irq_State);
+	}
+}
+/**
+ * @brief  Returns the kernel tick count.
+ * @return The current tick.
+ */
+uint32_t Kernel_Get_Ticks(void)
+{
+	return Kernel_Ticks;
+}
+/**
+ * @brief  Returns the running thread.
+ * @return The thread control block, NULL before Kernel_Start().
+ */
+Kernel_Thread_t * Kernel_Get_Current_Thread(void)
+{
+	return Kernel_Current;
+}
+/**
+ * @brief  Returns the number of context switches since the start.
+ * @return The context switch count.
+ */
+uint32_t Kernel_Get_Switch_Count(void)
+{
+	return Kernel_Switch_Count;
+}
+/**
+ * @brief  Initializes a counting semaphore.
+ * @param  Sem: The semaphore.
+ * @param  Initial_Count: Initial number of tokens.
+ * @param  Max_Count: Maximum number of tokens, 1 for a binary semaphore.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Sem_Init(Kernel_Sem_t * Sem, uint32_t Initial_Count, uint32_t Max_Count)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Sem) || (0 == Max_Count) || (Initial_Count > Max_Count))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Sem->Count = Initial_Count;
+		Sem->Max_Count = Max_Count;
+		Sem->Waiters.Head = NULL;
+	}
+	return retVal;
+}
+/**
+ * @brief  Takes a token, blocking until one is given or the timeout ends.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Sem: The semaphore.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Token taken
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Sem_Take(Kernel_Sem_t * Sem, uint32_t Timeout_Ticks)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+	uint32_t Start_Tick = 0;
+
+	if(NULL == Sem)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Start_Tick = Kernel_Ticks;
+		/* A woken waiter checks again, a higher priority thread may have taken the token */
+		while((0 == Sem->Count) && (E_OK == retVal))
+			{ retVal = Kernel_Wait(&Sem->Waiters, Timeout_Ticks, Start_Tick, &Irq_State); }
+		if(E_OK == retVal)
+			{ Sem->Count--; }
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Gives a token and wakes the highest priority waiter.
+ *         It can be called from an interrupt handler.
+ * @param  Sem: The semaphore.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Semaphore full or NULL
+ */
+Std_ReturnType_t Kernel_Sem_Give(Kernel_Sem_t * Sem)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if(NULL == Sem)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		if(Sem->Count >= Sem->Max_Count)
+		{
+			retVal = E_NOT_OK;
+		}
+		else
+		{
+			Sem->Count++;
+			Kernel_Wake_First(&Sem->Waiters);
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Initializes a message queue on a user buffer.
+ * @param  Queue: The queue.
+ * @param  Buffer: Storage of (Item_Size * Capacity) bytes.
+ * @param  Item_Size: Size of one item in bytes.
+ * @param  Capacity: Number of items.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Init(Kernel_Queue_t * Queue, void * Buffer, uint32_t Item_Size, uint32_t Capacity)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Queue) || (NULL == Buffer) || (0 == Item_Size) || (0 == Capacity))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Queue->Buffer = (uint8_t *)Buffer;
+		Queue->Item_Size = Item_Size;
+		Queue->Capacity = Capacity;
+		Queue->Count = 0;
+		Queue->Head = 0;
+		Queue->Tail = 0;
+		Queue->Senders.Head = NULL;
+		Queue->Receivers.Head = NULL;
+	}
+	return retVal;
+}
+/**
+ * @brief  Copies an item to the queue tail, blocking while the queue is full.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Queue: The queue.
+ * @param  Item: The item to copy.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Item queued
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Send(Kernel_Queue_t * Queue, const void * Item, uint32_t Timeout_Ticks)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+	uint32_t Start_Tick = 0;
+
+	if((NULL == Queue) || (NULL == Item))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Start_Tick = Kernel_Ticks;
+		while((Queue->Count == Queue->Capacity) && (E_OK == retVal))
+			{ retVal = Kernel_Wait(&Queue->Senders, Timeout_Ticks, Start_Tick, &Irq_State); }
+		if(E_OK == retVal)
+		{
+			Kernel_Copy(&Queue->Buffer[Queue->Tail * Queue->Item_Size], (const uint8_t *)Item, Queue->Item_Size);
+			Queue->Tail = (Queue->Tail + 1UL == Queue->Capacity) ? 0 : (Queue->Tail + 1UL);
+			Queue->Count++;
+			Kernel_Wake_First(&Queue->Receivers);
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Copies the item at the queue head out, blocking while the queue is empty.
+ *         Only KERNEL_NO_WAIT is allowed from an interrupt handler.
+ * @param  Queue: The queue.
+ * @param  Item: Returns the item.
+ * @param  Timeout_Ticks: KERNEL_NO_WAIT, a number of ticks or KERNEL_WAIT_FOREVER.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Item received
+ *         - E_NOT_OK: Timeout or invalid parameters
+ */
+Std_ReturnType_t Kernel_Queue_Receive(Kernel_Queue_t * Queue, void * Item, uint32_t Timeout_Ticks)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+	uint32_t Start_Tick = 0;
+
+	if((NULL == Queue) || (NULL == Item))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		Start_Tick = Kernel_Ticks;
+		while((0 == Queue->Count) && (E_OK == retVal))
+			{ retVal = Kernel_Wait(&Queue->Receivers, Timeout_Ticks, Start_Tick, &Irq_State); }
+		if(E_OK == retVal)
+		{
+			Kernel_Copy((uint8_t *)Item, &Queue->Buffer[Queue->Head * Queue->Item_Size], Queue->Item_Size);
+			Queue->Head = (Queue->Head + 1UL == Queue->Capacity) ? 0 : (Queue->Head + 1UL);
+			Queue->Count--;
+			Kernel_Wake_First(&Queue->Senders);
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Advances the kernel time by one tick, wakes the expired sleeps and
+ *         timeouts and rotates the running priority level.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void Kernel_Tick(void)
+{
+	Kernel_Thread_t * Thread = NULL;
+	Kernel_Thread_t * Next_Thread = NULL;
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	Kernel_Ticks++;
+
+	/* 1. Wake the sleeps and the waits that timed out. The signed
+	 *    compare also catches deadlines passed over by a missed tick. */
+	for(Thread = Kernel_Delay_Head; NULL != Thread; Thread = Next_Thread)
+	{
+		Next_Thread = Thread->Delay_Next;
+		if((int32_t)(Kernel_Ticks - Thread->Wake_Tick) >= 0)
+			{ Kernel_Make_Ready(Thread, E_NOT_OK); }
+	}
+
+#if KERNEL_TIME_SLICE_STATE == KERNEL_TIME_SLICE_ENABLED
+	/* 2. Round-robin inside the running priority level */
+	if((NULL != Kernel_Current) && (KERNEL_THREAD_READY == Kernel_Current->State) &&
+	   (Kernel_Ready[Kernel_Current->Priority].Head == Kernel_Current))
+		{ Kernel_Ready[Kernel_Current->Priority].Head = Kernel_Current->Next; }
+#endif
+
+	Kernel_Schedule();
+	Core_Exit_Critical(Irq_State);
+}
+/**
+ * @brief  Saves the context of the running thread and restores the context
+ *         of the highest priority ready thread.
+ *         R4-R11, EXC_RETURN and, when the thread used the FPU (EXC_RETURN bit 4
+ *         cleared), S16-S31 are pushed on the thread stack. Pushing S16-S31 also
+ *         triggers the lazy stacking of S0-S15 reserved by the hardware.
+ */
+#if defined(__arm__)
+void PendSV_Handler(void) __attribute__((naked));
+void PendSV_Handler(void)
+{
+	__asm volatile
+	(
+		"	mrs r0, psp						\n"
+		"	isb								\n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+		"	tst lr, #0x10					\n"
+		"	it eq							\n"
+		"	vstmdbeq r0!, {s16-s31}			\n"
+#endif
+		"	stmdb r0!, {r4-r11, lr}			\n"
+		"	cpsid i							\n"
+		"	bl Kernel_Switch_Stack			\n"
+		"	cpsie i							\n"
+		"	ldmia r0!, {r4-r11, lr}			\n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+		"	tst lr, #0x10					\n"
+		"	it eq							\n"
+		"	vldmiaeq r0!, {s16-s31}			\n"
+#endif
+		"	msr psp, r0						\n"
+		"	isb								\n"
+		"	bx lr							\n"
+	);
+}
+#else
+/* Host build (Host/): Host/Port switches the host contexts of the threads,
+ * their stacks keep the initial frame only */
+void Host_Context_Switch(uint32_t * From_Stack, uint32_t * To_Stack);
+void PendSV_Handler(void)
+{
+	uint32_t * From_Stack = (NULL != Kernel_Current) ? Kernel_Current->Stack_Pointer : NULL;
+	Host_Context_Switch(From_Stack, Kernel_Switch_Stack(From_Stack));
+}
+#endif
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Kernel_Thread_Setup(Kernel_Thread_t * Thread, Kernel_Thread_Entry_t Entry, void * Arg,
+								uint8_t Priority, uint32_t * Stack, uint32_t Stack_Words)
+{
+	uint32_t * Stack_Pointer = NULL;
+	uint32_t Reg_Idx = 0;
+
+	/* 1. AAPCS wants an 8-byte aligned stack on entry */
+	Stack_Pointer = (uint32_t *)((uint32_t)(Stack + Stack_Words) & ~7UL);
+
+	/* 2. Exception frame popped by the hardware on the first switch */
+	*(--Stack_Pointer) = KERNEL_INITIAL_XPSR;
+	*(--Stack_Pointer) = (uint32_t)Entry & ~1UL;		/* PC */
+	*(--Stack_Pointer) = (uint32_t)Kernel_Thread_Exit;	/* LR */
+	for(Reg_Idx = 0; Reg_Idx < 4U; Reg_Idx++)
+		{ *(--Stack_Pointer) = 0; }				/* R12, R3, R2, R1 */
+	*(--Stack_Pointer) = (uint32_t)Arg;			/* R0 */
+
+	/* 3. Frame popped by PendSV_Handler: R4..R11 then EXC_RETURN */
+	*(--Stack_Pointer) = KERNEL_INITIAL_EXC_RETURN;
+	for(Reg_Idx = 0; Reg_Idx < 8U; Reg_Idx++)
+		{ *(--Stack_Pointer) = 0; }
+
+	Thread->Stack_Pointer = Stack_Pointer;
+	Thread->Stack_Base = Stack;
+	Thread->Stack_Words = Stack_Words;
+	Thread->Priority = Priority;
+	Thread->Next = NULL;
+	Thread->Prev = NULL;
+	Thread->List = NULL;
+	Thread->Delay_Next = NULL;
+	Thread->Delay_Prev = NULL;
+	Thread->Delayed = 0;
+	Thread->State = KERNEL_THREAD_READY;
+	Thread->Wait_Result = E_OK;
+}
+
+static void Kernel_Idle_Entry(void * Arg)
+{
+	(void)Arg;
+	while(1)
+		{ CORE_WFI(); }
+}
+
+static void Kernel_Thread_Exit(void)
+{
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	Kernel_Make_Unready(Kernel_Current);
+	Kernel_Current->State = KERNEL_THREAD_TERMINATED;
+	Kernel_Schedule();
+	Core_Exit_Critical(Irq_State);
+	while(1);
+}
+
+/* Called with the interrupts masked */
+static void Kernel_Schedule(void)
+{
+	if(Kernel_Running &&
+	   (Kernel_Ready[Core_CLZ(Kernel_Ready_Bitmap)].Head != Kernel_Current))
+		{ KERNEL_PEND_SWITCH(); }
+}
+
+/* Called from PendSV_Handler with the interrupts masked */
+static uint32_t * Kernel_Switch_Stack(uint32_t * Stack_Pointer)
+{
+	if(NULL != Kernel_Current)
+		{ Kernel_Current->Stack_Pointer = Stack_Pointer; }
+	/* The idle thread keeps the bitmap non-zero */
+	Kernel_Current = Kernel_Ready[Core_CLZ(Kernel_Ready_Bitmap)].Head;
+	Kernel_Switch_Count++;
+	return Kernel_Current->Stack_Pointer;
+}
+
+static void Kernel_Make_Ready(Kernel_Thread_t * Thread, uint8_t Wait_Result)
+{
+	if(NULL != Thread->List)
+		{ Kernel_List_Remove(Thread); }
+	if(Thread->Delayed)
+		{ Kernel_Delay_Unlink(Thread); }
+	Thread->State = KERNEL_THREAD_READY;
+	Thread->Wait_Result = Wait_Result;
+	Kernel_List_Append(&Kernel_Ready[Thread->Priority], Thread);
+	Kernel_Ready_Bitmap |= KERNEL_PRIORITY_BIT(Thread->Priority);
+}
+
+static void Kernel_Make_Unready(Kernel_Thread_t * Thread)
+{
+	Kernel_List_Remove(Thread);
+	if(NULL == Kernel_Ready[Thread->Priority].Head)
+		{ Kernel_Ready_Bitmap &= ~KERNEL_PRIORITY_BIT(Thread->Priority); }
+}
+
+/* Called with the interrupts masked, returns with the interrupts masked */
+static Std_ReturnType_t Kernel_Wait(Kernel_List_t * List, uint32_t Timeout_Ticks, uint32_t Start_Tick, uint32_t * Irq_State)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	/* 1. Handlers, masked callers and expired timeouts cannot block */
+	if((KERNEL_NO_WAIT == Timeout_Ticks) || (0 != Core_Get_IPSR()) || (0 != *Irq_State) ||
+	   (0 == Kernel_Running) || (Kernel_Current == &Kernel_Idle_Thread) ||
+	   ((KERNEL_WAIT_FOREVER != Timeout_Ticks) && ((Kernel_Ticks - Start_Tick) >= Timeout_Ticks)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		/* 2. Move the thread from its ready queue to the wait list */
+		Kernel_Make_Unready(Kernel_Current);
+		Kernel_List_Insert_By_Priority(List, Kernel_Current);
+		Kernel_Current->State = KERNEL_THREAD_BLOCKED;
+		if(KERNEL_WAIT_FOREVER != Timeout_Ticks)
+		{
+			Kernel_Current->Wake_Tick = Start_Tick + Timeout_Ticks;
+			Kernel_Delay_Link(Kernel_Current);
+		}
+		Kernel_Schedule();
+
+		/* 3. The switch happens here, the thread resumes once woken */
+		Core_Exit_Critical(*Irq_State);
+		*Irq_State = Core_Enter_Critical();
+		retVal = Kernel_Current->Wait_Result;
+	}
+	return retVal;
+}
+
+/* Called with the interrupts masked */
+static void Kernel_Wake_First(Kernel_List_t * List)
+{
+	if(NULL != List->Head)
+	{
+		Kernel_Make_Ready(List->Head, E_OK);
+		Kernel_Schedule();
+	}
+}
+
+static void Kernel_List_Append(Kernel_List_t * List, Kernel_Thread_t * Thread)
+{
+	if(NULL == List->Head)
+	{
+		Thread->Next = Thread;
+		Thread->Prev = Thread;
+		List->Head = Thread;
+	}
+	else
+	{
+		/* The tail is Head->Prev */
+		Thread->Next = List->Head;
+		Thread->Prev = List->Head->Prev;
+		List->Head->Prev->Next = Thread;
+		List->Head->Prev = Thread;
+	}
+	Thread->List = List;
+}
+
+static void Kernel_List_Insert_By_Priority(Kernel_List_t * List, Kernel_Thread_t * Thread)
+{
+	Kernel_Thread_t * Position = List->Head;
+
+	/* Behind the waiters of the same or a higher priority */
+	Kernel_List_Append(List, Thread);
+	if(NULL != Position)
+	{
+		do
+		{
+			if(Position->Priority > Thread->Priority)
+			{
+				Kernel_List_Remove(Thread);
+				Thread->Next = Position;
+				Thread->Prev = Position->Prev;
+				Position->Prev->Next = Thread;
+				Position->Prev = Thread;
+				Thread->List = List;
+				if(Position == List->Head)
+					{ List->Head = Thread; }
+				break;
+			}
+			Position = Position->Next;
+		} while(Position != List->Head);
+	}
+}
+
+static void Kernel_List_Remove(Kernel_Thread_t * Thread)
+{
+	Kernel_List_t * List = Thread->List;
+
+	if(Thread->Next == Thread)
+	{
+		List->Head = NULL;
+	}
+	else
+	{
+		Thread->Prev->Next = Thread->Next;
+		Thread->Next->Prev = Thread->Prev;
+		if(List->Head == Thread)
+			{ List->Head = Thread->Next; }
+	}
+	Thread->Next = NULL;
+	Thread->Prev = NULL;
+	Thread->List = NULL;
+}
+
+static void Kernel_Delay_Link(Kernel_Thread_t * Thread)
+{
+	Thread->Delay_Prev = NULL;
+	Thread->Delay_Next = Kernel_Delay_Head;
+	if(NULL != Kernel_Delay_Head)
+		{ Kernel_Delay_Head->Delay_Prev = Thread; }
+	Kernel_Delay_Head = Thread;
+	Thread->Delayed = 1;
+}
+
+static void Kernel_Delay_Unlink(Kernel_Thread_t * Thread)
+{
+	if(NULL != Thread->Delay_Prev)
+		{ Thread->Delay_Prev->Delay_Next = Thread->Delay_Next; }
+	else
+		{ Kernel_Delay_Head = Thread->Delay_Next; }
+	if(NULL != Thread->Delay_Next)
+		{ Thread->Delay_Next->Delay_Prev = Thread->Delay_Prev; }
+	Thread->Delay_Next = NULL;
+	Thread->Delay_Prev = NULL;
+	Thread->Delayed = 0;
+}
+
+static void Kernel_Copy(uint8_t * Destination, const uint8_t * Source, uint32_t Size)
+{
+	while(Size--)
+		{ *Destination++ = *Source++; }
+}
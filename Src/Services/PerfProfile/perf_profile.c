@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ * @file           : perf_profile.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Performance Profiles Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/PerfProfile/perf_profile.h"
+#include "MCAL/FLASH/flash.h"
+#include "CortexM4/Core/Core.h"
+#include "CortexM4/SysTick/SysTick.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define PERF_PWR_CR_VOS_POS				14UL
+#define PERF_PWR_CR_VOS_MASK			(0x3UL << PERF_PWR_CR_VOS_POS)
+#define PERF_PWR_CSR_VOSRDY_POS			14UL
+#define PERF_PWR_VOS_SCALE3				0x1UL
+#define PERF_PWR_VOS_SCALE2				0x2UL
+/*---------------  Section: Global Variables --------------- */
+const Perf_Profile_t Perf_Profile_Burst =
+{
+	.Name = "burst",
+	.Clock =
+	{
+		.Oscillator_Configurations = { RCC_HSE_OFF, RCC_HSI_ON, RCC_PLLI2S_OFF },
+		.Clock_Source = RCC_CLOCK_SOURCE_PLL,
+		.AHB_Prescaler = SYSTEM_CLOCK_NOT_DIVIDED,
+		.APB1_Prescaler = APB1_CLOCK_DIVIDED_BY_2,
+		.APB2_Prescaler = APB2_CLOCK_NOT_DIVIDED,
+		.PLL_Configurations = { RCC_PLL_SOURE_HSI, 168, 8, 7, RCC_PLL_P_DIVIDE_BY_4 }
+	}
+};
+RCC_PLL_STATIC_ASSERT(RCC_HSI_VALUE, 8, 168, 4, 7);
+
+const Perf_Profile_t Perf_Profile_Idle =
+{
+	.Name = "idle",
+	.Clock =
+	{
+		.Oscillator_Configurations = { RCC_HSE_OFF, RCC_HSI_ON, RCC_PLLI2S_OFF },
+		.Clock_Source = RCC_CLOCK_SOURCE_HSI,
+		.AHB_Prescaler = SYSTEM_CLOCK_NOT_DIVIDED,
+		.APB1_Prescaler = APB1_CLOCK_NOT_DIVIDED,
+		.APB2_Prescaler = APB2_CLOCK_NOT_DIVIDED,
+		.PLL_Configurations = { RCC_PLL_SOURE_HSI, 168, 8, 7, RCC_PLL_P_DIVIDE_BY_4 }
+	}
+};
+/*---------------  Section: Static Global Variables --------------- */
+static const Perf_Profile_t * Perf_Profile_Current = NULL;
+static Perf_Profile_Listener_t Perf_Profile_Listeners[PERF_PROFILE_MAX_LISTENERS];
+static uint8_t Perf_Profile_Listeners_Count = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Perf_Profile_Set_Voltage_Scale(uint32_t SYSCLK_Freq);
+static Std_ReturnType_t Perf_Profile_Wait_Voltage(void);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Switches to a profile in a safe order:
+ * 		   1. raises the FLASH wait states if the new HCLK needs more,
+ * 		   2. parks SYSCLK on HSI and stops the PLL,
+ * 		   3. sets the voltage scaling of the new SYSCLK,
+ * 		   4. applies the clock tree, waiting for each source to be ready,
+ * 		   5. lowers the FLASH wait states if the new HCLK needs less,
+ * 		   6. rescales the SysTick and calls the listeners.
+ * 		   Call it from thread mode, the interrupts are masked during the switch.
+ * @param  Profile: The profile.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Invalid profile, or a source did not start (the system stays on HSI)
+ */
+Std_ReturnType_t Perf_Profile_Switch(const Perf_Profile_t * Profile)
+{
+	Std_ReturnType_t retVal = E_OK;
+	RCC_Clock_Freqs_t Old_Freqs;
+	RCC_Clock_Freqs_t New_Freqs;
+	uint32_t Old_Wait_States = 0;
+	uint32_t New_Wait_States = 0;
+	uint32_t Irq_State = 0;
+	uint8_t Listener_Idx = 0;
+
+	if((NULL == Profile) || (E_OK != RCC_Compute_Clock_Freqs(&Profile->Clock, &New_Freqs)))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		(void)RCC_Get_Clock_Freqs(&Old_Freqs);
+		Old_Wait_States = Flash_Get_Latency();
+		New_Wait_States = (New_Freqs.HCLK - 1UL) / PERF_PROFILE_FLASH_WS_STEP_HZ;
+
+		Irq_State = Core_Enter_Critical();
+
+		/* 1. The FLASH must be slow enough before the core speeds up */
+		if(New_Wait_States > Old_Wait_States)
+			{ retVal |= Flash_Set_Latency(New_Wait_States); }
+
+		/* 2. The PLL factors and the voltage scaling only change with the PLL off */
+		if(E_OK == retVal)
+			{ retVal |= RCC_PLL_Stop(); }
+
+		/* 3. Voltage scaling of the new SYSCLK, applied when the PLL starts */
+		if(E_OK == retVal)
+			{ Perf_Profile_Set_Voltage_Scale(New_Freqs.SYSCLK); }
+
+		/* 4. The new tree, RCC_Init() waits for the oscillators, the PLL and the switch */
+		if(E_OK == retVal)
+			{ retVal |= RCC_Init(&Profile->Clock); }
+		if((E_OK == retVal) && (RCC_CLOCK_SOURCE_PLL == Profile->Clock.Clock_Source))
+			{ retVal |= Perf_Profile_Wait_Voltage(); }
+
+		/* 5. Fewer wait states only once the core runs slower */
+		if((E_OK == retVal) && (New_Wait_States < Old_Wait_States))
+			{ retVal |= Flash_Set_Latency(New_Wait_States); }
+
+		/* 6. Keep the tick period in time */
+		(void)RCC_Get_Clock_Freqs(&New_Freqs);
+		(void)SysTick_Rescale(Old_Freqs.HCLK, New_Freqs.HCLK);
+		if(E_OK == retVal)
+			{ Perf_Profile_Current = Profile; }
+
+		Core_Exit_Critical(Irq_State);
+
+		/* 7. Tell the drivers, also after a failed switch that left the system on HSI */
+		if((Old_Freqs.SYSCLK != New_Freqs.SYSCLK) || (Old_Freqs.HCLK != New_Freqs.HCLK) ||
+		   (Old_Freqs.PCLK1 != New_Freqs.PCLK1) || (Old_Freqs.PCLK2 != New_Freqs.PCLK2))
+		{
+			for(Listener_Idx = 0; Listener_Idx < Perf_Profile_Listeners_Count; Listener_Idx++)
+				{ Perf_Profile_Listeners[Listener_Idx](&Old_Freqs, &New_Freqs); }
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Returns the profile in use, NULL before the first switch.
+ */
+const Perf_Profile_t * Perf_Profile_Get_Current(void)
+{
+	return Perf_Profile_Current;
+}
+/**
+ * @brief  Registers a clock-change listener.
+ * @param  Listener: The listener.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL listener or all the PERF_PROFILE_MAX_LISTENERS slots are used
+ */
+Std_ReturnType_t Perf_Profile_Register_Listener(Perf_Profile_Listener_t Listener)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((NULL == Listener) || (Perf_Profile_Listeners_Count >= PERF_PROFILE_MAX_LISTENERS))
+		{ retVal = E_NOT_OK; }
+	else
+		{ Perf_Profile_Listeners[Perf_Profile_Listeners_Count++] = Listener; }
+
+	return retVal;
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static void Perf_Profile_Set_Voltage_Scale(uint32_t SYSCLK_Freq)
+{
+	uint32_t Scale = (SYSCLK_Freq > PERF_PROFILE_VOS_SCALE3_MAX_HZ) ? PERF_PWR_VOS_SCALE2 : PERF_PWR_VOS_SCALE3;
+
+	/* The VOS field keeps its value with the PWR clock off */
+	(void)RCC_Periph_Clock_Acquire(RCC_PERIPH_PWR);
+	PWR->CR = (PWR->CR & ~PERF_PWR_CR_VOS_MASK) | (Scale << PERF_PWR_CR_VOS_POS);
+	(void)RCC_Periph_Clock_Release(RCC_PERIPH_PWR);
+}
+
+static Std_ReturnType_t Perf_Profile_Wait_Voltage(void)
+{
+	Std_ReturnType_t retVal = E_NOT_OK;
+	uint32_t Polls = 0;
+
+	(void)RCC_Periph_Clock_Acquire(RCC_PERIPH_PWR);
+	for(Polls = 0; (Polls < RCC_READY_TIMEOUT) && (E_NOT_OK == retVal); Polls++)
+	{
+		if(READ_BIT(PWR->CSR, PERF_PWR_CSR_VOSRDY_POS))
+			{ retVal = E_OK; }
+	}
+	(void)RCC_Periph_Clock_Release(RCC_PERIPH_PWR);
+	return retVal;
+}
@@ -0,0 +1,295 @@
+/**
+ ******************************************************************************
+ * @file           : ring_buffer.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Lock-Free Ring Buffer Service Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/RingBuffer/ring_buffer.h"
+#if !defined(RING_BUFFER_HOST)
+#include "CortexM4/Core/Core.h"
+#endif
+/* --------------- Section: Macro Declarations --------------- */
+#define RING_INDEX_MASK				0xFFFFUL
+#define RING_WRITERS_POS			16UL
+#define RING_WRITER_ONE				(1UL << RING_WRITERS_POS)
+/* --------------- Section: Macro Functions Declarations --------------- */
+#define RING_DISTANCE(TO, FROM)		(((TO) - (FROM)) & RING_INDEX_MASK)
+#define RING_SLOT(RING, INDEX)		(&(RING)->Buffer[((INDEX) & ((RING)->Capacity - 1UL)) * (RING)->Elem_Size])
+/*---------------  Section: Helper Function Declarations --------------- */
+static uint32_t Ring_Load(Ring_Atomic_t * Address);
+static void Ring_Store(Ring_Atomic_t * Address, uint32_t Value);
+static uint32_t Ring_Compare_Exchange(Ring_Atomic_t * Address, uint32_t Expected, uint32_t Desired);
+static void Ring_Add(Ring_Atomic_t * Address, uint32_t Value);
+static void Ring_Copy_In(Ring_Buffer_t * Ring, uint32_t Index, const uint8_t * Data, uint32_t Count);
+static void Ring_Copy_Out(Ring_Buffer_t * Ring, uint32_t Index, uint8_t * Data, uint32_t Count);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Initializes an empty ring.
+ * @param  Ring: The ring.
+ * @param  Buffer: Storage of Capacity * Elem_Size bytes.
+ * @param  Elem_Size: Size of one element in bytes.
+ * @param  Capacity: Number of elements, a power of two up to RING_BUFFER_MAX_CAPACITY.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer or invalid size
+ */
+Std_ReturnType_t Ring_Init(Ring_Buffer_t * Ring, void * Buffer, uint32_t Elem_Size, uint32_t Capacity)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if((NULL == Ring) || (NULL == Buffer) || (0 == Elem_Size) || (0 == Capacity) ||
+	   (Capacity > RING_BUFFER_MAX_CAPACITY) || (0 != (Capacity & (Capacity - 1UL))))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Ring->Buffer = (uint8_t *)Buffer;
+		Ring->Elem_Size = Elem_Size;
+		Ring->Capacity = Capacity;
+		Ring_Store(&Ring->Reserve, 0);
+		Ring_Store(&Ring->Head, 0);
+		Ring_Store(&Ring->Tail, 0);
+		Ring_Store(&Ring->Dropped, 0);
+	}
+	return retVal;
+}
+/**
+ * @brief  SPSC: pushes as many elements as fit, wait-free.
+ * @param  Ring: The ring.
+ * @param  Data: The elements.
+ * @param  Count: Number of elements.
+ * @return Number of elements pushed, the rest is counted as dropped.
+ */
+uint32_t Ring_SPSC_Push(Ring_Buffer_t * Ring, const void * Data, uint32_t Count)
+{
+	uint32_t Head = Ring_Load(&Ring->Head);
+	uint32_t Free = Ring->Capacity - RING_DISTANCE(Head, Ring_Load(&Ring->Tail));
+	uint32_t Pushed = (Count < Free) ? Count : Free;
+
+	Ring_Copy_In(Ring, Head, (const uint8_t *)Data, Pushed);
+	Ring_Store(&Ring->Head, (Head + Pushed) & RING_INDEX_MASK);
+	if(Pushed != Count)
+		{ Ring_Add(&Ring->Dropped, Count - Pushed); }
+
+	return Pushed;
+}
+/**
+ * @brief  SPSC: gets the contiguous free span to be filled in place.
+ * @param  Ring: The ring.
+ * @param  Span: Returns the address of the first free element.
+ * @return Number of free contiguous elements, may be less than the free total at the wrap.
+ */
+uint32_t Ring_SPSC_Write_Span(Ring_Buffer_t * Ring, void ** Span)
+{
+	uint32_t Head = Ring_Load(&Ring->Head);
+	uint32_t Free = Ring->Capacity - RING_DISTANCE(Head, Ring_Load(&Ring->Tail));
+	uint32_t To_End = Ring->Capacity - (Head & (Ring->Capacity - 1UL));
+
+	*Span = RING_SLOT(Ring, Head);
+	return (Free < To_End) ? Free : To_End;
+}
+/**
+ * @brief  SPSC: publishes the elements filled in the span.
+ * @param  Ring: The ring.
+ * @param  Count: Number of elements filled, at most the span size.
+ */
+void Ring_SPSC_Write_Commit(Ring_Buffer_t * Ring, uint32_t Count)
+{
+	Ring_Store(&Ring->Head, (Ring_Load(&Ring->Head) + Count) & RING_INDEX_MASK);
+}
+/**
+ * @brief  MPSC: pushes all the elements or none, lock-free, from any interrupt.
+ * @param  Ring: The ring.
+ * @param  Data: The elements.
+ * @param  Count: Number of elements.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: Not enough room (counted as dropped)
+ */
+Std_ReturnType_t Ring_MPSC_Push(Ring_Buffer_t * Ring, const void * Data, uint32_t Count)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t State = 0;
+	uint32_t Index = 0;
+	uint32_t Head = 0;
+
+	/* 1. Reserve the elements and register as a writer in one exclusive word */
+	do
+	{
+		State = Ring_Load(&Ring->Reserve);
+		Index = State & RING_INDEX_MASK;
+		if((Ring->Capacity - RING_DISTANCE(Index, Ring_Load(&Ring->Tail))) < Count)
+		{
+			retVal = E_NOT_OK;
+			break;
+		}
+	} while(0 == Ring_Compare_Exchange(&Ring->Reserve, State,
+									   ((State + RING_WRITER_ONE) & ~RING_INDEX_MASK) | ((Index + Count) & RING_INDEX_MASK)));
+
+	if(E_NOT_OK == retVal)
+	{
+		Ring_Add(&Ring->Dropped, Count);
+	}
+	else
+	{
+		/* 2. Fill them, a preempting writer reserves after them */
+		Ring_Copy_In(Ring, Index, (const uint8_t *)Data, Count);
+
+		/* 3. Leave, the last writer out publishes everything reserved so far */
+		do
+		{
+			State = Ring_Load(&Ring->Reserve);
+		} while(0 == Ring_Compare_Exchange(&Ring->Reserve, State, State - RING_WRITER_ONE));
+
+		if(0 == ((State - RING_WRITER_ONE) >> RING_WRITERS_POS))
+		{
+			/* Only move forward, a late publisher must not hide newer elements */
+			Index = State & RING_INDEX_MASK;
+			do
+			{
+				Head = Ring_Load(&Ring->Head);
+				if((0 == RING_DISTANCE(Index, Head)) || (RING_DISTANCE(Index, Head) > Ring->Capacity))
+					{ break; }
+			} while(0 == Ring_Compare_Exchange(&Ring->Head, Head, Index));
+		}
+	}
+	return retVal;
+}
+/**
+ * @brief  Pops up to Count elements.
+ * @param  Ring: The ring.
+ * @param  Data: Receives the elements.
+ * @param  Count: Most elements to pop.
+ * @return Number of elements popped.
+ */
+uint32_t Ring_Pop(Ring_Buffer_t * Ring, void * Data, uint32_t Count)
+{
+	uint32_t Tail = Ring_Load(&Ring->Tail);
+	uint32_t Used = RING_DISTANCE(Ring_Load(&Ring->Head), Tail);
+	uint32_t Popped = (Count < Used) ? Count : Used;
+
+	Ring_Copy_Out(Ring, Tail, (uint8_t *)Data, Popped);
+	Ring_Store(&Ring->Tail, (Tail + Popped) & RING_INDEX_MASK);
+
+	return Popped;
+}
+/**
+ * @brief  Gets the contiguous span of elements to be read in place.
+ * @param  Ring: The ring.
+ * @param  Span: Returns the address of the oldest element.
+ * @return Number of contiguous elements, may be less than the total at the wrap.
+ */
+uint32_t Ring_Read_Span(Ring_Buffer_t * Ring, const void ** Span)
+{
+	uint32_t Tail = Ring_Load(&Ring->Tail);
+	uint32_t Used = RING_DISTANCE(Ring_Load(&Ring->Head), Tail);
+	uint32_t To_End = Ring->Capacity - (Tail & (Ring->Capacity - 1UL));
+
+	*Span = RING_SLOT(Ring, Tail);
+	return (Used < To_End) ? Used : To_End;
+}
+/**
+ * @brief  Frees the elements read in the span.
+ * @param  Ring: The ring.
+ * @param  Count: Number of elements read, at most the span size.
+ */
+void Ring_Read_Release(Ring_Buffer_t * Ring, uint32_t Count)
+{
+	Ring_Store(&Ring->Tail, (Ring_Load(&Ring->Tail) + Count) & RING_INDEX_MASK);
+}
+/**
+ * @brief  Returns the number of elements ready to be read.
+ * @param  Ring: The ring.
+ */
+uint32_t Ring_Count(Ring_Buffer_t * Ring)
+{
+	return RING_DISTANCE(Ring_Load(&Ring->Head), Ring_Load(&Ring->Tail));
+}
+/**
+ * @brief  Returns the number of elements dropped since the initialization.
+ * @param  Ring: The ring.
+ */
+uint32_t Ring_Get_Dropped(Ring_Buffer_t * Ring)
+{
+	return Ring_Load(&Ring->Dropped);
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+/* Acquire load: what the other side wrote before publishing is visible after it */
+static uint32_t Ring_Load(Ring_Atomic_t * Address)
+{
+#if defined(RING_BUFFER_HOST)
+	return atomic_load_explicit(Address, memory_order_acquire);
+#else
+	uint32_t Value = *Address;
+	CORE_DMB();
+	return Value;
+#endif
+}
+/* Release store: publishes the elements copied before it */
+static void Ring_Store(Ring_Atomic_t * Address, uint32_t Value)
+{
+#if defined(RING_BUFFER_HOST)
+	atomic_store_explicit(Address, Value, memory_order_release);
+#else
+	CORE_DMB();
+	*Address = Value;
+#endif
+}
+/* Returns 1 if Address held Expected and now holds Desired, 0 to retry */
+static uint32_t Ring_Compare_Exchange(Ring_Atomic_t * Address, uint32_t Expected, uint32_t Desired)
+{
+#if defined(RING_BUFFER_HOST)
+	return atomic_compare_exchange_weak_explicit(Address, &Expected, Desired,
+												 memory_order_acq_rel, memory_order_acquire) ? 1UL : 0UL;
+#else
+	uint32_t Exchanged = 0;
+
+	CORE_DMB();
+	if(Core_LDREXW(Address) != Expected)
+		{ Core_CLREX(); }
+	else
+		{ Exchanged = (0 == Core_STREXW(Desired, Address)) ? 1UL : 0UL; }
+	CORE_DMB();
+	return Exchanged;
+#endif
+}
+
+static void Ring_Add(Ring_Atomic_t * Address, uint32_t Value)
+{
+	uint32_t Current = 0;
+
+	do
+	{
+		Current = Ring_Load(Address);
+	} while(0 == Ring_Compare_Exchange(Address, Current, Current + Value));
+}
+
+static void Ring_Copy_In(Ring_Buffer_t * Ring, uint32_t Index, const uint8_t * Data, uint32_t Count)
+{
+	uint32_t Offset = (Index & (Ring->Capacity - 1UL)) * Ring->Elem_Size;
+	uint32_t Size = Ring->Capacity * Ring->Elem_Size;
+	uint32_t Byte_Idx = 0;
+
+	for(Byte_Idx = 0; Byte_Idx < (Count * Ring->Elem_Size); Byte_Idx++)
+	{
+		Ring->Buffer[Offset] = Data[Byte_Idx];
+		Offset = (Offset + 1UL < Size) ? (Offset + 1UL) : 0;
+	}
+}
+
+static void Ring_Copy_Out(Ring_Buffer_t * Ring, uint32_t Index, uint8_t * Data, uint32_t Count)
+{
+	uint32_t Offset = (Index & (Ring->Capacity - 1UL)) * Ring->Elem_Size;
+	uint32_t Size = Ring->Capacity * Ring->Elem_Size;
+	uint32_t Byte_Idx = 0;
+
+	for(Byte_Idx = 0; Byte_Idx < (Count * Ring->Elem_Size); Byte_Idx++)
+	{
+		Data[Byte_Idx] = Ring->Buffer[Offset];
+		Offset = (Offset + 1UL < Size) ? (Offset + 1UL) : 0;
+	}
+}
@@ -0,0 +1,362 @@
+/**
+ ******************************************************************************
+ * @file           : sw_timer.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Software Timers Service (Hashed Timing Wheel) Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Services/SwTimer/sw_timer.h"
+#include "CortexM4/SysTick/SysTick.h"
+#include "CortexM4/Core/Core.h"
+/*---------------  Section: Static Global Variables --------------- */
+
+/* Timers are hashed by (Expiry % SW_TIMER_WHEEL_SIZE), a tick only visits one slot */
+static SwTimer_List_t SwTimer_Wheel[SW_TIMER_WHEEL_SIZE];
+/* Timers expired by the current tick, waiting for their callback */
+static SwTimer_List_t SwTimer_Expired;
+static volatile uint32_t SwTimer_Now = 0;
+/* Bumped on every start and tick, tells SwTimer_Idle() its deadline went stale */
+static volatile uint32_t SwTimer_Changes = 0;
+/*---------------  Section: Helper Function Declarations --------------- */
+static void SwTimer_Collect(void);
+static void SwTimer_Run_Expired(void);
+static inline __attribute__((always_inline)) void SwTimer_Link(SwTimer_List_t * List, SwTimer_t * Timer);
+static inline __attribute__((always_inline)) void SwTimer_Unlink(SwTimer_t * Timer);
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Clears the wheel and hooks the service to the SysTick interrupt.
+ *         The SysTick timebase must be started to make the timers run.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: No free SysTick hook
+ */
+Std_ReturnType_t SwTimer_Init(void)
+{
+	uint32_t Slot_Idx = 0;
+
+	for(Slot_Idx = 0; Slot_Idx < SW_TIMER_WHEEL_SIZE; Slot_Idx++)
+		{ SwTimer_Wheel[Slot_Idx].Head = NULL; }
+	SwTimer_Expired.Head = NULL;
+	SwTimer_Now = 0;
+
+	return SysTick_Register_TickHook(SwTimer_Tick);
+}
+/**
+ * @brief  Prepares a timer object before its first start.
+ * @param  Timer: The timer object.
+ * @param  Callback: Function called on expiry.
+ * @param  Context: Argument handed to the callback.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or callback
+ */
+Std_ReturnType_t SwTimer_Create(SwTimer_t * Timer, SwTimer_Callback_t Callback, void * Context)
+{
+	Std_ReturnType_t retVal = E_OK;
+	if((NULL == Timer) || (NULL == Callback))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Timer->Next = NULL;
+		Timer->Prev = NULL;
+		Timer->List = NULL;
+		Timer->Expiry = 0;
+		Timer->Timeout = 0;
+		Timer->Period = 0;
+		Timer->Callback = Callback;
+		Timer->Context = Context;
+	}
+	return retVal;
+}
+/**
+ * @brief  Starts (or re-arms) a timer in O(1).
+ * @param  Timer: The timer object.
+ * @param  Timeout_Ticks: Ticks until the first expiry (0 is taken as 1).
+ * @param  Period_Ticks: Reload period after each expiry, 0 for a one-shot timer.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or timer not created
+ */
+Std_ReturnType_t SwTimer_Start(SwTimer_t * Timer, uint32_t Timeout_Ticks, uint32_t Period_Ticks)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Timer) || (NULL == Timer->Callback))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		if(0 == Timeout_Ticks)
+			{ Timeout_Ticks = 1; }
+
+		Irq_State = Core_Enter_Critical();
+		if(NULL != Timer->List)
+			{ SwTimer_Unlink(Timer); }
+		Timer->Timeout = Timeout_Ticks;
+		Timer->Period = Period_Ticks;
+		Timer->Expiry = SwTimer_Now + Timeout_Ticks;
+		SwTimer_Link(&SwTimer_Wheel[Timer->Expiry & SW_TIMER_WHEEL_MASK], Timer);
+		SwTimer_Changes++;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Stops a timer in O(1). Stopping a stopped timer is harmless.
+ * @param  Timer: The timer object.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer
+ */
+Std_ReturnType_t SwTimer_Stop(SwTimer_t * Timer)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if(NULL == Timer)
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		if(NULL != Timer->List)
+			{ SwTimer_Unlink(Timer); }
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Re-arms a timer with the timeout and period of its last start (e.g. watchdog kick).
+ * @param  Timer: The timer object.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL timer or timer never started
+ */
+Std_ReturnType_t SwTimer_Restart(SwTimer_t * Timer)
+{
+	Std_ReturnType_t retVal = E_OK;
+	uint32_t Irq_State = 0;
+
+	if((NULL == Timer) || (0 == Timer->Timeout))
+	{
+		retVal = E_NOT_OK;
+	}
+	else
+	{
+		Irq_State = Core_Enter_Critical();
+		if(NULL != Timer->List)
+			{ SwTimer_Unlink(Timer); }
+		Timer->Expiry = SwTimer_Now + Timer->Timeout;
+		SwTimer_Link(&SwTimer_Wheel[Timer->Expiry & SW_TIMER_WHEEL_MASK], Timer);
+		SwTimer_Changes++;
+		Core_Exit_Critical(Irq_State);
+	}
+	return retVal;
+}
+/**
+ * @brief  Tells whether a timer is running.
+ * @param  Timer: The timer object.
+ * @return 1 if the timer is armed, 0 otherwise.
+ */
+uint8_t SwTimer_IsActive(const SwTimer_t * Timer)
+{
+	return ((NULL != Timer) && (NULL != Timer->List)) ? 1 : 0;
+}
+/**
+ * @brief  Returns the tick count of the wheel.
+ * @return The current tick.
+ */
+uint32_t SwTimer_Get_Ticks(void)
+{
+	return SwTimer_Now;
+}
+/**
+ * @brief  Advances the wheel by one tick and runs the expired timers.
+ *         Called from the SysTick interrupt, exposed for other tick sources.
+ */
+void SwTimer_Tick(void)
+{
+	uint32_t Irq_State = Core_Enter_Critical();
+	SwTimer_Collect();
+	Core_Exit_Critical(Irq_State);
+
+	SwTimer_Run_Expired();
+}
+/**
+ * @brief  Returns the number of ticks until the earliest armed timer expires.
+ *         The wheel is walked one slot per critical section, a timer started
+ *         meanwhile by an interrupt may be missed.
+ * @return Ticks to the next expiry (at least 1), SW_TIMER_NO_EXPIRY if no timer is armed.
+ */
+uint32_t SwTimer_Get_Ticks_To_Next_Expiry(void)
+{
+	uint32_t Next_Expiry = SW_TIMER_NO_EXPIRY;
+	uint32_t Distance = 0;
+	uint32_t Slot_Idx = 0;
+	SwTimer_t * Timer = NULL;
+	uint32_t Irq_State = 0;
+
+	/* Walk the slots in expiry order, the first timer due within
+	 * this revolution is the earliest one. One slot per critical
+	 * section, so the interrupts are never masked for the whole wheel. */
+	for(Distance = 1; (Distance <= SW_TIMER_WHEEL_SIZE) && (SW_TIMER_NO_EXPIRY == Next_Expiry); Distance++)
+	{
+		Irq_State = Core_Enter_Critical();
+		Timer = SwTimer_Wheel[(SwTimer_Now + Distance) & SW_TIMER_WHEEL_MASK].Head;
+		for(; NULL != Timer; Timer = Timer->Next)
+		{
+			if((Timer->Expiry - SwTimer_Now) == Distance)
+				{ Next_Expiry = Distance; break; }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+
+	/* Only timers of later revolutions left: take the minimum */
+	for(Slot_Idx = 0; (Slot_Idx < SW_TIMER_WHEEL_SIZE) && (SW_TIMER_NO_EXPIRY == Next_Expiry); Slot_Idx++)
+	{
+		Irq_State = Core_Enter_Critical();
+		for(Timer = SwTimer_Wheel[Slot_Idx].Head; NULL != Timer; Timer = Timer->Next)
+		{
+			if((Timer->Expiry - SwTimer_Now) < Next_Expiry)
+				{ Next_Expiry = Timer->Expiry - SwTimer_Now; }
+		}
+		Core_Exit_Critical(Irq_State);
+	}
+	return Next_Expiry;
+}
+/**
+ * @brief  Catches up with ticks that were not delivered by the tick source
+ *         (e.g. while sleeping tickless), expiring the timers due in between.
+ *         The callbacks run with interrupts unmasked, after the catch up.
+ * @param  Ticks: Number of missed ticks.
+ */
+void SwTimer_Advance(uint32_t Ticks)
+{
+	uint32_t Irq_State = 0;
+
+	while(Ticks--)
+	{
+		Irq_State = Core_Enter_Critical();
+		SwTimer_Collect();
+		Core_Exit_Critical(Irq_State);
+	}
+	SwTimer_Run_Expired();
+}
+/**
+ * @brief  Idles the CPU until the next timer deadline or any interrupt.
+ *         SysTick is reprogrammed so the core is not woken on every tick,
+ *         then the wheel is corrected for the time slept. While another
+ *         SysTick consumer is registered it is a plain WFI.
+ *         Call it from the main loop when there is nothing else to do.
+ */
+void SwTimer_Idle(void)
+{
+	uint32_t Irq_State = 0;
+	uint32_t Changes = SwTimer_Changes;
+	uint32_t Silent_Ticks = 0;
+	/* 1. Find the deadline with interrupts unmasked, the scan can be long */
+	uint32_t Next_Expiry = SwTimer_Get_Ticks_To_Next_Expiry();
+
+	/* 2. Masked so a timer started by an interrupt cannot slip in between
+	 *    the check and the sleep. A start or a tick during the scan makes
+	 *    the deadline stale: return, the caller polls again. */
+	Irq_State = Core_Enter_Critical();
+	if(Changes == SwTimer_Changes)
+	{
+		Silent_Ticks = SysTick_Tickless_Sleep(Next_Expiry, SwTimer_Tick);
+		while(Silent_Ticks--)
+			{ SwTimer_Collect(); }
+	}
+	/* 3. The pending interrupts (the deadline tick included) run here */
+	Core_Exit_Critical(Irq_State);
+
+	/* 4. The timers collected while masked run with interrupts unmasked */
+	SwTimer_Run_Expired();
+}
+/*---------------  Section: Helper Function Definitions --------------- */
+static inline void SwTimer_Link(SwTimer_List_t * List, SwTimer_t * Timer)
+{
+	Timer->Prev = NULL;
+	Timer->Next = List->Head;
+	if(NULL != List->Head)
+		{ List->Head->Prev = Timer; }
+	List->Head = Timer;
+	Timer->List = List;
+}
+
+static inline void SwTimer_Unlink(SwTimer_t * Timer)
+{
+	if(NULL != Timer->Prev)
+		{ Timer->Prev->Next = Timer->Next; }
+	else
+		{ Timer->List->Head = Timer->Next; }
+	if(NULL != Timer->Next)
+		{ Timer->Next->Prev = Timer->Prev; }
+	Timer->Next = NULL;
+	Timer->Prev = NULL;
+	Timer->List = NULL;
+}
+
+/* Advances the wheel by one tick and moves the timers due to the expired
+ * list. Called with interrupts masked. */
+static void SwTimer_Collect(void)
+{
+	SwTimer_t * Timer = NULL;
+	SwTimer_t * Next_Timer = NULL;
+
+	SwTimer_Now++;
+	SwTimer_Changes++;
+
+	/* Only the timers due now leave the slot, later rounds stay */
+	Timer = SwTimer_Wheel[SwTimer_Now & SW_TIMER_WHEEL_MASK].Head;
+	while(NULL != Timer)
+	{
+		Next_Timer = Timer->Next;
+		if(Timer->Expiry == SwTimer_Now)
+		{
+			SwTimer_Unlink(Timer);
+			SwTimer_Link(&SwTimer_Expired, Timer);
+		}
+		Timer = Next_Timer;
+	}
+}
+
+/* Runs the callbacks of the expired timers with interrupts unmasked.
+ * The callbacks may start or stop any timer, those still waiting here included. */
+static void SwTimer_Run_Expired(void)
+{
+	SwTimer_t * Timer = NULL;
+	SwTimer_Callback_t Callback = NULL;
+	void * Context = NULL;
+	uint32_t Irq_State = Core_Enter_Critical();
+
+	while(NULL != SwTimer_Expired.Head)
+	{
+		Timer = SwTimer_Expired.Head;
+		SwTimer_Unlink(Timer);
+		/* Re-armed before the callback, so the callback can still stop it.
+		 * Counted from the due tick, a late run does not shift the period. */
+		if(0 != Timer->Period)
+		{
+			Timer->Expiry += Timer->Period;
+			if((int32_t)(Timer->Expiry - SwTimer_Now) <= 0)
+				{ Timer->Expiry = SwTimer_Now + 1UL; }
+			SwTimer_Link(&SwTimer_Wheel[Timer->Expiry & SW_TIMER_WHEEL_MASK], Timer);
+			SwTimer_Changes++;
+		}
+		Callback = Timer->Callback;
+		Context = Timer->Context;
+
+		Core_Exit_Critical(Irq_State);
+		Callback(Context);
+		Irq_State = Core_Enter_Critical();
+	}
+	Core_Exit_Critical(Irq_State);
+}
@@ -0,0 +1,447 @@
+/**
+ ******************************************************************************
+ * @file           : startup.c
+ * @author         : Mostafa Asaad (https://github.com/M0stafa077)
+ * @brief          : Startup Code Implementation.
+ ******************************************************************************
+ */
+/* --------------- Section : Includes --------------- */
+#include "Startup/startup.h"
+#include "Common/stm32f401_registers.h"
+#include "CortexM4/NVIC/NVIC.h"
+#include "CortexM4/SCB/SCB.h"
+#include "CortexM4/DWT/DWT.h"
+#include "CortexM4/FPU/FPU.h"
+#include "MCAL/RCC/rcc.h"
+#include "MCAL/FLASH/flash.h"
+/* --------------- Section: Macro Declarations --------------- */
+#define STARTUP_RCC_AHB1ENR_DMA2EN_POS		22UL
+
+/* !< DMA2 stream configuration for a memory-to-memory word transfer */
+#define STARTUP_DMA_DATA_STREAM				0UL
+#define STARTUP_DMA_BSS_STREAM				1UL
+#define STARTUP_DMA_SxCR_EN_POS				0UL
+#define STARTUP_DMA_SxCR_M2M				(0x2UL << 6)
+#define STARTUP_DMA_SxCR_PINC				(1UL << 9)
+#define STARTUP_DMA_SxCR_MINC				(1UL << 10)
+#define STARTUP_DMA_SxCR_WORDS				((0x2UL << 11) | (0x2UL << 13))
+#define STARTUP_DMA_SxCR_PL_VERY_HIGH		(0x3UL << 16)
+#define STARTUP_DMA_SxFCR_FULL_FIFO			((1UL << 2) | 0x3UL)
+#define STARTUP_DMA_MAX_WORDS				0xFFFFUL
+/* !< LISR / LIFCR flags, stream 1 is 6 bits above stream 0 */
+#define STARTUP_DMA_TEIF(STREAM)			(1UL << (3UL + (6UL * (STREAM))))
+#define STARTUP_DMA_TCIF(STREAM)			(1UL << (5UL + (6UL * (STREAM))))
+#define STARTUP_DMA_ALL_FLAGS(STREAM)		(0x3DUL << (6UL * (STREAM)))
+
+/* --------------- Section: Macro Functions Declarations --------------- */
+#define STARTUP_WEAK_HANDLER(NAME)			void NAME(void) __attribute__((weak, alias("Default_Handler")))
+
+/*---------------  Section: External Symbols --------------- */
+/* !< Linker script symbols */
+extern uint32_t _estack;
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+
+extern void __libc_init_array(void) __attribute__((weak));
+extern int main(void);
+
+/*---------------  Section: Handlers Declarations --------------- */
+void Default_Handler(void);
+
+STARTUP_WEAK_HANDLER(NMI_Handler);
+STARTUP_WEAK_HANDLER(HardFault_Handler);
+STARTUP_WEAK_HANDLER(MemManage_Handler);
+STARTUP_WEAK_HANDLER(BusFault_Handler);
+STARTUP_WEAK_HANDLER(UsageFault_Handler);
+STARTUP_WEAK_HANDLER(SVC_Handler);
+STARTUP_WEAK_HANDLER(DebugMon_Handler);
+STARTUP_WEAK_HANDLER(PendSV_Handler);
+STARTUP_WEAK_HANDLER(SysTick_Handler);
+STARTUP_WEAK_HANDLER(WWDG_IRQHandler);
+STARTUP_WEAK_HANDLER(PVD_IRQHandler);
+STARTUP_WEAK_HANDLER(TAMP_STAMP_IRQHandler);
+STARTUP_WEAK_HANDLER(RTC_WKUP_IRQHandler);
+STARTUP_WEAK_HANDLER(FLASH_IRQHandler);
+STARTUP_WEAK_HANDLER(RCC_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI0_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI1_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI2_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI3_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI4_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream0_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream1_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream2_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream3_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream4_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream5_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream6_IRQHandler);
+STARTUP_WEAK_HANDLER(ADC_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI9_5_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM1_BRK_TIM9_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM1_UP_TIM10_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM1_TRG_COM_TIM11_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM1_CC_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM2_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM3_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM4_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C1_EV_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C1_ER_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C2_EV_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C2_ER_IRQHandler);
+STARTUP_WEAK_HANDLER(SPI1_IRQHandler);
+STARTUP_WEAK_HANDLER(SPI2_IRQHandler);
+STARTUP_WEAK_HANDLER(USART1_IRQHandler);
+STARTUP_WEAK_HANDLER(USART2_IRQHandler);
+STARTUP_WEAK_HANDLER(EXTI15_10_IRQHandler);
+STARTUP_WEAK_HANDLER(RTC_Alarm_IRQHandler);
+STARTUP_WEAK_HANDLER(OTG_FS_WKUP_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA1_Stream7_IRQHandler);
+STARTUP_WEAK_HANDLER(SDIO_IRQHandler);
+STARTUP_WEAK_HANDLER(TIM5_IRQHandler);
+STARTUP_WEAK_HANDLER(SPI3_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream0_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream1_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream2_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream3_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream4_IRQHandler);
+STARTUP_WEAK_HANDLER(OTG_FS_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream5_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream6_IRQHandler);
+STARTUP_WEAK_HANDLER(DMA2_Stream7_IRQHandler);
+STARTUP_WEAK_HANDLER(USART6_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C3_EV_IRQHandler);
+STARTUP_WEAK_HANDLER(I2C3_ER_IRQHandler);
+STARTUP_WEAK_HANDLER(FPU_IRQHandler);
+STARTUP_WEAK_HANDLER(SPI4_IRQHandler);
+
+/*---------------  Section: Global Variables --------------- */
+/* !< Reserved entries stay NULL */
+const Interrupt_Handler_t Startup_Vector_Table[SCB_VECTORS_NUMBER] __attribute__((section(".isr_vector"), used)) =
+{
+	[0] = (Interrupt_Handler_t)&_estack,
+	[1] = Reset_Handler,
+	[16 + NonMaskableInt_IRQn] = NMI_Handler,
+	[3] = HardFault_Handler,
+	[16 + MemoryManagement_IRQn] = MemManage_Handler,
+	[16 + BusFault_IRQn] = BusFault_Handler,
+	[16 + UsageFault_IRQn] = UsageFault_Handler,
+	[16 + SVCall_IRQn] = SVC_Handler,
+	[16 + DebugMonitor_IRQn] = DebugMon_Handler,
+	[16 + PendSV_IRQn] = PendSV_Handler,
+	[16 + SysTick_IRQn] = SysTick_Handler,
+	[16 + WWDG_IRQn] = WWDG_IRQHandler,
+	[16 + PVD_IRQn] = PVD_IRQHandler,
+	[16 + TAMP_STAMP_IRQn] = TAMP_STAMP_IRQHandler,
+	[16 + RTC_WKUP_IRQn] = RTC_WKUP_IRQHandler,
+	[16 + FLASH_IRQn] = FLASH_IRQHandler,
+	[16 + RCC_IRQn] = RCC_IRQHandler,
+	[16 + EXTI0_IRQn] = EXTI0_IRQHandler,
+	[16 + EXTI1_IRQn] = EXTI1_IRQHandler,
+	[16 + EXTI2_IRQn] = EXTI2_IRQHandler,
+	[16 + EXTI3_IRQn] = EXTI3_IRQHandler,
+	[16 + EXTI4_IRQn] = EXTI4_IRQHandler,
+	[16 + DMA1_Stream0_IRQn] = DMA1_Stream0_IRQHandler,
+	[16 + DMA1_Stream1_IRQn] = DMA1_Stream1_IRQHandler,
+	[16 + DMA1_Stream2_IRQn] = DMA1_Stream2_IRQHandler,
+	[16 + DMA1_Stream3_IRQn] = DMA1_Stream3_IRQHandler,
+	[16 + DMA1_Stream4_IRQn] = DMA1_Stream4_IRQHandler,
+	[16 + DMA1_Stream5_IRQn] = DMA1_Stream5_IRQHandler,
+	[16 + DMA1_Stream6_IRQn] = DMA1_Stream6_IRQHandler,
+	[16 + ADC_IRQn] = ADC_IRQHandler,
+	[16 + EXTI9_5_IRQn] = EXTI9_5_IRQHandler,
+	[16 + TIM1_BRK_TIM9_IRQn] = TIM1_BRK_TIM9_IRQHandler,
+	[16 + TIM1_UP_TIM10_IRQn] = TIM1_UP_TIM10_IRQHandler,
+	[16 + TIM1_TRG_COM_TIM11_IRQn] = TIM1_TRG_COM_TIM11_IRQHandler,
+	[16 + TIM1_CC_IRQn] = TIM1_CC_IRQHandler,
+	[16 + TIM2_IRQn] = TIM2_IRQHandler,
+	[16 + TIM3_IRQn] = TIM3_IRQHandler,
+	[16 + TIM4_IRQn] = TIM4_IRQHandler,
+	[16 + I2C1_EV_IRQn] = I2C1_EV_IRQHandler,
+	[16 + I2C1_ER_IRQn] = I2C1_ER_IRQHandler,
+	[16 + I2C2_EV_IRQn] = I2C2_EV_IRQHandler,
+	[16 + I2C2_ER_IRQn] = I2C2_ER_IRQHandler,
+	[16 + SPI1_IRQn] = SPI1_IRQHandler,
+	[16 + SPI2_IRQn] = SPI2_IRQHandler,
+	[16 + USART1_IRQn] = USART1_IRQHandler,
+	[16 + USART2_IRQn] = USART2_IRQHandler,
+	[16 + EXTI15_10_IRQn] = EXTI15_10_IRQHandler,
+	[16 + RTC_Alarm_IRQn] = RTC_Alarm_IRQHandler,
+	[16 + OTG_FS_WKUP_IRQn] = OTG_FS_WKUP_IRQHandler,
+	[16 + DMA1_Stream7_IRQn] = DMA1_Stream7_IRQHandler,
+	[16 + SDIO_IRQn] = SDIO_IRQHandler,
+	[16 + TIM5_IRQn] = TIM5_IRQHandler,
+	[16 + SPI3_IRQn] = SPI3_IRQHandler,
+	[16 + DMA2_Stream0_IRQn] = DMA2_Stream0_IRQHandler,
+	[16 + DMA2_Stream1_IRQn] = DMA2_Stream1_IRQHandler,
+	[16 + DMA2_Stream2_IRQn] = DMA2_Stream2_IRQHandler,
+	[16 + DMA2_Stream3_IRQn] = DMA2_Stream3_IRQHandler,
+	[16 + DMA2_Stream4_IRQn] = DMA2_Stream4_IRQHandler,
+	[16 + OTG_FS_IRQn] = OTG_FS_IRQHandler,
+	[16 + DMA2_Stream5_IRQn] = DMA2_Stream5_IRQHandler,
+	[16 + DMA2_Stream6_IRQn] = DMA2_Stream6_IRQHandler,
+	[16 + DMA2_Stream7_IRQn] = DMA2_Stream7_IRQHandler,
+	[16 + USART6_IRQn] = USART6_IRQHandler,
+	[16 + I2C3_EV_IRQn] = I2C3_EV_IRQHandler,
+	[16 + I2C3_ER_IRQn] = I2C3_ER_IRQHandler,
+	[16 + FPU_IRQn] = FPU_IRQHandler,
+	[16 + SPI4_IRQn] = SPI4_IRQHandler
+};
+
+/*---------------  Section: Static Global Variables --------------- */
+#if (STARTUP_EARLY_CLOCK_ENABLED == STARTUP_EARLY_CLOCK_STATE)
+RCC_PLL_STATIC_ASSERT(RCC_HSI_VALUE, STARTUP_PLL_M, STARTUP_PLL_N, STARTUP_PLL_P_DIV, STARTUP_PLL_Q);
+
+/* !< const so it sits in FLASH, read before .data exists */
+static const RCC_InitConfigs_t Startup_Clock_Configs =
+{
+	.Oscillator_Configurations = { RCC_HSE_OFF, RCC_HSI_ON, RCC_PLLI2S_OFF },
+	.Clock_Source = RCC_CLOCK_SOURCE_PLL,
+	.AHB_Prescaler = SYSTEM_CLOCK_NOT_DIVIDED,
+	.APB1_Prescaler = STARTUP_APB1_PRESCALER,
+	.APB2_Prescaler = APB2_CLOCK_NOT_DIVIDED,
+	.PLL_Configurations = { RCC_PLL_SOURE_HSI, STARTUP_PLL_N, STARTUP_PLL_M, STARTUP_PLL_Q, STARTUP_PLL_P }
+};
+#endif
+/* !< DMA source of the .bss zeroing */
+static const uint32_t Startup_Zero_Word = 0;
+/* !< Filled at the end of the runtime init, it lives in .bss itself */
+static Startup_Boot_Times_t Startup_Boot_Times;
+
+/*---------------  Section: Helper Function Declarations --------------- */
+static void Startup_Copy_Words(uint32_t * Dest, const uint32_t * Source, uint32_t Words);
+static void Startup_Zero_Words(uint32_t * Dest, uint32_t Words);
+#if (STARTUP_COPY_DMA == STARTUP_COPY_MODE)
+static void Startup_Dma_Start(uint32_t Stream, uint32_t * Dest, const uint32_t * Source, uint32_t Words, uint32_t Source_Inc);
+static uint8_t Startup_Dma_Init_Sections(uint32_t * Stamps);
+#endif
+
+/*---------------  Section: Function Definitions --------------- */
+
+/**
+ * @brief  Entry point after reset:
+ * 		   1. starts the cycle counter and grants the FPU access,
+ * 		   2. sets the FLASH wait states, prefetch and caches, and moves SYSCLK to the PLL,
+ * 		   3. copies .data and zeroes .bss (DMA2 memory-to-memory or unrolled word stores),
+ * 		   4. runs the constructors and calls main().
+ * 		   Nothing before step 3 may rely on initialized or zeroed globals.
+ */
+void Reset_Handler(void)
+{
+	/* On the stack until .bss is zeroed */
+	uint32_t Stamps[STARTUP_PHASE_COUNT] = { 0 };
+	uint8_t Dma_Used = 0;
+	uint32_t Phase_Idx = 0;
+
+	/* 1. Cycle counter from 0, FPU access before any FP instruction */
+	COREDEBUG_TRACE_ENABLE();
+	DWT->CYCCNT = 0;
+	DWT_CYCCNT_ENABLE();
+	Stamps[STARTUP_PHASE_RESET] = DWT_GET_CYCCNT();
+#if defined(__ARM_FP)
+	(void)FPU_Enable(FPU_STACKING_LAZY);
+#endif
+
+	/* 2. Wait states before the faster clock, then the PLL */
+#if (STARTUP_EARLY_CLOCK_ENABLED == STARTUP_EARLY_CLOCK_STATE)
+	if(E_OK == Flash_Set_Latency(STARTUP_FLASH_WAIT_STATES))
+	{
+		FLASH->ACR |= (1UL << FLASH_ACR_PRFTEN_POS) | (1UL << FLASH_ACR_ICEN_POS) | (1UL << FLASH_ACR_DCEN_POS);
+		(void)RCC_Init(&Startup_Clock_Configs);
+	}
+	Stamps[STARTUP_PHASE_CLOCK_READY] = DWT_GET_CYCCNT();
+#endif
+
+	/* 3. .data and .bss */
+#if (STARTUP_COPY_DMA == STARTUP_COPY_MODE)
+	Dma_Used = Startup_Dma_Init_Sections(Stamps);
+#endif
+	if(0 == Dma_Used)
+	{
+		Startup_Copy_Words(&_sdata, &_sidata, (uint32_t)(&_edata - &_sdata));
+		Stamps[STARTUP_PHASE_DATA_READY] = DWT_GET_CYCCNT();
+		Startup_Zero_Words(&_sbss, (uint32_t)(&_ebss - &_sbss));
+		Stamps[STARTUP_PHASE_BSS_READY] = DWT_GET_CYCCNT();
+	}
+
+	/* 4. The globals exist now: the clock cache got its reset value back from .data */
+	RCC_Update_Clock_Freqs();
+	for(Phase_Idx = 0; Phase_Idx < STARTUP_PHASE_COUNT; Phase_Idx++)
+		{ Startup_Boot_Times.Stamps[Phase_Idx] = Stamps[Phase_Idx]; }
+	Startup_Boot_Times.Reset_Clock = RCC_HSI_VALUE;
+	Startup_Boot_Times.Run_Clock = RCC_Get_SYSCLK_Freq();
+	Startup_Boot_Times.Dma_Used = Dma_Used;
+
+	/* 5. Constructors, then the application */
+	if(NULL != __libc_init_array)
+		{ __libc_init_array(); }
+	Startup_Boot_Times.Stamps[STARTUP_PHASE_INIT_READY] = DWT_GET_CYCCNT();
+
+	Startup_Boot_Times.Stamps[STARTUP_PHASE_MAIN_ENTRY] = DWT_GET_CYCCNT();
+	(void)main();
+	while(1);
+}
+/**
+ * @brief  Records the application ready stamp (STARTUP_PHASE_APP_READY),
+ * 		   only the first call counts. The time-to-first-sample is read from it.
+ */
+void Startup_Mark_App_Ready(void)
+{
+	if(0 == Startup_Boot_Times.Stamps[STARTUP_PHASE_APP_READY])
+		{ Startup_Boot_Times.Stamps[STARTUP_PHASE_APP_READY] = DWT_GET_CYCCNT(); }
+}
+/**
+ * @brief  Reads the boot timestamps.
+ * @param  Times: Returns a copy of the timestamps.
+ * @retval Std_ReturnType_t: Status of the operation.
+ *         - E_OK: Operation completed successfully
+ *         - E_NOT_OK: NULL pointer
+ */
+Std_ReturnType_t Startup_Get_Boot_Times(Startup_Boot_Times_t * Times)
+{
+	Std_ReturnType_t retVal = E_OK;
+
+	if(NULL == Times)
+		{ retVal = E_NOT_OK; }
+	else
+		{ *Times = Startup_Boot_Times; }
+
+	return retVal;
+}
+/**
+ * @brief  Converts a boot stamp to microseconds since reset, taking the clock switch into account.
+ * @param  Phase: The phase.
+ * @return Microseconds since reset, 0 for a phase not reached or invalid.
+ */
+uint32_t Startup_Get_Phase_Us(Startup_Phase_t Phase)
+{
+	uint32_t Us = 0;
+	uint32_t Clock_Stamp = Startup_Boot_Times.Stamps[STARTUP_PHASE_CLOCK_READY];
+	uint32_t Reset_Mhz = Startup_Boot_Times.Reset_Clock / 1000000UL;
+	uint32_t Run_Mhz = Startup_Boot_Times.Run_Clock / 1000000UL;
+
+	if((Phase >= STARTUP_PHASE_COUNT) || (0 == Reset_Mhz) || (0 == Run_Mhz))
+		{ /* Invalid phase or not booted through Reset_Handler */ }
+	else if((Phase <= STARTUP_PHASE_CLOCK_READY) || (0 == Clock_Stamp))
+		{ Us = Startup_Boot_Times.Stamps[Phase] / Reset_Mhz; }
+	else if(0 != Startup_Boot_Times.Stamps[Phase])
+		{ Us = (Clock_Stamp / Reset_Mhz) + ((Startup_Boot_Times.Stamps[Phase] - Clock_Stamp) / Run_Mhz); }
+
+	return Us;
+}
+/**
+ * @brief  Target of every handler the application does not define.
+ */
+void Default_Handler(void)
+{
+	while(1);
+}
+
+/*---------------  Section: Helper Function Definitions --------------- */
+/* The loops must not become memcpy() / memset() calls, the C library may not be usable yet */
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static void Startup_Copy_Words(uint32_t * Dest, const uint32_t * Source, uint32_t Words)
+{
+	/* 4 words per iteration, the loads pipeline on the FLASH prefetch */
+	for(; Words >= 4UL; Words -= 4UL)
+	{
+		Dest[0] = Source[0];
+		Dest[1] = Source[1];
+		Dest[2] = Source[2];
+		Dest[3] = Source[3];
+		Dest += 4;
+		Source += 4;
+	}
+	for(; Words > 0UL; Words--)
+		{ *Dest++ = *Source++; }
+}
+
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+static void Startup_Zero_Words(uint32_t * Dest, uint32_t Words)
+{
+	for(; Words >= 4UL; Words -= 4UL)
+	{
+		Dest[0] = 0;
+		Dest[1] = 0;
+		Dest[2] = 0;
+		Dest[3] = 0;
+		Dest += 4;
+	}
+	for(; Words > 0UL; Words--)
+		{ *Dest++ = 0; }
+}
+
+#if (STARTUP_COPY_DMA == STARTUP_COPY_MODE)
+/* Memory-to-memory: PAR is the source, M0AR the destination, the FIFO is mandatory */
+static void Startup_Dma_Start(uint32_t Stream, uint32_t * Dest, const uint32_t * Source, uint32_t Words, uint32_t Source_Inc)
+{
+	DMA2->Streams[Stream].CR = 0;
+	DMA2->Streams[Stream].PAR = (uint32_t)Source;
+	DMA2->Streams[Stream].M0AR = (uint32_t)Dest;
+	DMA2->Streams[Stream].NDTR = Words;
+	DMA2->Streams[Stream].FCR = STARTUP_DMA_SxFCR_FULL_FIFO;
+	DMA2->Streams[Stream].CR = STARTUP_DMA_SxCR_M2M | STARTUP_DMA_SxCR_MINC | STARTUP_DMA_SxCR_WORDS |
+							   STARTUP_DMA_SxCR_PL_VERY_HIGH | ((0 != Source_Inc) ? STARTUP_DMA_SxCR_PINC : 0UL);
+	SET_BIT(DMA2->Streams[Stream].CR, STARTUP_DMA_SxCR_EN_POS);
+}
+
+/*
+ * Runs the .data copy and the .bss zeroing on two DMA2 streams at once.
+ * Returns 0, having touched nothing, if a section is too small for the DMA to pay off
+ * (or too big for one transfer). A stream ending on a transfer error is redone by the CPU.
+ */
+static uint8_t Startup_Dma_Init_Sections(uint32_t * Stamps)
+{
+	uint8_t Dma_Used = 0;
+	uint32_t Data_Words = (uint32_t)(&_edata - &_sdata);
+	uint32_t Bss_Words = (uint32_t)(&_ebss - &_sbss);
+	uint32_t Pending = 0;
+	uint32_t Flags = 0;
+
+	if((Data_Words >= STARTUP_DMA_MIN_WORDS) && (Bss_Words >= STARTUP_DMA_MIN_WORDS) &&
+	   (Data_Words <= STARTUP_DMA_MAX_WORDS) && (Bss_Words <= STARTUP_DMA_MAX_WORDS))
+	{
+		Dma_Used = 1;
+		/* 1. The clock gating counters are in .bss, the DMA2 clock is driven directly */
+		SET_BIT(RCC->AHB1ENR, STARTUP_RCC_AHB1ENR_DMA2EN_POS);
+		(void)RCC->AHB1ENR;
+		DMA2->LIFCR = STARTUP_DMA_ALL_FLAGS(STARTUP_DMA_DATA_STREAM) | STARTUP_DMA_ALL_FLAGS(STARTUP_DMA_BSS_STREAM);
+
+		/* 2. Both sections at once */
+		Startup_Dma_Start(STARTUP_DMA_DATA_STREAM, &_sdata, &_sidata, Data_Words, 1);
+		Startup_Dma_Start(STARTUP_DMA_BSS_STREAM, &_sbss, &Startup_Zero_Word, Bss_Words, 0);
+		Pending = (1UL << STARTUP_DMA_DATA_STREAM) | (1UL << STARTUP_DMA_BSS_STREAM);
+
+		/* 3. Stamp each one as it ends */
+		while(0 != Pending)
+		{
+			Flags = DMA2->LISR;
+			if((Pending & (1UL << STARTUP_DMA_DATA_STREAM)) &&
+			   (Flags & (STARTUP_DMA_TCIF(STARTUP_DMA_DATA_STREAM) | STARTUP_DMA_TEIF(STARTUP_DMA_DATA_STREAM))))
+			{
+				if(Flags & STARTUP_DMA_TEIF(STARTUP_DMA_DATA_STREAM))
+					{ Startup_Copy_Words(&_sdata, &_sidata, Data_Words); }
+				Stamps[STARTUP_PHASE_DATA_READY] = DWT_GET_CYCCNT();
+				Pending &= ~(1UL << STARTUP_DMA_DATA_STREAM);
+			}
+			if((Pending & (1UL << STARTUP_DMA_BSS_STREAM)) &&
+			   (Flags & (STARTUP_DMA_TCIF(STARTUP_DMA_BSS_STREAM) | STARTUP_DMA_TEIF(STARTUP_DMA_BSS_STREAM))))
+			{
+				if(Flags & STARTUP_DMA_TEIF(STARTUP_DMA_BSS_STREAM))
+					{ Startup_Zero_Words(&_sbss, Bss_Words); }
+				Stamps[STARTUP_PHASE_BSS_READY] = DWT_GET_CYCCNT();
+				Pending &= ~(1UL << STARTUP_DMA_BSS_STREAM);
+			}
+		}
+
+		/* 4. Leave DMA2 as out of reset, matching its zeroed clock gating counter */
+		DMA2->LIFCR = STARTUP_DMA_ALL_FLAGS(STARTUP_DMA_DATA_STREAM) | STARTUP_DMA_ALL_FLAGS(STARTUP_DMA_BSS_STREAM);
+		DMA2->Streams[STARTUP_DMA_DATA_STREAM].CR = 0;
+		DMA2->Streams[STARTUP_DMA_BSS_STREAM].CR = 0;
+		CLEAR_BIT(RCC->AHB1ENR, STARTUP_RCC_AHB1ENR_DMA2EN_POS);
+	}
+	return Dma_Used;
+}
+#endif
@@ -13,8 +13,7 @@
 #include "CortexM4/SysTick/SysTick.h"
 #include "MCAL/DMA/dma.h"
 #include "MCAL/FLASH/flash.h"
-
-void RCC_Clock_Config();
+#include "Services/EventLoop/event_loop.h"
 
 
 static volatile uint32_t x = 0;
@@ -41,8 +40,8 @@ DMA_Stream_InitCfgs_t stream_cfgs =
 
 int main(void)
 {
+	/* The clock tree is up already, Reset_Handler started the PLL (Startup/startup_cfg.h) */
 	NVIC_SetPriorityGrouping(NVIC_PRIORITY_GROUP_2_BITS);
-	RCC_Clock_Config();
 
 //	uint32_t No_Of_Ticks = 2000000;
 //	retVal = SysTick_Init(No_Of_Ticks);
@@ -57,35 +56,12 @@ int main(void)
 
 
 
-    while(1)
-    {
-//    	x++;
-    }
+    /* Sleeps until the interrupts post events */
+    retVal |= Event_Loop_Init();
+    Event_Loop_Run();
     return 0;
 }
 
 
 void SysTick_ExcepHandler(void)
 { x++; }
-
-void RCC_Clock_Config()
-{
-	RCC_InitConfigs_t rcc_cfgs =
-	{
-		.Oscillator_Configurations = { RCC_HSE_OFF, RCC_HSI_ON, RCC_PLLI2S_OFF },
-		.Clock_Source = RCC_CLOCK_SOURCE_HSI,
-		.AHB_Prescaler = SYSTEM_CLOCK_NOT_DIVIDED,
-		.APB1_Prescaler = APB1_CLOCK_NOT_DIVIDED,
-		.APB2_Prescaler = APB2_CLOCK_NOT_DIVIDED,
-		.PLL_Configurations = {
-			RCC_PLL_SOURE_HSI,		// Clock Src
-			0xA8,					// N
-			0x08,					// M
-			0x04,					// Q
-			RCC_PLL_P_DIVIDE_BY_4	// P
-		}
-	};
-	RCC_Init(&rcc_cfgs);
-}
-
-